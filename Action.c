@@ -26,7 +26,9 @@ in the source distribution for its full text.
 #include "Macros.h"
 #include "MainPanel.h"
 #include "OpenFilesScreen.h"
+#include "Platform.h"
 #include "Process.h"
+#include "ProcessGroup.h"
 #include "ProcessLocksScreen.h"
 #include "ProvideCurses.h"
 #include "ScreenManager.h"
@@ -232,12 +234,43 @@ static Htop_Reaction actionToggleMergedCommand(State* st) {
 
 static Htop_Reaction actionToggleTreeView(State* st) {
    st->settings->treeView = !st->settings->treeView;
+   st->settings->groupBy = 0;
 
    if (!st->settings->allBranchesCollapsed)
       ProcessList_expandTree(st->pl);
    return HTOP_REFRESH | HTOP_SAVE_SETTINGS | HTOP_KEEP_FOLLOWING | HTOP_REDRAW_BAR | HTOP_UPDATE_PANELHDR;
 }
 
+static Htop_Reaction actionGroupBy(State* st) {
+   Panel* groupPanel = Panel_new(0, 0, 0, 0, Class(ListItem), true, FunctionBar_newEnterEsc("Group  ", "Cancel "));
+   Panel_setHeader(groupPanel, "Group by");
+   Panel_add(groupPanel, (Object*) ListItem_new("(none)", 0));
+   const ProcessField* fields = st->settings->fields;
+   for (int i = 0; fields[i]; i++) {
+      /* runtime-discovered columns have no raw values to group on */
+      if (fields[i] >= LAST_PROCESSFIELD || fields[i] == COMM)
+         continue;
+
+      char* name = String_trim(Process_fields[fields[i]].name);
+      Panel_add(groupPanel, (Object*) ListItem_new(name, fields[i]));
+      if (fields[i] == st->settings->groupBy)
+         Panel_setSelected(groupPanel, Panel_size(groupPanel) - 1);
+
+      free(name);
+   }
+   const ListItem* field = (const ListItem*) Action_pickFromVector(st, groupPanel, 18, false);
+   Htop_Reaction reaction = HTOP_OK;
+   if (field && field->key != (int)st->settings->groupBy) {
+      st->settings->groupBy = field->key;
+      if (field->key)
+         st->settings->treeView = false;
+      reaction |= HTOP_SAVE_SETTINGS | HTOP_RECALCULATE;
+   }
+   Object_delete(groupPanel);
+
+   return reaction | HTOP_REFRESH | HTOP_REDRAW_BAR | HTOP_UPDATE_PANELHDR;
+}
+
 static Htop_Reaction actionExpandOrCollapseAllBranches(State* st) {
    st->settings->allBranchesCollapsed = !st->settings->allBranchesCollapsed;
    if (st->settings->allBranchesCollapsed)
@@ -250,7 +283,7 @@ static Htop_Reaction actionExpandOrCollapseAllBranches(State* st) {
 static Htop_Reaction actionIncFilter(State* st) {
    IncSet* inc = (st->mainPanel)->inc;
    IncSet_activate(inc, INC_FILTER, (Panel*)st->mainPanel);
-   st->pl->incFilter = IncSet_filter(inc);
+   ProcessList_setFilter(st->pl, IncSet_filter(inc));
    return HTOP_REFRESH | HTOP_KEEP_FOLLOWING;
 }
 
@@ -312,7 +345,7 @@ static Htop_Reaction actionSetAffinity(State* st) {
       return HTOP_OK;
 
 #if (defined(HAVE_LIBHWLOC) || defined(HAVE_AFFINITY))
-   const Process* p = (const Process*) Panel_getSelected((Panel*)st->mainPanel);
+   const Process* p = MainPanel_getSelectedProcess(st->mainPanel);
    if (!p)
       return HTOP_OK;
 
@@ -391,7 +424,7 @@ static Htop_Reaction actionLsof(State* st) {
    if (Settings_isReadonly())
       return HTOP_OK;
 
-   const Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
+   const Process* p = MainPanel_getSelectedProcess(st->mainPanel);
    if (!p)
       return HTOP_OK;
 
@@ -404,7 +437,7 @@ static Htop_Reaction actionLsof(State* st) {
 }
 
 static Htop_Reaction actionShowLocks(State* st) {
-   const Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
+   const Process* p = MainPanel_getSelectedProcess(st->mainPanel);
    if (!p)
       return HTOP_OK;
    ProcessLocksScreen* pls = ProcessLocksScreen_new(p);
@@ -419,7 +452,7 @@ static Htop_Reaction actionStrace(State* st) {
    if (Settings_isReadonly())
       return HTOP_OK;
 
-   const Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
+   const Process* p = MainPanel_getSelectedProcess(st->mainPanel);
    if (!p)
       return HTOP_OK;
 
@@ -439,7 +472,10 @@ static Htop_Reaction actionTag(State* st) {
    if (!p)
       return HTOP_OK;
 
-   Process_toggleTag(p);
+   if (ProcessGroup_isGroup((Object*)p))
+      ProcessGroup_setTag((ProcessGroup*)p, !p->tag);
+   else
+      Process_toggleTag(p);
    Panel_onKey((Panel*)st->mainPanel, KEY_DOWN);
    return HTOP_OK;
 }
@@ -464,6 +500,7 @@ static const struct {
    { .key = "   F3 /: ",  .roInactive = false, .info = "incremental name search" },
    { .key = "   F4 \\: ", .roInactive = false, .info = "incremental name filtering" },
    { .key = "   F5 t: ",  .roInactive = false, .info = "tree view" },
+   { .key = "      g: ",  .roInactive = false, .info = "group by a column (+ - expand a group)" },
    { .key = "      p: ",  .roInactive = false, .info = "toggle program path" },
    { .key = "      m: ",  .roInactive = false, .info = "toggle merged command" },
    { .key = "      Z: ",  .roInactive = false, .info = "pause/resume process updates" },
@@ -494,9 +531,19 @@ static const struct {
 #endif
    { .key = "      e: ", .roInactive = false, .info = "show process environment" },
    { .key = "      i: ", .roInactive = true,  .info = "set IO priority" },
+#ifdef HTOP_LINUX
+   { .key = "      l: ", .roInactive = true,  .info = "list open files" },
+#else
    { .key = "      l: ", .roInactive = true,  .info = "list open files with lsof" },
+#endif
    { .key = "      x: ", .roInactive = false, .info = "list file locks of process" },
+#ifdef HTOP_LINUX
+   { .key = "      G: ", .roInactive = false, .info = "show control group usage" },
+   { .key = "      L: ", .roInactive = false, .info = "find who holds open files" },
+   { .key = "      s: ", .roInactive = true,  .info = "count syscalls (F8 there: strace)" },
+#else
    { .key = "      s: ", .roInactive = true,  .info = "trace syscalls with strace" },
+#endif
    { .key = "      w: ", .roInactive = false, .info = "wrap process command in multiple lines" },
    { .key = " F2 C S: ", .roInactive = false, .info = "setup" },
    { .key = " F1 h ?: ", .roInactive = false, .info = "show this help screen" },
@@ -603,6 +650,18 @@ static Htop_Reaction actionHelp(State* st) {
    line += MAXIMUM(leftHelpItems, item);
    line++;
 
+   /* keys of the modes that bind further ones */
+   if (st->pl->replay) {
+      mvaddstr(line++, 0, "Replay: ( ) step back/forward, b f seek a minute back/forward, v play/faster");
+      line++;
+   }
+#ifdef HTOP_PCP
+   if (opts.context == PM_CONTEXT_ARCHIVE) {
+      mvaddstr(line++, 0, "Archive: b f seek a minute back/forward, { } an hour, j jump to a time");
+      line++;
+   }
+#endif
+
    attrset(CRT_colors[HELP_BOLD]);
    mvaddstr(line++, 0, "Press any key to return.");
    attrset(CRT_colors[DEFAULT_COLOR]);
@@ -616,7 +675,10 @@ static Htop_Reaction actionHelp(State* st) {
 static Htop_Reaction actionUntagAll(State* st) {
    for (int i = 0; i < Panel_size((Panel*)st->mainPanel); i++) {
       Process* p = (Process*) Panel_get((Panel*)st->mainPanel, i);
-      p->tag = false;
+      if (ProcessGroup_isGroup((Object*)p))
+         ProcessGroup_setTag((ProcessGroup*)p, false);
+      else
+         p->tag = false;
    }
    return HTOP_REFRESH;
 }
@@ -626,12 +688,15 @@ static Htop_Reaction actionTagAllChildren(State* st) {
    if (!p)
       return HTOP_OK;
 
-   tagAllChildren((Panel*)st->mainPanel, p);
+   if (ProcessGroup_isGroup((Object*)p))
+      ProcessGroup_setTag((ProcessGroup*)p, true);
+   else
+      tagAllChildren((Panel*)st->mainPanel, p);
    return HTOP_OK;
 }
 
 static Htop_Reaction actionShowEnvScreen(State* st) {
-   Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
+   Process* p = MainPanel_getSelectedProcess(st->mainPanel);
    if (!p)
       return HTOP_OK;
 
@@ -644,7 +709,7 @@ static Htop_Reaction actionShowEnvScreen(State* st) {
 }
 
 static Htop_Reaction actionShowCommandScreen(State* st) {
-   Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
+   Process* p = MainPanel_getSelectedProcess(st->mainPanel);
    if (!p)
       return HTOP_OK;
 
@@ -688,6 +753,7 @@ void Action_setBindings(Htop_Action* keys) {
    keys['a'] = actionSetAffinity;
    keys['c'] = actionTagAllChildren;
    keys['e'] = actionShowEnvScreen;
+   keys['g'] = actionGroupBy;
    keys['h'] = actionHelp;
    keys['k'] = actionKill;
    keys['l'] = actionLsof;
@@ -12,6 +12,7 @@ in the source distribution for its full text.
 #include <stdlib.h>
 
 #include "CPUMeter.h"
+#include "DiskIOMeter.h"
 #include "DynamicMeter.h"
 #include "FunctionBar.h"
 #include "Hashtable.h"
@@ -20,6 +21,7 @@ in the source distribution for its full text.
 #include "Macros.h"
 #include "Meter.h"
 #include "MetersPanel.h"
+#include "NetworkIOMeter.h"
 #include "Object.h"
 #include "Platform.h"
 #include "ProvideCurses.h"
@@ -133,6 +135,28 @@ static void AvailableMetersPanel_addDynamicMeters(Panel* super, const ProcessLis
    Hashtable_foreach(pl->dynamicMeters, AvailableMetersPanel_addDynamicMeter, &iter);
 }
 
+// Handle (&DiskIOMeter_class) entries in the AvailableMetersPanel, one per device
+static void AvailableMetersPanel_addDiskIOMeters(Panel* super, const MeterClass* type, const ProcessList* pl, unsigned int offset) {
+   Panel_add(super, (Object*) ListItem_new(type->uiName, offset << 16));
+   size_t count = MINIMUM(DiskIOMeter_deviceCount(pl), 0xffff);
+   for (unsigned int i = 1; i <= count; i++) {
+      char buffer[50];
+      xSnprintf(buffer, sizeof(buffer), "%s %s", type->uiName, DiskIOMeter_deviceName(i));
+      Panel_add(super, (Object*) ListItem_new(buffer, (offset << 16) | i));
+   }
+}
+
+// Handle (&NetworkIOMeter_class) entries in the AvailableMetersPanel, one per interface
+static void AvailableMetersPanel_addNetworkIOMeters(Panel* super, const MeterClass* type, const ProcessList* pl, unsigned int offset) {
+   Panel_add(super, (Object*) ListItem_new(type->uiName, offset << 16));
+   size_t count = MINIMUM(NetworkIOMeter_interfaceCount(pl), 0xffff);
+   for (unsigned int i = 1; i <= count; i++) {
+      char buffer[50];
+      xSnprintf(buffer, sizeof(buffer), "%s %s", type->uiName, NetworkIOMeter_interfaceName(i));
+      Panel_add(super, (Object*) ListItem_new(buffer, (offset << 16) | i));
+   }
+}
+
 // Handle remaining Platform Meter entries in the AvailableMetersPanel
 static void AvailableMetersPanel_addPlatformMeter(Panel* super, const MeterClass* type, unsigned int offset) {
    const char* label = type->description ? type->description : type->uiName;
@@ -161,6 +185,10 @@ AvailableMetersPanel* AvailableMetersPanel_new(Settings* settings, Header* heade
       assert(type != &CPUMeter_class);
       if (type == &DynamicMeter_class)
          AvailableMetersPanel_addDynamicMeters(super, pl, i);
+      else if (type == &DiskIOMeter_class)
+         AvailableMetersPanel_addDiskIOMeters(super, type, pl, i);
+      else if (type == &NetworkIOMeter_class)
+         AvailableMetersPanel_addNetworkIOMeters(super, type, pl, i);
       else
          AvailableMetersPanel_addPlatformMeter(super, type, i);
    }
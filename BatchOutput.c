@@ -0,0 +1,210 @@
+/*
+htop - BatchOutput.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "BatchOutput.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DynamicColumn.h"
+#include "Process.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+/* Most samples reach the reader in one write */
+#define BATCH_BUFFER_SIZE (256 * 1024)
+
+BatchOutput* BatchOutput_new(FILE* file, BatchFormat format, const Settings* settings) {
+   BatchOutput* this = xCalloc(1, sizeof(BatchOutput));
+   this->file = file;
+   this->format = format;
+   this->settings = settings;
+   setvbuf(file, NULL, _IOFBF, BATCH_BUFFER_SIZE);
+   return this;
+}
+
+void BatchOutput_delete(BatchOutput* this) {
+   fflush(this->file);
+   free(this);
+}
+
+bool BatchOutput_parseFormat(const char* name, BatchFormat* format) {
+   if (String_eq(name, "tsv")) {
+      *format = BATCH_TSV;
+   } else if (String_eq(name, "json")) {
+      *format = BATCH_JSON;
+   } else {
+      return false;
+   }
+   return true;
+}
+
+static const char* BatchOutput_fieldName(const ProcessList* pl, ProcessField field) {
+   if (field >= LAST_PROCESSFIELD) {
+      const DynamicColumn* column = DynamicColumn_lookup(pl->dynamicColumns, field);
+      return column ? column->name : "-";
+   }
+   return Process_fields[field].name ? Process_fields[field].name : "-";
+}
+
+static void BatchOutput_putString(BatchOutput* this, const char* value) {
+   fputs(value, this->file);
+}
+
+/* Escapes separators and control characters; other bytes are copied as they
+ * are, in runs, as most strings have nothing to escape */
+static void BatchOutput_putEscaped(BatchOutput* this, const char* value) {
+   static const char tsvSpecial[] =
+      "\\\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"
+      "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f\x7f";
+   static const char jsonSpecial[] =
+      "\\\"\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"
+      "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f";
+   const char* special = this->format == BATCH_JSON ? jsonSpecial : tsvSpecial;
+
+   for (;;) {
+      size_t run = strcspn(value, special);
+      fwrite(value, 1, run, this->file);
+      value += run;
+      if (!*value)
+         return;
+
+      unsigned char c = (unsigned char) *value++;
+      switch (c) {
+         case '\\': fputs("\\\\", this->file); break;
+         case '"':  fputs("\\\"", this->file); break;
+         case '\t': fputs("\\t", this->file); break;
+         case '\n': fputs("\\n", this->file); break;
+         case '\r': fputs("\\r", this->file); break;
+         default:
+            fprintf(this->file, this->format == BATCH_JSON ? "\\u%04x" : "\\x%02x", c);
+            break;
+      }
+   }
+}
+
+/* Whole numbers, the most common by far, skip printf */
+static void BatchOutput_putNumber(BatchOutput* this, double value) {
+   if (isnan(value) || isinf(value)) {
+      if (this->format == BATCH_JSON)
+         fputs("null", this->file);
+      return;
+   }
+
+   if (floor(value) < value || fabs(value) >= 9007199254740992.0 /* 2^53 */) {
+      fprintf(this->file, "%.2f", value);
+      return;
+   }
+
+   char digits[24];
+   char* end = digits + sizeof(digits);
+   char* at = end;
+   bool negative = value < 0;
+   uint64_t n = (uint64_t) fabs(value);
+   do {
+      *--at = (char)('0' + n % 10);
+      n /= 10;
+   } while (n);
+   if (negative)
+      *--at = '-';
+   fwrite(at, 1, (size_t)(end - at), this->file);
+}
+
+static void BatchOutput_putValue(BatchOutput* this, const Process* p, ProcessField field) {
+   ProcessFieldValue value;
+   if (!Process_getFieldValue(p, field, &value)) {
+      if (this->format == BATCH_JSON)
+         fputs("null", this->file);
+      return;
+   }
+
+   if (!value.string) {
+      BatchOutput_putNumber(this, value.number);
+   } else if (this->format == BATCH_JSON) {
+      fputc('"', this->file);
+      BatchOutput_putEscaped(this, value.string);
+      fputc('"', this->file);
+   } else {
+      BatchOutput_putEscaped(this, value.string);
+   }
+}
+
+static void BatchOutput_writeTSV(BatchOutput* this, const ProcessList* pl) {
+   const ProcessField* fields = this->settings->fields;
+
+   if (!this->wroteNames) {
+      BatchOutput_putString(this, "TIMESTAMP");
+      for (int i = 0; fields[i]; i++) {
+         fputc('\t', this->file);
+         BatchOutput_putString(this, BatchOutput_fieldName(pl, fields[i]));
+      }
+      fputc('\n', this->file);
+      this->wroteNames = true;
+   }
+
+   for (int i = 0; i < Vector_size(pl->processes); i++) {
+      const Process* p = (const Process*) Vector_get(pl->processes, i);
+      if (!p->show || !ProcessList_matchesFilters(pl, p))
+         continue;
+
+      BatchOutput_putNumber(this, (double)pl->realtimeMs);
+      for (int j = 0; fields[j]; j++) {
+         fputc('\t', this->file);
+         BatchOutput_putValue(this, p, fields[j]);
+      }
+      fputc('\n', this->file);
+   }
+}
+
+static void BatchOutput_writeJSON(BatchOutput* this, const ProcessList* pl) {
+   const ProcessField* fields = this->settings->fields;
+
+   fputs("{\"timestamp\":", this->file);
+   BatchOutput_putNumber(this, (double)pl->realtimeMs);
+   fputs(",\"tasks\":", this->file);
+   BatchOutput_putNumber(this, pl->totalTasks);
+   fputs(",\"running\":", this->file);
+   BatchOutput_putNumber(this, pl->runningTasks);
+   fputs(",\"processes\":[", this->file);
+
+   bool first = true;
+   for (int i = 0; i < Vector_size(pl->processes); i++) {
+      const Process* p = (const Process*) Vector_get(pl->processes, i);
+      if (!p->show || !ProcessList_matchesFilters(pl, p))
+         continue;
+
+      fputs(first ? "{" : ",{", this->file);
+      first = false;
+      for (int j = 0; fields[j]; j++) {
+         fputs(j ? ",\"" : "\"", this->file);
+         BatchOutput_putEscaped(this, BatchOutput_fieldName(pl, fields[j]));
+         fputs("\":", this->file);
+         BatchOutput_putValue(this, p, fields[j]);
+      }
+      fputc('}', this->file);
+   }
+
+   fputs("]}\n", this->file);
+}
+
+bool BatchOutput_writeSample(BatchOutput* this, const ProcessList* pl) {
+   switch (this->format) {
+      case BATCH_TSV:
+         BatchOutput_writeTSV(this, pl);
+         break;
+      case BATCH_JSON:
+         BatchOutput_writeJSON(this, pl);
+         break;
+   }
+
+   return fflush(this->file) == 0 && !ferror(this->file);
+}
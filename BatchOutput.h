@@ -0,0 +1,40 @@
+#ifndef HEADER_BatchOutput
+#define HEADER_BatchOutput
+/*
+htop - BatchOutput.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "ProcessList.h"
+#include "Settings.h"
+
+
+typedef enum BatchFormat_ {
+   BATCH_TSV,                 /* a line of column names, then a line per process */
+   BATCH_JSON,                /* a JSON object per sample and line */
+} BatchFormat;
+
+typedef struct BatchOutput_ {
+   FILE* file;
+   BatchFormat format;
+   const Settings* settings;
+   bool wroteNames;
+} BatchOutput;
+
+BatchOutput* BatchOutput_new(FILE* file, BatchFormat format, const Settings* settings);
+
+void BatchOutput_delete(BatchOutput* this);
+
+/* false for an unknown name */
+bool BatchOutput_parseFormat(const char* name, BatchFormat* format);
+
+/* Writes the processes shown with the configured columns and filters, in
+ * the configured order, with their raw values; false on a write error */
+bool BatchOutput_writeSample(BatchOutput* this, const ProcessList* pl);
+
+#endif
@@ -213,6 +213,18 @@ static void AllCPUsMeter_updateValues(Meter* this) {
       Meter_updateValues(meters[i]);
 }
 
+Meter* const* CPUMeter_getSubMeters(const Meter* this, int* count) {
+   if (As_Meter(this)->updateValues != AllCPUsMeter_updateValues || !this->meterData) {
+      *count = 0;
+      return NULL;
+   }
+
+   const CPUMeterData* data = this->meterData;
+   int start;
+   AllCPUsMeter_getRange(this, &start, count);
+   return data->meters;
+}
+
 static void CPUMeterCommonInit(Meter* this, int ncol) {
    unsigned int cpus = this->pl->existingCPUs;
    CPUMeterData* data = this->meterData;
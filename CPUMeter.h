@@ -50,4 +50,7 @@ extern const MeterClass LeftCPUs8Meter_class;
 
 extern const MeterClass RightCPUs8Meter_class;
 
+/* The per-CPU meters drawn by one of the meters above, NULL for others */
+Meter* const* CPUMeter_getSubMeters(const Meter* this, int* count);
+
 #endif
@@ -942,6 +942,14 @@ void CRT_init(const Settings* settings, bool allowUnicode) {
    CRT_degreeSign = initDegreeSign();
 }
 
+void CRT_initHeadless(const Settings* settings) {
+   CRT_crashSettings = settings;
+   CRT_delay = &(settings->delay);
+   CRT_colorScheme = COLORSCHEME_MONOCHROME;
+   CRT_colors = CRT_colorSchemes[CRT_colorScheme];
+   CRT_degreeSign = initDegreeSign();
+}
+
 void CRT_done() {
    curs_set(1);
    endwin();
@@ -176,6 +176,10 @@ void CRT_init(const Settings* settings, bool allowUnicode);
 
 void CRT_done(void);
 
+/* Set up what shared code needs (colors for formatting) without curses,
+ * for the modes which do not draw on the terminal */
+void CRT_initHeadless(const Settings* settings);
+
 void CRT_resetSignalHandlers(void);
 
 int CRT_readKey(void);
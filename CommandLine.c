@@ -11,9 +11,12 @@ in the source distribution for its full text.
 #include "CommandLine.h"
 
 #include <assert.h>
+#include <errno.h>
 #include <getopt.h>
 #include <locale.h>
+#include <signal.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -21,12 +24,14 @@ in the source distribution for its full text.
 #include <unistd.h>
 
 #include "Action.h"
+#include "BatchOutput.h"
 #include "CRT.h"
 #include "DynamicColumn.h"
 #include "DynamicMeter.h"
 #include "Hashtable.h"
 #include "Header.h"
 #include "IncSet.h"
+#include "Macros.h"
 #include "MainPanel.h"
 #include "MetersPanel.h"
 #include "Panel.h"
@@ -34,6 +39,8 @@ in the source distribution for its full text.
 #include "Process.h"
 #include "ProcessList.h"
 #include "ProvideCurses.h"
+#include "Recorder.h"
+#include "Replay.h"
 #include "ScreenManager.h"
 #include "Settings.h"
 #include "UsersTable.h"
@@ -48,14 +55,20 @@ static void printHelpFlag(const char* name) {
    printf("%s " VERSION "\n"
           COPYRIGHT "\n"
           "Released under the GNU GPLv2.\n\n"
+          "   --batch                      Write samples to stdout without a user interface, like top -b\n"
           "-C --no-color                   Use a monochrome color scheme\n"
           "-d --delay=DELAY                Set the delay between updates, in tenths of seconds\n"
           "-F --filter=FILTER              Show only the commands matching the given filter\n"
           "-h --help                       Print this help screen\n"
           "-H --highlight-changes[=DELAY]  Highlight new and old processes\n"
+          "   --iterations=N               Stop after N samples in batch mode\n"
           "-M --no-mouse                   Disable the mouse\n"
+          "   --output=FORMAT              Write samples as tsv (the default) or json in batch mode\n"
           "-p --pid=PID[,PID,PID...]       Show only the given PIDs\n"
           "   --readonly                   Disable all system and process changing features\n"
+          "   --record=FILE                Record samples to FILE without a user interface, until interrupted\n"
+          "   --record-size=MIB            Rotate the recording to FILE.1 once it exceeds MIB mebibytes\n"
+          "   --replay=FILE                Browse a recording made with --record instead of the running system\n"
           "-s --sort-key=COLUMN            Sort by COLUMN in list view (try --sort-key=help for a list)\n"
           "-t --tree                       Show the tree view (can be combined with -s)\n"
           "-u --user[=USERNAME]            Show only processes for a given user (or $USER)\n"
@@ -83,6 +96,12 @@ typedef struct CommandLineSettings_ {
    bool highlightChanges;
    int highlightDelaySecs;
    bool readonly;
+   char* recordFile;
+   uint64_t recordMaxSize;
+   char* replayFile;
+   bool batch;
+   unsigned int iterations;   /* 0 for no limit */
+   BatchFormat batchFormat;
 } CommandLineSettings;
 
 static CommandLineSettings parseArguments(const char* program, int argc, char** argv) {
@@ -100,6 +119,12 @@ static CommandLineSettings parseArguments(const char* program, int argc, char**
       .highlightChanges = false,
       .highlightDelaySecs = -1,
       .readonly = false,
+      .recordFile = NULL,
+      .recordMaxSize = 0,
+      .replayFile = NULL,
+      .batch = false,
+      .iterations = 0,
+      .batchFormat = BATCH_TSV,
    };
 
    const struct option long_opts[] =
@@ -118,11 +143,19 @@ static CommandLineSettings parseArguments(const char* program, int argc, char**
       {"filter",     required_argument,   0, 'F'},
       {"highlight-changes", optional_argument, 0, 'H'},
       {"readonly",   no_argument,         0, 128},
+      {"record",     required_argument,   0, 129},
+      {"record-size", required_argument,  0, 130},
+      {"replay",     required_argument,   0, 131},
+      {"batch",      no_argument,         0, 132},
+      {"iterations", required_argument,   0, 133},
+      {"output",     required_argument,   0, 134},
       PLATFORM_LONG_OPTIONS
       {0, 0, 0, 0}
    };
 
    int opt, opti = 0;
+   const char* batchOption = NULL;   /* given, of those only meaningful with --batch */
+   const char* recordOption = NULL;  /* given, of those only meaningful with --record */
    /* Parse arguments */
    while ((opt = getopt_long(argc, argv, "hVMCs:td:u::Up:F:H::", long_opts, &opti))) {
       if (opt == EOF)
@@ -243,6 +276,45 @@ static CommandLineSettings parseArguments(const char* program, int argc, char**
          case 128:
             flags.readonly = true;
             break;
+         case 129:
+            assert(optarg);
+            free_and_xStrdup(&flags.recordFile, optarg);
+            break;
+         case 130: {
+            assert(optarg);
+            unsigned int mebibytes;
+            if (sscanf(optarg, "%10u", &mebibytes) == 1 && mebibytes > 0) {
+               flags.recordMaxSize = (uint64_t)mebibytes * ONE_M;
+            } else {
+               fprintf(stderr, "Error: invalid recording size \"%s\".\n", optarg);
+               exit(1);
+            }
+            recordOption = "--record-size";
+            break;
+         }
+         case 131:
+            assert(optarg);
+            free_and_xStrdup(&flags.replayFile, optarg);
+            break;
+         case 132:
+            flags.batch = true;
+            break;
+         case 133:
+            assert(optarg);
+            if (sscanf(optarg, "%10u", &flags.iterations) != 1 || flags.iterations == 0) {
+               fprintf(stderr, "Error: invalid number of iterations \"%s\".\n", optarg);
+               exit(1);
+            }
+            batchOption = "--iterations";
+            break;
+         case 134:
+            assert(optarg);
+            if (!BatchOutput_parseFormat(optarg, &flags.batchFormat)) {
+               fprintf(stderr, "Error: invalid output format \"%s\".\n", optarg);
+               exit(1);
+            }
+            batchOption = "--output";
+            break;
 
          default:
            if (Platform_getLongOption(opt, argc, argv) == false)
@@ -250,6 +322,27 @@ static CommandLineSettings parseArguments(const char* program, int argc, char**
            break;
       }
    }
+
+   if (flags.recordFile && flags.replayFile) {
+      fprintf(stderr, "Error: --record and --replay can not be combined.\n");
+      exit(1);
+   }
+
+   if (recordOption && !flags.recordFile) {
+      fprintf(stderr, "Error: %s requires --record.\n", recordOption);
+      exit(1);
+   }
+
+   if (batchOption && !flags.batch) {
+      fprintf(stderr, "Error: %s requires --batch.\n", batchOption);
+      exit(1);
+   }
+
+   if (flags.batch && (flags.recordFile || flags.replayFile)) {
+      fprintf(stderr, "Error: --batch can not be combined with --record or --replay.\n");
+      exit(1);
+   }
+
    return flags;
 }
 
@@ -263,12 +356,102 @@ static void CommandLine_delay(ProcessList* pl, unsigned long millisec) {
    Platform_gettime_realtime(&pl->realtime, &pl->realtimeMs);
 }
 
+static volatile sig_atomic_t CommandLine_stopRequested = 0;
+
+static void CommandLine_handleStopSignal(ATTR_UNUSED int sgn) {
+   CommandLine_stopRequested = 1;
+}
+
+static void CommandLine_catchStopSignals(void) {
+   struct sigaction act = { .sa_handler = CommandLine_handleStopSignal };
+   sigemptyset(&act.sa_mask);
+   sigaction(SIGINT, &act, NULL);
+   sigaction(SIGTERM, &act, NULL);
+}
+
+/* Waits for the update interval, or until a stop signal */
+static void CommandLine_sleepInterval(const Settings* settings, ProcessList* pl) {
+   struct timespec req = {
+      .tv_sec = settings->delay / 10,
+      .tv_nsec = (settings->delay % 10) * 100000000L
+   };
+   while (!CommandLine_stopRequested && nanosleep(&req, &req) == -1)
+      continue;
+   Platform_gettime_realtime(&pl->realtime, &pl->realtimeMs);
+}
+
+/* Scan at the update interval and append every sample to the recording,
+ * until SIGINT or SIGTERM; no terminal is needed */
+static int CommandLine_record(const CommandLineSettings* flags, Settings* settings, ProcessList* pl, Header* header) {
+   Recorder* recorder = Recorder_new(flags->recordFile, flags->recordMaxSize, settings, header);
+   if (!recorder) {
+      fprintf(stderr, "Error: can not write recording to %s: %s\n", flags->recordFile, strerror(errno));
+      return 1;
+   }
+
+   CommandLine_catchStopSignals();
+
+   /* nothing is in view without a panel, so collect everything */
+   settings->collectVisibleOnly = false;
+
+   ProcessList_scan(pl, false);
+   CommandLine_delay(pl, 75);
+
+   int result = 0;
+   while (!CommandLine_stopRequested) {
+      ProcessList_scan(pl, false);
+      Header_updateData(header);
+      if (!Recorder_writeSample(recorder, pl)) {
+         fprintf(stderr, "Error: can not write recording to %s: %s\n", flags->recordFile, strerror(errno));
+         result = 1;
+         break;
+      }
+
+      CommandLine_sleepInterval(settings, pl);
+   }
+
+   Recorder_delete(recorder);
+   return result;
+}
+
+/* Scan at the update interval and write every sample to stdout, until
+ * the number of iterations or a stop signal; no terminal is needed */
+static int CommandLine_batch(const CommandLineSettings* flags, Settings* settings, ProcessList* pl) {
+   BatchOutput* output = BatchOutput_new(stdout, flags->batchFormat, settings);
+
+   CommandLine_catchStopSignals();
+
+   settings->collectVisibleOnly = false;
+
+   ProcessList_scan(pl, false);
+   CommandLine_delay(pl, 75);
+
+   int result = 0;
+   unsigned int written = 0;
+   while (!CommandLine_stopRequested) {
+      ProcessList_scan(pl, false);
+      ProcessList_sort(pl);
+      if (!BatchOutput_writeSample(output, pl)) {
+         result = 1;
+         break;
+      }
+
+      if (flags->iterations && ++written >= flags->iterations)
+         break;
+
+      CommandLine_sleepInterval(settings, pl);
+   }
+
+   BatchOutput_delete(output);
+   return result;
+}
+
 static void setCommFilter(State* state, char** commFilter) {
    ProcessList* pl = state->pl;
    IncSet* inc = state->mainPanel->inc;
 
    IncSet_setFilter(inc, *commFilter);
-   pl->incFilter = IncSet_filter(inc);
+   ProcessList_setFilter(pl, IncSet_filter(inc));
 
    free(*commFilter);
    *commFilter = NULL;
@@ -285,9 +468,20 @@ int CommandLine_run(const char* name, int argc, char** argv) {
 
    CommandLineSettings flags = parseArguments(name, argc, argv);
 
-   if (flags.readonly)
+   /* the processes of a recording are not there to act on */
+   if (flags.readonly || flags.replayFile)
       Settings_enableReadonly();
 
+   Replay* replay = NULL;
+   if (flags.replayFile) {
+      const char* error;
+      replay = Replay_new(flags.replayFile, &error);
+      if (!replay) {
+         fprintf(stderr, "Error: can not replay %s: %s\n", flags.replayFile, error);
+         exit(1);
+      }
+   }
+
    Platform_init();
 
    Process_setupColumnWidths();
@@ -303,6 +497,11 @@ int CommandLine_run(const char* name, int argc, char** argv) {
    Settings* settings = Settings_new(pl->activeCPUs, dc);
    pl->settings = settings;
 
+   if (replay) {
+      Replay_attach(replay, pl);
+      Replay_applySettings(replay, settings);
+   }
+
    Header* header = Header_new(pl, settings, 2);
 
    Header_populateFromSettings(header);
@@ -330,12 +529,45 @@ int CommandLine_run(const char* name, int argc, char** argv) {
       Settings_setSortKey(settings, flags.sortKey);
    }
 
+   if (flags.recordFile || flags.batch) {
+      int result;
+      if (flags.recordFile) {
+         /* record the meters by the names the settings use for them */
+         Header_writeBackToSettings(header);
+         CRT_initHeadless(settings);
+
+         result = CommandLine_record(&flags, settings, pl, header);
+      } else {
+         CRT_initHeadless(settings);
+         if (flags.commFilter)
+            ProcessList_setFilter(pl, flags.commFilter);
+
+         result = CommandLine_batch(&flags, settings, pl);
+      }
+
+      Platform_done();
+      Header_delete(header);
+      ProcessList_delete(pl);
+      UsersTable_delete(ut);
+      if (flags.pidMatchList)
+         Hashtable_delete(flags.pidMatchList);
+      free(flags.recordFile);
+      free(flags.commFilter);
+      Settings_delete(settings);
+      Hashtable_delete(dc);
+      if (dm)
+         Hashtable_delete(dm);
+      return result;
+   }
+
    CRT_init(settings, flags.allowUnicode);
 
    MainPanel* panel = MainPanel_new();
    ProcessList_setPanel(pl, (Panel*) panel);
 
    MainPanel_updateTreeFunctions(panel, settings->treeView);
+   if (replay)
+      Replay_setBindings(panel->keys);
 
    State state = {
       .settings = settings,
@@ -372,7 +604,8 @@ int CommandLine_run(const char* name, int argc, char** argv) {
 
    CRT_done();
 
-   if (settings->changed) {
+   /* the header of a recording is not to become the configured one */
+   if (settings->changed && !replay) {
       int r = Settings_write(settings, false);
       if (r < 0)
          fprintf(stderr, "Can not save configuration to %s: %s\n", settings->filename, strerror(-r));
@@ -380,6 +613,9 @@ int CommandLine_run(const char* name, int argc, char** argv) {
 
    Header_delete(header);
    ProcessList_delete(pl);
+   if (replay)
+      Replay_delete(replay);
+   free(flags.replayFile);
 
    ScreenManager_delete(scr);
    MetersPanel_cleanup();
@@ -9,6 +9,7 @@ in the source distribution for its full text.
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "CRT.h"
 #include "Macros.h"
@@ -25,91 +26,181 @@ static const int DiskIOMeter_attributes[] = {
    METER_VALUE_IOWRITE,
 };
 
+/* Shared by all Disk IO meters, refreshed at most once per scan */
 static bool hasData = false;
-static uint32_t cached_read_diff;
-static uint32_t cached_write_diff;
-static double cached_utilisation_diff;
+static uint64_t cached_last_update;
+static DiskIODevice cached_total;
+static DiskIODevices cached_devices;
+
+DiskIODevice* DiskIODevices_get(DiskIODevices* this, const char* name) {
+   /* devices are usually listed in the same order on every scan */
+   for (size_t n = 0; n < this->count; n++) {
+      size_t i = (this->cursor + n) % this->count;
+      if (String_eq(this->devices[i].name, name)) {
+         this->cursor = i + 1;
+         return &this->devices[i];
+      }
+   }
 
-static void DiskIOMeter_updateValues(Meter* this) {
-   const ProcessList* pl = this->pl;
+   if (this->count == this->allocd) {
+      this->allocd = this->allocd ? this->allocd * 2 : 16;
+      this->devices = xReallocArray(this->devices, this->allocd, sizeof(DiskIODevice));
+   }
 
-   static uint64_t cached_last_update;
-   uint64_t passedTimeInMs = pl->realtimeMs - cached_last_update;
+   DiskIODevice* device = &this->devices[this->count++];
+   memset(device, 0, sizeof(DiskIODevice));
+   String_safeStrncpy(device->name, name, sizeof(device->name));
+   this->cursor = this->count;
+   return device;
+}
 
-   /* update only every 500ms */
-   if (passedTimeInMs > 500) {
-      static uint64_t cached_read_total;
-      static uint64_t cached_write_total;
-      static uint64_t cached_msTimeSpend_total;
-      uint64_t diff;
+static uint64_t DiskIOMeter_delta(uint64_t current, uint64_t previous) {
+   return current > previous ? current - previous : 0;
+}
 
-      cached_last_update = pl->realtimeMs;
+static void DiskIODevice_updateRates(DiskIODevice* this, uint64_t passedTimeInMs) {
+   if (this->hasPrevious && passedTimeInMs > 0) {
+      const DiskIOData* cur = &this->data;
+      const DiskIOData* prev = &this->previous;
+
+      /* Meter_humanUnit() expects unit in kilo */
+      this->readRate = DiskIOMeter_delta(cur->totalBytesRead, prev->totalBytesRead) / ONE_K * 1000 / passedTimeInMs;
+      this->writeRate = DiskIOMeter_delta(cur->totalBytesWritten, prev->totalBytesWritten) / ONE_K * 1000 / passedTimeInMs;
+      this->readOps = 1000.0 * DiskIOMeter_delta(cur->numReads, prev->numReads) / passedTimeInMs;
+      this->writeOps = 1000.0 * DiskIOMeter_delta(cur->numWrites, prev->numWrites) / passedTimeInMs;
+      this->utilisation = 100.0 * DiskIOMeter_delta(cur->totalMsTimeSpend, prev->totalMsTimeSpend) / passedTimeInMs;
+   } else {
+      this->readRate = 0;
+      this->writeRate = 0;
+      this->readOps = 0.0;
+      this->writeOps = 0.0;
+      this->utilisation = 0.0;
+   }
 
-      DiskIOData data;
+   this->previous = this->data;
+   this->hasPrevious = true;
+}
 
-      hasData = Platform_getDiskIO(&data);
-      if (!hasData) {
-         this->values[0] = 0;
-         xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "no data");
-         return;
-      }
+static void DiskIOMeter_updateStats(const ProcessList* pl) {
+   if (cached_last_update == pl->realtimeMs)
+      return;
 
-      if (data.totalBytesRead > cached_read_total) {
-         diff = data.totalBytesRead - cached_read_total;
-         diff /= 1024; /* Meter_humanUnit() expects unit in kilo */
-         cached_read_diff = (uint32_t)diff;
-      } else {
-         cached_read_diff = 0;
-      }
-      cached_read_total = data.totalBytesRead;
+   uint64_t passedTimeInMs = pl->realtimeMs - cached_last_update;
+   cached_last_update = pl->realtimeMs;
 
-      if (data.totalBytesWritten > cached_write_total) {
-         diff = data.totalBytesWritten - cached_write_total;
-         diff /= 1024; /* Meter_humanUnit() expects unit in kilo */
-         cached_write_diff = (uint32_t)diff;
-      } else {
-         cached_write_diff = 0;
-      }
-      cached_write_total = data.totalBytesWritten;
+   for (size_t i = 0; i < cached_devices.count; i++)
+      cached_devices.devices[i].present = false;
 
-      if (data.totalMsTimeSpend > cached_msTimeSpend_total) {
-         diff = data.totalMsTimeSpend - cached_msTimeSpend_total;
-         cached_utilisation_diff = 100.0 * (double)diff / passedTimeInMs;
+   memset(&cached_total.data, 0, sizeof(cached_total.data));
+   hasData = Platform_getDiskIO(&cached_total.data, &cached_devices);
+   if (!hasData)
+      return;
+
+   DiskIODevice_updateRates(&cached_total, passedTimeInMs);
+   for (size_t i = 0; i < cached_devices.count; i++) {
+      DiskIODevice* device = &cached_devices.devices[i];
+      if (device->present) {
+         DiskIODevice_updateRates(device, passedTimeInMs);
       } else {
-         cached_utilisation_diff = 0.0;
+         device->hasPrevious = false;
       }
-      cached_msTimeSpend_total = data.totalMsTimeSpend;
+   }
+}
+
+size_t DiskIOMeter_deviceCount(const ProcessList* pl) {
+   DiskIOMeter_updateStats(pl);
+   return cached_devices.count;
+}
+
+const char* DiskIOMeter_deviceName(unsigned int param) {
+   if (param == 0 || param > cached_devices.count)
+      return NULL;
+
+   return cached_devices.devices[param - 1].name;
+}
+
+unsigned int DiskIOMeter_deviceParam(const char* name) {
+   return (unsigned int)(DiskIODevices_get(&cached_devices, name) - cached_devices.devices) + 1;
+}
+
+/* The device shown by a meter, NULL if there is no data for it */
+static const DiskIODevice* DiskIOMeter_device(const Meter* this) {
+   if (!hasData)
+      return NULL;
+
+   if (this->param == 0)
+      return &cached_total;
+
+   if (this->param > cached_devices.count)
+      return NULL;
+
+   const DiskIODevice* device = &cached_devices.devices[this->param - 1];
+   return device->present ? device : NULL;
+}
+
+static void DiskIOMeter_init(Meter* this) {
+   const char* name = DiskIOMeter_deviceName(this->param);
+   if (name) {
+      char caption[40];
+      xSnprintf(caption, sizeof(caption), "%s: ", name);
+      Meter_setCaption(this, caption);
+   }
+}
+
+static void DiskIOMeter_getUiName(const Meter* this, char* buffer, size_t length) {
+   const char* name = DiskIOMeter_deviceName(this->param);
+   if (name)
+      xSnprintf(buffer, length, "%s %s", Meter_uiName(this), name);
+   else
+      xSnprintf(buffer, length, "%s", Meter_uiName(this));
+}
+
+static void DiskIOMeter_updateValues(Meter* this) {
+   DiskIOMeter_updateStats(this->pl);
+
+   const DiskIODevice* device = DiskIOMeter_device(this);
+   if (!device) {
+      this->values[0] = 0;
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "no data");
+      return;
    }
 
-   this->values[0] = cached_utilisation_diff;
+   this->values[0] = device->utilisation;
    this->total = MAXIMUM(this->values[0], 100.0); /* fix total after (initial) spike */
 
    char bufferRead[12], bufferWrite[12];
-   Meter_humanUnit(bufferRead, cached_read_diff, sizeof(bufferRead));
-   Meter_humanUnit(bufferWrite, cached_write_diff, sizeof(bufferWrite));
-   snprintf(this->txtBuffer, sizeof(this->txtBuffer), "%sB %sB %.1f%%", bufferRead, bufferWrite, cached_utilisation_diff);
+   Meter_humanUnit(bufferRead, device->readRate, sizeof(bufferRead));
+   Meter_humanUnit(bufferWrite, device->writeRate, sizeof(bufferWrite));
+   snprintf(this->txtBuffer, sizeof(this->txtBuffer), "%siB/s %siB/s %.0f/%.0f IOPS %.1f%%",
+            bufferRead, bufferWrite, device->readOps, device->writeOps, device->utilisation);
 }
 
-static void DiskIOMeter_display(ATTR_UNUSED const Object* cast, RichString* out) {
-   if (!hasData) {
+static void DiskIOMeter_display(const Object* cast, RichString* out) {
+   const DiskIODevice* device = DiskIOMeter_device((const Meter*)cast);
+   if (!device) {
       RichString_writeAscii(out, CRT_colors[METER_VALUE_ERROR], "no data");
       return;
    }
 
-   char buffer[16];
+   char buffer[32];
    int len;
 
-   int color = cached_utilisation_diff > 40.0 ? METER_VALUE_NOTICE : METER_VALUE;
-   len = xSnprintf(buffer, sizeof(buffer), "%.1f%%", cached_utilisation_diff);
+   int color = device->utilisation > 40.0 ? METER_VALUE_NOTICE : METER_VALUE;
+   len = xSnprintf(buffer, sizeof(buffer), "%.1f%%", device->utilisation);
    RichString_appendnAscii(out, CRT_colors[color], buffer, len);
 
    RichString_appendAscii(out, CRT_colors[METER_TEXT], " read: ");
-   Meter_humanUnit(buffer, cached_read_diff, sizeof(buffer));
+   Meter_humanUnit(buffer, device->readRate, sizeof(buffer));
    RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], buffer);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], "iB/s");
 
    RichString_appendAscii(out, CRT_colors[METER_TEXT], " write: ");
-   Meter_humanUnit(buffer, cached_write_diff, sizeof(buffer));
+   Meter_humanUnit(buffer, device->writeRate, sizeof(buffer));
    RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], buffer);
+   RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], "iB/s");
+
+   len = xSnprintf(buffer, sizeof(buffer), " (%.0f/%.0f IOPS)", device->readOps, device->writeOps);
+   RichString_appendnAscii(out, CRT_colors[METER_TEXT], buffer, len);
 }
 
 const MeterClass DiskIOMeter_class = {
@@ -125,5 +216,7 @@ const MeterClass DiskIOMeter_class = {
    .attributes = DiskIOMeter_attributes,
    .name = "DiskIO",
    .uiName = "Disk IO",
-   .caption = "Disk IO: "
+   .caption = "Disk IO: ",
+   .init = DiskIOMeter_init,
+   .getUiName = DiskIOMeter_getUiName
 };
@@ -7,15 +7,57 @@ Released under the GNU GPLv2, see the COPYING file
 in the source distribution for its full text.
 */
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #include "Meter.h"
+#include "ProcessList.h"
 
 
 typedef struct DiskIOData_ {
    uint64_t totalBytesRead;
    uint64_t totalBytesWritten;
    uint64_t totalMsTimeSpend;
+   uint64_t numReads;
+   uint64_t numWrites;
 } DiskIOData;
 
+typedef struct DiskIODevice_ {
+   char name[32];
+   bool present;           /* listed by the last Platform_getDiskIO() */
+   DiskIOData data;        /* counters, filled in by the platform */
+
+   /* derived by DiskIOMeter on every refresh */
+   bool hasPrevious;
+   DiskIOData previous;
+   uint64_t readRate;      /* KiB/s */
+   uint64_t writeRate;     /* KiB/s */
+   double readOps;         /* per second */
+   double writeOps;        /* per second */
+   double utilisation;     /* percent */
+} DiskIODevice;
+
+/* Devices are only ever appended, so their index stays valid as meter param */
+typedef struct DiskIODevices_ {
+   DiskIODevice* devices;
+   size_t count;
+   size_t allocd;
+   size_t cursor;          /* where the next lookup starts */
+} DiskIODevices;
+
+/* Find a device by name, adding it if unknown; for use by Platform_getDiskIO() */
+DiskIODevice* DiskIODevices_get(DiskIODevices* this, const char* name);
+
+/* Number of devices known to the shared statistics, refreshing them if due */
+size_t DiskIOMeter_deviceCount(const ProcessList* pl);
+
+/* Device shown by a meter with the given param (1-based), NULL for the total */
+const char* DiskIOMeter_deviceName(unsigned int param);
+
+/* Param of the meter for the named device */
+unsigned int DiskIOMeter_deviceParam(const char* name);
+
 extern const MeterClass DiskIOMeter_class;
 
 #endif /* HEADER_DiskIOMeter */
@@ -17,8 +17,10 @@ in the source distribution for its full text.
 
 #include "CRT.h"
 #include "CPUMeter.h"
+#include "DiskIOMeter.h"
 #include "DynamicMeter.h"
 #include "Macros.h"
+#include "NetworkIOMeter.h"
 #include "Object.h"
 #include "Platform.h"
 #include "ProvideCurses.h"
@@ -87,11 +89,15 @@ static void Header_addMeterByName(Header* this, const char* name, MeterModeId mo
       int ok = sscanf(paren, "(%10u)", &param); // CPUMeter
       if (!ok) {
          char* end, dynamic[32] = {0};
-         if (sscanf(paren, "(%30s)", dynamic)) { // DynamicMeter
+         if (sscanf(paren, "(%30s)", dynamic)) { // DynamicMeter, or device of an IO meter
             if ((end = strrchr(dynamic, ')')) == NULL)
                return;    // htoprc parse failure
             *end = '\0';
-            if (!DynamicMeter_search(this->pl->dynamicMeters, dynamic, &param))
+            if (String_startsWith(name, "DiskIO("))
+               param = DiskIOMeter_deviceParam(dynamic);
+            else if (String_startsWith(name, "NetworkIO("))
+               param = NetworkIOMeter_interfaceParam(dynamic);
+            else if (!DynamicMeter_search(this->pl->dynamicMeters, dynamic, &param))
                return;    // name lookup failure
          } else {
             param = 0;
@@ -156,6 +162,10 @@ void Header_writeBackToSettings(const Header* this) {
             xAsprintf(&name, "%s(%s)", As_Meter(meter)->name, dynamic);
          } else if (meter->param && As_Meter(meter) == &CPUMeter_class) {
             xAsprintf(&name, "%s(%u)", As_Meter(meter)->name, meter->param);
+         } else if (meter->param && As_Meter(meter) == &DiskIOMeter_class) {
+            xAsprintf(&name, "%s(%s)", As_Meter(meter)->name, DiskIOMeter_deviceName(meter->param));
+         } else if (meter->param && As_Meter(meter) == &NetworkIOMeter_class) {
+            xAsprintf(&name, "%s(%s)", As_Meter(meter)->name, NetworkIOMeter_interfaceName(meter->param));
          } else {
             xAsprintf(&name, "%s", As_Meter(meter)->name);
          }
@@ -23,6 +23,7 @@ in the source distribution for its full text.
 static void IncMode_reset(IncMode* mode) {
    mode->index = 0;
    mode->buffer[0] = 0;
+   StringMatcher_compile(&mode->matcher, NULL);
 }
 
 void IncSet_reset(IncSet* this, IncType type) {
@@ -33,6 +34,7 @@ void IncSet_setFilter(IncSet* this, const char* filter) {
    IncMode* mode = &this->modes[INC_FILTER];
    size_t len = String_safeStrncpy(mode->buffer, filter, sizeof(mode->buffer));
    mode->index = len;
+   StringMatcher_compile(&mode->matcher, mode->buffer);
    this->filtering = true;
 }
 
@@ -42,6 +44,7 @@ static const int searchEvents[] = {KEY_F(3), KEY_F(15), 27, ERR};
 
 static inline void IncMode_initSearch(IncMode* search) {
    memset(search, 0, sizeof(IncMode));
+   StringMatcher_init(&search->matcher);
    search->bar = FunctionBar_new(searchFunctions, searchKeys, searchEvents);
    search->isFilter = false;
 }
@@ -52,12 +55,14 @@ static const int filterEvents[] = {13, 27, ERR};
 
 static inline void IncMode_initFilter(IncMode* filter) {
    memset(filter, 0, sizeof(IncMode));
+   StringMatcher_init(&filter->matcher);
    filter->bar = FunctionBar_new(filterFunctions, filterKeys, filterEvents);
    filter->isFilter = true;
 }
 
 static inline void IncMode_done(IncMode* mode) {
    FunctionBar_delete(mode->bar);
+   StringMatcher_done(&mode->matcher);
 }
 
 IncSet* IncSet_new(FunctionBar* bar) {
@@ -82,10 +87,10 @@ static void updateWeakPanel(const IncSet* this, Panel* panel, Vector* lines) {
    Panel_prune(panel);
    if (this->filtering) {
       int n = 0;
-      const char* incFilter = this->modes[INC_FILTER].buffer;
+      const StringMatcher* matcher = &this->modes[INC_FILTER].matcher;
       for (int i = 0; i < Vector_size(lines); i++) {
          ListItem* line = (ListItem*)Vector_get(lines, i);
-         if (String_contains_i(line->value, incFilter)) {
+         if (StringMatcher_matches(matcher, line->value)) {
             Panel_add(panel, (Object*)line);
             if (selected == (Object*)line) {
                Panel_setSelected(panel, n);
@@ -108,7 +113,7 @@ static void updateWeakPanel(const IncSet* this, Panel* panel, Vector* lines) {
 static bool search(const IncMode* mode, Panel* panel, IncMode_GetPanelValue getPanelValue) {
    int size = Panel_size(panel);
    for (int i = 0; i < size; i++) {
-      if (String_contains_i(getPanelValue(panel, i), mode->buffer)) {
+      if (StringMatcher_matches(&mode->matcher, getPanelValue(panel, i))) {
          Panel_setSelected(panel, i);
          return true;
       }
@@ -133,7 +138,7 @@ static bool IncMode_find(const IncMode* mode, Panel* panel, IncMode_GetPanelValu
          return false;
       }
 
-      if (String_contains_i(getPanelValue(panel, i), mode->buffer)) {
+      if (StringMatcher_matches(&mode->matcher, getPanelValue(panel, i))) {
          Panel_setSelected(panel, i);
          return true;
       }
@@ -159,6 +164,7 @@ bool IncSet_handleKey(IncSet* this, int ch, Panel* panel, IncMode_GetPanelValue
          mode->buffer[mode->index] = ch;
          mode->index++;
          mode->buffer[mode->index] = 0;
+         StringMatcher_compile(&mode->matcher, mode->buffer);
          if (mode->isFilter) {
             filterChanged = true;
             if (mode->index == 1) {
@@ -170,6 +176,7 @@ bool IncSet_handleKey(IncSet* this, int ch, Panel* panel, IncMode_GetPanelValue
       if (mode->index > 0) {
          mode->index--;
          mode->buffer[mode->index] = 0;
+         StringMatcher_compile(&mode->matcher, mode->buffer);
          if (mode->isFilter) {
             filterChanged = true;
             if (mode->index == 0) {
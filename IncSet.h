@@ -12,10 +12,11 @@ in the source distribution for its full text.
 
 #include "FunctionBar.h"
 #include "Panel.h"
+#include "StringMatcher.h"
 #include "Vector.h"
 
 
-#define INCMODE_MAX 40
+#define INCMODE_MAX 128
 
 typedef enum {
    INC_SEARCH = 0,
@@ -25,6 +26,7 @@ typedef enum {
 typedef struct IncMode_ {
    char buffer[INCMODE_MAX + 1];
    int index;
+   StringMatcher matcher;  /* compiled from buffer */
    FunctionBar* bar;
    bool isFilter;
 } IncMode;
@@ -41,6 +43,10 @@ static inline const char* IncSet_filter(const IncSet* this) {
    return this->filtering ? this->modes[INC_FILTER].buffer : NULL;
 }
 
+static inline const StringMatcher* IncSet_matcher(const IncSet* this) {
+   return this->filtering ? &this->modes[INC_FILTER].matcher : NULL;
+}
+
 void IncSet_setFilter(IncSet* this, const char* filter);
 
 typedef const char* (*IncMode_GetPanelValue)(Panel*, int);
@@ -11,6 +11,7 @@
 #include "ListItem.h"
 #include "Object.h"
 #include "ProvideCurses.h"
+#include "StringMatcher.h"
 #include "XUtils.h"
 
 
@@ -62,8 +63,8 @@ void InfoScreen_drawTitled(InfoScreen* this, const char* fmt, ...) {
 
 void InfoScreen_addLine(InfoScreen* this, const char* line) {
    Vector_add(this->lines, (Object*) ListItem_new(line, 0));
-   const char* incFilter = IncSet_filter(this->inc);
-   if (!incFilter || String_contains_i(line, incFilter)) {
+   const StringMatcher* incFilter = IncSet_matcher(this->inc);
+   if (!incFilter || StringMatcher_matches(incFilter, line)) {
       Panel_add(this->display, Vector_get(this->lines, Vector_size(this->lines) - 1));
    }
 }
@@ -71,8 +72,8 @@ void InfoScreen_addLine(InfoScreen* this, const char* line) {
 void InfoScreen_appendLine(InfoScreen* this, const char* line) {
    ListItem* last = (ListItem*)Vector_get(this->lines, Vector_size(this->lines) - 1);
    ListItem_append(last, line);
-   const char* incFilter = IncSet_filter(this->inc);
-   if (incFilter && Panel_get(this->display, Panel_size(this->display) - 1) != (Object*)last && String_contains_i(line, incFilter)) {
+   const StringMatcher* incFilter = IncSet_matcher(this->inc);
+   if (incFilter && Panel_get(this->display, Panel_size(this->display) - 1) != (Object*)last && StringMatcher_matches(incFilter, line)) {
       Panel_add(this->display, (Object*)last);
    }
 }
@@ -15,8 +15,10 @@ in the source distribution for its full text.
 #include "FunctionBar.h"
 #include "Platform.h"
 #include "Process.h"
+#include "ProcessGroup.h"
 #include "ProcessList.h"
 #include "ProvideCurses.h"
+#include "Replay.h"
 #include "Settings.h"
 #include "XUtils.h"
 
@@ -85,7 +87,7 @@ static HandlerResult MainPanel_eventHandler(Panel* super, int ch) {
    } else if (ch != ERR && this->inc->active) {
       bool filterChanged = IncSet_handleKey(this->inc, ch, super, MainPanel_getValue, NULL);
       if (filterChanged) {
-         this->state->pl->incFilter = IncSet_filter(this->inc);
+         ProcessList_setFilter(this->state->pl, IncSet_filter(this->inc));
          reaction = HTOP_REFRESH | HTOP_REDRAW_BAR;
       }
       if (this->inc->found) {
@@ -145,20 +147,46 @@ int MainPanel_selectedPid(MainPanel* this) {
    return -1;
 }
 
+Process* MainPanel_getSelectedProcess(MainPanel* this) {
+   Object* selected = Panel_getSelected((Panel*)this);
+   return ProcessGroup_isGroup(selected) ? NULL : (Process*) selected;
+}
+
+/* Apply to the members of a group; to the tagged ones only if anyTagged is given */
+static bool MainPanel_foreachMember(const ProcessGroup* group, MainPanel_ForeachProcessFn fn, Arg arg, bool* anyTagged) {
+   bool ok = true;
+   for (int i = 0; i < Vector_size(group->members); i++) {
+      Process* p = (Process*) Vector_get(group->members, i);
+      if (!anyTagged) {
+         ok = fn(p, arg) && ok;
+      } else if (p->tag) {
+         ok = fn(p, arg) && ok;
+         *anyTagged = true;
+      }
+   }
+   return ok;
+}
+
 bool MainPanel_foreachProcess(MainPanel* this, MainPanel_ForeachProcessFn fn, Arg arg, bool* wasAnyTagged) {
    Panel* super = (Panel*) this;
    bool ok = true;
    bool anyTagged = false;
    for (int i = 0; i < Panel_size(super); i++) {
       Process* p = (Process*) Panel_get(super, i);
-      if (p->tag) {
+      if (ProcessGroup_isGroup((Object*)p)) {
+         /* members of expanded groups are rows of their own */
+         if (!p->showChildren)
+            ok = MainPanel_foreachMember((const ProcessGroup*)p, fn, arg, &anyTagged) && ok;
+      } else if (p->tag) {
          ok = fn(p, arg) && ok;
          anyTagged = true;
       }
    }
    if (!anyTagged) {
       Process* p = (Process*) Panel_getSelected(super);
-      if (p) {
+      if (ProcessGroup_isGroup((Object*)p)) {
+         ok &= MainPanel_foreachMember((const ProcessGroup*)p, fn, arg, NULL);
+      } else if (p) {
          ok &= fn(p, arg);
       }
    }
@@ -180,6 +208,11 @@ static void MainPanel_drawFunctionBar(Panel* super, bool hideFunctionBar) {
    if (this->state->pauseProcessUpdate) {
       FunctionBar_append("PAUSED", CRT_colors[PAUSED]);
    }
+   if (this->state->pl->replay) {
+      char status[64];
+      Replay_formatStatus(this->state->pl->replay, status, sizeof(status));
+      FunctionBar_append(status, CRT_colors[PAUSED]);
+   }
 }
 
 static void MainPanel_printHeader(Panel* super) {
@@ -36,6 +36,9 @@ void MainPanel_updateTreeFunctions(MainPanel* this, bool mode);
 
 int MainPanel_selectedPid(MainPanel* this);
 
+/* The selected process; NULL if a group row is selected, as it stands for several */
+Process* MainPanel_getSelectedProcess(MainPanel* this);
+
 bool MainPanel_foreachProcess(MainPanel* this, MainPanel_ForeachProcessFn fn, Arg arg, bool* wasAnyTagged);
 
 extern const PanelClass MainPanel_class;
@@ -32,6 +32,15 @@ const MeterClass Meter_class = {
    }
 };
 
+static void GraphData_delete(GraphData* this) {
+   if (!this)
+      return;
+
+   free(this->values);
+   free(this->glyphs);
+   free(this);
+}
+
 Meter* Meter_new(const struct ProcessList_* pl, unsigned int param, const MeterClass* type) {
    Meter* this = xCalloc(1, sizeof(Meter));
    Object_setClass(this, type);
@@ -86,7 +95,7 @@ void Meter_delete(Object* cast) {
    if (Meter_doneFn(this)) {
       Meter_done(this);
    }
-   free(this->drawData);
+   GraphData_delete(this->drawData);
    free(this->caption);
    free(this->values);
    free(this);
@@ -97,7 +106,9 @@ void Meter_setCaption(Meter* this, const char* caption) {
 }
 
 static inline void Meter_displayBuffer(const Meter* this, RichString* out) {
-   if (Object_displayFn(this)) {
+   /* a replay restores the values and text of meters, but not the state
+      their display functions may draw from */
+   if (Object_displayFn(this) && !this->pl->replay) {
       Object_display(this, out);
    } else {
       RichString_writeWide(out, CRT_colors[Meter_attributes(this)[0]], this->txtBuffer);
@@ -121,7 +132,7 @@ void Meter_setMode(Meter* this, int modeIndex) {
       }
    } else {
       assert(modeIndex >= 1);
-      free(this->drawData);
+      GraphData_delete(this->drawData);
       this->drawData = NULL;
 
       const MeterMode* mode = Meter_modes[modeIndex];
@@ -286,14 +297,47 @@ static const char* const GraphMeterMode_dotsAscii[] = {
    /*20*/":", /*21*/":", /*22*/":"
 };
 
+static GraphData* GraphData_new(unsigned int nValues) {
+   GraphData* this = xCalloc(1, sizeof(GraphData));
+   this->nValues = nValues;
+   this->values = xCalloc(nValues, sizeof(double));
+   this->glyphs = xCalloc(nValues / 2, GRAPH_HEIGHT);
+   return this;
+}
+
+static int GraphMeterMode_pixels(double value, double total, int pix) {
+   return CLAMP((int) lround(value / total * pix), 1, pix);
+}
+
+/* Compute the glyphs of column c; a sample not taken yet is drawn empty,
+ * a column before the first sample as the zero line. */
+static void GraphMeterMode_computeColumn(GraphData* data, unsigned long long c, int pixPerRow) {
+   const int pix = pixPerRow * GRAPH_HEIGHT;
+   const unsigned long long n = 2 * c;
+   int v1 = GraphMeterMode_pixels(data->values[n % data->nValues], data->glyphTotal, pix);
+   int v2 = n + 1 < data->count ? GraphMeterMode_pixels(data->values[(n + 1) % data->nValues], data->glyphTotal, pix) : 0;
+
+   uint8_t* glyphs = data->glyphs + (c % (data->nValues / 2)) * GRAPH_HEIGHT;
+   for (int line = 0; line < GRAPH_HEIGHT; line++) {
+      int line1 = CLAMP(v1 - (pixPerRow * (GRAPH_HEIGHT - 1 - line)), 0, pixPerRow);
+      int line2 = CLAMP(v2 - (pixPerRow * (GRAPH_HEIGHT - 1 - line)), 0, pixPerRow);
+      glyphs[line] = line1 * (pixPerRow + 1) + line2;
+   }
+}
+
 static void GraphMeterMode_draw(Meter* this, int x, int y, int w) {
    const ProcessList* pl = this->pl;
 
+   const unsigned int nValues = (pl->settings->graphHistory + 1) & ~1U;
+   if (this->drawData && this->drawData->nValues != nValues) {
+      GraphData_delete(this->drawData);
+      this->drawData = NULL;
+   }
    if (!this->drawData) {
-      this->drawData = xCalloc(1, sizeof(GraphData));
+      this->drawData = GraphData_new(nValues);
    }
    GraphData* data = this->drawData;
-   const int nValues = METER_GRAPHDATA_SIZE;
+   const unsigned int nColumns = nValues / 2;
 
    const char* const* GraphMeterMode_dots;
    int GraphMeterMode_pixPerRow;
@@ -315,39 +359,56 @@ static void GraphMeterMode_draw(Meter* this, int x, int y, int w) {
    x += captionLen;
    w -= captionLen;
 
+   if (this->total < 1)
+      this->total = 1;
+
+   /* A changed scale invalidates every cached column */
+   const bool rescale = islessgreater(data->glyphTotal, this->total) || data->glyphPixPerRow != GraphMeterMode_pixPerRow;
+   data->glyphTotal = this->total;
+   data->glyphPixPerRow = GraphMeterMode_pixPerRow;
+
    if (!timercmp(&pl->realtime, &(data->time), <)) {
       int globalDelay = this->pl->settings->delay;
       struct timeval delay = { .tv_sec = globalDelay / 10, .tv_usec = (globalDelay % 10) * 100000L };
       timeradd(&pl->realtime, &delay, &(data->time));
 
-      for (int i = 0; i < nValues - 1; i++)
-         data->values[i] = data->values[i + 1];
-
       double value = 0.0;
       for (uint8_t i = 0; i < this->curItems; i++)
          value += this->values[i];
-      data->values[nValues - 1] = value;
+      data->values[data->count % nValues] = value;
+      data->count++;
+
+      if (!rescale)
+         GraphMeterMode_computeColumn(data, (data->count - 1) / 2, GraphMeterMode_pixPerRow);
+   }
+
+   if (data->count == 0) {
+      attrset(CRT_colors[RESET_COLOR]);
+      return;
    }
 
-   int i = nValues - (w * 2) + 2, k = 0;
-   if (i < 0) {
-      k = -i / 2;
-      i = 0;
+   const unsigned long long newest = (data->count - 1) / 2;
+   const unsigned long long stored = MINIMUM(newest + 1, nColumns);
+
+   if (rescale) {
+      for (unsigned long long c = newest + 1 - stored; c <= newest; c++)
+         GraphMeterMode_computeColumn(data, c, GraphMeterMode_pixPerRow);
    }
-   for (; i < nValues - 1; i += 2, k++) {
-      int pix = GraphMeterMode_pixPerRow * GRAPH_HEIGHT;
-      if (this->total < 1)
-         this->total = 1;
-      int v1 = CLAMP((int) lround(data->values[i] / this->total * pix), 1, pix);
-      int v2 = CLAMP((int) lround(data->values[i + 1] / this->total * pix), 1, pix);
+
+   /* The newest column is drawn at x + w - 2, older ones to its left; columns
+    * from before the first sample show the zero line like an idle meter. */
+   const int zeroLine = 1 * (GraphMeterMode_pixPerRow + 1) + 1;
+   const int shown = MINIMUM(w - 1, (int) nColumns);
+   for (int k = w - 1 - shown; k < w - 1; k++) {
+      const unsigned long long age = (unsigned long long) (w - 2 - k);
+      const uint8_t* glyphs = age <= newest ? data->glyphs + ((newest - age) % nColumns) * GRAPH_HEIGHT : NULL;
 
       int colorIdx = GRAPH_1;
       for (int line = 0; line < GRAPH_HEIGHT; line++) {
-         int line1 = CLAMP(v1 - (GraphMeterMode_pixPerRow * (GRAPH_HEIGHT - 1 - line)), 0, GraphMeterMode_pixPerRow);
-         int line2 = CLAMP(v2 - (GraphMeterMode_pixPerRow * (GRAPH_HEIGHT - 1 - line)), 0, GraphMeterMode_pixPerRow);
+         int glyph = glyphs ? glyphs[line] : (line == GRAPH_HEIGHT - 1 ? zeroLine : 0);
 
          attrset(CRT_colors[colorIdx]);
-         mvaddstr(y + line, x + k, GraphMeterMode_dots[line1 * (GraphMeterMode_pixPerRow + 1) + line2]);
+         mvaddstr(y + line, x + k, GraphMeterMode_dots[glyph]);
          colorIdx = GRAPH_2;
       }
    }
@@ -20,7 +20,6 @@ in the source distribution for its full text.
 
 
 #define METER_TXTBUFFER_LEN 256
-#define METER_GRAPHDATA_SIZE 256
 
 #define METER_BUFFER_CHECK(buffer, size, written)          \
    do {                                                    \
@@ -95,7 +94,12 @@ typedef struct MeterClass_ {
 
 typedef struct GraphData_ {
    struct timeval time;
-   double values[METER_GRAPHDATA_SIZE];
+   unsigned int nValues;      /* ring buffer capacity, always even */
+   unsigned long long count;  /* number of samples taken so far */
+   double* values;            /* sample n is stored at n % nValues */
+   uint8_t* glyphs;           /* glyph indices, GRAPH_HEIGHT per column; column c holds samples 2c and 2c+1 */
+   double glyphTotal;         /* meter total the cached glyphs were scaled to */
+   int glyphPixPerRow;
 } GraphData;
 
 struct Meter_ {
@@ -2,6 +2,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "CRT.h"
 #include "Macros.h"
@@ -18,87 +19,160 @@ static const int NetworkIOMeter_attributes[] = {
    METER_VALUE_IOWRITE,
 };
 
+/* Shared by all Network IO meters, refreshed at most once per scan */
 static bool hasData = false;
+static uint64_t cached_last_update;
+static NetworkIOInterface cached_total;
+static NetworkIOInterfaces cached_interfaces;
+
+NetworkIOInterface* NetworkIOInterfaces_get(NetworkIOInterfaces* this, const char* name) {
+   /* interfaces are usually listed in the same order on every scan */
+   for (size_t n = 0; n < this->count; n++) {
+      size_t i = (this->cursor + n) % this->count;
+      if (String_eq(this->interfaces[i].name, name)) {
+         this->cursor = i + 1;
+         return &this->interfaces[i];
+      }
+   }
+
+   if (this->count == this->allocd) {
+      this->allocd = this->allocd ? this->allocd * 2 : 8;
+      this->interfaces = xReallocArray(this->interfaces, this->allocd, sizeof(NetworkIOInterface));
+   }
 
-static uint32_t cached_rxb_diff;
-static uint32_t cached_rxp_diff;
-static uint32_t cached_txb_diff;
-static uint32_t cached_txp_diff;
+   NetworkIOInterface* interface = &this->interfaces[this->count++];
+   memset(interface, 0, sizeof(NetworkIOInterface));
+   String_safeStrncpy(interface->name, name, sizeof(interface->name));
+   this->cursor = this->count;
+   return interface;
+}
 
-static void NetworkIOMeter_updateValues(Meter* this) {
-   const ProcessList* pl = this->pl;
-   static uint64_t cached_last_update = 0;
+static uint64_t NetworkIOMeter_delta(uint64_t current, uint64_t previous) {
+   return current > previous ? current - previous : 0;
+}
+
+static void NetworkIOInterface_updateRates(NetworkIOInterface* this, uint64_t passedTimeInMs) {
+   if (this->hasPrevious && passedTimeInMs > 0) {
+      const NetworkIOData* cur = &this->data;
+      const NetworkIOData* prev = &this->previous;
+
+      /* Meter_humanUnit() expects unit in kilo */
+      this->rxRate = NetworkIOMeter_delta(cur->bytesReceived, prev->bytesReceived) / ONE_K * 1000 / passedTimeInMs;
+      this->txRate = NetworkIOMeter_delta(cur->bytesTransmitted, prev->bytesTransmitted) / ONE_K * 1000 / passedTimeInMs;
+      this->rxPackets = 1000.0 * NetworkIOMeter_delta(cur->packetsReceived, prev->packetsReceived) / passedTimeInMs;
+      this->txPackets = 1000.0 * NetworkIOMeter_delta(cur->packetsTransmitted, prev->packetsTransmitted) / passedTimeInMs;
+   } else {
+      this->rxRate = 0;
+      this->txRate = 0;
+      this->rxPackets = 0.0;
+      this->txPackets = 0.0;
+   }
+
+   this->previous = this->data;
+   this->hasPrevious = true;
+}
+
+static void NetworkIOMeter_updateStats(const ProcessList* pl) {
+   if (cached_last_update == pl->realtimeMs)
+      return;
 
    uint64_t passedTimeInMs = pl->realtimeMs - cached_last_update;
+   cached_last_update = pl->realtimeMs;
 
-   /* update only every 500ms */
-   if (passedTimeInMs > 500) {
-      static uint64_t cached_rxb_total;
-      static uint64_t cached_rxp_total;
-      static uint64_t cached_txb_total;
-      static uint64_t cached_txp_total;
-      uint64_t diff;
-
-      cached_last_update = pl->realtimeMs;
-
-      NetworkIOData data;
-      hasData = Platform_getNetworkIO(&data);
-      if (!hasData) {
-         xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "no data");
-         return;
-      }
+   for (size_t i = 0; i < cached_interfaces.count; i++)
+      cached_interfaces.interfaces[i].present = false;
 
-      if (data.bytesReceived > cached_rxb_total) {
-         diff = data.bytesReceived - cached_rxb_total;
-         diff /= ONE_K; /* Meter_humanUnit() expects unit in kilo */
-         diff = (1000 * diff) / passedTimeInMs; /* convert to per second */
-         cached_rxb_diff = (uint32_t)diff;
-      } else {
-         cached_rxb_diff = 0;
-      }
-      cached_rxb_total = data.bytesReceived;
+   memset(&cached_total.data, 0, sizeof(cached_total.data));
+   hasData = Platform_getNetworkIO(&cached_total.data, &cached_interfaces);
+   if (!hasData)
+      return;
 
-      if (data.packetsReceived > cached_rxp_total) {
-         diff = data.packetsReceived - cached_rxp_total;
-         cached_rxp_diff = (uint32_t)diff;
+   NetworkIOInterface_updateRates(&cached_total, passedTimeInMs);
+   for (size_t i = 0; i < cached_interfaces.count; i++) {
+      NetworkIOInterface* interface = &cached_interfaces.interfaces[i];
+      if (interface->present) {
+         NetworkIOInterface_updateRates(interface, passedTimeInMs);
       } else {
-         cached_rxp_diff = 0;
+         interface->hasPrevious = false;
       }
-      cached_rxp_total = data.packetsReceived;
+   }
+}
 
-      if (data.bytesTransmitted > cached_txb_total) {
-         diff = data.bytesTransmitted - cached_txb_total;
-         diff /= ONE_K; /* Meter_humanUnit() expects unit in kilo */
-         diff = (1000 * diff) / passedTimeInMs; /* convert to per second */
-         cached_txb_diff = (uint32_t)diff;
-      } else {
-         cached_txb_diff = 0;
-      }
-      cached_txb_total = data.bytesTransmitted;
+size_t NetworkIOMeter_interfaceCount(const ProcessList* pl) {
+   NetworkIOMeter_updateStats(pl);
+   return cached_interfaces.count;
+}
 
-      if (data.packetsTransmitted > cached_txp_total) {
-         diff = data.packetsTransmitted - cached_txp_total;
-         cached_txp_diff = (uint32_t)diff;
-      } else {
-         cached_txp_diff = 0;
-      }
-      cached_txp_total = data.packetsTransmitted;
+const char* NetworkIOMeter_interfaceName(unsigned int param) {
+   if (param == 0 || param > cached_interfaces.count)
+      return NULL;
+
+   return cached_interfaces.interfaces[param - 1].name;
+}
+
+unsigned int NetworkIOMeter_interfaceParam(const char* name) {
+   return (unsigned int)(NetworkIOInterfaces_get(&cached_interfaces, name) - cached_interfaces.interfaces) + 1;
+}
+
+/* The interface shown by a meter, NULL if there is no data for it */
+static const NetworkIOInterface* NetworkIOMeter_interface(const Meter* this) {
+   if (!hasData)
+      return NULL;
+
+   if (this->param == 0)
+      return &cached_total;
+
+   if (this->param > cached_interfaces.count)
+      return NULL;
+
+   const NetworkIOInterface* interface = &cached_interfaces.interfaces[this->param - 1];
+   return interface->present ? interface : NULL;
+}
+
+static void NetworkIOMeter_init(Meter* this) {
+   const char* name = NetworkIOMeter_interfaceName(this->param);
+   if (name) {
+      char caption[40];
+      xSnprintf(caption, sizeof(caption), "%s: ", name);
+      Meter_setCaption(this, caption);
+   }
+}
+
+static void NetworkIOMeter_getUiName(const Meter* this, char* buffer, size_t length) {
+   const char* name = NetworkIOMeter_interfaceName(this->param);
+   if (name)
+      xSnprintf(buffer, length, "%s %s", Meter_uiName(this), name);
+   else
+      xSnprintf(buffer, length, "%s", Meter_uiName(this));
+}
+
+static void NetworkIOMeter_updateValues(Meter* this) {
+   NetworkIOMeter_updateStats(this->pl);
+
+   const NetworkIOInterface* interface = NetworkIOMeter_interface(this);
+   if (!interface) {
+      this->values[0] = 0;
+      this->values[1] = 0;
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "no data");
+      return;
    }
 
-   this->values[0] = cached_rxb_diff;
-   this->values[1] = cached_txb_diff;
-   if (cached_rxb_diff + cached_txb_diff > this->total) {
-      this->total = cached_rxb_diff + cached_txb_diff;
+   this->values[0] = interface->rxRate;
+   this->values[1] = interface->txRate;
+   if (interface->rxRate + interface->txRate > this->total) {
+      this->total = interface->rxRate + interface->txRate;
    }
 
    char bufferBytesReceived[12], bufferBytesTransmitted[12];
-   Meter_humanUnit(bufferBytesReceived, cached_rxb_diff, sizeof(bufferBytesReceived));
-   Meter_humanUnit(bufferBytesTransmitted, cached_txb_diff, sizeof(bufferBytesTransmitted));
-   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "rx:%siB/s tx:%siB/s", bufferBytesReceived, bufferBytesTransmitted);
+   Meter_humanUnit(bufferBytesReceived, interface->rxRate, sizeof(bufferBytesReceived));
+   Meter_humanUnit(bufferBytesTransmitted, interface->txRate, sizeof(bufferBytesTransmitted));
+   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "rx:%siB/s tx:%siB/s %.0f/%.0f pkts/s",
+             bufferBytesReceived, bufferBytesTransmitted, interface->rxPackets, interface->txPackets);
 }
 
-static void NetworkIOMeter_display(ATTR_UNUSED const Object* cast, RichString* out) {
-   if (!hasData) {
+static void NetworkIOMeter_display(const Object* cast, RichString* out) {
+   const NetworkIOInterface* interface = NetworkIOMeter_interface((const Meter*)cast);
+   if (!interface) {
       RichString_writeAscii(out, CRT_colors[METER_VALUE_ERROR], "no data");
       return;
    }
@@ -107,16 +181,16 @@ static void NetworkIOMeter_display(ATTR_UNUSED const Object* cast, RichString* o
    int len;
 
    RichString_writeAscii(out, CRT_colors[METER_TEXT], "rx: ");
-   Meter_humanUnit(buffer, cached_rxb_diff, sizeof(buffer));
+   Meter_humanUnit(buffer, interface->rxRate, sizeof(buffer));
    RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], buffer);
    RichString_appendAscii(out, CRT_colors[METER_VALUE_IOREAD], "iB/s");
 
    RichString_appendAscii(out, CRT_colors[METER_TEXT], " tx: ");
-   Meter_humanUnit(buffer, cached_txb_diff, sizeof(buffer));
+   Meter_humanUnit(buffer, interface->txRate, sizeof(buffer));
    RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], buffer);
    RichString_appendAscii(out, CRT_colors[METER_VALUE_IOWRITE], "iB/s");
 
-   len = xSnprintf(buffer, sizeof(buffer), " (%u/%u packets) ", cached_rxp_diff, cached_txp_diff);
+   len = xSnprintf(buffer, sizeof(buffer), " (%.0f/%.0f packets/s) ", interface->rxPackets, interface->txPackets);
    RichString_appendnAscii(out, CRT_colors[METER_TEXT], buffer, len);
 }
 
@@ -133,5 +207,7 @@ const MeterClass NetworkIOMeter_class = {
    .attributes = NetworkIOMeter_attributes,
    .name = "NetworkIO",
    .uiName = "Network IO",
-   .caption = "Network: "
+   .caption = "Network: ",
+   .init = NetworkIOMeter_init,
+   .getUiName = NetworkIOMeter_getUiName
 };
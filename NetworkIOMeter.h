@@ -1,7 +1,12 @@
 #ifndef HEADER_NetworkIOMeter
 #define HEADER_NetworkIOMeter
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #include "Meter.h"
+#include "ProcessList.h"
 
 
 typedef struct NetworkIOData_ {
@@ -11,6 +16,40 @@ typedef struct NetworkIOData_ {
    uint64_t packetsTransmitted;
 } NetworkIOData;
 
+typedef struct NetworkIOInterface_ {
+   char name[32];
+   bool present;           /* listed by the last Platform_getNetworkIO() */
+   NetworkIOData data;     /* counters, filled in by the platform */
+
+   /* derived by NetworkIOMeter on every refresh */
+   bool hasPrevious;
+   NetworkIOData previous;
+   uint64_t rxRate;        /* KiB/s */
+   uint64_t txRate;        /* KiB/s */
+   double rxPackets;       /* per second */
+   double txPackets;       /* per second */
+} NetworkIOInterface;
+
+/* Interfaces are only ever appended, so their index stays valid as meter param */
+typedef struct NetworkIOInterfaces_ {
+   NetworkIOInterface* interfaces;
+   size_t count;
+   size_t allocd;
+   size_t cursor;          /* where the next lookup starts */
+} NetworkIOInterfaces;
+
+/* Find an interface by name, adding it if unknown; for use by Platform_getNetworkIO() */
+NetworkIOInterface* NetworkIOInterfaces_get(NetworkIOInterfaces* this, const char* name);
+
+/* Number of interfaces known to the shared statistics, refreshing them if due */
+size_t NetworkIOMeter_interfaceCount(const ProcessList* pl);
+
+/* Interface shown by a meter with the given param (1-based), NULL for the total */
+const char* NetworkIOMeter_interfaceName(unsigned int param);
+
+/* Param of the meter for the named interface */
+unsigned int NetworkIOMeter_interfaceParam(const char* name);
+
 extern const MeterClass NetworkIOMeter_class;
 
 #endif /* HEADER_NetworkIOMeter */
@@ -19,42 +19,28 @@ in the source distribution for its full text.
 
 #include "Macros.h"
 #include "Panel.h"
+#include "Platform.h"
 #include "ProvideCurses.h"
 #include "Vector.h"
 #include "XUtils.h"
 
 
-typedef struct OpenFiles_Data_ {
-   char* data[7];
-} OpenFiles_Data;
-
-typedef struct OpenFiles_ProcessData_ {
-   OpenFiles_Data data;
-   int error;
-   struct OpenFiles_FileData_* files;
-} OpenFiles_ProcessData;
-
-typedef struct OpenFiles_FileData_ {
-   OpenFiles_Data data;
-   struct OpenFiles_FileData_* next;
-} OpenFiles_FileData;
-
 static size_t getIndexForType(char type) {
    switch (type) {
    case 'f':
-      return 0;
+      return OPENFILES_FD;
    case 'a':
-      return 1;
+      return OPENFILES_ACCESS;
    case 'D':
-      return 2;
+      return OPENFILES_DEVICE;
    case 'i':
-      return 3;
+      return OPENFILES_INODE;
    case 'n':
-      return 4;
+      return OPENFILES_NAME;
    case 's':
-      return 5;
+      return OPENFILES_SIZE;
    case 't':
-      return 6;
+      return OPENFILES_TYPE;
    }
 
    /* should never reach here */
@@ -86,6 +72,11 @@ static void OpenFilesScreen_draw(InfoScreen* this) {
 }
 
 static OpenFiles_ProcessData* OpenFilesScreen_getProcessData(pid_t pid) {
+   /* read natively where the platform can, lsof otherwise */
+   OpenFiles_ProcessData* native = Platform_getProcessFiles(pid);
+   if (native)
+      return native;
+
    OpenFiles_ProcessData* pdata = xCalloc(1, sizeof(OpenFiles_ProcessData));
 
    int fdpair[2] = {0, 0};
@@ -19,6 +19,33 @@ typedef struct OpenFilesScreen_ {
    pid_t pid;
 } OpenFilesScreen;
 
+/* Fields of an open file, named after the lsof(8) -F field characters */
+typedef enum OpenFiles_Field_ {
+   OPENFILES_FD,              /* f: descriptor, or cwd, rtd, txt */
+   OPENFILES_ACCESS,          /* a: r, w or u */
+   OPENFILES_DEVICE,          /* D */
+   OPENFILES_INODE,           /* i */
+   OPENFILES_NAME,            /* n: path, or addresses of a socket */
+   OPENFILES_SIZE,            /* s */
+   OPENFILES_TYPE,            /* t */
+   LAST_OPENFILES_FIELD
+} OpenFiles_Field;
+
+typedef struct OpenFiles_Data_ {
+   char* data[LAST_OPENFILES_FIELD];
+} OpenFiles_Data;
+
+typedef struct OpenFiles_FileData_ {
+   OpenFiles_Data data;
+   struct OpenFiles_FileData_* next;
+} OpenFiles_FileData;
+
+typedef struct OpenFiles_ProcessData_ {
+   OpenFiles_Data data;
+   int error;
+   struct OpenFiles_FileData_* files;
+} OpenFiles_ProcessData;
+
 extern const InfoScreenClass OpenFilesScreen_class;
 
 OpenFilesScreen* OpenFilesScreen_new(const Process* process);
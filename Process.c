@@ -977,6 +977,7 @@ void Process_init(Process* this, const Settings* settings) {
    this->tag = false;
    this->showChildren = true;
    this->show = true;
+   this->inView = true;
    this->updated = false;
    this->cmdlineBasenameEnd = -1;
    this->st_uid = (uid_t)-1;
@@ -1159,6 +1160,107 @@ int Process_compareByKey_Base(const Process* p1, const Process* p2, ProcessField
    }
 }
 
+bool Process_getFieldValue_Base(const Process* this, ProcessField key, ProcessFieldValue* value) {
+   value->string = NULL;
+   value->number = 0.0;
+
+   switch (key) {
+   case PERCENT_CPU:
+      value->number = this->percent_cpu;
+      break;
+   case PERCENT_NORM_CPU:
+      value->number = this->processList->activeCPUs > 0 ? this->percent_cpu / this->processList->activeCPUs : this->percent_cpu;
+      break;
+   case PERCENT_MEM:
+      value->number = this->percent_mem;
+      break;
+   case COMM: {
+      const char* command = Process_getCommand(this);
+      value->string = command ? command : "";
+      break;
+   }
+   case PROC_COMM:
+      value->string = this->procComm ? this->procComm : (Process_isKernelThread(this) ? kthreadID : "");
+      break;
+   case PROC_EXE:
+      value->string = this->procExe ? (this->procExe + this->procExeBasenameOffset) : (Process_isKernelThread(this) ? kthreadID : "");
+      break;
+   case CWD:
+      value->string = this->procCwd ? this->procCwd : "";
+      break;
+   case ELAPSED:
+      value->number = (double)this->processList->realtime.tv_sec - (double)this->starttime_ctime;
+      break;
+   case MAJFLT:
+      value->number = this->majflt;
+      break;
+   case MINFLT:
+      value->number = this->minflt;
+      break;
+   case M_RESIDENT:
+      value->number = this->m_resident;
+      break;
+   case M_VIRT:
+      value->number = this->m_virt;
+      break;
+   case NICE:
+      value->number = this->nice;
+      break;
+   case NLWP:
+      value->number = this->nlwp;
+      break;
+   case PGRP:
+      value->number = this->pgrp;
+      break;
+   case PID:
+      value->number = this->pid;
+      break;
+   case PPID:
+      value->number = this->ppid;
+      break;
+   case PRIORITY:
+      value->number = this->priority;
+      break;
+   case PROCESSOR:
+      value->number = this->processor;
+      break;
+   case SESSION:
+      value->number = this->session;
+      break;
+   case STARTTIME:
+      value->number = this->starttime_ctime;
+      break;
+   case STATE:
+      value->buffer[0] = this->state;
+      value->buffer[1] = '\0';
+      value->string = value->buffer;
+      break;
+   case ST_UID:
+      value->number = this->st_uid;
+      break;
+   case TIME:
+      /* in seconds, like the ELAPSED field */
+      value->number = this->time / 100.0;
+      break;
+   case TGID:
+      value->number = this->tgid;
+      break;
+   case TPGID:
+      value->number = this->tpgid;
+      break;
+   case TTY:
+      value->string = this->tty_name ? this->tty_name : "";
+      break;
+   case USER:
+      value->string = this->user ? this->user : "";
+      break;
+   default:
+      return false;
+   }
+
+   return true;
+}
+
 void Process_updateComm(Process* this, const char* comm) {
    if (!this->procComm && !comm)
       return;
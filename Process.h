@@ -231,6 +231,9 @@ typedef struct Process_ {
    /* Whether this process was shown last cycle */
    bool wasShown;
 
+   /* Whether this process was within the panel window (plus margin) at the last rebuild */
+   bool inView;
+
    /* Whether to show children of this process in tree-mode */
    bool showChildren;
 
@@ -283,22 +286,32 @@ extern const ProcessFieldData Process_fields[LAST_PROCESSFIELD];
 #define PROCESS_MAX_PID_DIGITS 19
 extern int Process_pidDigits;
 
+/* Raw value of a process field, as consumed by the process filter */
+typedef struct ProcessFieldValue_ {
+   const char* string; /* NULL for numeric fields */
+   double number;
+   char buffer[2];     /* backing store for single character fields */
+} ProcessFieldValue;
+
 typedef Process* (*Process_New)(const struct Settings_*);
 typedef void (*Process_WriteField)(const Process*, RichString*, ProcessField);
 typedef int (*Process_CompareByKey)(const Process*, const Process*, ProcessField);
 typedef const char* (*Process_GetCommandStr)(const Process*);
+typedef bool (*Process_GetFieldValue)(const Process*, ProcessField, ProcessFieldValue*);
 
 typedef struct ProcessClass_ {
    const ObjectClass super;
    const Process_WriteField writeField;
    const Process_CompareByKey compareByKey;
    const Process_GetCommandStr getCommandStr;
+   const Process_GetFieldValue getFieldValue;
 } ProcessClass;
 
 #define As_Process(this_)                              ((const ProcessClass*)((this_)->super.klass))
 
 #define Process_getCommand(this_)                      (As_Process(this_)->getCommandStr ? As_Process(this_)->getCommandStr((const Process*)(this_)) : Process_getCommandStr((const Process*)(this_)))
 #define Process_compareByKey(p1_, p2_, key_)           (As_Process(p1_)->compareByKey ? (As_Process(p1_)->compareByKey(p1_, p2_, key_)) : Process_compareByKey_Base(p1_, p2_, key_))
+#define Process_getFieldValue(p_, key_, value_)        (As_Process(p_)->getFieldValue ? (As_Process(p_)->getFieldValue(p_, key_, value_)) : Process_getFieldValue_Base(p_, key_, value_))
 
 static inline pid_t Process_getParentPid(const Process* this) {
    return this->tgid == this->pid ? this->ppid : this->tgid;
@@ -382,6 +395,9 @@ int Process_pidCompare(const void* v1, const void* v2);
 
 int Process_compareByKey_Base(const Process* p1, const Process* p2, ProcessField key);
 
+/* Returns false if the field has no value for this platform */
+bool Process_getFieldValue_Base(const Process* this, ProcessField key, ProcessFieldValue* value);
+
 // Avoid direct calls, use Process_getCommand instead
 const char* Process_getCommandStr(const Process* this);
 
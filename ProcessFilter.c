@@ -0,0 +1,473 @@
+/*
+htop - ProcessFilter.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "ProcessFilter.h"
+
+#include <ctype.h>
+#include <regex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "Macros.h"
+#include "StringMatcher.h"
+#include "XUtils.h"
+
+
+typedef enum ProcessFilterNodeType_ {
+   FILTER_AND,
+   FILTER_OR,
+   FILTER_NOT,
+   FILTER_TEXT,
+   FILTER_CLAUSE,
+} ProcessFilterNodeType;
+
+typedef enum ProcessFilterOp_ {
+   OP_EQ,
+   OP_NE,
+   OP_LT,
+   OP_LE,
+   OP_GT,
+   OP_GE,
+   OP_MATCH,
+   OP_NOMATCH,
+} ProcessFilterOp;
+
+typedef enum ProcessFilterResult_ {
+   RESULT_NO_MATCH,
+   RESULT_MATCH,
+   RESULT_UNKNOWN,
+} ProcessFilterResult;
+
+struct ProcessFilterNode_ {
+   ProcessFilterNodeType type;
+   uint32_t flags;
+
+   /* FILTER_AND, FILTER_OR, FILTER_NOT */
+   ProcessFilterNode** children;
+   size_t count;
+
+   /* FILTER_TEXT */
+   StringMatcher matcher;
+
+   /* FILTER_CLAUSE */
+   ProcessField field;
+   ProcessFilterOp op;
+   char* string;
+   double number;
+   bool isNumber;
+   bool hasRegex;
+   regex_t regex;
+};
+
+typedef struct ProcessFilterParser_ {
+   const char* at;
+} ProcessFilterParser;
+
+static const struct {
+   const char* alias;
+   ProcessField field;
+} ProcessFilter_aliases[] = {
+   { "cpu", PERCENT_CPU },
+   { "mem", PERCENT_MEM },
+   { "rss", M_RESIDENT },
+   { "cmd", COMM },
+   { "uid", ST_UID },
+   { "threads", NLWP },
+   { "prio", PRIORITY },
+};
+
+static ProcessFilterNode* ProcessFilterNode_new(ProcessFilterNodeType type) {
+   ProcessFilterNode* node = xCalloc(1, sizeof(ProcessFilterNode));
+   node->type = type;
+   return node;
+}
+
+static void ProcessFilterNode_delete(ProcessFilterNode* node) {
+   if (!node)
+      return;
+
+   for (size_t i = 0; i < node->count; i++)
+      ProcessFilterNode_delete(node->children[i]);
+   free(node->children);
+
+   if (node->type == FILTER_TEXT)
+      StringMatcher_done(&node->matcher);
+
+   if (node->hasRegex)
+      regfree(&node->regex);
+   free(node->string);
+   free(node);
+}
+
+static void ProcessFilterNode_addChild(ProcessFilterNode* node, ProcessFilterNode* child) {
+   node->children = xReallocArray(node->children, node->count + 1, sizeof(ProcessFilterNode*));
+   node->children[node->count++] = child;
+   node->flags |= child->flags;
+}
+
+/* Move children not depending on optional scan data to the front, keeping their order */
+static void ProcessFilterNode_cheapFirst(ProcessFilterNode* node) {
+   size_t cheap = 0;
+   for (size_t i = 0; i < node->count; i++) {
+      if (node->children[i]->flags)
+         continue;
+
+      ProcessFilterNode* child = node->children[i];
+      memmove(&node->children[cheap + 1], &node->children[cheap], (i - cheap) * sizeof(ProcessFilterNode*));
+      node->children[cheap++] = child;
+   }
+}
+
+static bool ProcessFilter_matchesTitle(const char* title, const char* name) {
+   while (*title == ' ')
+      title++;
+
+   size_t len = strlen(name);
+   if (strncasecmp(title, name, len) != 0)
+      return false;
+
+   for (title += len; *title; title++) {
+      if (*title != ' ')
+         return false;
+   }
+
+   return true;
+}
+
+static bool ProcessFilter_lookupField(const char* name, ProcessField* field) {
+   for (size_t i = 0; i < ARRAYSIZE(ProcessFilter_aliases); i++) {
+      if (strcasecmp(name, ProcessFilter_aliases[i].alias) == 0) {
+         *field = ProcessFilter_aliases[i].field;
+         return true;
+      }
+   }
+
+   for (int i = 1; i < LAST_PROCESSFIELD; i++) {
+      if (Process_fields[i].name && strcasecmp(name, Process_fields[i].name) == 0) {
+         *field = i;
+         return true;
+      }
+   }
+
+   for (int i = 1; i < LAST_PROCESSFIELD; i++) {
+      if (Process_fields[i].name && Process_fields[i].title && ProcessFilter_matchesTitle(Process_fields[i].title, name)) {
+         *field = i;
+         return true;
+      }
+   }
+
+   return false;
+}
+
+static void ProcessFilterParser_skipSpace(ProcessFilterParser* this) {
+   while (isspace((unsigned char)*this->at))
+      this->at++;
+}
+
+static bool ProcessFilterParser_accept(ProcessFilterParser* this, const char* token) {
+   ProcessFilterParser_skipSpace(this);
+   size_t len = strlen(token);
+   if (strncmp(this->at, token, len) != 0)
+      return false;
+
+   this->at += len;
+   return true;
+}
+
+static bool ProcessFilterParser_isWordChar(char c) {
+   return c && !isspace((unsigned char)c) && !strchr("()&|!=<>~\"", c);
+}
+
+static char* ProcessFilterParser_word(ProcessFilterParser* this) {
+   ProcessFilterParser_skipSpace(this);
+
+   if (*this->at == '"') {
+      const char* start = this->at + 1;
+      const char* end = strchr(start, '"');
+      if (!end)
+         return NULL;
+
+      this->at = end + 1;
+      return xStrndup(start, end - start);
+   }
+
+   const char* start = this->at;
+   while (ProcessFilterParser_isWordChar(*this->at))
+      this->at++;
+
+   return this->at > start ? xStrndup(start, this->at - start) : NULL;
+}
+
+/* Values end at whitespace, "&&", "||" or an unbalanced ')' */
+static char* ProcessFilterParser_value(ProcessFilterParser* this) {
+   ProcessFilterParser_skipSpace(this);
+
+   if (*this->at == '"')
+      return ProcessFilterParser_word(this);
+
+   const char* start = this->at;
+   int depth = 0;
+   for (; *this->at && !isspace((unsigned char)*this->at); this->at++) {
+      if (String_startsWith(this->at, "&&") || String_startsWith(this->at, "||"))
+         break;
+
+      if (*this->at == '(') {
+         depth++;
+      } else if (*this->at == ')') {
+         if (depth == 0)
+            break;
+         depth--;
+      }
+   }
+
+   return this->at > start ? xStrndup(start, this->at - start) : NULL;
+}
+
+static bool ProcessFilterParser_op(ProcessFilterParser* this, ProcessFilterOp* op) {
+   static const struct {
+      const char* token;
+      ProcessFilterOp op;
+   } ops[] = {
+      /* longest tokens first */
+      { "==", OP_EQ },
+      { "!=", OP_NE },
+      { "<=", OP_LE },
+      { ">=", OP_GE },
+      { "!~", OP_NOMATCH },
+      { "=", OP_EQ },
+      { "<", OP_LT },
+      { ">", OP_GT },
+      { "~", OP_MATCH },
+   };
+
+   for (size_t i = 0; i < ARRAYSIZE(ops); i++) {
+      if (ProcessFilterParser_accept(this, ops[i].token)) {
+         *op = ops[i].op;
+         return true;
+      }
+   }
+
+   return false;
+}
+
+static ProcessFilterNode* ProcessFilterParser_clause(ProcessFilterParser* this, const char* name, ProcessFilterOp op) {
+   ProcessField field;
+   if (!ProcessFilter_lookupField(name, &field))
+      return NULL;
+
+   char* value = ProcessFilterParser_value(this);
+   if (!value)
+      return NULL;
+
+   ProcessFilterNode* node = ProcessFilterNode_new(FILTER_CLAUSE);
+   node->field = field;
+   node->op = op;
+   node->flags = Process_fields[field].flags;
+   node->string = value;
+
+   if (op == OP_MATCH || op == OP_NOMATCH) {
+      size_t len = strlen(value);
+      if (len >= 2 && value[0] == '/' && value[len - 1] == '/') {
+         memmove(value, value + 1, len - 2);
+         value[len - 2] = '\0';
+      }
+
+      if (regcomp(&node->regex, value, REG_EXTENDED | REG_NOSUB | REG_ICASE) != 0) {
+         ProcessFilterNode_delete(node);
+         return NULL;
+      }
+      node->hasRegex = true;
+   } else {
+      char* end;
+      node->number = strtod(value, &end);
+      node->isNumber = end != value && *end == '\0';
+   }
+
+   return node;
+}
+
+static ProcessFilterNode* ProcessFilterParser_or(ProcessFilterParser* this);
+
+static ProcessFilterNode* ProcessFilterParser_primary(ProcessFilterParser* this) {
+   if (ProcessFilterParser_accept(this, "(")) {
+      ProcessFilterNode* node = ProcessFilterParser_or(this);
+      if (node && !ProcessFilterParser_accept(this, ")")) {
+         ProcessFilterNode_delete(node);
+         return NULL;
+      }
+      return node;
+   }
+
+   if (ProcessFilterParser_accept(this, "!")) {
+      ProcessFilterNode* child = ProcessFilterParser_primary(this);
+      if (!child)
+         return NULL;
+
+      ProcessFilterNode* node = ProcessFilterNode_new(FILTER_NOT);
+      ProcessFilterNode_addChild(node, child);
+      return node;
+   }
+
+   char* word = ProcessFilterParser_word(this);
+   if (!word)
+      return NULL;
+
+   ProcessFilterNode* node;
+   ProcessFilterOp op;
+   if (ProcessFilterParser_op(this, &op)) {
+      node = ProcessFilterParser_clause(this, word, op);
+   } else {
+      node = ProcessFilterNode_new(FILTER_TEXT);
+      StringMatcher_init(&node->matcher);
+      StringMatcher_compile(&node->matcher, word);
+   }
+
+   free(word);
+   return node;
+}
+
+static ProcessFilterNode* ProcessFilterParser_list(ProcessFilterParser* this, ProcessFilterNodeType type) {
+   const char* token = type == FILTER_OR ? "||" : "&&";
+
+   ProcessFilterNode* first = type == FILTER_OR ? ProcessFilterParser_list(this, FILTER_AND) : ProcessFilterParser_primary(this);
+   if (!first || !ProcessFilterParser_accept(this, token))
+      return first;
+
+   ProcessFilterNode* node = ProcessFilterNode_new(type);
+   ProcessFilterNode_addChild(node, first);
+   do {
+      ProcessFilterNode* next = type == FILTER_OR ? ProcessFilterParser_list(this, FILTER_AND) : ProcessFilterParser_primary(this);
+      if (!next) {
+         ProcessFilterNode_delete(node);
+         return NULL;
+      }
+      ProcessFilterNode_addChild(node, next);
+   } while (ProcessFilterParser_accept(this, token));
+
+   ProcessFilterNode_cheapFirst(node);
+   return node;
+}
+
+static ProcessFilterNode* ProcessFilterParser_or(ProcessFilterParser* this) {
+   return ProcessFilterParser_list(this, FILTER_OR);
+}
+
+ProcessFilter* ProcessFilter_new(const char* text) {
+   if (!text || !text[0])
+      return NULL;
+
+   ProcessFilterParser parser = { .at = text };
+   ProcessFilterNode* root = ProcessFilterParser_or(&parser);
+   ProcessFilterParser_skipSpace(&parser);
+
+   if (!root || *parser.at) {
+      /* Not an expression: plain (multi-term) substring filter */
+      ProcessFilterNode_delete(root);
+      root = ProcessFilterNode_new(FILTER_TEXT);
+      StringMatcher_init(&root->matcher);
+      StringMatcher_compile(&root->matcher, text);
+   }
+
+   ProcessFilter* this = xMalloc(sizeof(ProcessFilter));
+   this->root = root;
+   this->flags = root->flags;
+   return this;
+}
+
+void ProcessFilter_delete(ProcessFilter* this) {
+   if (!this)
+      return;
+
+   ProcessFilterNode_delete(this->root);
+   free(this);
+}
+
+static bool ProcessFilterNode_compare(const ProcessFilterNode* node, const ProcessFieldValue* value) {
+   const char* string = value->string;
+   char buffer[64];
+   if (!string && (node->hasRegex || !node->isNumber)) {
+      xSnprintf(buffer, sizeof(buffer), "%g", value->number);
+      string = buffer;
+   }
+
+   if (node->hasRegex) {
+      bool found = regexec(&node->regex, string, 0, NULL, 0) == 0;
+      return found == (node->op == OP_MATCH);
+   }
+
+   int cmp = string ? strcmp(string, node->string) : SPACESHIP_NUMBER(value->number, node->number);
+   switch (node->op) {
+   case OP_EQ: return cmp == 0;
+   case OP_NE: return cmp != 0;
+   case OP_LT: return cmp < 0;
+   case OP_LE: return cmp <= 0;
+   case OP_GT: return cmp > 0;
+   case OP_GE: return cmp >= 0;
+   default:
+      return false;
+   }
+}
+
+static ProcessFilterResult ProcessFilterNode_eval(const ProcessFilterNode* node, const Process* p, bool complete) {
+   ProcessFilterResult result;
+
+   switch (node->type) {
+   case FILTER_AND:
+      result = RESULT_MATCH;
+      for (size_t i = 0; i < node->count; i++) {
+         ProcessFilterResult r = ProcessFilterNode_eval(node->children[i], p, complete);
+         if (r == RESULT_NO_MATCH)
+            return RESULT_NO_MATCH;
+         if (r == RESULT_UNKNOWN)
+            result = RESULT_UNKNOWN;
+      }
+      return result;
+   case FILTER_OR:
+      result = RESULT_NO_MATCH;
+      for (size_t i = 0; i < node->count; i++) {
+         ProcessFilterResult r = ProcessFilterNode_eval(node->children[i], p, complete);
+         if (r == RESULT_MATCH)
+            return RESULT_MATCH;
+         if (r == RESULT_UNKNOWN)
+            result = RESULT_UNKNOWN;
+      }
+      return result;
+   case FILTER_NOT:
+      result = ProcessFilterNode_eval(node->children[0], p, complete);
+      if (result == RESULT_UNKNOWN)
+         return RESULT_UNKNOWN;
+      return result == RESULT_MATCH ? RESULT_NO_MATCH : RESULT_MATCH;
+   case FILTER_TEXT: {
+      const char* command = Process_getCommand(p);
+      return command && StringMatcher_matches(&node->matcher, command) ? RESULT_MATCH : RESULT_NO_MATCH;
+   }
+   case FILTER_CLAUSE: {
+      if (!complete && node->flags)
+         return RESULT_UNKNOWN;
+
+      ProcessFieldValue value;
+      if (!Process_getFieldValue(p, node->field, &value))
+         return RESULT_NO_MATCH;
+
+      return ProcessFilterNode_compare(node, &value) ? RESULT_MATCH : RESULT_NO_MATCH;
+   }
+   }
+
+   return RESULT_NO_MATCH;
+}
+
+bool ProcessFilter_matches(const ProcessFilter* this, const Process* p) {
+   return ProcessFilterNode_eval(this->root, p, true) == RESULT_MATCH;
+}
+
+bool ProcessFilter_mayMatch(const ProcessFilter* this, const Process* p) {
+   return ProcessFilterNode_eval(this->root, p, false) != RESULT_NO_MATCH;
+}
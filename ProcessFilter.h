@@ -0,0 +1,46 @@
+#ifndef HEADER_ProcessFilter
+#define HEADER_ProcessFilter
+/*
+htop - ProcessFilter.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Process.h"
+
+
+/*
+ * Process filter expressions, e.g.
+ *
+ *    user=postgres && cpu>5 && cgroup~/system.slice/db/
+ *
+ * Clauses compare a field (by name, column title or a short alias like
+ * "cpu" or "mem") using =, !=, <, <=, >, >=, ~ or !~ (regular expression,
+ * optionally enclosed in slashes). Clauses are combined with &&, || and !
+ * and may be grouped with parentheses. A bare word matches the command
+ * line. Text which is not a valid expression filters by substring.
+ */
+
+typedef struct ProcessFilterNode_ ProcessFilterNode;
+
+typedef struct ProcessFilter_ {
+   ProcessFilterNode* root;
+   uint32_t flags;           /* scan flags needed by the referenced fields */
+} ProcessFilter;
+
+/* Returns NULL for a NULL or empty filter text */
+ProcessFilter* ProcessFilter_new(const char* text);
+
+void ProcessFilter_delete(ProcessFilter* this);
+
+bool ProcessFilter_matches(const ProcessFilter* this, const Process* p);
+
+/* Like ProcessFilter_matches, but clauses on fields that need an optional
+ * scan flag are considered unknown; false only if p cannot match */
+bool ProcessFilter_mayMatch(const ProcessFilter* this, const Process* p);
+
+#endif
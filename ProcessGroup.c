@@ -0,0 +1,363 @@
+/*
+htop - ProcessGroup.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "ProcessGroup.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "ProcessList.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "XUtils.h"
+
+
+typedef enum ProcessGroupAggregate_ {
+   AGGREGATE_SUM,
+   AGGREGATE_MAX,
+} ProcessGroupAggregate;
+
+typedef enum ProcessGroupFormat_ {
+   FORMAT_PERCENT,
+   FORMAT_KBYTES,
+   FORMAT_BYTES,
+   FORMAT_RATE,
+   FORMAT_SECONDS,
+   FORMAT_COUNT,
+} ProcessGroupFormat;
+
+typedef struct ProcessGroupColumn_ {
+   const char* name;
+   ProcessGroupAggregate aggregate;
+   ProcessGroupFormat format;
+} ProcessGroupColumn;
+
+/* Columns which can be aggregated, by field name so that platform specific
+ * columns are covered as well; the values are those of Process_getFieldValue */
+static const ProcessGroupColumn ProcessGroup_columnList[] = {
+   { "PERCENT_CPU",        AGGREGATE_SUM, FORMAT_PERCENT },
+   { "PERCENT_NORM_CPU",   AGGREGATE_SUM, FORMAT_PERCENT },
+   { "PERCENT_MEM",        AGGREGATE_SUM, FORMAT_PERCENT },
+   { "PERCENT_CPU_DELAY",  AGGREGATE_MAX, FORMAT_PERCENT },
+   { "PERCENT_IO_DELAY",   AGGREGATE_MAX, FORMAT_PERCENT },
+   { "PERCENT_SWAP_DELAY", AGGREGATE_MAX, FORMAT_PERCENT },
+   { "CGROUP_PSI_CPU",     AGGREGATE_MAX, FORMAT_PERCENT },
+   { "CGROUP_PSI_IO",      AGGREGATE_MAX, FORMAT_PERCENT },
+   { "CGROUP_PSI_MEMORY",  AGGREGATE_MAX, FORMAT_PERCENT },
+   { "M_VIRT",             AGGREGATE_SUM, FORMAT_KBYTES },
+   { "M_RESIDENT",         AGGREGATE_SUM, FORMAT_KBYTES },
+   { "M_PSS",              AGGREGATE_SUM, FORMAT_KBYTES },
+   { "M_SWAP",             AGGREGATE_SUM, FORMAT_KBYTES },
+   { "M_PSSWP",            AGGREGATE_SUM, FORMAT_KBYTES },
+   { "RCHAR",              AGGREGATE_SUM, FORMAT_BYTES },
+   { "WCHAR",              AGGREGATE_SUM, FORMAT_BYTES },
+   { "RBYTES",             AGGREGATE_SUM, FORMAT_BYTES },
+   { "WBYTES",             AGGREGATE_SUM, FORMAT_BYTES },
+   { "CNCLWB",             AGGREGATE_SUM, FORMAT_BYTES },
+   { "IO_READ_RATE",       AGGREGATE_SUM, FORMAT_RATE },
+   { "IO_WRITE_RATE",      AGGREGATE_SUM, FORMAT_RATE },
+   { "IO_RATE",            AGGREGATE_SUM, FORMAT_RATE },
+   { "TIME",               AGGREGATE_SUM, FORMAT_SECONDS },
+   { "UTIME",              AGGREGATE_SUM, FORMAT_SECONDS },
+   { "STIME",              AGGREGATE_SUM, FORMAT_SECONDS },
+   { "CUTIME",             AGGREGATE_SUM, FORMAT_SECONDS },
+   { "CSTIME",             AGGREGATE_SUM, FORMAT_SECONDS },
+   { "ELAPSED",            AGGREGATE_MAX, FORMAT_SECONDS },
+   { "NLWP",               AGGREGATE_SUM, FORMAT_COUNT },
+   { "MINFLT",             AGGREGATE_SUM, FORMAT_COUNT },
+   { "MAJFLT",             AGGREGATE_SUM, FORMAT_COUNT },
+   { "CMINFLT",            AGGREGATE_SUM, FORMAT_COUNT },
+   { "CMAJFLT",            AGGREGATE_SUM, FORMAT_COUNT },
+   { "SYSCR",              AGGREGATE_SUM, FORMAT_COUNT },
+   { "SYSCW",              AGGREGATE_SUM, FORMAT_COUNT },
+   { "CTXT",               AGGREGATE_SUM, FORMAT_COUNT },
+};
+
+static const ProcessGroupColumn* ProcessGroup_column(ProcessField field) {
+   static const ProcessGroupColumn* columns[LAST_PROCESSFIELD];
+   static bool resolved = false;
+
+   if (!resolved) {
+      for (int i = 1; i < LAST_PROCESSFIELD; i++) {
+         const char* name = Process_fields[i].name;
+         if (!name)
+            continue;
+
+         for (size_t j = 0; j < ARRAYSIZE(ProcessGroup_columnList); j++) {
+            if (String_eq(name, ProcessGroup_columnList[j].name)) {
+               columns[i] = &ProcessGroup_columnList[j];
+               break;
+            }
+         }
+      }
+      resolved = true;
+   }
+
+   if (field <= 0 || field >= LAST_PROCESSFIELD)
+      return NULL;
+
+   return columns[field];
+}
+
+ht_key_t ProcessGroup_hash(const char* key) {
+   /* FNV-1a */
+   ht_key_t hash = 2166136261U;
+   for (const unsigned char* c = (const unsigned char*)key; *c; c++) {
+      hash ^= *c;
+      hash *= 16777619U;
+   }
+   return hash;
+}
+
+const char* ProcessGroup_keyOf(const Process* p, ProcessField field, ProcessFieldValue* value, char* buffer, size_t size) {
+   if (!Process_getFieldValue(p, field, value))
+      return "";
+
+   if (value->string)
+      return value->string;
+
+   xSnprintf(buffer, size, "%.15g", value->number);
+   return buffer;
+}
+
+ProcessGroup* ProcessGroup_new(const ProcessList* pl, const char* key, ht_key_t hash) {
+   ProcessGroup* this = xCalloc(1, sizeof(ProcessGroup));
+   Object_setClass(this, Class(ProcessGroup));
+   Process_init(&this->super, pl->settings);
+   this->super.processList = pl;
+   this->super.pid = -1;
+   this->super.ppid = -1;
+   this->super.tgid = -1;
+   this->super.showChildren = false;
+
+   this->key = xStrdup(key);
+   this->hash = hash;
+   this->members = Vector_new(Class(Process), false, DEFAULT_SIZE);
+   return this;
+}
+
+void ProcessGroup_delete(Object* cast) {
+   ProcessGroup* this = (ProcessGroup*) cast;
+   Process_done(&this->super);
+   Vector_delete(this->members);
+   free(this->totals);
+   free(this->key);
+   free(this);
+}
+
+void ProcessGroup_reset(ProcessGroup* this) {
+   const ProcessField* fields = this->super.settings->fields;
+   size_t count = 0;
+   while (fields[count])
+      count++;
+
+   if (this->totalsSize < count) {
+      this->totals = xReallocArray(this->totals, count, sizeof(double));
+      this->totalsSize = count;
+   }
+   memset(this->totals, 0, this->totalsSize * sizeof(double));
+   this->sortTotal = 0.0;
+
+   Vector_prune(this->members);
+   this->mixedUsers = false;
+   this->updated = false;
+}
+
+static double ProcessGroup_combine(const ProcessGroupColumn* column, double total, const Process* member, ProcessField field) {
+   ProcessFieldValue value;
+   if (!Process_getFieldValue(member, field, &value) || value.string || isnan(value.number))
+      return total;
+
+   if (column->aggregate == AGGREGATE_MAX)
+      return MAXIMUM(total, value.number);
+
+   return total + value.number;
+}
+
+void ProcessGroup_add(ProcessGroup* this, Process* member) {
+   const Settings* settings = this->super.settings;
+   const ProcessField* fields = settings->fields;
+
+   for (size_t i = 0; i < this->totalsSize && fields[i]; i++) {
+      const ProcessGroupColumn* column = ProcessGroup_column(fields[i]);
+      if (column)
+         this->totals[i] = ProcessGroup_combine(column, this->totals[i], member, fields[i]);
+   }
+
+   const ProcessField sortKey = Settings_getActiveSortKey(settings);
+   const ProcessGroupColumn* sortColumn = ProcessGroup_column(sortKey);
+   if (sortColumn)
+      this->sortTotal = ProcessGroup_combine(sortColumn, this->sortTotal, member, sortKey);
+
+   if (Vector_size(this->members) == 0) {
+      this->super.st_uid = member->st_uid;
+      this->super.tag = member->tag;
+   } else {
+      this->super.tag = this->super.tag && member->tag;
+
+      if (!this->mixedUsers && member->st_uid != this->super.st_uid) {
+         /* do not shadow groups of several users */
+         this->mixedUsers = true;
+         this->super.st_uid = getuid();
+      }
+   }
+
+   Vector_add(this->members, member);
+   this->updated = true;
+}
+
+void ProcessGroup_setTag(ProcessGroup* this, bool tag) {
+   for (int i = 0; i < Vector_size(this->members); i++) {
+      Process* member = (Process*) Vector_get(this->members, i);
+      member->tag = tag;
+   }
+   this->super.tag = tag;
+}
+
+/* Width of the column as printed for an actual process */
+static int ProcessGroup_columnWidth(const Process* member, ProcessField field) {
+   RichString_begin(sample);
+   As_Process(member)->writeField(member, &sample, field);
+   int width = RichString_size(&sample);
+   RichString_delete(&sample);
+   return width;
+}
+
+static void ProcessGroup_writeTotal(const ProcessGroupColumn* column, double total, const Process* member, RichString* str, ProcessField field) {
+   char buffer[32];
+   int attr = CRT_colors[DEFAULT_COLOR];
+   bool coloring = member->settings->highlightMegabytes;
+
+   switch (column->format) {
+   case FORMAT_KBYTES: Process_printKBytes(str, (unsigned long long)total, coloring); return;
+   case FORMAT_BYTES: Process_printBytes(str, (unsigned long long)total, coloring); return;
+   case FORMAT_RATE: Process_printRate(str, total, coloring); return;
+   case FORMAT_SECONDS: Process_printTime(str, (unsigned long long)(total * 100.0), coloring); return;
+   case FORMAT_PERCENT: {
+      int width = ProcessGroup_columnWidth(member, field) - 1;
+      if (total > 999.9) {
+         xSnprintf(buffer, sizeof(buffer), "%*u ", width, (unsigned int)total);
+      } else if (total > 99.9) {
+         xSnprintf(buffer, sizeof(buffer), "%*u. ", width - 1, (unsigned int)total);
+      } else {
+         if (total < 0.05)
+            attr = CRT_colors[PROCESS_SHADOW];
+
+         xSnprintf(buffer, sizeof(buffer), "%*.1f ", width, total);
+      }
+      break;
+   }
+   case FORMAT_COUNT:
+      xSnprintf(buffer, sizeof(buffer), "%*llu ", ProcessGroup_columnWidth(member, field) - 1, (unsigned long long)total);
+      break;
+   default:
+      assert(0 && "ProcessGroup_writeTotal: default key reached"); /* should never be reached */
+      xSnprintf(buffer, sizeof(buffer), "- ");
+      break;
+   }
+   RichString_appendAscii(str, attr, buffer);
+}
+
+static void ProcessGroup_writeLabel(const ProcessGroup* this, RichString* str) {
+   char buffer[32];
+
+   xSnprintf(buffer, sizeof(buffer), "%s ", CRT_treeStr[this->super.showChildren ? TREE_STR_SHUT : TREE_STR_OPEN]);
+   RichString_appendWide(str, CRT_colors[PROCESS_TREE], buffer);
+   RichString_appendWide(str, CRT_colors[PROCESS_BASENAME], this->key[0] ? this->key : "-");
+
+   int count = Vector_size(this->members);
+   xSnprintf(buffer, sizeof(buffer), " (%d task%s)", count, count == 1 ? "" : "s");
+   RichString_appendAscii(str, CRT_colors[PROCESS_SHADOW], buffer);
+}
+
+static void ProcessGroup_writeField(const Process* super, RichString* str, ProcessField field) {
+   const ProcessGroup* this = (const ProcessGroup*) super;
+   const Settings* settings = super->settings;
+
+   if (field == COMM) {
+      ProcessGroup_writeLabel(this, str);
+      return;
+   }
+
+   if (Vector_size(this->members) == 0) {
+      RichString_appendAscii(str, CRT_colors[PROCESS_SHADOW], "- ");
+      return;
+   }
+
+   /* all members share the value of the grouping column */
+   const Process* member = (const Process*) Vector_get(this->members, 0);
+   if (field == settings->groupBy) {
+      As_Process(member)->writeField(member, str, field);
+      return;
+   }
+
+   const ProcessGroupColumn* column = ProcessGroup_column(field);
+   if (column) {
+      for (size_t i = 0; i < this->totalsSize && settings->fields[i]; i++) {
+         if (settings->fields[i] == field) {
+            ProcessGroup_writeTotal(column, this->totals[i], member, str, field);
+            return;
+         }
+      }
+   }
+
+   RichString_appendChr(str, CRT_colors[DEFAULT_COLOR], ' ', ProcessGroup_columnWidth(member, field));
+}
+
+static const char* ProcessGroup_getCommandStr(const Process* super) {
+   const ProcessGroup* this = (const ProcessGroup*) super;
+   return this->key;
+}
+
+static int ProcessGroup_compareKeys(const ProcessGroup* g1, const ProcessGroup* g2) {
+   char* end1;
+   char* end2;
+   double n1 = strtod(g1->key, &end1);
+   double n2 = strtod(g2->key, &end2);
+   if (end1 != g1->key && *end1 == '\0' && end2 != g2->key && *end2 == '\0')
+      return SPACESHIP_NUMBER(n1, n2);
+
+   return strcmp(g1->key, g2->key);
+}
+
+static int ProcessGroup_compare(const void* v1, const void* v2) {
+   const ProcessGroup* g1 = (const ProcessGroup*) v1;
+   const ProcessGroup* g2 = (const ProcessGroup*) v2;
+   const Settings* settings = g1->super.settings;
+   const ProcessField key = Settings_getActiveSortKey(settings);
+
+   int result;
+   if (ProcessGroup_column(key)) {
+      result = SPACESHIP_NUMBER(g1->sortTotal, g2->sortTotal);
+      if (result == 0)
+         return ProcessGroup_compareKeys(g1, g2);
+   } else if (key == settings->groupBy) {
+      result = ProcessGroup_compareKeys(g1, g2);
+   } else {
+      return ProcessGroup_compareKeys(g1, g2);
+   }
+
+   return (Settings_getActiveDirection(settings) == 1) ? result : -result;
+}
+
+const ProcessClass ProcessGroup_class = {
+   .super = {
+      .extends = Class(Process),
+      .display = Process_display,
+      .delete = ProcessGroup_delete,
+      .compare = ProcessGroup_compare
+   },
+   .writeField = ProcessGroup_writeField,
+   .getCommandStr = ProcessGroup_getCommandStr,
+};
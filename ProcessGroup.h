@@ -0,0 +1,68 @@
+#ifndef HEADER_ProcessGroup
+#define HEADER_ProcessGroup
+/*
+htop - ProcessGroup.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "Hashtable.h"
+#include "Object.h"
+#include "Process.h"
+#include "Vector.h"
+
+
+/*
+ * Synthetic row standing for all displayed processes which share the value
+ * of the column the process list is grouped by. Numeric columns show the
+ * sum (or the maximum, for delays and elapsed time) over the members, the
+ * command column shows the group value and the number of members.
+ *
+ * A group is a Process so that it can live in the main panel; its pid is
+ * -1, and showChildren holds whether the members are listed below it.
+ */
+typedef struct ProcessGroup_ {
+   Process super;
+
+   char* key;                       /* shared value of the grouping column */
+   ht_key_t hash;
+   struct ProcessGroup_* next;      /* next group with the same hash */
+
+   Vector* members;                 /* not owned, in display order */
+   double* totals;                  /* one aggregate per displayed column */
+   size_t totalsSize;
+   double sortTotal;                /* aggregate of the sort column */
+   bool mixedUsers;
+   bool updated;                    /* whether it had members in the last rebuild */
+} ProcessGroup;
+
+extern const ProcessClass ProcessGroup_class;
+
+ProcessGroup* ProcessGroup_new(const struct ProcessList_* pl, const char* key, ht_key_t hash);
+
+void ProcessGroup_delete(Object* cast);
+
+/* Hash of a group value, also used for the lookup of the group of a process */
+ht_key_t ProcessGroup_hash(const char* key);
+
+/* The value of the grouping column of a process as a string, which may point
+ * into value or buffer */
+const char* ProcessGroup_keyOf(const Process* p, ProcessField field, ProcessFieldValue* value, char* buffer, size_t size);
+
+/* Forget the members, in preparation of a new aggregation pass */
+void ProcessGroup_reset(ProcessGroup* this);
+
+void ProcessGroup_add(ProcessGroup* this, Process* member);
+
+/* Set the tag of all members; the group row is shown as tagged if all of them are */
+void ProcessGroup_setTag(ProcessGroup* this, bool tag);
+
+static inline bool ProcessGroup_isGroup(const Object* o) {
+   return o && o->klass == (const ObjectClass*)&ProcessGroup_class;
+}
+
+#endif
@@ -16,6 +16,8 @@ in the source distribution for its full text.
 #include "Hashtable.h"
 #include "Macros.h"
 #include "Platform.h"
+#include "ProcessGroup.h"
+#include "Replay.h"
 #include "Vector.h"
 #include "XUtils.h"
 
@@ -28,12 +30,18 @@ ProcessList* ProcessList_init(ProcessList* this, const ObjectClass* klass, Users
    this->displayTreeSet = Hashtable_new(200, false);
    this->draftingTreeSet = Hashtable_new(200, false);
 
+   this->groups = Vector_new(Class(ProcessGroup), true, DEFAULT_SIZE);
+   this->groupTable = Hashtable_new(64, false);
+   this->groupedBy = 0;
+
    this->usersTable = usersTable;
    this->pidMatchList = pidMatchList;
    this->dynamicMeters = dynamicMeters;
    this->dynamicColumns = dynamicColumns;
 
    this->userId = userId;
+   this->incFilter = NULL;
+   this->replay = NULL;
 
    // set later by platform-specific code
    this->activeCPUs = 0;
@@ -73,6 +81,11 @@ void ProcessList_done(ProcessList* this) {
    }
 #endif
 
+   ProcessFilter_delete(this->incFilter);
+
+   Hashtable_delete(this->groupTable);
+   Vector_delete(this->groups);
+
    Hashtable_delete(this->draftingTreeSet);
    Hashtable_delete(this->displayTreeSet);
    Hashtable_delete(this->processTable);
@@ -85,6 +98,15 @@ void ProcessList_setPanel(ProcessList* this, Panel* panel) {
    this->panel = panel;
 }
 
+void ProcessList_setProcessClass(ProcessList* this, const ObjectClass* klass) {
+   assert(Vector_size(this->processes) == 0);
+
+   Vector_delete(this->processes2);
+   Vector_delete(this->processes);
+   this->processes = Vector_new(klass, true, DEFAULT_SIZE);
+   this->processes2 = Vector_new(klass, true, DEFAULT_SIZE);
+}
+
 static const char* alignedDynamicColumnTitle(const ProcessList* this, int key) {
    const DynamicColumn* column = Hashtable_get(this->dynamicColumns, key);
    if (column == NULL)
@@ -522,9 +544,111 @@ void ProcessList_collapseAllBranches(ProcessList* this) {
    }
 }
 
-void ProcessList_rebuildPanel(ProcessList* this) {
-   const char* incFilter = this->incFilter;
+void ProcessList_setFilter(ProcessList* this, const char* filter) {
+   ProcessFilter_delete(this->incFilter);
+   this->incFilter = ProcessFilter_new(filter);
+}
+
+static bool ProcessList_filter(const ProcessList* this, const Process* p, bool complete) {
+   if (this->userId != (uid_t) -1 && p->st_uid != this->userId)
+      return false;
+
+   if (this->pidMatchList && !Hashtable_get(this->pidMatchList, p->tgid))
+      return false;
+
+   if (this->incFilter)
+      return complete ? ProcessFilter_matches(this->incFilter, p) : ProcessFilter_mayMatch(this->incFilter, p);
 
+   return true;
+}
+
+bool ProcessList_matchesFilters(const ProcessList* this, const Process* p) {
+   return ProcessList_filter(this, p, true);
+}
+
+bool ProcessList_mayMatchFilters(const ProcessList* this, const Process* p) {
+   return ProcessList_filter(this, p, false);
+}
+
+static ProcessGroup* ProcessList_getGroup(ProcessList* this, const char* key) {
+   const ht_key_t hash = ProcessGroup_hash(key);
+   ProcessGroup* head = (ProcessGroup*) Hashtable_get(this->groupTable, hash);
+   for (ProcessGroup* group = head; group; group = group->next) {
+      if (String_eq(group->key, key))
+         return group;
+   }
+
+   ProcessGroup* group = ProcessGroup_new(this, key, hash);
+   ProcessGroup_reset(group);
+   group->next = head;
+   Hashtable_put(this->groupTable, hash, group);
+   Vector_add(this->groups, group);
+   return group;
+}
+
+static void ProcessList_removeGroup(ProcessList* this, int idx) {
+   ProcessGroup* group = (ProcessGroup*) Vector_get(this->groups, idx);
+   ProcessGroup* head = (ProcessGroup*) Hashtable_get(this->groupTable, group->hash);
+   if (head == group) {
+      if (group->next)
+         Hashtable_put(this->groupTable, group->hash, group->next);
+      else
+         Hashtable_remove(this->groupTable, group->hash);
+   } else {
+      ProcessGroup* prev = head;
+      while (prev->next != group)
+         prev = prev->next;
+      prev->next = group->next;
+   }
+   Vector_remove(this->groups, idx);
+}
+
+/* Hash aggregation of the displayed processes by the value of the grouping
+ * column. Groups persist across rebuilds to keep their expanded state. */
+static void ProcessList_buildGroups(ProcessList* this) {
+   const ProcessField groupBy = this->settings->groupBy;
+   if (groupBy != this->groupedBy) {
+      Hashtable_clear(this->groupTable);
+      Vector_prune(this->groups);
+      this->groupedBy = groupBy;
+   }
+
+   for (int i = 0; i < Vector_size(this->groups); i++)
+      ProcessGroup_reset((ProcessGroup*) Vector_get(this->groups, i));
+
+   char buffer[32];
+   for (int i = 0; i < Vector_size(this->processes); i++) {
+      Process* p = (Process*) Vector_get(this->processes, i);
+      p->inView = true;
+
+      if (!p->show || !ProcessList_matchesFilters(this, p))
+         continue;
+
+      ProcessFieldValue value;
+      const char* key = ProcessGroup_keyOf(p, groupBy, &value, buffer, sizeof(buffer));
+      ProcessGroup_add(ProcessList_getGroup(this, key), p);
+   }
+
+   for (int i = Vector_size(this->groups) - 1; i >= 0; i--) {
+      const ProcessGroup* group = (const ProcessGroup*) Vector_get(this->groups, i);
+      if (!group->updated)
+         ProcessList_removeGroup(this, i);
+   }
+
+   Vector_quickSort(this->groups);
+}
+
+static void ProcessList_setRow(ProcessList* this, int idx, Process* p, bool* foundFollowed, int currScrollV) {
+   Panel_set(this->panel, idx, (Object*)p);
+
+   if (this->following != -1 && p->pid == this->following) {
+      *foundFollowed = true;
+      Panel_setSelected(this->panel, idx);
+      this->panel->scrollV = currScrollV;
+   }
+}
+
+void ProcessList_rebuildPanel(ProcessList* this) {
    const int currPos = Panel_getSelectedIndex(this->panel);
    const int currScrollV = this->panel->scrollV;
    const int currSize = Panel_size(this->panel);
@@ -540,27 +664,37 @@ void ProcessList_rebuildPanel(ProcessList* this) {
       }
    }
 
-   const int processCount = Vector_size(this->processes);
    int idx = 0;
    bool foundFollowed = false;
 
-   for (int i = 0; i < processCount; i++) {
-      Process* p = (Process*) Vector_get(this->processes, i);
+   if (settings->groupBy) {
+      ProcessList_buildGroups(this);
 
-      if ( (!p->show)
-         || (this->userId != (uid_t) -1 && (p->st_uid != this->userId))
-         || (incFilter && !(String_contains_i(Process_getCommand(p), incFilter)))
-         || (this->pidMatchList && !Hashtable_get(this->pidMatchList, p->tgid)) )
-         continue;
+      for (int i = 0; i < Vector_size(this->groups); i++) {
+         ProcessGroup* group = (ProcessGroup*) Vector_get(this->groups, i);
+         ProcessList_setRow(this, idx++, (Process*)group, &foundFollowed, currScrollV);
+         if (!group->super.showChildren)
+            continue;
+
+         for (int j = 0; j < Vector_size(group->members); j++)
+            ProcessList_setRow(this, idx++, (Process*) Vector_get(group->members, j), &foundFollowed, currScrollV);
+      }
+   } else {
+      /* Rows around the visible window for which a lazy scan keeps collecting data */
+      const int viewMargin = this->panel->h;
+      const int viewFirst = currScrollV - viewMargin;
+      const int viewLast = currScrollV + this->panel->h + viewMargin;
+
+      for (int i = 0; i < Vector_size(this->processes); i++) {
+         Process* p = (Process*) Vector_get(this->processes, i);
+         p->inView = false;
 
-      Panel_set(this->panel, idx, (Object*)p);
+         if (!p->show || !ProcessList_matchesFilters(this, p))
+            continue;
 
-      if (this->following != -1 && p->pid == this->following) {
-         foundFollowed = true;
-         Panel_setSelected(this->panel, idx);
-         this->panel->scrollV = currScrollV;
+         p->inView = idx >= viewFirst && idx < viewLast;
+         ProcessList_setRow(this, idx++, p, &foundFollowed, currScrollV);
       }
-      idx++;
    }
 
    if (this->following != -1 && !foundFollowed) {
@@ -597,7 +731,8 @@ Process* ProcessList_getProcess(ProcessList* this, pid_t pid, bool* preExisting,
 void ProcessList_scan(ProcessList* this, bool pauseProcessUpdate) {
    // in pause mode only gather global data for meters (CPU/memory/...)
    if (pauseProcessUpdate) {
-      ProcessList_goThroughEntries(this, true);
+      if (!this->replay)
+         ProcessList_goThroughEntries(this, true);
       return;
    }
 
@@ -614,6 +749,12 @@ void ProcessList_scan(ProcessList* this, bool pauseProcessUpdate) {
    this->kernelThreads = 0;
    this->runningTasks = 0;
 
+   // sorting by a column backed by an optional collector needs it for every
+   // process, and so do the aggregates of grouped rows
+   const ProcessField sortKey = Settings_getActiveSortKey(this->settings);
+   this->lazyScan = this->settings->collectVisibleOnly &&
+                    !this->settings->groupBy &&
+                    !(sortKey < LAST_PROCESSFIELD && Process_fields[sortKey].flags);
 
    // set scan timestamp
    static bool firstScanDone = false;
@@ -624,7 +765,10 @@ void ProcessList_scan(ProcessList* this, bool pauseProcessUpdate) {
       firstScanDone = true;
    }
 
-   ProcessList_goThroughEntries(this, false);
+   if (this->replay)
+      Replay_goThroughEntries(this->replay, this);
+   else
+      ProcessList_goThroughEntries(this, false);
 
    for (int i = Vector_size(this->processes) - 1; i >= 0; i--) {
       Process* p = (Process*) Vector_get(this->processes, i);
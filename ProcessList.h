@@ -19,6 +19,7 @@ in the source distribution for its full text.
 #include "Object.h"
 #include "Panel.h"
 #include "Process.h"
+#include "ProcessFilter.h"
 #include "RichString.h"
 #include "Settings.h"
 #include "UsersTable.h"
@@ -51,6 +52,10 @@ typedef struct ProcessList_ {
    Hashtable* displayTreeSet;
    Hashtable* draftingTreeSet;
 
+   Vector* groups;            /* ProcessGroup rows when grouping by a column */
+   Hashtable* groupTable;     /* groups by hash of their value */
+   ProcessField groupedBy;    /* column the groups were built for */
+
    Hashtable* dynamicMeters;  /* runtime-discovered meters */
    Hashtable* dynamicColumns; /* runtime-discovered Columns */
 
@@ -61,8 +66,10 @@ typedef struct ProcessList_ {
    Panel* panel;
    int following;
    uid_t userId;
-   const char* incFilter;
+   ProcessFilter* incFilter;
    Hashtable* pidMatchList;
+   bool lazyScan;             /* only processes in view get expensive data collected */
+   struct Replay_* replay;    /* recording scanned instead of the platform, if any */
 
    #ifdef HAVE_LIBHWLOC
    hwloc_topology_t topology;
@@ -102,6 +109,9 @@ void ProcessList_done(ProcessList* this);
 
 void ProcessList_setPanel(ProcessList* this, Panel* panel);
 
+/* For processes not created by the platform, only while the list is empty */
+void ProcessList_setProcessClass(ProcessList* this, const ObjectClass* klass);
+
 void ProcessList_printHeader(const ProcessList* this, RichString* header);
 
 void ProcessList_add(ProcessList* this, Process* p);
@@ -120,10 +130,32 @@ void ProcessList_rebuildPanel(ProcessList* this);
 
 Process* ProcessList_getProcess(ProcessList* this, pid_t pid, bool* preExisting, Process_New constructor);
 
+void ProcessList_setFilter(ProcessList* this, const char* filter);
+
+bool ProcessList_matchesFilters(const ProcessList* this, const Process* p);
+
+bool ProcessList_mayMatchFilters(const ProcessList* this, const Process* p);
+
 void ProcessList_scan(ProcessList* this, bool pauseProcessUpdate);
 
 static inline Process* ProcessList_findProcess(ProcessList* this, pid_t pid) {
    return (Process*) Hashtable_get(this->processTable, pid);
 }
 
+/* Optional data to gather: that of the displayed columns, of the fields the
+ * filter refers to and of the column the list is grouped by */
+static inline uint32_t ProcessList_scanFlags(const ProcessList* this) {
+   const ProcessField groupBy = this->settings->groupBy;
+   return this->settings->flags |
+          (this->incFilter ? this->incFilter->flags : 0) |
+          (groupBy > 0 && groupBy < LAST_PROCESSFIELD ? Process_fields[groupBy].flags : 0);
+}
+
+/* Whether platform code should run expensive collectors (smaps, io, ...) for
+ * this process during the current scan. Relies on data read from cheap
+ * sources (stat, status, cmdline) already being up to date. */
+static inline bool ProcessList_wantsDetails(const ProcessList* this, const Process* p) {
+   return ProcessList_mayMatchFilters(this, p) && (!this->lazyScan || p->inView);
+}
+
 #endif
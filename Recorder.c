@@ -0,0 +1,643 @@
+/*
+htop - Recorder.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "Recorder.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CPUMeter.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Object.h"
+#include "Process.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+/* Samples between keyframes, the most a seek has to decode */
+#define RECORD_KEYFRAME_INTERVAL 60
+
+const char* const Recorder_coreColumnNames[RECORD_CORE_COLUMN_COUNT] = {
+   [RECORD_PPID] = "ppid",
+   [RECORD_TGID] = "tgid",
+   [RECORD_PGRP] = "pgrp",
+   [RECORD_SESSION] = "session",
+   [RECORD_TPGID] = "tpgid",
+   [RECORD_TTY_NR] = "tty_nr",
+   [RECORD_ST_UID] = "st_uid",
+   [RECORD_STATE] = "state",
+   [RECORD_FLAGS] = "flags",
+   [RECORD_PRIORITY] = "priority",
+   [RECORD_NICE] = "nice",
+   [RECORD_NLWP] = "nlwp",
+   [RECORD_PROCESSOR] = "processor",
+   [RECORD_PERCENT_CPU] = "percent_cpu",
+   [RECORD_PERCENT_MEM] = "percent_mem",
+   [RECORD_TIME] = "time",
+   [RECORD_STARTTIME] = "starttime",
+   [RECORD_M_VIRT] = "m_virt",
+   [RECORD_M_RESIDENT] = "m_resident",
+   [RECORD_MINFLT] = "minflt",
+   [RECORD_MAJFLT] = "majflt",
+   [RECORD_CMDLINE_BASENAME_START] = "cmdline_basename_start",
+   [RECORD_CMDLINE_BASENAME_END] = "cmdline_basename_end",
+   [RECORD_EXE_BASENAME_OFFSET] = "exe_basename_offset",
+   [RECORD_USER] = "user",
+   [RECORD_TTY_NAME] = "tty_name",
+   [RECORD_CMDLINE] = "cmdline",
+   [RECORD_COMM] = "comm",
+   [RECORD_EXE] = "exe",
+   [RECORD_CWD] = "cwd",
+};
+
+/* Fields which are shown from the core columns alone */
+static const ProcessField Recorder_coreFields[] = {
+   PID, COMM, STATE, PPID, PGRP, SESSION, TTY, TPGID, MINFLT, MAJFLT,
+   PRIORITY, NICE, STARTTIME, PROCESSOR, M_VIRT, M_RESIDENT, ST_UID,
+   PERCENT_CPU, PERCENT_MEM, USER, TIME, NLWP, TGID, PERCENT_NORM_CPU,
+   ELAPSED, PROC_COMM, PROC_EXE, CWD,
+};
+
+/* Numbers of extra columns are kept with two decimals */
+#define RECORD_EXTRA_SCALE 100
+
+int64_t Record_scale(double value, unsigned int scale) {
+   if (isnan(value))
+      return RECORD_NAN;
+
+   double scaled = value * scale;
+   if (scaled >= 9.2e18)
+      return INT64_MAX;
+   if (scaled <= -9.2e18)
+      return INT64_MIN + 1;
+   return llround(scaled);
+}
+
+double Record_unscale(int64_t value, unsigned int scale) {
+   if (value == RECORD_NAN)
+      return NAN;
+
+   return scale == 1 ? (double)value : (double)value / scale;
+}
+
+ht_key_t Record_hashString(const char* value, size_t length) {
+   /* FNV-1a */
+   ht_key_t hash = 2166136261U;
+   for (size_t i = 0; i < length; i++) {
+      hash ^= (unsigned char)value[i];
+      hash *= 16777619U;
+   }
+   return hash;
+}
+
+static inline int64_t Record_delta(int64_t value, int64_t previous) {
+   /* wraps around for the NAN marker, undone by the same addition */
+   return (int64_t)((uint64_t)value - (uint64_t)previous);
+}
+
+/* ---------------------------------------------------------------------- */
+
+static void RecordBuffer_reserve(RecordBuffer* this, size_t more) {
+   if (this->size + more <= this->allocd)
+      return;
+
+   this->allocd = MAXIMUM(this->allocd * 2, this->size + more + 256);
+   this->data = xRealloc(this->data, this->allocd);
+}
+
+static void RecordBuffer_putByte(RecordBuffer* this, unsigned char value) {
+   RecordBuffer_reserve(this, 1);
+   this->data[this->size++] = value;
+}
+
+static void RecordBuffer_putBytes(RecordBuffer* this, const void* value, size_t length) {
+   RecordBuffer_reserve(this, length);
+   memcpy(this->data + this->size, value, length);
+   this->size += length;
+}
+
+static void RecordBuffer_putVarint(RecordBuffer* this, uint64_t value) {
+   RecordBuffer_reserve(this, 10);
+   while (value >= 0x80) {
+      this->data[this->size++] = (unsigned char)(value | 0x80);
+      value >>= 7;
+   }
+   this->data[this->size++] = (unsigned char)value;
+}
+
+static void RecordBuffer_putSigned(RecordBuffer* this, int64_t value) {
+   RecordBuffer_putVarint(this, Record_zigzag(value));
+}
+
+static void RecordBuffer_putString(RecordBuffer* this, const char* value) {
+   size_t length = strlen(value);
+   RecordBuffer_putVarint(this, length);
+   RecordBuffer_putBytes(this, value, length);
+}
+
+static void RecordBuffer_putUint64(RecordBuffer* this, uint64_t value) {
+   unsigned char bytes[8];
+   for (int i = 0; i < 8; i++)
+      bytes[i] = (unsigned char)(value >> (8 * i));
+   RecordBuffer_putBytes(this, bytes, sizeof(bytes));
+}
+
+/* ---------------------------------------------------------------------- */
+
+static void RecordStrings_clear(RecordStrings* this) {
+   for (uint32_t i = 0; i < this->count; i++)
+      free(this->strings[i].value);
+   this->count = 0;
+   Hashtable_clear(this->byHash);
+}
+
+/* Reference to an interned string, as written in the file */
+static uint64_t RecordStrings_intern(RecordStrings* this, const char* value) {
+   if (!value)
+      return 0;
+
+   size_t length = strlen(value);
+   ht_key_t hash = Record_hashString(value, length);
+   uintptr_t first = (uintptr_t)Hashtable_get(this->byHash, hash);
+   for (uintptr_t ref = first; ref; ref = this->strings[ref - 1].next) {
+      if (String_eq(this->strings[ref - 1].value, value))
+         return ref;
+   }
+
+   if (this->count == this->allocd) {
+      this->allocd = this->allocd ? this->allocd * 2 : 256;
+      this->strings = xReallocArray(this->strings, this->allocd, sizeof(RecordString));
+   }
+
+   RecordString* string = &this->strings[this->count++];
+   string->value = xStrndup(value, length);
+   string->hash = hash;
+   string->next = (uint32_t)first;
+   Hashtable_put(this->byHash, hash, (void*)(uintptr_t)this->count);
+   return this->count;
+}
+
+/* ---------------------------------------------------------------------- */
+
+static bool Recorder_writeChunk(Recorder* this, char type, const RecordBuffer* payload) {
+   unsigned char head[5] = { (unsigned char)type };
+   for (int i = 0; i < 4; i++)
+      head[1 + i] = (unsigned char)(payload->size >> (8 * i));
+
+   if (fwrite(head, sizeof(head), 1, this->file) != 1)
+      return false;
+   if (payload->size && fwrite(payload->data, payload->size, 1, this->file) != 1)
+      return false;
+
+   this->offset += sizeof(head) + payload->size;
+   return true;
+}
+
+static bool Recorder_openFile(Recorder* this) {
+   this->file = fopen(this->filename, "wb");
+   if (!this->file)
+      return false;
+
+   if (fwrite(RECORD_MAGIC, RECORD_MAGIC_SIZE, 1, this->file) != 1) {
+      int err = errno;
+      fclose(this->file);
+      this->file = NULL;
+      errno = err;
+      return false;
+   }
+
+   this->offset = RECORD_MAGIC_SIZE;
+   this->indexCount = 0;
+   this->needsHeader = true;
+   this->sinceKeyframe = 0;
+   return true;
+}
+
+static bool Recorder_closeFile(Recorder* this) {
+   if (!this->file)
+      return true;
+
+   RecordBuffer* buffer = &this->chunk;
+   buffer->size = 0;
+   for (size_t i = 0; i < this->indexCount; i++) {
+      RecordBuffer_putUint64(buffer, this->index[i].realtimeMs);
+      RecordBuffer_putUint64(buffer, this->index[i].offset);
+   }
+
+   uint64_t indexOffset = this->offset;
+   bool ok = Recorder_writeChunk(this, RECORD_CHUNK_INDEX, buffer);
+   if (ok) {
+      buffer->size = 0;
+      RecordBuffer_putUint64(buffer, indexOffset);
+      RecordBuffer_putBytes(buffer, RECORD_INDEX_MAGIC, RECORD_MAGIC_SIZE);
+      ok = fwrite(buffer->data, buffer->size, 1, this->file) == 1;
+   }
+
+   ok = (fclose(this->file) == 0) && ok;
+   this->file = NULL;
+   return ok;
+}
+
+static bool Recorder_rotate(Recorder* this) {
+   if (!Recorder_closeFile(this))
+      return false;
+
+   char* rotated;
+   xAsprintf(&rotated, "%s.1", this->filename);
+   int res = rename(this->filename, rotated);
+   free(rotated);
+   if (res != 0)
+      return false;
+
+   return Recorder_openFile(this);
+}
+
+bool Recorder_isCoreField(ProcessField field) {
+   for (size_t i = 0; i < ARRAYSIZE(Recorder_coreFields); i++) {
+      if (Recorder_coreFields[i] == field)
+         return true;
+   }
+   return false;
+}
+
+static void Recorder_chooseColumns(Recorder* this, const ProcessList* pl) {
+   free(this->columns);
+   this->columns = xCalloc(RECORD_CORE_COLUMN_COUNT + LAST_PROCESSFIELD, sizeof(RecordColumn));
+   this->columnCount = 0;
+
+   for (int i = 0; i < RECORD_CORE_COLUMN_COUNT; i++) {
+      RecordColumn* column = &this->columns[this->columnCount++];
+      column->kind = i >= RECORD_USER ? RECORD_STRING : RECORD_NUMBER;
+      column->scale = (i == RECORD_PERCENT_CPU || i == RECORD_PERCENT_MEM) ? 100 : 1;
+   }
+
+   /* the configured platform columns, typed by their values */
+   const Process* sample = Vector_size(pl->processes) ? (const Process*)Vector_get(pl->processes, 0) : NULL;
+   for (const ProcessField* field = this->settings->fields; *field; field++) {
+      if (*field >= LAST_PROCESSFIELD || !Process_fields[*field].name || Recorder_isCoreField(*field))
+         continue;
+
+      bool seen = false;
+      for (size_t i = RECORD_CORE_COLUMN_COUNT; i < this->columnCount; i++)
+         seen |= this->columns[i].field == *field;
+
+      ProcessFieldValue value;
+      if (seen || !sample || !Process_getFieldValue(sample, *field, &value))
+         continue;
+
+      RecordColumn* column = &this->columns[this->columnCount++];
+      column->field = *field;
+      column->kind = value.string ? RECORD_STRING : RECORD_NUMBER;
+      column->scale = RECORD_EXTRA_SCALE;
+   }
+}
+
+static void Recorder_setupMeters(Recorder* this) {
+   free(this->meterOffsets);
+   free(this->meterValues);
+
+   this->meterCount = 0;
+   this->slotCount = 0;
+   Header_forEachColumn(this->header, col) {
+      const Vector* meters = this->header->columns[col];
+      for (int i = 0; i < Vector_size(meters); i++) {
+         int subCount;
+         CPUMeter_getSubMeters((const Meter*) Vector_get(meters, i), &subCount);
+         this->meterCount++;
+         this->slotCount += 1 + subCount;
+      }
+   }
+
+   this->meterOffsets = xCalloc(this->slotCount + 1, sizeof(size_t));
+   size_t slot = 0;
+   Header_forEachColumn(this->header, col) {
+      const Vector* meters = this->header->columns[col];
+      for (int i = 0; i < Vector_size(meters); i++) {
+         const Meter* meter = (const Meter*) Vector_get(meters, i);
+         this->meterOffsets[slot + 1] = this->meterOffsets[slot] + 1 + As_Meter(meter)->maxItems;
+         slot++;
+
+         int subCount;
+         Meter* const* subMeters = CPUMeter_getSubMeters(meter, &subCount);
+         for (int j = 0; j < subCount; j++, slot++)
+            this->meterOffsets[slot + 1] = this->meterOffsets[slot] + 1 + As_Meter(subMeters[j])->maxItems;
+      }
+   }
+   this->meterValues = xCalloc(this->meterOffsets[this->slotCount] + 1, sizeof(int64_t));
+}
+
+static bool Recorder_writeHeader(Recorder* this, const ProcessList* pl) {
+   Recorder_chooseColumns(this, pl);
+   Recorder_setupMeters(this);
+
+   RecordBuffer* buffer = &this->chunk;
+   buffer->size = 0;
+   RecordBuffer_putVarint(buffer, (uint64_t)this->settings->delay * 100);
+   RecordBuffer_putVarint(buffer, this->header->headerLayout);
+
+   RecordBuffer_putVarint(buffer, this->columnCount);
+   for (size_t i = 0; i < this->columnCount; i++) {
+      const RecordColumn* column = &this->columns[i];
+      RecordBuffer_putVarint(buffer, column->field);
+      RecordBuffer_putString(buffer, column->field ? Process_fields[column->field].name : Recorder_coreColumnNames[i]);
+      RecordBuffer_putByte(buffer, (unsigned char)column->kind);
+      RecordBuffer_putVarint(buffer, column->scale);
+   }
+
+   RecordBuffer_putVarint(buffer, this->meterCount);
+   Header_forEachColumn(this->header, col) {
+      const Vector* meters = this->header->columns[col];
+      const MeterColumnSetting* colSettings = &this->settings->hColumns[col];
+      for (int i = 0; i < Vector_size(meters); i++) {
+         const Meter* meter = (const Meter*) Vector_get(meters, i);
+         /* the settings name carries the parameter, e.g. "CPU(1)" */
+         bool named = colSettings->len == Vector_size(meters) && colSettings->names;
+         RecordBuffer_putVarint(buffer, col);
+         RecordBuffer_putString(buffer, named ? colSettings->names[i] : Meter_name(meter));
+         RecordBuffer_putVarint(buffer, (uint64_t)meter->mode);
+      }
+   }
+
+   this->needsHeader = false;
+   return Recorder_writeChunk(this, RECORD_CHUNK_HEADER, buffer);
+}
+
+Recorder* Recorder_new(const char* filename, uint64_t maxSize, const Settings* settings, const Header* header) {
+   Recorder* this = xCalloc(1, sizeof(Recorder));
+   this->filename = xStrdup(filename);
+   this->maxSize = maxSize;
+   this->settings = settings;
+   this->header = header;
+   this->keyframeInterval = RECORD_KEYFRAME_INTERVAL;
+   this->strings.byHash = Hashtable_new(1024, false);
+   this->previous = Hashtable_new(1024, true);
+
+   if (!Recorder_openFile(this)) {
+      int err = errno;
+      Recorder_delete(this);
+      errno = err;
+      return NULL;
+   }
+
+   return this;
+}
+
+void Recorder_delete(Recorder* this) {
+   Recorder_closeFile(this);
+
+   RecordStrings_clear(&this->strings);
+   free(this->strings.strings);
+   Hashtable_delete(this->strings.byHash);
+   Hashtable_delete(this->previous);
+   free(this->columns);
+   free(this->meterValues);
+   free(this->meterOffsets);
+   free(this->index);
+   free(this->chunk.data);
+   free(this->body.data);
+   free(this->filename);
+   free(this);
+}
+
+static int64_t Recorder_coreValue(Recorder* this, const Process* p, RecordCoreColumn column) {
+   switch (column) {
+   case RECORD_PPID: return p->ppid;
+   case RECORD_TGID: return p->tgid;
+   case RECORD_PGRP: return p->pgrp;
+   case RECORD_SESSION: return p->session;
+   case RECORD_TPGID: return p->tpgid;
+   case RECORD_TTY_NR: return (int64_t)p->tty_nr;
+   case RECORD_ST_UID: return p->st_uid;
+   case RECORD_STATE: return p->state;
+   case RECORD_FLAGS:
+      return (p->isKernelThread ? RECORD_FLAG_KERNEL_THREAD : 0) |
+             (p->isUserlandThread ? RECORD_FLAG_USERLAND_THREAD : 0) |
+             (p->procExeDeleted ? RECORD_FLAG_EXE_DELETED : 0) |
+             (p->usesDeletedLib ? RECORD_FLAG_DELETED_LIB : 0);
+   case RECORD_PRIORITY: return p->priority;
+   case RECORD_NICE: return p->nice;
+   case RECORD_NLWP: return p->nlwp;
+   case RECORD_PROCESSOR: return p->processor;
+   case RECORD_PERCENT_CPU: return Record_scale(p->percent_cpu, 100);
+   case RECORD_PERCENT_MEM: return Record_scale(p->percent_mem, 100);
+   case RECORD_TIME: return (int64_t)p->time;
+   case RECORD_STARTTIME: return p->starttime_ctime;
+   case RECORD_M_VIRT: return p->m_virt;
+   case RECORD_M_RESIDENT: return p->m_resident;
+   case RECORD_MINFLT: return (int64_t)p->minflt;
+   case RECORD_MAJFLT: return (int64_t)p->majflt;
+   case RECORD_CMDLINE_BASENAME_START: return p->cmdlineBasenameStart;
+   case RECORD_CMDLINE_BASENAME_END: return p->cmdlineBasenameEnd;
+   case RECORD_EXE_BASENAME_OFFSET: return p->procExeBasenameOffset;
+   case RECORD_USER: return (int64_t)RecordStrings_intern(&this->strings, p->user);
+   case RECORD_TTY_NAME: return (int64_t)RecordStrings_intern(&this->strings, p->tty_name);
+   case RECORD_CMDLINE: return (int64_t)RecordStrings_intern(&this->strings, p->cmdline);
+   case RECORD_COMM: return (int64_t)RecordStrings_intern(&this->strings, p->procComm);
+   case RECORD_EXE: return (int64_t)RecordStrings_intern(&this->strings, p->procExe);
+   case RECORD_CWD: return (int64_t)RecordStrings_intern(&this->strings, p->procCwd);
+   default:
+      return 0;
+   }
+}
+
+static int64_t Recorder_columnValue(Recorder* this, const Process* p, size_t i) {
+   const RecordColumn* column = &this->columns[i];
+   if (!column->field)
+      return Recorder_coreValue(this, p, (RecordCoreColumn)i);
+
+   ProcessFieldValue value;
+   if (!Process_getFieldValue(p, column->field, &value))
+      return column->kind == RECORD_STRING ? 0 : RECORD_NAN;
+
+   if (column->kind == RECORD_STRING)
+      return (int64_t)RecordStrings_intern(&this->strings, value.string ? value.string : "");
+
+   return Record_scale(value.string ? NAN : value.number, column->scale);
+}
+
+static int Recorder_comparePids(const void* v1, const void* v2) {
+   const Process* p1 = *(const Process* const*)v1;
+   const Process* p2 = *(const Process* const*)v2;
+   return SPACESHIP_NUMBER(p1->pid, p2->pid);
+}
+
+static void Recorder_encodeProcesses(Recorder* this, const ProcessList* pl) {
+   RecordBuffer* body = &this->body;
+
+   int count = Vector_size(pl->processes);
+   const Process** sorted = xMallocArray(MAXIMUM(count, 1), sizeof(Process*));
+   int live = 0;
+   for (int i = 0; i < count; i++) {
+      const Process* p = (const Process*) Vector_get(pl->processes, i);
+      /* tombed processes are already gone */
+      if (p->tombStampMs == 0)
+         sorted[live++] = p;
+   }
+   qsort(sorted, live, sizeof(Process*), Recorder_comparePids);
+
+   const size_t bitmapSize = (this->columnCount + 7) / 8;
+   unsigned char bitmap[(RECORD_CORE_COLUMN_COUNT + LAST_PROCESSFIELD + 7) / 8];
+   int64_t values[RECORD_CORE_COLUMN_COUNT + LAST_PROCESSFIELD];
+
+   RecordBuffer_putVarint(body, (uint64_t)live);
+   pid_t lastPid = 0;
+   for (int n = 0; n < live; n++) {
+      const Process* p = sorted[n];
+
+      /* last values written for the pid, one per column */
+      int64_t* previous = Hashtable_get(this->previous, (ht_key_t)p->pid);
+      if (!previous) {
+         previous = xCalloc(this->columnCount, sizeof(int64_t));
+         Hashtable_put(this->previous, (ht_key_t)p->pid, previous);
+      }
+
+      bool changed = false;
+      memset(bitmap, 0, bitmapSize);
+      for (size_t i = 0; i < this->columnCount; i++) {
+         values[i] = Recorder_columnValue(this, p, i);
+         if (values[i] != previous[i]) {
+            bitmap[i / 8] |= (unsigned char)(1 << (i % 8));
+            changed = true;
+         }
+      }
+
+      RecordBuffer_putVarint(body, ((uint64_t)(p->pid - lastPid) << 1) | (changed ? 1 : 0));
+      lastPid = p->pid;
+      if (!changed)
+         continue;
+
+      RecordBuffer_putBytes(body, bitmap, bitmapSize);
+      for (size_t i = 0; i < this->columnCount; i++) {
+         if (!(bitmap[i / 8] & (1 << (i % 8))))
+            continue;
+
+         if (this->columns[i].kind == RECORD_STRING)
+            RecordBuffer_putVarint(body, (uint64_t)values[i]);
+         else
+            RecordBuffer_putSigned(body, Record_delta(values[i], previous[i]));
+         previous[i] = values[i];
+      }
+   }
+
+   free(sorted);
+}
+
+static void Recorder_encodeMeter(Recorder* this, const Meter* meter, size_t slot) {
+   RecordBuffer* body = &this->body;
+   int64_t* previous = &this->meterValues[this->meterOffsets[slot]];
+   unsigned int items = MINIMUM(meter->curItems, As_Meter(meter)->maxItems);
+
+   RecordBuffer_putVarint(body, items);
+   int64_t total = Record_scale(meter->total, 100);
+   RecordBuffer_putSigned(body, Record_delta(total, previous[0]));
+   previous[0] = total;
+   for (unsigned int j = 0; j < items; j++) {
+      int64_t value = Record_scale(meter->values[j], 100);
+      RecordBuffer_putSigned(body, Record_delta(value, previous[1 + j]));
+      previous[1 + j] = value;
+   }
+   RecordBuffer_putVarint(body, RecordStrings_intern(&this->strings, meter->txtBuffer));
+}
+
+static void Recorder_encodeMeters(Recorder* this) {
+   RecordBuffer_putVarint(&this->body, this->meterCount);
+   size_t slot = 0;
+   Header_forEachColumn(this->header, col) {
+      const Vector* meters = this->header->columns[col];
+      for (int i = 0; i < Vector_size(meters); i++) {
+         const Meter* meter = (const Meter*) Vector_get(meters, i);
+         Recorder_encodeMeter(this, meter, slot++);
+
+         int subCount;
+         Meter* const* subMeters = CPUMeter_getSubMeters(meter, &subCount);
+         RecordBuffer_putVarint(&this->body, (uint64_t)subCount);
+         for (int j = 0; j < subCount; j++)
+            Recorder_encodeMeter(this, subMeters[j], slot++);
+      }
+   }
+}
+
+static void Recorder_encodeGlobals(Recorder* this, const ProcessList* pl) {
+   const int64_t globals[RECORD_GLOBAL_COUNT] = {
+      [RECORD_TOTAL_TASKS] = pl->totalTasks,
+      [RECORD_RUNNING_TASKS] = pl->runningTasks,
+      [RECORD_USERLAND_THREADS] = pl->userlandThreads,
+      [RECORD_KERNEL_THREADS] = pl->kernelThreads,
+      [RECORD_TOTAL_MEM] = (int64_t)pl->totalMem,
+      [RECORD_USED_MEM] = (int64_t)pl->usedMem,
+      [RECORD_BUFFERS_MEM] = (int64_t)pl->buffersMem,
+      [RECORD_CACHED_MEM] = (int64_t)pl->cachedMem,
+      [RECORD_SHARED_MEM] = (int64_t)pl->sharedMem,
+      [RECORD_AVAILABLE_MEM] = (int64_t)pl->availableMem,
+      [RECORD_TOTAL_SWAP] = (int64_t)pl->totalSwap,
+      [RECORD_USED_SWAP] = (int64_t)pl->usedSwap,
+      [RECORD_CACHED_SWAP] = (int64_t)pl->cachedSwap,
+      [RECORD_ACTIVE_CPUS] = pl->activeCPUs,
+      [RECORD_EXISTING_CPUS] = pl->existingCPUs,
+   };
+
+   for (int i = 0; i < RECORD_GLOBAL_COUNT; i++) {
+      RecordBuffer_putSigned(&this->body, Record_delta(globals[i], this->globals[i]));
+      this->globals[i] = globals[i];
+   }
+}
+
+bool Recorder_writeSample(Recorder* this, const ProcessList* pl) {
+   if (!this->file)
+      return false;
+
+   if (this->needsHeader && !Recorder_writeHeader(this, pl))
+      return false;
+
+   bool keyframe = this->sinceKeyframe == 0;
+   if (keyframe) {
+      RecordStrings_clear(&this->strings);
+      this->writtenStrings = 0;
+      Hashtable_clear(this->previous);
+      memset(this->globals, 0, sizeof(this->globals));
+      memset(this->meterValues, 0, (this->meterOffsets[this->slotCount] + 1) * sizeof(int64_t));
+   }
+
+   this->body.size = 0;
+   Recorder_encodeGlobals(this, pl);
+   Recorder_encodeMeters(this);
+   Recorder_encodeProcesses(this, pl);
+
+   RecordBuffer* chunk = &this->chunk;
+   chunk->size = 0;
+   RecordBuffer_putVarint(chunk, pl->realtimeMs);
+   RecordBuffer_putByte(chunk, keyframe ? RECORD_SAMPLE_KEYFRAME : 0);
+   RecordBuffer_putVarint(chunk, this->strings.count - this->writtenStrings);
+   for (uint32_t i = this->writtenStrings; i < this->strings.count; i++)
+      RecordBuffer_putString(chunk, this->strings.strings[i].value);
+   this->writtenStrings = this->strings.count;
+   RecordBuffer_putBytes(chunk, this->body.data, this->body.size);
+
+   if (this->indexCount == this->indexAllocd) {
+      this->indexAllocd = this->indexAllocd ? this->indexAllocd * 2 : 1024;
+      this->index = xReallocArray(this->index, this->indexAllocd, sizeof(RecordIndexEntry));
+   }
+   this->index[this->indexCount++] = (RecordIndexEntry) {
+      .realtimeMs = pl->realtimeMs,
+      .offset = this->offset | (keyframe ? RECORD_INDEX_KEYFRAME : 0),
+   };
+
+   if (!Recorder_writeChunk(this, RECORD_CHUNK_SAMPLE, chunk) || fflush(this->file) != 0)
+      return false;
+
+   this->sinceKeyframe = (this->sinceKeyframe + 1) % this->keyframeInterval;
+
+   if (this->maxSize && this->offset >= this->maxSize)
+      return Recorder_rotate(this);
+
+   return true;
+}
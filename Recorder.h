@@ -0,0 +1,241 @@
+#ifndef HEADER_Recorder
+#define HEADER_Recorder
+/*
+htop - Recorder.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Hashtable.h"
+#include "Header.h"
+#include "ProcessList.h"
+#include "Settings.h"
+
+
+/*
+ * Recording file format
+ *
+ * The file starts with the 8 byte magic RECORD_MAGIC, followed by chunks of
+ * a one byte type, a 32 bit little endian payload length and the payload.
+ * Integers in payloads are LEB128 varints, signed ones zigzag encoded;
+ * strings are a varint length and the bytes.
+ *
+ * RECORD_CHUNK_HEADER, first in every file:
+ *    varint update interval (ms), varint header layout
+ *    varint column count, per column: varint field, string name,
+ *       byte kind (RecordColumnKind), varint scale
+ *    varint meter count, per meter: varint header column, string name,
+ *       varint mode
+ *
+ * RECORD_CHUNK_SAMPLE, one per scan:
+ *    varint realtime (ms since the Epoch), byte flags (RECORD_SAMPLE_*)
+ *    varint count of new strings, and the strings; their ids follow the
+ *       ones defined before in the span since the last keyframe
+ *    RECORD_GLOBAL_COUNT deltas of the process list totals
+ *    varint meter count, per meter: varint item count, the deltas of the
+ *       total and the items, the string id of the meter text, and a varint
+ *       count of the per-CPU meters drawn by it, each stored the same way
+ *       but without such a count
+ *    varint process count, per process in ascending pid order: varint pid
+ *       delta, a bitmap of the columns which changed (a bit per column, in
+ *       bytes) and for each of those a delta or a string reference; the
+ *       lowest bit of the pid delta tells whether the bitmap follows, as
+ *       it is left out when nothing changed
+ *
+ * String references are 0 for no string (NULL) and the id plus 1 otherwise.
+ *
+ * Numbers are stored as integers in units of 1/scale, and as deltas to the
+ * value of the same pid, meter or total in the previous sample. A keyframe
+ * resets all previous values to 0 and forgets the interned strings, so that
+ * decoding can start at any keyframe.
+ *
+ * RECORD_CHUNK_INDEX, last in a finished file: per sample a 64 bit realtime
+ * and a 64 bit file offset of its chunk, with RECORD_INDEX_KEYFRAME set for
+ * keyframes, all little endian; the file ends with the 64 bit offset of
+ * this chunk and the magic RECORD_INDEX_MAGIC. A file without it (e.g. of
+ * a killed recorder) can still be read by walking the chunks.
+ */
+
+#define RECORD_MAGIC            "htoprec1"
+#define RECORD_INDEX_MAGIC      "htopidx1"
+#define RECORD_MAGIC_SIZE       8
+
+#define RECORD_CHUNK_HEADER     'H'
+#define RECORD_CHUNK_SAMPLE     'S'
+#define RECORD_CHUNK_INDEX      'I'
+
+#define RECORD_SAMPLE_KEYFRAME  0x01
+
+#define RECORD_INDEX_KEYFRAME   (1ULL << 63)
+
+/* Stands for NAN in scaled numbers */
+#define RECORD_NAN              INT64_MIN
+
+typedef enum RecordColumnKind_ {
+   RECORD_NUMBER,
+   RECORD_STRING,
+} RecordColumnKind;
+
+/* Columns recorded for every process, before those of the configured fields */
+typedef enum RecordCoreColumn_ {
+   RECORD_PPID,
+   RECORD_TGID,
+   RECORD_PGRP,
+   RECORD_SESSION,
+   RECORD_TPGID,
+   RECORD_TTY_NR,
+   RECORD_ST_UID,
+   RECORD_STATE,
+   RECORD_FLAGS,           /* RECORD_FLAG_* */
+   RECORD_PRIORITY,
+   RECORD_NICE,
+   RECORD_NLWP,
+   RECORD_PROCESSOR,
+   RECORD_PERCENT_CPU,
+   RECORD_PERCENT_MEM,
+   RECORD_TIME,
+   RECORD_STARTTIME,
+   RECORD_M_VIRT,
+   RECORD_M_RESIDENT,
+   RECORD_MINFLT,
+   RECORD_MAJFLT,
+   RECORD_CMDLINE_BASENAME_START,
+   RECORD_CMDLINE_BASENAME_END,
+   RECORD_EXE_BASENAME_OFFSET,
+   RECORD_USER,
+   RECORD_TTY_NAME,
+   RECORD_CMDLINE,
+   RECORD_COMM,
+   RECORD_EXE,
+   RECORD_CWD,
+   RECORD_CORE_COLUMN_COUNT
+} RecordCoreColumn;
+
+#define RECORD_FLAG_KERNEL_THREAD   0x01
+#define RECORD_FLAG_USERLAND_THREAD 0x02
+#define RECORD_FLAG_EXE_DELETED     0x04
+#define RECORD_FLAG_DELETED_LIB     0x08
+
+/* Totals of the process list, in this order */
+typedef enum RecordGlobal_ {
+   RECORD_TOTAL_TASKS,
+   RECORD_RUNNING_TASKS,
+   RECORD_USERLAND_THREADS,
+   RECORD_KERNEL_THREADS,
+   RECORD_TOTAL_MEM,
+   RECORD_USED_MEM,
+   RECORD_BUFFERS_MEM,
+   RECORD_CACHED_MEM,
+   RECORD_SHARED_MEM,
+   RECORD_AVAILABLE_MEM,
+   RECORD_TOTAL_SWAP,
+   RECORD_USED_SWAP,
+   RECORD_CACHED_SWAP,
+   RECORD_ACTIVE_CPUS,
+   RECORD_EXISTING_CPUS,
+   RECORD_GLOBAL_COUNT
+} RecordGlobal;
+
+/* Names of the core columns, as stored in the file header */
+extern const char* const Recorder_coreColumnNames[RECORD_CORE_COLUMN_COUNT];
+
+typedef struct RecordColumn_ {
+   ProcessField field;        /* 0 for core columns */
+   RecordColumnKind kind;
+   unsigned int scale;
+} RecordColumn;
+
+typedef struct RecordBuffer_ {
+   unsigned char* data;
+   size_t size;
+   size_t allocd;
+} RecordBuffer;
+
+typedef struct RecordString_ {
+   char* value;
+   ht_key_t hash;
+   uint32_t next;             /* id + 1 of the next string with the same hash */
+} RecordString;
+
+/* Interned strings of the current keyframe span */
+typedef struct RecordStrings_ {
+   RecordString* strings;
+   uint32_t count;
+   uint32_t allocd;
+   Hashtable* byHash;         /* id + 1 of the first string by hash, not owned */
+} RecordStrings;
+
+typedef struct RecordIndexEntry_ {
+   uint64_t realtimeMs;
+   uint64_t offset;           /* RECORD_INDEX_KEYFRAME set for keyframes */
+} RecordIndexEntry;
+
+typedef struct Recorder_ {
+   char* filename;
+   FILE* file;
+   uint64_t offset;           /* of the next chunk in the current file */
+   uint64_t maxSize;          /* rotate to <filename>.1 beyond it, 0 for no limit */
+
+   const Settings* settings;
+   const Header* header;
+
+   RecordColumn* columns;     /* chosen at the first sample of each file */
+   size_t columnCount;
+   bool needsHeader;
+
+   unsigned int keyframeInterval;
+   unsigned int sinceKeyframe;
+
+   RecordStrings strings;
+   uint32_t writtenStrings;   /* interned strings already defined in the file */
+
+   Hashtable* previous;       /* last values by pid */
+   int64_t globals[RECORD_GLOBAL_COUNT];
+   int64_t* meterValues;      /* last total and items of all meters */
+   size_t* meterOffsets;      /* of each meter in meterValues, per-CPU ones after theirs */
+   size_t meterCount;         /* without the per-CPU meters */
+   size_t slotCount;          /* with them */
+
+   RecordIndexEntry* index;
+   size_t indexCount;
+   size_t indexAllocd;
+
+   RecordBuffer chunk;
+   RecordBuffer body;
+} Recorder;
+
+/* NULL with errno set if the file can not be created */
+Recorder* Recorder_new(const char* filename, uint64_t maxSize, const Settings* settings, const Header* header);
+
+/* Finishes the file with its index */
+void Recorder_delete(Recorder* this);
+
+/* Appends the current state of the process list and the header meters */
+bool Recorder_writeSample(Recorder* this, const ProcessList* pl);
+
+/* Helpers shared with the reading side */
+
+/* Whether the field is shown from the core columns alone */
+bool Recorder_isCoreField(ProcessField field);
+
+static inline uint64_t Record_zigzag(int64_t value) {
+   return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static inline int64_t Record_unzigzag(uint64_t value) {
+   return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+int64_t Record_scale(double value, unsigned int scale);
+
+double Record_unscale(int64_t value, unsigned int scale);
+
+ht_key_t Record_hashString(const char* value, size_t length);
+
+#endif
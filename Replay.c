@@ -0,0 +1,967 @@
+/*
+htop - Replay.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "Replay.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include "CPUMeter.h"
+#include "CRT.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Object.h"
+#include "Platform.h"
+#include "RichString.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+/* Playback speeds cycle up to this factor */
+#define REPLAY_MAX_SPEED 64
+
+/* Seeking steps */
+#define REPLAY_SEEK_MS (60 * 1000)
+
+typedef struct ReplayReader_ {
+   const unsigned char* at;
+   const unsigned char* end;
+   bool failed;
+} ReplayReader;
+
+static uint64_t ReplayReader_varint(ReplayReader* this) {
+   uint64_t value = 0;
+   for (unsigned int shift = 0; shift < 64; shift += 7) {
+      if (this->at >= this->end)
+         break;
+
+      unsigned char byte = *this->at++;
+      value |= (uint64_t)(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+         return value;
+   }
+
+   this->failed = true;
+   return 0;
+}
+
+static int64_t ReplayReader_signed(ReplayReader* this) {
+   return Record_unzigzag(ReplayReader_varint(this));
+}
+
+static unsigned char ReplayReader_byte(ReplayReader* this) {
+   if (this->at >= this->end) {
+      this->failed = true;
+      return 0;
+   }
+   return *this->at++;
+}
+
+static const unsigned char* ReplayReader_bytes(ReplayReader* this, uint64_t length) {
+   if (length > (uint64_t)(this->end - this->at)) {
+      this->failed = true;
+      return NULL;
+   }
+
+   const unsigned char* bytes = this->at;
+   this->at += length;
+   return bytes;
+}
+
+static char* ReplayReader_string(ReplayReader* this) {
+   uint64_t length = ReplayReader_varint(this);
+   const unsigned char* bytes = ReplayReader_bytes(this, length);
+   return bytes ? xStrndup((const char*)bytes, length) : NULL;
+}
+
+static uint64_t Replay_uint64(const unsigned char* bytes) {
+   uint64_t value = 0;
+   for (int i = 7; i >= 0; i--)
+      value = (value << 8) | bytes[i];
+   return value;
+}
+
+/* ---------------------------------------------------------------------- */
+
+static bool Replay_chunkAt(const Replay* this, uint64_t offset, char* type, ReplayReader* payload) {
+   if (offset > this->size || this->size - offset < 5)
+      return false;
+
+   const unsigned char* head = this->data + offset;
+   uint64_t length = 0;
+   for (int i = 3; i >= 0; i--)
+      length = (length << 8) | head[1 + i];
+   if (length > this->size - offset - 5)
+      return false;
+
+   *type = (char)head[0];
+   *payload = (ReplayReader) {
+      .at = head + 5,
+      .end = head + 5 + length,
+      .failed = false,
+   };
+   return true;
+}
+
+static bool Replay_readHeader(Replay* this, ReplayReader* r) {
+   this->delayMs = (unsigned int)ReplayReader_varint(r);
+   uint64_t layout = ReplayReader_varint(r);
+   if (layout >= LAST_HEADER_LAYOUT)
+      return false;
+   this->headerLayout = (HeaderLayout)layout;
+
+   uint64_t columnCount = ReplayReader_varint(r);
+   if (columnCount < RECORD_CORE_COLUMN_COUNT || columnCount > RECORD_CORE_COLUMN_COUNT + LAST_PROCESSFIELD)
+      return false;
+
+   this->columns = xCalloc(columnCount, sizeof(RecordColumn));
+   this->columnCount = columnCount;
+   for (size_t i = 0; i < LAST_PROCESSFIELD; i++)
+      this->columnOfField[i] = -1;
+
+   for (size_t i = 0; i < columnCount && !r->failed; i++) {
+      RecordColumn* column = &this->columns[i];
+      uint64_t field = ReplayReader_varint(r);
+      char* name = ReplayReader_string(r);
+      column->kind = ReplayReader_byte(r) == RECORD_STRING ? RECORD_STRING : RECORD_NUMBER;
+      uint64_t scale = ReplayReader_varint(r);
+      column->scale = (unsigned int)MAXIMUM(scale, 1);
+
+      /* field ids are only trusted where the names agree */
+      if (i >= RECORD_CORE_COLUMN_COUNT && field > 0 && field < LAST_PROCESSFIELD &&
+          name && Process_fields[field].name && String_eq(name, Process_fields[field].name)) {
+         column->field = (ProcessField)field;
+         this->columnOfField[field] = (int)i;
+      }
+      free(name);
+   }
+
+   uint64_t meterCount = ReplayReader_varint(r);
+   if (meterCount > (uint64_t)(r->end - r->at))
+      return false;
+
+   this->meters = xCalloc(MAXIMUM(meterCount, 1), sizeof(ReplayMeter));
+   for (size_t i = 0; i < meterCount && !r->failed; i++) {
+      ReplayMeter* meter = &this->meters[i];
+      meter->column = (unsigned int)ReplayReader_varint(r);
+      meter->name = ReplayReader_string(r);
+      meter->mode = (int)ReplayReader_varint(r);
+      this->meterCount++;
+   }
+
+   return !r->failed;
+}
+
+static void Replay_addSample(Replay* this, size_t* allocd, uint64_t realtimeMs, uint64_t offset) {
+   if (this->sampleCount == *allocd) {
+      *allocd = *allocd ? *allocd * 2 : 1024;
+      this->index = xReallocArray(this->index, *allocd, sizeof(RecordIndexEntry));
+   }
+   this->index[this->sampleCount++] = (RecordIndexEntry) {
+      .realtimeMs = realtimeMs,
+      .offset = offset,
+   };
+}
+
+/* The index at the end of a finished recording */
+static bool Replay_readIndex(Replay* this) {
+   if (this->size < 2 * RECORD_MAGIC_SIZE + 8)
+      return false;
+
+   const unsigned char* footer = this->data + this->size - 8 - RECORD_MAGIC_SIZE;
+   if (memcmp(footer + 8, RECORD_INDEX_MAGIC, RECORD_MAGIC_SIZE) != 0)
+      return false;
+
+   char type;
+   ReplayReader r;
+   if (!Replay_chunkAt(this, Replay_uint64(footer), &type, &r) || type != RECORD_CHUNK_INDEX)
+      return false;
+
+   size_t length = (size_t)(r.end - r.at);
+   if (length % 16 != 0)
+      return false;
+
+   size_t allocd = 0;
+   for (const unsigned char* entry = r.at; entry < r.end; entry += 16)
+      Replay_addSample(this, &allocd, Replay_uint64(entry), Replay_uint64(entry + 8));
+   return true;
+}
+
+/* The samples of a recording without index, e.g. of a killed recorder */
+static void Replay_walkChunks(Replay* this) {
+   size_t allocd = 0;
+   uint64_t offset = RECORD_MAGIC_SIZE;
+   char type;
+   ReplayReader r;
+   while (Replay_chunkAt(this, offset, &type, &r) && type != RECORD_CHUNK_INDEX) {
+      if (type == RECORD_CHUNK_SAMPLE) {
+         uint64_t realtimeMs = ReplayReader_varint(&r);
+         unsigned char flags = ReplayReader_byte(&r);
+         if (r.failed)
+            break;
+
+         Replay_addSample(this, &allocd, realtimeMs, offset | ((flags & RECORD_SAMPLE_KEYFRAME) ? RECORD_INDEX_KEYFRAME : 0));
+      }
+      offset = (uint64_t)(r.end - this->data);
+   }
+}
+
+static bool Replay_findKeyframes(Replay* this) {
+   this->keyframes = xMallocArray(MAXIMUM(this->sampleCount, 1), sizeof(size_t));
+
+   size_t keyframe = SIZE_MAX;
+   for (size_t i = 0; i < this->sampleCount; i++) {
+      if (this->index[i].offset & RECORD_INDEX_KEYFRAME)
+         keyframe = i;
+      this->index[i].offset &= ~RECORD_INDEX_KEYFRAME;
+
+      if (keyframe == SIZE_MAX)
+         return false;
+      this->keyframes[i] = keyframe;
+   }
+   return true;
+}
+
+/* ---------------------------------------------------------------------- */
+
+static void Replay_reset(Replay* this) {
+   for (uint64_t i = 0; i < this->stringCount; i++)
+      free(this->strings[i]);
+   this->stringCount = 0;
+
+   Hashtable_clear(this->previous);
+   memset(this->globals, 0, sizeof(this->globals));
+   if (this->slots)
+      memset(this->slots, 0, this->slotCount * sizeof(ReplayMeterSlot));
+}
+
+static const char* Replay_string(const Replay* this, int64_t ref) {
+   return (ref > 0 && (uint64_t)ref <= this->stringCount) ? this->strings[ref - 1] : NULL;
+}
+
+static inline int64_t Replay_add(int64_t previous, int64_t delta) {
+   /* wraps around like the deltas written */
+   return (int64_t)((uint64_t)previous + (uint64_t)delta);
+}
+
+static void Replay_decodeMeter(Replay* this, ReplayReader* r, size_t slot) {
+   if (slot >= this->slotCount) {
+      size_t count = MAXIMUM(slot + 1, this->slotCount * 2);
+      this->slots = xReallocArray(this->slots, count, sizeof(ReplayMeterSlot));
+      memset(this->slots + this->slotCount, 0, (count - this->slotCount) * sizeof(ReplayMeterSlot));
+      this->slotCount = count;
+   }
+
+   ReplayMeterSlot* values = &this->slots[slot];
+   uint64_t items = ReplayReader_varint(r);
+   if (items > UINT8_MAX) {
+      r->failed = true;
+      return;
+   }
+
+   values->items = (unsigned int)items;
+   for (unsigned int i = 0; i <= items; i++)
+      values->values[i] = Replay_add(values->values[i], ReplayReader_signed(r));
+
+   values->text = ReplayReader_varint(r);
+   if (values->text > this->stringCount)
+      r->failed = true;
+}
+
+static void Replay_decodeProcesses(Replay* this, ReplayReader* r) {
+   const size_t bitmapSize = (this->columnCount + 7) / 8;
+
+   uint64_t count = ReplayReader_varint(r);
+   if (count > (uint64_t)(r->end - r->at)) {
+      r->failed = true;
+      return;
+   }
+
+   if (count > this->pidAllocd) {
+      this->pidAllocd = count;
+      this->pids = xReallocArray(this->pids, count, sizeof(pid_t));
+   }
+   this->pidCount = 0;
+
+   uint64_t pid = 0;
+   for (uint64_t n = 0; n < count && !r->failed; n++) {
+      uint64_t head = ReplayReader_varint(r);
+      pid += head >> 1;
+      this->pids[this->pidCount++] = (pid_t)pid;
+
+      /* values of pids gone in between are kept until the next keyframe,
+         as the recorder does */
+      int64_t* values = Hashtable_get(this->previous, (ht_key_t)pid);
+      if (!values) {
+         values = xCalloc(this->columnCount, sizeof(int64_t));
+         Hashtable_put(this->previous, (ht_key_t)pid, values);
+      }
+
+      if (!(head & 1))
+         continue;
+
+      const unsigned char* bitmap = ReplayReader_bytes(r, bitmapSize);
+      if (!bitmap)
+         return;
+
+      for (size_t i = 0; i < this->columnCount; i++) {
+         if (!(bitmap[i / 8] & (1 << (i % 8))))
+            continue;
+
+         if (this->columns[i].kind == RECORD_STRING) {
+            uint64_t ref = ReplayReader_varint(r);
+            if (ref > this->stringCount)
+               r->failed = true;
+            values[i] = (int64_t)ref;
+         } else {
+            values[i] = Replay_add(values[i], ReplayReader_signed(r));
+         }
+      }
+   }
+}
+
+static bool Replay_decodeSample(Replay* this, size_t n) {
+   char type;
+   ReplayReader r;
+   if (!Replay_chunkAt(this, this->index[n].offset, &type, &r) || type != RECORD_CHUNK_SAMPLE)
+      return false;
+
+   ReplayReader_varint(&r);
+   if (ReplayReader_byte(&r) & RECORD_SAMPLE_KEYFRAME)
+      Replay_reset(this);
+
+   uint64_t newStrings = ReplayReader_varint(&r);
+   if (newStrings > (uint64_t)(r.end - r.at))
+      return false;
+
+   if (this->stringCount + newStrings > this->stringAllocd) {
+      this->stringAllocd = MAXIMUM(this->stringAllocd * 2, this->stringCount + newStrings);
+      this->strings = xReallocArray(this->strings, this->stringAllocd, sizeof(char*));
+   }
+   for (uint64_t i = 0; i < newStrings; i++) {
+      char* string = ReplayReader_string(&r);
+      if (!string)
+         return false;
+      this->strings[this->stringCount++] = string;
+   }
+
+   for (int i = 0; i < RECORD_GLOBAL_COUNT; i++)
+      this->globals[i] = Replay_add(this->globals[i], ReplayReader_signed(&r));
+
+   if (ReplayReader_varint(&r) != this->meterCount)
+      return false;
+
+   size_t slot = 0;
+   for (size_t m = 0; m < this->meterCount && !r.failed; m++) {
+      ReplayMeter* meter = &this->meters[m];
+      meter->slot = slot;
+      Replay_decodeMeter(this, &r, slot++);
+
+      uint64_t subCount = ReplayReader_varint(&r);
+      if (subCount > (uint64_t)(r.end - r.at))
+         return false;
+
+      meter->subCount = (unsigned int)subCount;
+      for (uint64_t i = 0; i < subCount && !r.failed; i++)
+         Replay_decodeMeter(this, &r, slot++);
+   }
+
+   Replay_decodeProcesses(this, &r);
+   return !r.failed;
+}
+
+/* Decodes sample n from the closest keyframe, or onwards from the state
+ * when it is in the same span; a damaged sample ends the recording */
+static bool Replay_decode(Replay* this, size_t n) {
+   if (this->decoded == n)
+      return true;
+
+   size_t from = this->keyframes[n];
+   if (this->decoded != SIZE_MAX && this->decoded < n && this->decoded >= from)
+      from = this->decoded + 1;
+
+   for (size_t i = from; i <= n; i++) {
+      if (!Replay_decodeSample(this, i)) {
+         this->decoded = SIZE_MAX;
+         this->sampleCount = i;
+         return false;
+      }
+      this->decoded = i;
+   }
+   return true;
+}
+
+/* Last sample recorded at or before the given time */
+static size_t Replay_findSample(const Replay* this, uint64_t realtimeMs) {
+   size_t low = 0;
+   size_t high = this->sampleCount;
+   while (high - low > 1) {
+      size_t middle = low + (high - low) / 2;
+      if (this->index[middle].realtimeMs <= realtimeMs)
+         low = middle;
+      else
+         high = middle;
+   }
+   return low;
+}
+
+/* ---------------------------------------------------------------------- */
+
+Replay* Replay_new(const char* filename, const char** error) {
+   int fd = open(filename, O_RDONLY);
+   if (fd < 0) {
+      *error = strerror(errno);
+      return NULL;
+   }
+
+   struct stat st;
+   if (fstat(fd, &st) != 0) {
+      *error = strerror(errno);
+      close(fd);
+      return NULL;
+   }
+
+   if (st.st_size < RECORD_MAGIC_SIZE) {
+      *error = "not a recording of htop";
+      close(fd);
+      return NULL;
+   }
+
+   void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   int err = errno;
+   close(fd);
+   if (data == MAP_FAILED) {
+      *error = strerror(err);
+      return NULL;
+   }
+
+   Replay* this = xCalloc(1, sizeof(Replay));
+   this->data = data;
+   this->size = (size_t)st.st_size;
+   this->decoded = SIZE_MAX;
+   this->previous = Hashtable_new(1024, true);
+   this->users = Hashtable_new(64, true);
+
+   char type;
+   ReplayReader r;
+   if (memcmp(this->data, RECORD_MAGIC, RECORD_MAGIC_SIZE) != 0 ||
+       !Replay_chunkAt(this, RECORD_MAGIC_SIZE, &type, &r) || type != RECORD_CHUNK_HEADER) {
+      *error = "not a recording of htop";
+      goto fail;
+   }
+
+   if (!Replay_readHeader(this, &r)) {
+      *error = "damaged recording header";
+      goto fail;
+   }
+
+   if (!Replay_readIndex(this))
+      Replay_walkChunks(this);
+
+   if (!Replay_findKeyframes(this) || !this->sampleCount || !Replay_decode(this, 0)) {
+      *error = "no samples in the recording";
+      goto fail;
+   }
+
+   this->current = 0;
+   this->playing = true;
+   this->speed = 1;
+   this->playTimeMs = this->index[0].realtimeMs;
+   return this;
+
+fail:
+   Replay_delete(this);
+   return NULL;
+}
+
+void Replay_delete(Replay* this) {
+   Replay_reset(this);
+   free(this->strings);
+   Hashtable_delete(this->previous);
+   Hashtable_delete(this->users);
+
+   for (size_t i = 0; i < this->meterCount; i++)
+      free(this->meters[i].name);
+   free(this->meters);
+   free(this->columns);
+   free(this->slots);
+   free(this->pids);
+   free(this->index);
+   free(this->keyframes);
+
+   munmap(this->data, this->size);
+   free(this);
+}
+
+void Replay_applySettings(const Replay* this, Settings* settings) {
+   Settings_setHeaderLayout(settings, this->headerLayout);
+
+   for (size_t col = 0; col < HeaderLayout_getColumns(this->headerLayout); col++) {
+      MeterColumnSetting* colSettings = &settings->hColumns[col];
+      if (colSettings->names) {
+         for (size_t i = 0; i < colSettings->len; i++)
+            free(colSettings->names[i]);
+         free(colSettings->names);
+      }
+      free(colSettings->modes);
+
+      size_t len = 0;
+      for (size_t m = 0; m < this->meterCount; m++)
+         len += this->meters[m].column == col;
+
+      len = MINIMUM(len, UINT8_MAX);
+      colSettings->names = len ? xCalloc(len, sizeof(char*)) : NULL;
+      colSettings->modes = len ? xCalloc(len, sizeof(int)) : NULL;
+      colSettings->len = (uint8_t)len;
+
+      size_t i = 0;
+      for (size_t m = 0; m < this->meterCount && i < len; m++) {
+         if (this->meters[m].column != col)
+            continue;
+
+         colSettings->names[i] = xStrdup(this->meters[m].name);
+         colSettings->modes[i] = this->meters[m].mode;
+         i++;
+      }
+   }
+
+   if (this->delayMs >= 100)
+      settings->delay = (int)CLAMP(this->delayMs / 100, 1, 100);
+}
+
+void Replay_attach(Replay* this, ProcessList* pl) {
+   ProcessList_setProcessClass(pl, Class(ReplayProcess));
+   pl->replay = this;
+}
+
+/* ---------------------------------------------------------------------- */
+
+/* User names are referred to by the processes, so they outlive the spans */
+static const char* Replay_user(Replay* this, const char* name) {
+   if (!name)
+      return NULL;
+
+   for (ht_key_t key = Record_hashString(name, strlen(name)); ; key++) {
+      const char* user = Hashtable_get(this->users, key);
+      if (!user) {
+         char* copy = xStrdup(name);
+         Hashtable_put(this->users, key, copy);
+         return copy;
+      }
+      if (String_eq(user, name))
+         return user;
+   }
+}
+
+static void Replay_updateString(char** field, const char* value) {
+   if (!*field && !value)
+      return;
+   if (*field && value && String_eq(*field, value))
+      return;
+
+   free(*field);
+   *field = value ? xStrdup(value) : NULL;
+}
+
+static void Replay_applyCmdline(Process* proc, const char* cmdline, int64_t start, int64_t end) {
+   if (!cmdline || !cmdline[0]) {
+      Process_updateCmdline(proc, NULL, 0, 0);
+      return;
+   }
+
+   int64_t length = (int64_t)strlen(cmdline);
+   if (end <= 0 || end > length) {
+      start = 0;
+      end = length;
+   }
+   if (start < 0 || start >= end)
+      start = 0;
+
+   Process_updateCmdline(proc, cmdline, (int)start, (int)end);
+}
+
+static void Replay_applyProcess(Replay* this, ReplayProcess* rp, const int64_t* values) {
+   Process* proc = &rp->super;
+
+   proc->ppid = (pid_t)values[RECORD_PPID];
+   proc->tgid = (pid_t)values[RECORD_TGID];
+   proc->pgrp = (int)values[RECORD_PGRP];
+   proc->session = (int)values[RECORD_SESSION];
+   proc->tpgid = (int)values[RECORD_TPGID];
+   proc->tty_nr = (unsigned long int)values[RECORD_TTY_NR];
+   proc->st_uid = (uid_t)values[RECORD_ST_UID];
+   proc->state = (char)values[RECORD_STATE];
+   proc->priority = (long int)values[RECORD_PRIORITY];
+   proc->nice = (long int)values[RECORD_NICE];
+   proc->nlwp = (long int)values[RECORD_NLWP];
+   proc->processor = (int)values[RECORD_PROCESSOR];
+   proc->percent_cpu = (float)Record_unscale(values[RECORD_PERCENT_CPU], this->columns[RECORD_PERCENT_CPU].scale);
+   proc->percent_mem = (float)Record_unscale(values[RECORD_PERCENT_MEM], this->columns[RECORD_PERCENT_MEM].scale);
+   proc->time = (unsigned long long int)values[RECORD_TIME];
+   proc->m_virt = (long)values[RECORD_M_VIRT];
+   proc->m_resident = (long)values[RECORD_M_RESIDENT];
+   proc->minflt = (unsigned long int)values[RECORD_MINFLT];
+   proc->majflt = (unsigned long int)values[RECORD_MAJFLT];
+
+   if (proc->starttime_ctime != (time_t)values[RECORD_STARTTIME] || !proc->starttime_show[0]) {
+      proc->starttime_ctime = (time_t)values[RECORD_STARTTIME];
+      Process_fillStarttimeBuffer(proc);
+   }
+
+   int64_t flags = values[RECORD_FLAGS];
+   proc->isKernelThread = flags & RECORD_FLAG_KERNEL_THREAD;
+   proc->isUserlandThread = flags & RECORD_FLAG_USERLAND_THREAD;
+   proc->procExeDeleted = flags & RECORD_FLAG_EXE_DELETED;
+   proc->usesDeletedLib = flags & RECORD_FLAG_DELETED_LIB;
+
+   proc->user = Replay_user(this, Replay_string(this, values[RECORD_USER]));
+   Replay_updateString(&proc->tty_name, Replay_string(this, values[RECORD_TTY_NAME]));
+   Replay_updateString(&proc->procCwd, Replay_string(this, values[RECORD_CWD]));
+   Replay_applyCmdline(proc, Replay_string(this, values[RECORD_CMDLINE]), values[RECORD_CMDLINE_BASENAME_START], values[RECORD_CMDLINE_BASENAME_END]);
+   Process_updateComm(proc, Replay_string(this, values[RECORD_COMM]));
+   Process_updateExe(proc, Replay_string(this, values[RECORD_EXE]));
+
+   if (this->columnCount == RECORD_CORE_COLUMN_COUNT)
+      return;
+
+   if (!rp->values) {
+      rp->columnCount = this->columnCount;
+      rp->values = xCalloc(this->columnCount, sizeof(int64_t));
+      rp->strings = xCalloc(this->columnCount, sizeof(char*));
+   }
+
+   for (size_t i = RECORD_CORE_COLUMN_COUNT; i < this->columnCount; i++) {
+      if (this->columns[i].kind == RECORD_STRING)
+         Replay_updateString(&rp->strings[i], Replay_string(this, values[i]));
+      else
+         rp->values[i] = values[i];
+   }
+}
+
+static void Replay_applyGlobals(const Replay* this, ProcessList* pl) {
+   const int64_t* globals = this->globals;
+
+   pl->totalTasks = (unsigned int)globals[RECORD_TOTAL_TASKS];
+   pl->runningTasks = (unsigned int)globals[RECORD_RUNNING_TASKS];
+   pl->userlandThreads = (unsigned int)globals[RECORD_USERLAND_THREADS];
+   pl->kernelThreads = (unsigned int)globals[RECORD_KERNEL_THREADS];
+   pl->totalMem = (memory_t)globals[RECORD_TOTAL_MEM];
+   pl->usedMem = (memory_t)globals[RECORD_USED_MEM];
+   pl->buffersMem = (memory_t)globals[RECORD_BUFFERS_MEM];
+   pl->cachedMem = (memory_t)globals[RECORD_CACHED_MEM];
+   pl->sharedMem = (memory_t)globals[RECORD_SHARED_MEM];
+   pl->availableMem = (memory_t)globals[RECORD_AVAILABLE_MEM];
+   pl->totalSwap = (memory_t)globals[RECORD_TOTAL_SWAP];
+   pl->usedSwap = (memory_t)globals[RECORD_USED_SWAP];
+   pl->cachedSwap = (memory_t)globals[RECORD_CACHED_SWAP];
+   /* the number of existing CPUs sizes platform data, it stays the local one */
+   pl->activeCPUs = (unsigned int)MAXIMUM(globals[RECORD_ACTIVE_CPUS], 1);
+
+   uint64_t realtimeMs = this->index[this->current].realtimeMs;
+   pl->realtimeMs = realtimeMs;
+   pl->realtime.tv_sec = (time_t)(realtimeMs / 1000);
+   pl->realtime.tv_usec = (suseconds_t)(realtimeMs % 1000 * 1000);
+}
+
+static void Replay_play(Replay* this, const Settings* settings) {
+   uint64_t nowMs;
+   Platform_gettime_monotonic(&nowMs);
+
+   if (this->playing && this->lastStepMs) {
+      /* a pause of the updates holds the playback */
+      uint64_t elapsedMs = MINIMUM(nowMs - this->lastStepMs, 200 * (uint64_t)settings->delay);
+      this->playTimeMs += elapsedMs * this->speed;
+      while (this->current + 1 < this->sampleCount && this->index[this->current + 1].realtimeMs <= this->playTimeMs)
+         this->current++;
+
+      if (this->current + 1 >= this->sampleCount)
+         this->playing = false;
+   }
+
+   this->lastStepMs = nowMs;
+}
+
+void Replay_goThroughEntries(Replay* this, ProcessList* pl) {
+   const Settings* settings = pl->settings;
+
+   Replay_play(this, settings);
+   while (!Replay_decode(this, this->current))
+      this->current = MINIMUM(this->current, this->sampleCount - 1);
+
+   Replay_applyGlobals(this, pl);
+
+   for (size_t i = 0; i < this->pidCount; i++) {
+      const int64_t* values = Hashtable_get(this->previous, (ht_key_t)this->pids[i]);
+
+      bool preExisting;
+      Process* proc = ProcessList_getProcess(pl, this->pids[i], &preExisting, ReplayProcess_new);
+      Replay_applyProcess(this, (ReplayProcess*)proc, values);
+
+      proc->show = ! ((settings->hideKernelThreads && Process_isKernelThread(proc)) || (settings->hideUserlandThreads && Process_isUserlandThread(proc)));
+      proc->updated = true;
+
+      if (!preExisting)
+         ProcessList_add(pl, proc);
+   }
+}
+
+/* ---------------------------------------------------------------------- */
+
+static const ReplayMeter* Replay_findMeter(const Replay* this, unsigned int column, int n) {
+   for (size_t m = 0; m < this->meterCount; m++) {
+      if (this->meters[m].column == column && n-- == 0)
+         return &this->meters[m];
+   }
+   return NULL;
+}
+
+static bool Replay_meterMatches(const ReplayMeter* recorded, const Meter* meter) {
+   /* the settings name adds the parameter in parentheses */
+   size_t length = strcspn(recorded->name, "(");
+   const char* name = As_Meter(meter)->name;
+   return strncmp(recorded->name, name, length) == 0 && name[length] == '\0';
+}
+
+static void Replay_setMeter(const Replay* this, Meter* meter, const ReplayMeterSlot* slot) {
+   unsigned int maxItems = As_Meter(meter)->maxItems;
+   unsigned int items = slot ? MINIMUM(slot->items, maxItems) : 0;
+
+   for (unsigned int i = 0; i < maxItems; i++)
+      meter->values[i] = i < items ? Record_unscale(slot->values[1 + i], 100) : 0.0;
+   meter->curItems = (uint8_t)(slot ? items : maxItems);
+
+   if (!slot) {
+      /* not in the recording */
+      xSnprintf(meter->txtBuffer, sizeof(meter->txtBuffer), "N/A");
+      return;
+   }
+
+   meter->total = Record_unscale(slot->values[0], 100);
+   const char* text = Replay_string(this, (int64_t)slot->text);
+   String_safeStrncpy(meter->txtBuffer, text ? text : "", sizeof(meter->txtBuffer));
+}
+
+static void Replay_resetGraph(Meter* meter) {
+   if (meter->drawData)
+      timerclear(&meter->drawData->time);
+}
+
+void Replay_updateHeader(Replay* this, const Header* header) {
+   Header_forEachColumn(header, col) {
+      const Vector* meters = header->columns[col];
+      for (int i = 0; i < Vector_size(meters); i++) {
+         Meter* meter = (Meter*) Vector_get(meters, i);
+         const ReplayMeter* recorded = Replay_findMeter(this, (unsigned int)col, i);
+         if (recorded && !Replay_meterMatches(recorded, meter))
+            recorded = NULL;
+
+         Replay_setMeter(this, meter, recorded ? &this->slots[recorded->slot] : NULL);
+         if (this->rewound)
+            Replay_resetGraph(meter);
+
+         int subCount;
+         Meter* const* subMeters = CPUMeter_getSubMeters(meter, &subCount);
+         for (int j = 0; j < subCount; j++) {
+            bool known = recorded && (unsigned int)j < recorded->subCount;
+            Replay_setMeter(this, subMeters[j], known ? &this->slots[recorded->slot + 1 + j] : NULL);
+            if (this->rewound)
+               Replay_resetGraph(subMeters[j]);
+         }
+      }
+   }
+
+   this->rewound = false;
+}
+
+void Replay_formatStatus(const Replay* this, char* buffer, size_t size) {
+   time_t seconds = (time_t)(this->index[this->current].realtimeMs / 1000);
+   struct tm date;
+   char when[32];
+   (void) localtime_r(&seconds, &date);
+   strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", &date);
+
+   if (this->playing)
+      xSnprintf(buffer, size, "REPLAY %s %zu/%zu %ux", when, this->current + 1, this->sampleCount, this->speed);
+   else
+      xSnprintf(buffer, size, "REPLAY %s %zu/%zu stopped", when, this->current + 1, this->sampleCount);
+}
+
+/* ---------------------------------------------------------------------- */
+
+static Htop_Reaction Replay_seek(State* st, size_t sample) {
+   Replay* this = st->pl->replay;
+   if (sample < this->current)
+      this->rewound = true;
+
+   this->current = sample;
+   this->playTimeMs = this->index[sample].realtimeMs;
+   st->pauseProcessUpdate = false;
+   return HTOP_RECALCULATE | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction actionReplayStepForward(State* st) {
+   Replay* this = st->pl->replay;
+   this->playing = false;
+   return Replay_seek(st, MINIMUM(this->current + 1, this->sampleCount - 1));
+}
+
+static Htop_Reaction actionReplayStepBack(State* st) {
+   Replay* this = st->pl->replay;
+   this->playing = false;
+   return Replay_seek(st, this->current ? this->current - 1 : 0);
+}
+
+static Htop_Reaction actionReplaySeekForward(State* st) {
+   const Replay* this = st->pl->replay;
+   return Replay_seek(st, Replay_findSample(this, this->index[this->current].realtimeMs + REPLAY_SEEK_MS));
+}
+
+static Htop_Reaction actionReplaySeekBack(State* st) {
+   const Replay* this = st->pl->replay;
+   uint64_t realtimeMs = this->index[this->current].realtimeMs;
+   return Replay_seek(st, Replay_findSample(this, realtimeMs > REPLAY_SEEK_MS ? realtimeMs - REPLAY_SEEK_MS : 0));
+}
+
+static Htop_Reaction actionReplaySpeed(State* st) {
+   Replay* this = st->pl->replay;
+   if (this->playing) {
+      this->speed = this->speed >= REPLAY_MAX_SPEED ? 1 : this->speed * 2;
+      return HTOP_REDRAW_BAR;
+   }
+
+   this->playing = true;
+   this->speed = 1;
+   return Replay_seek(st, this->current + 1 < this->sampleCount ? this->current : 0);
+}
+
+void Replay_setBindings(Htop_Action* keys) {
+   keys[')'] = actionReplayStepForward;
+   keys['('] = actionReplayStepBack;
+   keys['f'] = actionReplaySeekForward;
+   keys['b'] = actionReplaySeekBack;
+   keys['v'] = actionReplaySpeed;
+}
+
+/* ---------------------------------------------------------------------- */
+
+Process* ReplayProcess_new(const Settings* settings) {
+   ReplayProcess* this = xCalloc(1, sizeof(ReplayProcess));
+   Object_setClass(this, Class(ReplayProcess));
+   Process_init(&this->super, settings);
+   return &this->super;
+}
+
+void ReplayProcess_delete(Object* cast) {
+   ReplayProcess* this = (ReplayProcess*) cast;
+   Process_done(&this->super);
+   for (size_t i = 0; this->strings && i < this->columnCount; i++)
+      free(this->strings[i]);
+   free(this->strings);
+   free(this->values);
+   free(this);
+}
+
+static int ReplayProcess_column(const ReplayProcess* this, ProcessField field) {
+   const Replay* replay = this->super.processList->replay;
+   if (!this->values || field >= LAST_PROCESSFIELD)
+      return -1;
+
+   return replay->columnOfField[field];
+}
+
+static void ReplayProcess_writeField(const Process* super, RichString* str, ProcessField field) {
+   if (Recorder_isCoreField(field)) {
+      Process_writeField(super, str, field);
+      return;
+   }
+
+   const ReplayProcess* this = (const ReplayProcess*) super;
+   const Replay* replay = super->processList->replay;
+   int column = ReplayProcess_column(this, field);
+   const char* title = field < LAST_PROCESSFIELD ? Process_fields[field].title : NULL;
+   int width = title ? MAXIMUM((int)strlen(title) - 1, 1) : 1;
+
+   char buffer[256];
+   int attr = CRT_colors[DEFAULT_COLOR];
+   if (column >= 0 && replay->columns[column].kind == RECORD_STRING) {
+      Process_printLeftAlignedField(str, attr, this->strings[column] ? this->strings[column] : "", (unsigned int)width);
+      return;
+   }
+
+   int64_t value = column >= 0 ? this->values[column] : RECORD_NAN;
+   unsigned int scale = column >= 0 ? replay->columns[column].scale : 1;
+   if (value == RECORD_NAN) {
+      attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, sizeof(buffer), "%*s ", width, "N/A");
+   } else if (value % scale == 0) {
+      xSnprintf(buffer, sizeof(buffer), "%*lld ", width, (long long)(value / scale));
+   } else {
+      xSnprintf(buffer, sizeof(buffer), "%*.1f ", width, Record_unscale(value, scale));
+   }
+   RichString_appendAscii(str, attr, buffer);
+}
+
+static int ReplayProcess_compareByKey(const Process* v1, const Process* v2, ProcessField key) {
+   if (Recorder_isCoreField(key))
+      return Process_compareByKey_Base(v1, v2, key);
+
+   const ReplayProcess* p1 = (const ReplayProcess*) v1;
+   const ReplayProcess* p2 = (const ReplayProcess*) v2;
+   const Replay* replay = v1->processList->replay;
+   int column = key < LAST_PROCESSFIELD ? replay->columnOfField[key] : -1;
+   if (column < 0)
+      return 0;
+
+   if (replay->columns[column].kind == RECORD_STRING) {
+      const char* s1 = p1->strings && p1->strings[column] ? p1->strings[column] : "";
+      const char* s2 = p2->strings && p2->strings[column] ? p2->strings[column] : "";
+      return strcmp(s1, s2);
+   }
+
+   return SPACESHIP_NUMBER(p1->values ? p1->values[column] : RECORD_NAN, p2->values ? p2->values[column] : RECORD_NAN);
+}
+
+static bool ReplayProcess_getFieldValue(const Process* super, ProcessField key, ProcessFieldValue* value) {
+   if (Recorder_isCoreField(key))
+      return Process_getFieldValue_Base(super, key, value);
+
+   const ReplayProcess* this = (const ReplayProcess*) super;
+   const Replay* replay = super->processList->replay;
+   int column = ReplayProcess_column(this, key);
+   if (column < 0)
+      return false;
+
+   value->number = 0;
+   if (replay->columns[column].kind == RECORD_STRING) {
+      value->string = this->strings[column] ? this->strings[column] : "";
+   } else {
+      value->string = NULL;
+      value->number = Record_unscale(this->values[column], replay->columns[column].scale);
+   }
+   return true;
+}
+
+const ProcessClass ReplayProcess_class = {
+   .super = {
+      .extends = Class(Process),
+      .display = Process_display,
+      .delete = ReplayProcess_delete,
+      .compare = Process_compare
+   },
+   .writeField = ReplayProcess_writeField,
+   .compareByKey = ReplayProcess_compareByKey,
+   .getFieldValue = ReplayProcess_getFieldValue
+};
@@ -0,0 +1,114 @@
+#ifndef HEADER_Replay
+#define HEADER_Replay
+/*
+htop - Replay.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "Action.h"
+#include "Hashtable.h"
+#include "Header.h"
+#include "HeaderLayout.h"
+#include "Process.h"
+#include "ProcessList.h"
+#include "Recorder.h"
+#include "Settings.h"
+
+
+typedef struct ReplayMeter_ {
+   unsigned int column;       /* in the header */
+   char* name;                /* as in the settings, e.g. "CPU(1)" */
+   int mode;
+   size_t slot;               /* of its values, those of its per-CPU meters follow */
+   unsigned int subCount;     /* per-CPU meters */
+} ReplayMeter;
+
+/* Decoded values of a meter, scaled by 100 */
+typedef struct ReplayMeterSlot_ {
+   unsigned int items;
+   int64_t values[1 + UINT8_MAX]; /* the total, then the items */
+   uint64_t text;             /* string reference */
+} ReplayMeterSlot;
+
+typedef struct Replay_ {
+   unsigned char* data;       /* the file, mapped read only */
+   size_t size;
+
+   unsigned int delayMs;
+   HeaderLayout headerLayout;
+   RecordColumn* columns;
+   size_t columnCount;
+   int columnOfField[LAST_PROCESSFIELD]; /* -1 for fields not recorded */
+   ReplayMeter* meters;
+   size_t meterCount;
+
+   RecordIndexEntry* index;   /* of all samples, without RECORD_INDEX_KEYFRAME */
+   size_t* keyframes;         /* the keyframe each sample is decoded from */
+   size_t sampleCount;
+
+   /* decoder state, as of sample decoded (SIZE_MAX for none) */
+   size_t decoded;
+   char** strings;
+   uint64_t stringCount;
+   uint64_t stringAllocd;
+   Hashtable* previous;       /* column values by pid */
+   int64_t globals[RECORD_GLOBAL_COUNT];
+   ReplayMeterSlot* slots;
+   size_t slotCount;
+   pid_t* pids;               /* of the processes in the decoded sample */
+   size_t pidCount;
+   size_t pidAllocd;
+
+   Hashtable* users;          /* user names, kept while processes refer to them */
+
+   /* playback */
+   size_t current;            /* sample shown */
+   bool playing;
+   unsigned int speed;
+   uint64_t playTimeMs;       /* recorded time played up to */
+   uint64_t lastStepMs;       /* monotonic time of the last playback step */
+   bool rewound;              /* went back in time since the header was updated */
+} Replay;
+
+typedef struct ReplayProcess_ {
+   Process super;
+   size_t columnCount;
+   int64_t* values;           /* of the recorded platform columns, by column */
+   char** strings;
+} ReplayProcess;
+
+extern const ProcessClass ReplayProcess_class;
+
+Process* ReplayProcess_new(const Settings* settings);
+
+void ReplayProcess_delete(Object* cast);
+
+/* NULL with a description in error if the file can not be replayed */
+Replay* Replay_new(const char* filename, const char** error);
+
+void Replay_delete(Replay* this);
+
+/* Takes over the header meters and update interval of the recording */
+void Replay_applySettings(const Replay* this, Settings* settings);
+
+/* Makes the process list show the recording */
+void Replay_attach(Replay* this, ProcessList* pl);
+
+/* Fills the process list with the sample due, in place of the platform scan */
+void Replay_goThroughEntries(Replay* this, ProcessList* pl);
+
+/* Sets the header meters to the recorded values */
+void Replay_updateHeader(Replay* this, const Header* header);
+
+void Replay_formatStatus(const Replay* this, char* buffer, size_t size);
+
+void Replay_setBindings(Htop_Action* keys);
+
+#endif
@@ -8,12 +8,17 @@ in the source distribution for its full text.
 #include "RichString.h"
 
 #include <ctype.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "Macros.h"
 #include "XUtils.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 
 #define charBytes(n) (sizeof(CharType) * (n))
 
@@ -52,7 +57,53 @@ void RichString_rewind(RichString* this, int count) {
 
 #ifdef HAVE_LIBNCURSESW
 
+/* Most strings (numbers, user names, command lines) are plain ASCII
+ * and can be stored without going through mbstowcs and iswprint. */
+static inline bool RichString_isAscii(const char* data, size_t len) {
+   size_t i = 0;
+
+#ifdef __SSE2__
+   for (; i + 16 <= len; i += 16) {
+      if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(data + i))))
+         return false;
+   }
+#endif
+
+   for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, data + i, sizeof(word));
+      if (word & UINT64_C(0x8080808080808080))
+         return false;
+   }
+
+   for (; i < len; i++) {
+      if ((unsigned char)data[i] & 0x80)
+         return false;
+   }
+
+   return true;
+}
+
+static inline void RichString_writeAsciiCells(RichString* this, int attrs, const char* data, int from, int len) {
+   CharType* cell = this->chptr + from;
+   for (int j = 0; j < len; j++) {
+      const unsigned char c = data[j];
+      cell[j] = (CharType) { .attr = attrs & 0xffffff, .chars = { (c >= 0x20 && c < 0x7f) ? c : '?' } };
+   }
+}
+
 static inline int RichString_writeFromWide(RichString* this, int attrs, const char* data_c, int from, int len) {
+   /* mbstowcs stops at the terminating NUL, and ASCII characters are single bytes */
+   const int asciiLen = len > 0 ? (int)strnlen(data_c, len) : 0;
+   if (RichString_isAscii(data_c, asciiLen)) {
+      if (asciiLen == 0)
+         return 0;
+
+      RichString_setLen(this, from + asciiLen);
+      RichString_writeAsciiCells(this, attrs, data_c, from, asciiLen);
+      return asciiLen;
+   }
+
    wchar_t data[len + 1];
    len = mbstowcs(data, data_c, len);
    if (len <= 0)
@@ -68,6 +119,20 @@ static inline int RichString_writeFromWide(RichString* this, int attrs, const ch
 }
 
 int RichString_appendnWideColumns(RichString* this, int attrs, const char* data_c, int len, int* columns) {
+   const int asciiLen = len > 0 ? (int)strnlen(data_c, len) : 0;
+   if (RichString_isAscii(data_c, asciiLen)) {
+      if (asciiLen == 0)
+         return 0;
+
+      /* every ASCII character (or its '?' replacement) takes one column */
+      const int count = CLAMP(*columns, 0, asciiLen);
+      const int from = this->chlen;
+      RichString_setLen(this, from + count);
+      RichString_writeAsciiCells(this, attrs, data_c, from, count);
+      *columns = count;
+      return count;
+   }
+
    wchar_t data[len + 1];
    len = mbstowcs(data, data_c, len);
    if (len <= 0)
@@ -98,19 +163,17 @@ int RichString_appendnWideColumns(RichString* this, int attrs, const char* data_
 }
 
 static inline int RichString_writeFromAscii(RichString* this, int attrs, const char* data, int from, int len) {
-   int newLen = from + len;
-   RichString_setLen(this, newLen);
-   for (int i = from, j = 0; i < newLen; i++, j++) {
-      this->chptr[i] = (CharType) { .attr = attrs & 0xffffff, .chars = { (isprint(data[j]) ? data[j] : '?') } };
-   }
+   RichString_setLen(this, from + len);
+   RichString_writeAsciiCells(this, attrs, data, from, len);
 
    return len;
 }
 
 inline void RichString_setAttrn(RichString* this, int attrs, int start, int charcount) {
    int end = CLAMP(start + charcount, 0, this->chlen);
-   for (int i = start; i < end; i++) {
-      this->chptr[i].attr = attrs;
+   CharType* cell = this->chptr + start;
+   for (int i = start; i < end; i++, cell++) {
+      cell->attr = attrs;
    }
 }
 
@@ -11,6 +11,7 @@ in the source distribution for its full text.
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <sys/time.h>
 
@@ -20,6 +21,7 @@ in the source distribution for its full text.
 #include "Platform.h"
 #include "ProcessList.h"
 #include "ProvideCurses.h"
+#include "Replay.h"
 #include "XUtils.h"
 
 
@@ -91,8 +93,15 @@ void ScreenManager_resize(ScreenManager* this) {
 static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTimeout, bool* redraw, bool* rescan, bool* timedOut) {
    ProcessList* pl = this->header->pl;
 
-   Platform_gettime_realtime(&pl->realtime, &pl->realtimeMs);
-   double newTime = ((double)pl->realtime.tv_sec * 10) + ((double)pl->realtime.tv_usec / 100000);
+   struct timeval realtime;
+   uint64_t realtimeMs;
+   Platform_gettime_realtime(&realtime, &realtimeMs);
+   // a replay keeps the time of the sample shown
+   if (!pl->replay) {
+      pl->realtime = realtime;
+      pl->realtimeMs = realtimeMs;
+   }
+   double newTime = ((double)realtime.tv_sec * 10) + ((double)realtime.tv_usec / 100000);
 
    *timedOut = (newTime - *oldTime > this->settings->delay);
    *rescan |= *timedOut;
@@ -106,7 +115,10 @@ static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTi
       // scan processes first - some header values are calculated there
       ProcessList_scan(pl, this->state->pauseProcessUpdate);
       // always update header, especially to avoid gaps in graph meters
-      Header_updateData(this->header);
+      if (pl->replay)
+         Replay_updateHeader(pl->replay, this->header);
+      else
+         Header_updateData(this->header);
       if (!this->state->pauseProcessUpdate && (*sortTimeout == 0 || this->settings->treeView)) {
          ProcessList_sort(pl);
          *sortTimeout = 1;
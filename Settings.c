@@ -196,6 +196,9 @@ static bool Settings_read(Settings* this, const char* fileName, unsigned int ini
          this->direction = atoi(option[1]);
       } else if (String_eq(option[0], "tree_sort_direction")) {
          this->treeDirection = atoi(option[1]);
+      } else if (String_eq(option[0], "group_by")) {
+         int groupBy = atoi(option[1]);
+         this->groupBy = (groupBy > 0 && groupBy < LAST_PROCESSFIELD && Process_fields[groupBy].name) ? groupBy : 0;
       } else if (String_eq(option[0], "tree_view")) {
          this->treeView = atoi(option[1]);
       } else if (String_eq(option[0], "tree_view_always_by_pid")) {
@@ -254,10 +257,14 @@ static bool Settings_read(Settings* this, const char* fileName, unsigned int ini
       #endif
       } else if (String_eq(option[0], "update_process_names")) {
          this->updateProcessNames = atoi(option[1]);
+      } else if (String_eq(option[0], "collect_visible_only")) {
+         this->collectVisibleOnly = atoi(option[1]);
       } else if (String_eq(option[0], "account_guest_in_cpu_meter")) {
          this->accountGuestInCPUMeter = atoi(option[1]);
       } else if (String_eq(option[0], "delay")) {
          this->delay = CLAMP(atoi(option[1]), 1, 255);
+      } else if (String_eq(option[0], "graph_history")) {
+         this->graphHistory = CLAMP(atoi(option[1]), 2, MAX_GRAPH_HISTORY);
       } else if (String_eq(option[0], "color_scheme")) {
          this->colorScheme = atoi(option[1]);
          if (this->colorScheme < 0 || this->colorScheme >= LAST_COLORSCHEME) {
@@ -371,6 +378,7 @@ int Settings_write(const Settings* this, bool onCrash) {
    printSettingInteger("sort_direction", this->direction);
    printSettingInteger("tree_sort_key", this->treeSortKey - 1);
    printSettingInteger("tree_sort_direction", this->treeDirection);
+   printSettingInteger("group_by", this->groupBy);
    printSettingInteger("hide_kernel_threads", this->hideKernelThreads);
    printSettingInteger("hide_userland_threads", this->hideUserlandThreads);
    printSettingInteger("shadow_other_users", this->shadowOtherUsers);
@@ -398,12 +406,14 @@ int Settings_write(const Settings* this, bool onCrash) {
    printSettingInteger("degree_fahrenheit", this->degreeFahrenheit);
    #endif
    printSettingInteger("update_process_names", this->updateProcessNames);
+   printSettingInteger("collect_visible_only", this->collectVisibleOnly);
    printSettingInteger("account_guest_in_cpu_meter", this->accountGuestInCPUMeter);
    printSettingInteger("color_scheme", this->colorScheme);
    #ifdef HAVE_GETMOUSE
    printSettingInteger("enable_mouse", this->enableMouse);
    #endif
    printSettingInteger("delay", (int) this->delay);
+   printSettingInteger("graph_history", this->graphHistory);
    printSettingInteger("hide_function_bar", (int) this->hideFunctionBar);
    #ifdef HAVE_LIBHWLOC
    printSettingInteger("topology_affinity", this->topologyAffinity);
@@ -462,6 +472,7 @@ Settings* Settings_new(unsigned int initialCpuCount, Hashtable* dynamicColumns)
    this->degreeFahrenheit = false;
    #endif
    this->updateProcessNames = false;
+   this->collectVisibleOnly = false;
    this->showProgramPath = true;
    this->highlightThreads = true;
    this->highlightChanges = false;
@@ -523,6 +534,7 @@ Settings* Settings_new(unsigned int initialCpuCount, Hashtable* dynamicColumns)
 #endif
    this->changed = false;
    this->delay = DEFAULT_DELAY;
+   this->graphHistory = DEFAULT_GRAPH_HISTORY;
    bool ok = false;
    if (legacyDotfile) {
       ok = Settings_read(this, legacyDotfile, initialCpuCount);
@@ -19,6 +19,9 @@ in the source distribution for its full text.
 
 #define DEFAULT_DELAY 15
 
+#define DEFAULT_GRAPH_HISTORY 256
+#define MAX_GRAPH_HISTORY 16384
+
 #define CONFIG_READER_MIN_VERSION 2
 
 typedef struct {
@@ -38,11 +41,13 @@ typedef struct Settings_ {
    uint32_t flags;
    int colorScheme;
    int delay;
+   int graphHistory;      /* samples kept by graph meters, two per column */
 
    int direction;
    int treeDirection;
    ProcessField sortKey;
    ProcessField treeSortKey;
+   ProcessField groupBy;  /* column the process list is grouped by, 0 for none */
 
    bool countCPUsFromOne;
    bool detailedCPUTime;
@@ -70,6 +75,7 @@ typedef struct Settings_ {
    bool stripExeFromCmdline;
    bool showMergedCommand;
    bool updateProcessNames;
+   bool collectVisibleOnly;
    bool accountGuestInCPUMeter;
    bool headerMargin;
    #ifdef HAVE_GETMOUSE
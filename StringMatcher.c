@@ -0,0 +1,159 @@
+/*
+htop - StringMatcher.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "StringMatcher.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "XUtils.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+static inline unsigned char foldChar(unsigned char c) {
+   return (c >= 'A' && c <= 'Z') ? (c | 0x20) : c;
+}
+
+/* Bits to OR into a haystack byte before comparing it against needle byte c */
+static inline unsigned char foldMask(unsigned char c) {
+   return (c >= 'a' && c <= 'z') ? 0x20 : 0;
+}
+
+void StringMatcher_init(StringMatcher* this) {
+   this->buffer = NULL;
+   this->terms = NULL;
+   this->count = 0;
+   this->allocd = 0;
+   this->hasPositive = false;
+}
+
+void StringMatcher_done(StringMatcher* this) {
+   free(this->buffer);
+   free(this->terms);
+   StringMatcher_init(this);
+}
+
+void StringMatcher_compile(StringMatcher* this, const char* pattern) {
+   free(this->buffer);
+   this->buffer = NULL;
+   this->count = 0;
+   this->hasPositive = false;
+
+   if (!pattern || !pattern[0])
+      return;
+
+   this->buffer = xStrdup(pattern);
+
+   char* at = this->buffer;
+   for (;;) {
+      char* sep = strchr(at, '|');
+      if (sep)
+         *sep = '\0';
+
+      bool negate = at[0] == '!';
+      char* needle = negate ? at + 1 : at;
+      size_t len = 0;
+      for (; needle[len]; len++)
+         needle[len] = (char)foldChar((unsigned char)needle[len]);
+
+      if (len > 0) {
+         if (this->count == this->allocd) {
+            this->allocd = this->allocd ? this->allocd * 2 : 4;
+            this->terms = xReallocArray(this->terms, this->allocd, sizeof(StringMatcherTerm));
+         }
+         this->terms[this->count++] = (StringMatcherTerm) {
+            .needle = needle,
+            .len = len,
+            .negate = negate,
+         };
+         this->hasPositive |= !negate;
+      }
+
+      if (!sep)
+         break;
+
+      at = sep + 1;
+   }
+}
+
+static inline bool equalsFolded(const char* str, const StringMatcherTerm* term) {
+   for (size_t k = 0; k < term->len; k++) {
+      if (foldChar((unsigned char)str[k]) != (unsigned char)term->needle[k])
+         return false;
+   }
+   return true;
+}
+
+static bool StringMatcher_findTerm(const StringMatcherTerm* term, const char* str, size_t slen) {
+   if (term->len > slen)
+      return false;
+
+   /* start offsets 0 .. last are candidates */
+   const size_t last = slen - term->len;
+   const unsigned char c0 = (unsigned char)term->needle[0];
+   const unsigned char c1 = (unsigned char)term->needle[term->len > 1 ? 1 : 0];
+   const size_t off1 = term->len > 1 ? 1 : 0;
+   size_t i = 0;
+
+#ifdef __SSE2__
+   /* Compare the first two needle bytes at 16 candidate offsets at once,
+    * verify only the offsets where both match */
+   const __m128i m0 = _mm_set1_epi8((char)foldMask(c0));
+   const __m128i v0 = _mm_set1_epi8((char)c0);
+   const __m128i m1 = _mm_set1_epi8((char)foldMask(c1));
+   const __m128i v1 = _mm_set1_epi8((char)c1);
+
+   for (; i + 16 <= last + 1; i += 16) {
+      const __m128i b0 = _mm_loadu_si128((const __m128i*)(str + i));
+      const __m128i b1 = _mm_loadu_si128((const __m128i*)(str + i + off1));
+      const __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(_mm_or_si128(b0, m0), v0),
+                                       _mm_cmpeq_epi8(_mm_or_si128(b1, m1), v1));
+      unsigned int bits = (unsigned int)_mm_movemask_epi8(eq);
+      while (bits) {
+         unsigned int k = (unsigned int)__builtin_ctz(bits);
+         if (equalsFolded(str + i + k, term))
+            return true;
+         bits &= bits - 1;
+      }
+   }
+#endif
+
+   for (; i <= last; i++) {
+      if (foldChar((unsigned char)str[i]) == c0 &&
+          foldChar((unsigned char)str[i + off1]) == c1 &&
+          equalsFolded(str + i, term))
+         return true;
+   }
+
+   return false;
+}
+
+bool StringMatcher_matches(const StringMatcher* this, const char* str) {
+   if (this->count == 0)
+      return true;
+
+   const size_t slen = strlen(str);
+   bool found = !this->hasPositive;
+
+   for (size_t i = 0; i < this->count; i++) {
+      const StringMatcherTerm* term = &this->terms[i];
+      if (term->negate) {
+         if (StringMatcher_findTerm(term, str, slen))
+            return false;
+      } else if (!found) {
+         found = StringMatcher_findTerm(term, str, slen);
+      }
+   }
+
+   return found;
+}
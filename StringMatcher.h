@@ -0,0 +1,45 @@
+#ifndef HEADER_StringMatcher
+#define HEADER_StringMatcher
+/*
+htop - StringMatcher.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/*
+ * Case-insensitive substring matcher, compiled once per pattern.
+ *
+ * A pattern consists of terms separated by '|'. A line matches if it
+ * contains any of the plain terms (or there are none) and none of the
+ * terms prefixed with '!'. Case folding covers ASCII letters only.
+ */
+
+typedef struct StringMatcherTerm_ {
+   const char* needle;      /* lower-cased, points into StringMatcher.buffer */
+   size_t len;
+   bool negate;
+} StringMatcherTerm;
+
+typedef struct StringMatcher_ {
+   char* buffer;
+   StringMatcherTerm* terms;
+   size_t count;
+   size_t allocd;
+   bool hasPositive;
+} StringMatcher;
+
+void StringMatcher_init(StringMatcher* this);
+
+void StringMatcher_done(StringMatcher* this);
+
+/* Recompile with a new pattern; a NULL or empty pattern matches everything */
+void StringMatcher_compile(StringMatcher* this, const char* pattern);
+
+bool StringMatcher_matches(const StringMatcher* this, const char* str);
+
+#endif
@@ -17,6 +17,7 @@ in the source distribution for its full text.
 #include "DiskIOMeter.h"
 #include "Hashtable.h"
 #include "NetworkIOMeter.h"
+#include "OpenFilesScreen.h"
 #include "ProcessLocksScreen.h"
 #include "SignalsPanel.h"
 #include "darwin/DarwinProcess.h"
@@ -69,9 +70,11 @@ char* Platform_getInodeFilename(pid_t pid, ino_t inode);
 
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid);
 
-bool Platform_getDiskIO(DiskIOData* data);
+OpenFiles_ProcessData* Platform_getProcessFiles(pid_t pid);
 
-bool Platform_getNetworkIO(NetworkIOData* data);
+bool Platform_getDiskIO(DiskIOData* data, DiskIODevices* devices);
+
+bool Platform_getNetworkIO(NetworkIOData* data, NetworkIOInterfaces* interfaces);
 
 void Platform_getBattery(double* percent, ACPresence* isOnAC);
 
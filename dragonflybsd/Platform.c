@@ -231,15 +231,22 @@ FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    return NULL;
 }
 
-bool Platform_getDiskIO(DiskIOData* data) {
+OpenFiles_ProcessData* Platform_getProcessFiles(pid_t pid) {
+   (void)pid;
+   return NULL;
+}
+
+bool Platform_getDiskIO(DiskIOData* data, DiskIODevices* devices) {
    // TODO
    (void)data;
+   (void)devices;
    return false;
 }
 
-bool Platform_getNetworkIO(NetworkIOData* data) {
+bool Platform_getNetworkIO(NetworkIOData* data, NetworkIOInterfaces* interfaces) {
    // TODO
    (void)data;
+   (void)interfaces;
    return false;
 }
 
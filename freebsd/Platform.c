@@ -279,7 +279,12 @@ FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    return NULL;
 }
 
-bool Platform_getDiskIO(DiskIOData* data) {
+OpenFiles_ProcessData* Platform_getProcessFiles(pid_t pid) {
+   (void)pid;
+   return NULL;
+}
+
+bool Platform_getDiskIO(DiskIOData* data, ATTR_UNUSED DiskIODevices* devices) {
 
    if (devstat_checkversion(NULL) < 0)
       return false;
@@ -319,7 +324,7 @@ bool Platform_getDiskIO(DiskIOData* data) {
    return true;
 }
 
-bool Platform_getNetworkIO(NetworkIOData* data) {
+bool Platform_getNetworkIO(NetworkIOData* data, ATTR_UNUSED NetworkIOInterfaces* interfaces) {
    // get number of interfaces
    int count;
    size_t countLen = sizeof(count);
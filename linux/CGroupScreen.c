@@ -0,0 +1,318 @@
+/*
+htop - CGroupScreen.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupScreen.h"
+
+#include <ctype.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "Macros.h"
+#include "Meter.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "Vector.h"
+#include "XUtils.h"
+#include "generic/gettime.h"
+#include "linux/CGroupUtils.h"
+#include "linux/PressureStall.h"
+
+
+#define CGROUP_MAX_DEPTH 64
+
+/* Cumulative counters of one cgroup, kept between scans to compute rates */
+typedef struct CGroupSample_ {
+   unsigned long long cpuUsec;
+   unsigned long long readBytes;
+   unsigned long long writeBytes;
+   unsigned long long stallUsec[LAST_PRESSURE_STALL_RESOURCE];   /* "some" totals */
+   bool hasCPU;
+   bool hasIO;
+   bool hasPressure[LAST_PRESSURE_STALL_RESOURCE];
+} CGroupSample;
+
+CGroupScreen* CGroupScreen_new(void) {
+   CGroupScreen* this = xCalloc(1, sizeof(CGroupScreen));
+   Object_setClass(this, Class(CGroupScreen));
+   this->mountPoint = CGroup_findMountPoint();
+   this->samples = Hashtable_new(64, true);
+   return (CGroupScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, "  CPU%      MEM   READ/s  WRITE/s  CPUPSI  IOPSI MEMPSI  TASKS  CGROUP");
+}
+
+static void CGroupScreen_clearEntries(CGroupScreen* this) {
+   for (size_t i = 0; i < this->count; i++)
+      free(this->entries[i].name);
+   this->count = 0;
+}
+
+void CGroupScreen_delete(Object* cast) {
+   CGroupScreen* this = (CGroupScreen*) cast;
+   CGroupScreen_clearEntries(this);
+   free(this->entries);
+   Hashtable_delete(this->samples);
+   free(this->mountPoint);
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void CGroupScreen_draw(InfoScreen* super) {
+   const CGroupScreen* this = (const CGroupScreen*) super;
+   InfoScreen_drawTitled(super, "Control groups at %s", this->mountPoint ? this->mountPoint : "(not mounted)");
+}
+
+static unsigned long long CGroupScreen_readValue(int dirfd, const char* file, bool* ok) {
+   char buffer[32];
+   ssize_t res = xReadfileat(dirfd, file, buffer, sizeof(buffer));
+   *ok = res > 0 && isdigit((unsigned char)buffer[0]);
+   return *ok ? strtoull(buffer, NULL, 10) : 0;
+}
+
+/* Value of "key N" in a flat keyed file like cpu.stat */
+static bool CGroupScreen_readKeyed(int dirfd, const char* file, const char* key, unsigned long long* value) {
+   char buffer[1024];
+   ssize_t res = xReadfileat(dirfd, file, buffer, sizeof(buffer));
+   if (res < 1)
+      return false;
+
+   size_t keyLen = strlen(key);
+   for (const char* line = buffer; line; line = strchr(line, '\n')) {
+      if (*line == '\n')
+         line++;
+      if (strncmp(line, key, keyLen) == 0 && line[keyLen] == ' ') {
+         *value = strtoull(line + keyLen + 1, NULL, 10);
+         return true;
+      }
+   }
+   return false;
+}
+
+/* io.stat has one line per device: "MAJ:MIN rbytes=N wbytes=N rios=N wios=N ..." */
+static bool CGroupScreen_readIO(int dirfd, unsigned long long* readBytes, unsigned long long* writeBytes) {
+   char buffer[16384];
+   ssize_t res = xReadfileat(dirfd, "io.stat", buffer, sizeof(buffer));
+   if (res < 0)
+      return false;
+
+   *readBytes = 0;
+   *writeBytes = 0;
+   for (const char* at = buffer; (at = strchr(at, '=')) != NULL; at++) {
+      if (at - buffer >= 6 && String_startsWith(at - 6, "rbytes"))
+         *readBytes += strtoull(at + 1, NULL, 10);
+      else if (at - buffer >= 6 && String_startsWith(at - 6, "wbytes"))
+         *writeBytes += strtoull(at + 1, NULL, 10);
+   }
+   return true;
+}
+
+static unsigned long long CGroupScreen_countLines(int dirfd, const char* file) {
+   char buffer[65536];
+   ssize_t res = xReadfileat(dirfd, file, buffer, sizeof(buffer));
+   unsigned long long lines = 0;
+   for (ssize_t i = 0; i < res; i++)
+      lines += buffer[i] == '\n';
+   return lines;
+}
+
+static int CGroupScreen_compareNames(const void* a, const void* b) {
+   return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+static size_t CGroupScreen_walk(CGroupScreen* this, Hashtable* samples, int dirfd, const char* name, int depth) {
+   if (this->count == this->allocd) {
+      this->allocd = this->allocd ? this->allocd * 2 : 64;
+      this->entries = xReallocArray(this->entries, this->allocd, sizeof(CGroupEntry));
+   }
+
+   size_t index = this->count++;
+   CGroupEntry* entry = &this->entries[index];
+   *entry = (CGroupEntry) {
+      .name = xStrdup(name),
+      .depth = depth,
+      .cpuPercent = NAN,
+      .memory = -1,
+      .readRate = NAN,
+      .writeRate = NAN,
+   };
+
+   CGroupSample* sample = xCalloc(1, sizeof(CGroupSample));
+   sample->hasCPU = CGroupScreen_readKeyed(dirfd, "cpu.stat", "usage_usec", &sample->cpuUsec);
+   sample->hasIO = CGroupScreen_readIO(dirfd, &sample->readBytes, &sample->writeBytes);
+   for (int r = 0; r < LAST_PRESSURE_STALL_RESOURCE; r++) {
+      PressureStallData data;
+      sample->hasPressure[r] = CGroup_readPressure(dirfd, (PressureStallResource)r, &data);
+      sample->stallUsec[r] = data.some.total;
+      entry->pressure[r] = sample->hasPressure[r] ? data.some.avg10 : NAN;
+   }
+
+   bool ok;
+   unsigned long long memory = CGroupScreen_readValue(dirfd, "memory.current", &ok);
+   if (ok)
+      entry->memory = memory;
+
+   /* pids.current counts the whole subtree, cgroup.threads only this cgroup */
+   bool haveTasks;
+   entry->tasks = CGroupScreen_readValue(dirfd, "pids.current", &haveTasks);
+   if (!haveTasks)
+      entry->tasks = CGroupScreen_countLines(dirfd, "cgroup.threads");
+
+   struct stat sb;
+   if (fstat(dirfd, &sb) == 0) {
+      const CGroupSample* prev = Hashtable_get(this->samples, (ht_key_t)sb.st_ino);
+      if (prev && this->elapsed > 0) {
+         const double seconds = this->elapsed / 1000.0;
+         if (sample->hasCPU && prev->hasCPU)
+            entry->cpuPercent = saturatingSub(sample->cpuUsec, prev->cpuUsec) / (seconds * 10000.0);
+         if (sample->hasIO && prev->hasIO) {
+            entry->readRate = saturatingSub(sample->readBytes, prev->readBytes) / seconds;
+            entry->writeRate = saturatingSub(sample->writeBytes, prev->writeBytes) / seconds;
+         }
+         for (int r = 0; r < LAST_PRESSURE_STALL_RESOURCE; r++) {
+            if (sample->hasPressure[r] && prev->hasPressure[r])
+               entry->pressure[r] = PressureStall_percent(sample->stallUsec[r], prev->stallUsec[r], this->elapsed);
+         }
+      }
+      Hashtable_put(samples, (ht_key_t)sb.st_ino, sample);
+   } else {
+      free(sample);
+   }
+
+   if (depth >= CGROUP_MAX_DEPTH)
+      return index;
+
+   int listFd = openat(dirfd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   DIR* dir = listFd >= 0 ? fdopendir(listFd) : NULL;
+   if (!dir) {
+      if (listFd >= 0)
+         close(listFd);
+      return index;
+   }
+
+   char** children = NULL;
+   size_t nChildren = 0, allocd = 0;
+   const struct dirent* dirEntry;
+   while ((dirEntry = readdir(dir)) != NULL) {
+      if (dirEntry->d_type != DT_DIR || dirEntry->d_name[0] == '.')
+         continue;
+      if (nChildren == allocd) {
+         allocd = allocd ? allocd * 2 : 8;
+         children = xReallocArray(children, allocd, sizeof(char*));
+      }
+      children[nChildren++] = xStrdup(dirEntry->d_name);
+   }
+   closedir(dir);
+
+   if (nChildren > 1)
+      qsort(children, nChildren, sizeof(char*), CGroupScreen_compareNames);
+
+   for (size_t i = 0; i < nChildren; i++) {
+      int childFd = openat(dirfd, children[i], O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      if (childFd >= 0) {
+         size_t child = CGroupScreen_walk(this, samples, childFd, children[i], depth + 1);
+         if (!haveTasks)
+            this->entries[index].tasks += this->entries[child].tasks;
+         close(childFd);
+      }
+      free(children[i]);
+   }
+   free(children);
+
+   return index;
+}
+
+static void CGroupScreen_formatBytes(char* buffer, size_t size, double bytes) {
+   if (isnan(bytes) || bytes < 0) {
+      xSnprintf(buffer, size, "-");
+   } else {
+      Meter_humanUnit(buffer, (unsigned long)(bytes / ONE_K), size);
+   }
+}
+
+static void CGroupScreen_formatPercent(char* buffer, size_t size, double percent) {
+   if (isnan(percent)) {
+      xSnprintf(buffer, size, "-");
+   } else {
+      xSnprintf(buffer, size, "%.1f", percent);
+   }
+}
+
+static void CGroupScreen_scan(InfoScreen* super) {
+   CGroupScreen* this = (CGroupScreen*) super;
+   Panel* panel = super->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+
+   if (!this->mountPoint) {
+      InfoScreen_addLine(super, "No cgroup v2 hierarchy is mounted.");
+      return;
+   }
+
+   int rootFd = open(this->mountPoint, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (rootFd < 0) {
+      InfoScreen_addLine(super, "Could not open the cgroup v2 hierarchy.");
+      return;
+   }
+
+   uint64_t now;
+   Generic_gettime_monotonic(&now);
+   this->elapsed = this->lastScan ? now - this->lastScan : 0;
+   this->lastScan = now;
+
+   CGroupScreen_clearEntries(this);
+   Hashtable* samples = Hashtable_new(64, true);
+   CGroupScreen_walk(this, samples, rootFd, "/", 0);
+   close(rootFd);
+
+   Hashtable_delete(this->samples);
+   this->samples = samples;
+
+   for (size_t i = 0; i < this->count; i++) {
+      const CGroupEntry* entry = &this->entries[i];
+
+      char cpu[16], memory[16], readRate[16], writeRate[16];
+      char pressure[LAST_PRESSURE_STALL_RESOURCE][16];
+      CGroupScreen_formatPercent(cpu, sizeof(cpu), entry->cpuPercent);
+      for (int r = 0; r < LAST_PRESSURE_STALL_RESOURCE; r++)
+         CGroupScreen_formatPercent(pressure[r], sizeof(pressure[r]), entry->pressure[r]);
+      CGroupScreen_formatBytes(memory, sizeof(memory), entry->memory);
+      CGroupScreen_formatBytes(readRate, sizeof(readRate), entry->readRate);
+      CGroupScreen_formatBytes(writeRate, sizeof(writeRate), entry->writeRate);
+
+      char line[512];
+      xSnprintf(line, sizeof(line), "%6s %8s %8s %8s %7s %6s %6s %6llu  %*s%s",
+         cpu, memory, readRate, writeRate,
+         pressure[PRESSURE_STALL_CPU], pressure[PRESSURE_STALL_IO], pressure[PRESSURE_STALL_MEMORY],
+         entry->tasks,
+         2 * entry->depth, "", entry->name);
+      InfoScreen_addLine(super, line);
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+static void CGroupScreen_onErr(InfoScreen* super) {
+   Vector_prune(super->lines);
+   InfoScreen_scan(super);
+   InfoScreen_draw(super);
+}
+
+const InfoScreenClass CGroupScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = CGroupScreen_delete
+   },
+   .scan = CGroupScreen_scan,
+   .draw = CGroupScreen_draw,
+   .onErr = CGroupScreen_onErr
+};
@@ -0,0 +1,47 @@
+#ifndef HEADER_CGroupScreen
+#define HEADER_CGroupScreen
+/*
+htop - CGroupScreen.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Hashtable.h"
+#include "InfoScreen.h"
+#include "Object.h"
+#include "linux/PressureStall.h"
+
+
+typedef struct CGroupEntry_ {
+   char* name;              /* last path component, "/" for the root */
+   int depth;
+   double cpuPercent;       /* NAN if unknown */
+   long long memory;        /* bytes, -1 if unknown */
+   double readRate;         /* bytes per second, NAN if unknown */
+   double writeRate;
+   double pressure[LAST_PRESSURE_STALL_RESOURCE];   /* "some" stall percent, NAN if unknown */
+   unsigned long long tasks;
+} CGroupEntry;
+
+typedef struct CGroupScreen_ {
+   InfoScreen super;
+   char* mountPoint;        /* of the cgroup2 hierarchy, NULL if none */
+   Hashtable* samples;      /* counters of the previous scan, by cgroup inode */
+   uint64_t lastScan;       /* monotonic, in milliseconds */
+   uint64_t elapsed;        /* between the last two scans */
+   CGroupEntry* entries;    /* in tree order */
+   size_t count;
+   size_t allocd;
+} CGroupScreen;
+
+extern const InfoScreenClass CGroupScreen_class;
+
+CGroupScreen* CGroupScreen_new(void);
+
+void CGroupScreen_delete(Object* this);
+
+#endif
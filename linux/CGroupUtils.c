@@ -0,0 +1,89 @@
+/*
+htop - CGroupUtils.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupUtils.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "XUtils.h"
+
+
+#ifndef PROCDIR
+#define PROCDIR "/proc"
+#endif
+
+char* CGroup_findMountPoint(void) {
+   FILE* file = fopen(PROCDIR "/self/mounts", "r");
+   if (!file)
+      return NULL;
+
+   char* mountPoint = NULL;
+   char buffer[1024];
+   while (fgets(buffer, sizeof(buffer), file)) {
+      /* "cgroup2 /sys/fs/cgroup cgroup2 rw,nosuid,... 0 0" */
+      char* dir = strchr(buffer, ' ');
+      if (!dir)
+         continue;
+      dir++;
+
+      char* type = strchr(dir, ' ');
+      if (!type)
+         continue;
+      *type++ = '\0';
+
+      if (String_startsWith(type, "cgroup2 ")) {
+         mountPoint = xStrdup(dir);
+         break;
+      }
+   }
+
+   fclose(file);
+   return mountPoint;
+}
+
+bool CGroup_unifiedPath(const char* cgroup, char* buffer, size_t size) {
+   if (!cgroup)
+      return false;
+
+   /* entries of /proc/PID/cgroup without the hierarchy id, separated by ';';
+    * the v2 one has no controllers: "::/system.slice/foo.service" */
+   const char* at = cgroup;
+   while (!String_startsWith(at, "::/")) {
+      at = strchr(at, ';');
+      if (!at)
+         return false;
+      at++;
+   }
+   at += strlen("::/");
+
+   size_t len = strcspn(at, ";\n");
+   if (len == 0) {
+      xSnprintf(buffer, size, ".");
+      return true;
+   }
+   if (len >= size)
+      return false;
+
+   memcpy(buffer, at, len);
+   buffer[len] = '\0';
+   return true;
+}
+
+bool CGroup_readPressure(int dirfd, PressureStallResource resource, PressureStallData* data) {
+   char file[32];
+   xSnprintf(file, sizeof(file), "%s.pressure", PressureStall_resourceNames[resource]);
+
+   char buffer[256];
+   ssize_t res = xReadfileat(dirfd, file, buffer, sizeof(buffer));
+   if (res < 1)
+      return false;
+
+   return PressureStall_parse(buffer, data);
+}
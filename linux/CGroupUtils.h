@@ -0,0 +1,26 @@
+#ifndef HEADER_CGroupUtils
+#define HEADER_CGroupUtils
+/*
+htop - CGroupUtils.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "linux/PressureStall.h"
+
+
+/* Mount point of the cgroup v2 hierarchy, NULL if none is mounted */
+char* CGroup_findMountPoint(void);
+
+/* Path of the cgroup v2 entry in a process' cgroup column, relative to the
+ * mount point ("." for the root); false if the process has none */
+bool CGroup_unifiedPath(const char* cgroup, char* buffer, size_t size);
+
+/* Read <resource>.pressure of the cgroup directory dirfd */
+bool CGroup_readPressure(int dirfd, PressureStallResource resource, PressureStallData* data);
+
+#endif
@@ -0,0 +1,83 @@
+/*
+htop - FileHoldersScreen.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/FileHoldersScreen.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "XUtils.h"
+
+
+/* Holders listed on the line of a file, the others are counted */
+#define FILE_HOLDERS_SHOWN 8
+
+FileHoldersScreen* FileHoldersScreen_new(void) {
+   FileHoldersScreen* this = xCalloc(1, sizeof(FileHoldersScreen));
+   Object_setClass(this, Class(FileHoldersScreen));
+   this->index = FileIndex_new();
+   return (FileHoldersScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, "  FDS TYPE    NAME  <-  PID/COMMAND (FD)");
+}
+
+void FileHoldersScreen_delete(Object* cast) {
+   FileHoldersScreen* this = (FileHoldersScreen*) cast;
+   FileIndex_delete(this->index);
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void FileHoldersScreen_draw(InfoScreen* super) {
+   const FileIndex* index = ((const FileHoldersScreen*) super)->index;
+   InfoScreen_drawTitled(super, "Files open in %zu processes (%zu not accessible), %zu descriptors read - filter by path or :port",
+      index->processCount, index->unreadable, index->linksRead);
+}
+
+static void FileHoldersScreen_scan(InfoScreen* super) {
+   FileHoldersScreen* this = (FileHoldersScreen*) super;
+   Panel* panel = super->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+   FileIndex_refresh(this->index);
+
+   const FileIndex* index = this->index;
+   for (size_t i = 0; i < index->fileCount; i++) {
+      const FileIndex_File* file = &index->files[i];
+
+      size_t size = strlen(file->name) + 64 + FILE_HOLDERS_SHOWN * 40;
+      char* line = xMalloc(size);
+      int len = xSnprintf(line, size, "%5zu %-7.7s %s  <- ", file->count, file->type, file->name);
+
+      for (size_t j = 0; j < file->count; j++) {
+         const FileIndex_Holding* holding = &file->holdings[j];
+         if (j == FILE_HOLDERS_SHOWN) {
+            len += xSnprintf(line + len, size - len, " +%zu", file->count - j);
+            break;
+         }
+         len += xSnprintf(line + len, size - len, "%s%d/%.15s (%d)",
+            j ? " " : "", holding->process->pid, holding->process->comm, holding->record->fd);
+      }
+
+      InfoScreen_addLine(super, line);
+      free(line);
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+const InfoScreenClass FileHoldersScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = FileHoldersScreen_delete
+   },
+   .scan = FileHoldersScreen_scan,
+   .draw = FileHoldersScreen_draw
+};
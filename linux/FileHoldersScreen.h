@@ -0,0 +1,26 @@
+#ifndef HEADER_FileHoldersScreen
+#define HEADER_FileHoldersScreen
+/*
+htop - FileHoldersScreen.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "linux/FileIndex.h"
+
+
+typedef struct FileHoldersScreen_ {
+   InfoScreen super;
+   FileIndex* index;          /* kept between refreshes */
+} FileHoldersScreen;
+
+extern const InfoScreenClass FileHoldersScreen_class;
+
+FileHoldersScreen* FileHoldersScreen_new(void);
+
+void FileHoldersScreen_delete(Object* this);
+
+#endif
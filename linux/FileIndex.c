@@ -0,0 +1,363 @@
+/*
+htop - FileIndex.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/FileIndex.h"
+
+#include <ctype.h>
+#include <dirent.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "Compat.h"
+#include "Macros.h"
+#include "XUtils.h"
+
+#include "linux/LinuxProcessList.h"
+
+
+/* Processes a worker takes at once */
+#define FILE_INDEX_BATCH 16
+
+typedef struct FileIndex_Queue_ {
+   FileIndex_Process** processes;
+   size_t count;
+} FileIndex_Queue;
+
+const char* FileIndex_typeName(mode_t mode, const char* target) {
+   if (String_startsWith(target, "anon_inode:"))
+      return "a_inode";
+
+   switch (mode & S_IFMT) {
+      case S_IFREG:  return "REG";
+      case S_IFDIR:  return "DIR";
+      case S_IFCHR:  return "CHR";
+      case S_IFBLK:  return "BLK";
+      case S_IFIFO:  return "FIFO";
+      case S_IFLNK:  return "LINK";
+      case S_IFSOCK: return "sock";
+      default:       return "unknown";
+   }
+}
+
+FileIndex* FileIndex_new(void) {
+   FileIndex* this = xCalloc(1, sizeof(FileIndex));
+   this->processes = Hashtable_new(256, false);
+   this->sockets = SocketTable_new();
+   this->workers = WorkerPool_new(WORKER_POOL_MAX_THREADS);
+   return this;
+}
+
+static void FileIndex_clearRecords(FileIndex_Process* proc) {
+   for (size_t i = 0; i < proc->count; i++) {
+      free(proc->records[i].name);
+      free(proc->records[i].socket);
+   }
+   proc->count = 0;
+}
+
+static void FileIndex_freeProcess(FileIndex_Process* proc) {
+   FileIndex_clearRecords(proc);
+   free(proc->records);
+   free(proc);
+}
+
+static void FileIndex_deleteProcess(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* userdata) {
+   FileIndex_freeProcess(value);
+}
+
+void FileIndex_delete(FileIndex* this) {
+   Hashtable_foreach(this->processes, FileIndex_deleteProcess, NULL);
+   Hashtable_delete(this->processes);
+   SocketTable_delete(this->sockets);
+   WorkerPool_delete(this->workers);
+   free(this->holdings);
+   free(this->files);
+   free(this);
+}
+
+static int FileIndex_compareFds(const void* v1, const void* v2) {
+   const FileIndex_Record* r1 = v1;
+   const FileIndex_Record* r2 = v2;
+   return SPACESHIP_NUMBER(r1->fd, r2->fd);
+}
+
+/* Reads a descriptor not listed before, unless it was closed meanwhile */
+static void FileIndex_readRecord(FileIndex_Process* proc, int dirfd, const char* path, const char* name) {
+   char target[PATH_MAX];
+   ssize_t n = Compat_readlinkat(dirfd, path, name, target, sizeof(target) - 1);
+   if (n < 0)
+      return;
+   target[n] = '\0';
+
+   struct stat sb;
+   if (Compat_fstatat(dirfd, path, name, &sb, 0) != 0)
+      return;
+
+   if (proc->count == proc->allocd) {
+      proc->allocd = proc->allocd ? proc->allocd * 2 : 16;
+      proc->records = xReallocArray(proc->records, proc->allocd, sizeof(FileIndex_Record));
+   }
+   proc->records[proc->count++] = (FileIndex_Record) {
+      .dev = sb.st_dev,
+      .inode = sb.st_ino,
+      .fd = atoi(name),
+      .type = FileIndex_typeName(sb.st_mode, target),
+      .name = xStrdup(target),
+      .socket = S_ISSOCK(sb.st_mode) ? xStrdup(target) : NULL,
+      .listed = true,
+   };
+   proc->linksRead++;
+}
+
+/* Runs in a worker: touches nothing but the process */
+static void FileIndex_readProcess(FileIndex_Process* proc) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/fd", proc->pid);
+
+   struct stat sb;
+   if (stat(path, &sb) != 0) {
+      /* exited meanwhile */
+      proc->seen = false;
+      return;
+   }
+
+   bool changed = sb.st_ino != proc->dirInode;
+   if (changed) {
+      FileIndex_clearRecords(proc);
+      proc->dirInode = sb.st_ino;
+   }
+   proc->linksRead = 0;
+
+   DIR* dirp = opendir(path);
+   proc->readable = dirp != NULL;
+   if (!dirp) {
+      FileIndex_clearRecords(proc);
+      return;
+   }
+
+   /* the readdir() of procfs costs no call per descriptor, unlike reading
+    * one, so only descriptors of numbers not known yet are read */
+   size_t known = proc->count;
+   for (size_t i = 0; i < known; i++)
+      proc->records[i].listed = false;
+
+   int fd = dirfd(dirp);
+   const struct dirent* de;
+   while ((de = readdir(dirp))) {
+      if (!isdigit((unsigned char)de->d_name[0]))
+         continue;
+
+      FileIndex_Record key = { .fd = atoi(de->d_name) };
+      FileIndex_Record* record = bsearch(&key, proc->records, known, sizeof(FileIndex_Record), FileIndex_compareFds);
+      if (record)
+         record->listed = true;
+      else
+         FileIndex_readRecord(proc, fd, path, de->d_name);
+   }
+   closedir(dirp);
+
+   size_t kept = 0;
+   for (size_t i = 0; i < proc->count; i++) {
+      FileIndex_Record* record = &proc->records[i];
+      if (record->listed) {
+         proc->records[kept++] = *record;
+      } else {
+         free(record->name);
+         free(record->socket);
+      }
+   }
+   changed = changed || kept < proc->count || proc->linksRead > 0;
+   proc->count = kept;
+   if (proc->linksRead > 0)
+      qsort(proc->records, proc->count, sizeof(FileIndex_Record), FileIndex_compareFds);
+
+   if (!changed)
+      return;
+
+   char commPath[64];
+   xSnprintf(commPath, sizeof(commPath), PROCDIR "/%d/comm", proc->pid);
+   ssize_t len = xReadfile(commPath, proc->comm, sizeof(proc->comm));
+   if (len > 0 && proc->comm[len - 1] == '\n')
+      proc->comm[len - 1] = '\0';
+   else if (len <= 0)
+      proc->comm[0] = '\0';
+}
+
+static bool FileIndex_work(void* context, size_t index) {
+   const FileIndex_Queue* queue = context;
+   FileIndex_readProcess(queue->processes[index]);
+   return true;
+}
+
+/* Sockets are resolved after the workers are done, the table is shared;
+ * on every refresh, as their states change */
+static void FileIndex_resolveSockets(FileIndex* this, FileIndex_Process* proc) {
+   for (size_t i = 0; i < proc->count; i++) {
+      FileIndex_Record* record = &proc->records[i];
+      if (!record->socket)
+         continue;
+
+      const SocketTable_Entry* entry = SocketTable_lookup(this->sockets, proc->pid, record->inode);
+      record->type = entry ? entry->type : "sock";
+      free_and_xStrdup(&record->name, entry ? entry->name : record->socket);
+   }
+}
+
+typedef struct FileIndex_Collect_ {
+   FileIndex* index;
+   pid_t* gone;
+   size_t goneCount;
+   size_t goneAllocd;
+   size_t records;
+} FileIndex_Collect;
+
+static void FileIndex_collect(ht_key_t key, void* value, void* userdata) {
+   FileIndex_Collect* collect = userdata;
+   FileIndex_Process* proc = value;
+
+   if (!proc->seen) {
+      if (collect->goneCount == collect->goneAllocd) {
+         collect->goneAllocd = collect->goneAllocd ? collect->goneAllocd * 2 : 64;
+         collect->gone = xReallocArray(collect->gone, collect->goneAllocd, sizeof(pid_t));
+      }
+      collect->gone[collect->goneCount++] = (pid_t) key;
+      return;
+   }
+   proc->seen = false;
+
+   FileIndex_resolveSockets(collect->index, proc);
+   if (!proc->readable)
+      collect->index->unreadable++;
+   collect->records += proc->count;
+}
+
+typedef struct FileIndex_Group_ {
+   FileIndex* index;
+   size_t at;
+} FileIndex_Group;
+
+static void FileIndex_addHoldings(ATTR_UNUSED ht_key_t key, void* value, void* userdata) {
+   FileIndex_Group* group = userdata;
+   const FileIndex_Process* proc = value;
+
+   for (size_t i = 0; i < proc->count; i++) {
+      group->index->holdings[group->at++] = (FileIndex_Holding) {
+         .record = &proc->records[i],
+         .process = proc,
+      };
+   }
+}
+
+/* Orders by file: descriptors of the anon inode fs, e.g. of an eventfd or
+ * an epoll instance, all share one inode, so the target tells their kind */
+static int FileIndex_compareRecords(const FileIndex_Record* r1, const FileIndex_Record* r2) {
+   int r = SPACESHIP_NUMBER(r1->dev, r2->dev);
+   if (r == 0)
+      r = SPACESHIP_NUMBER(r1->inode, r2->inode);
+   if (r == 0 && String_startsWith(r1->name, "anon_inode:"))
+      r = strcmp(r1->name, r2->name);
+   return r;
+}
+
+static int FileIndex_compareHoldings(const void* v1, const void* v2) {
+   const FileIndex_Holding* h1 = v1;
+   const FileIndex_Holding* h2 = v2;
+
+   int r = FileIndex_compareRecords(h1->record, h2->record);
+   if (r == 0)
+      r = SPACESHIP_NUMBER(h1->process->pid, h2->process->pid);
+   if (r == 0)
+      r = SPACESHIP_NUMBER(h1->record->fd, h2->record->fd);
+   return r;
+}
+
+static int FileIndex_compareFiles(const void* v1, const void* v2) {
+   const FileIndex_File* f1 = v1;
+   const FileIndex_File* f2 = v2;
+   return strcmp(f1->name, f2->name);
+}
+
+void FileIndex_refresh(FileIndex* this) {
+   DIR* dirp = opendir(PROCDIR);
+   if (!dirp)
+      return;
+
+   FileIndex_Queue queue = {0};
+   size_t allocd = 0;
+
+   const struct dirent* de;
+   while ((de = readdir(dirp))) {
+      if (!isdigit((unsigned char)de->d_name[0]))
+         continue;
+
+      pid_t pid = atoi(de->d_name);
+      FileIndex_Process* proc = Hashtable_get(this->processes, (ht_key_t) pid);
+      if (!proc) {
+         proc = xCalloc(1, sizeof(FileIndex_Process));
+         proc->pid = pid;
+         Hashtable_put(this->processes, (ht_key_t) pid, proc);
+      }
+      proc->seen = true;
+
+      if (queue.count == allocd) {
+         allocd = allocd ? allocd * 2 : 256;
+         queue.processes = xReallocArray(queue.processes, allocd, sizeof(FileIndex_Process*));
+      }
+      queue.processes[queue.count++] = proc;
+   }
+   closedir(dirp);
+
+   WorkerPool_run(this->workers, queue.count, FILE_INDEX_BATCH, FileIndex_work, &queue);
+
+   size_t linksRead = 0;
+   for (size_t i = 0; i < queue.count; i++)
+      linksRead += queue.processes[i]->linksRead;
+   free(queue.processes);
+
+   /* read the socket tables again for the current states */
+   SocketTable_expire(this->sockets);
+
+   FileIndex_Collect collect = { .index = this };
+   this->unreadable = 0;
+   Hashtable_foreach(this->processes, FileIndex_collect, &collect);
+   for (size_t i = 0; i < collect.goneCount; i++)
+      FileIndex_freeProcess(Hashtable_remove(this->processes, (ht_key_t) collect.gone[i]));
+   free(collect.gone);
+
+   this->processCount = queue.count;
+   this->linksRead = linksRead;
+
+   /* group the descriptors of all processes by file */
+   this->holdings = xReallocArray(this->holdings, MAXIMUM(collect.records, 1), sizeof(FileIndex_Holding));
+   this->holdingCount = collect.records;
+   FileIndex_Group group = { .index = this };
+   Hashtable_foreach(this->processes, FileIndex_addHoldings, &group);
+   qsort(this->holdings, this->holdingCount, sizeof(FileIndex_Holding), FileIndex_compareHoldings);
+
+   this->files = xReallocArray(this->files, MAXIMUM(this->holdingCount, 1), sizeof(FileIndex_File));
+   this->fileCount = 0;
+   for (size_t i = 0; i < this->holdingCount; ) {
+      const FileIndex_Record* record = this->holdings[i].record;
+      size_t end = i + 1;
+      while (end < this->holdingCount && FileIndex_compareRecords(this->holdings[end].record, record) == 0)
+         end++;
+
+      this->files[this->fileCount++] = (FileIndex_File) {
+         .name = record->name,
+         .type = record->type,
+         .holdings = &this->holdings[i],
+         .count = end - i,
+      };
+      i = end;
+   }
+   qsort(this->files, this->fileCount, sizeof(FileIndex_File), FileIndex_compareFiles);
+}
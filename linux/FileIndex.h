@@ -0,0 +1,81 @@
+#ifndef HEADER_FileIndex
+#define HEADER_FileIndex
+/*
+htop - FileIndex.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+#include "linux/SocketTable.h"
+#include "linux/WorkerPool.h"
+
+
+/* An open descriptor of a process */
+typedef struct FileIndex_Record_ {
+   dev_t dev;
+   ino_t inode;
+   int fd;
+   const char* type;          /* as lsof(8) names it, e.g. REG or IPv4 */
+   char* name;                /* path, or addresses of a socket */
+   char* socket;              /* "socket:[inode]" as read, NULL for other files */
+   bool listed;               /* in the last listing of the process */
+} FileIndex_Record;
+
+typedef struct FileIndex_Process_ {
+   pid_t pid;
+   char comm[16];
+   FileIndex_Record* records; /* by descriptor */
+   size_t count;
+   size_t allocd;
+   size_t linksRead;          /* descriptors read at the last refresh */
+   ino_t dirInode;            /* of /proc/PID/fd, another one for a new process of the pid */
+   bool readable;             /* its descriptors could be listed */
+   bool seen;                 /* in /proc at the last refresh */
+} FileIndex_Process;
+
+typedef struct FileIndex_Holding_ {
+   const FileIndex_Record* record;
+   const FileIndex_Process* process;
+} FileIndex_Holding;
+
+/* A file, pipe or socket and all descriptors open on it */
+typedef struct FileIndex_File_ {
+   const char* name;
+   const char* type;
+   const FileIndex_Holding* holdings;   /* by process */
+   size_t count;
+} FileIndex_File;
+
+typedef struct FileIndex_ {
+   Hashtable* processes;      /* FileIndex_Process by pid */
+   SocketTable* sockets;
+   WorkerPool* workers;       /* read the descriptors of the processes */
+   FileIndex_Holding* holdings;
+   size_t holdingCount;
+   FileIndex_File* files;     /* by name */
+   size_t fileCount;
+   size_t processCount;
+   size_t unreadable;         /* processes whose descriptors are not accessible */
+   size_t linksRead;          /* descriptors read at the last refresh, the others were known */
+} FileIndex;
+
+FileIndex* FileIndex_new(void);
+
+void FileIndex_delete(FileIndex* this);
+
+/* Lists the descriptors of all processes, with a pool of threads, and
+ * regroups them by file. Only descriptors not listed at the last refresh
+ * are read, so one closed and opened again, or replaced with dup2(2), in
+ * between keeps showing its former file until it is closed for longer */
+void FileIndex_refresh(FileIndex* this);
+
+/* The lsof(8) type of a file of the given mode, reached by a link to target */
+const char* FileIndex_typeName(mode_t mode, const char* target);
+
+#endif
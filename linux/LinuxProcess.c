@@ -100,6 +100,9 @@ const ProcessFieldData Process_fields[LAST_PROCESSFIELD] = {
    [CWD] = { .name = "CWD", .title = "CWD                       ", .description = "The current working directory of the process", .flags = PROCESS_FLAG_CWD, },
    [AUTOGROUP_ID] = { .name = "AUTOGROUP_ID", .title = "AGRP", .description = "The autogroup identifier of the process", .flags = PROCESS_FLAG_LINUX_AUTOGROUP, },
    [AUTOGROUP_NICE] = { .name = "AUTOGROUP_NICE", .title = " ANI", .description = "Nice value (the higher the value, the more other processes take priority) associated with the process autogroup", .flags = PROCESS_FLAG_LINUX_AUTOGROUP, },
+   [CGROUP_PSI_CPU] = { .name = "CGROUP_PSI_CPU", .title = "CPUPSI ", .description = "Percentage of time some tasks of the process' cgroup were waiting for a CPU", .flags = PROCESS_FLAG_LINUX_CGROUP | PROCESS_FLAG_LINUX_CGROUP_PSI, .defaultSortDesc = true, },
+   [CGROUP_PSI_IO] = { .name = "CGROUP_PSI_IO", .title = " IOPSI ", .description = "Percentage of time some tasks of the process' cgroup were waiting for I/O", .flags = PROCESS_FLAG_LINUX_CGROUP | PROCESS_FLAG_LINUX_CGROUP_PSI, .defaultSortDesc = true, },
+   [CGROUP_PSI_MEMORY] = { .name = "CGROUP_PSI_MEMORY", .title = "MEMPSI ", .description = "Percentage of time some tasks of the process' cgroup were waiting for memory", .flags = PROCESS_FLAG_LINUX_CGROUP | PROCESS_FLAG_LINUX_CGROUP_PSI, .defaultSortDesc = true, },
 };
 
 Process* LinuxProcess_new(const Settings* settings) {
@@ -190,6 +193,14 @@ bool LinuxProcess_changeAutogroupPriorityBy(Process* this, Arg delta) {
    return success;
 }
 
+static void LinuxProcess_printPressure(float percent, char* buffer, int n) {
+   if (isnan(percent)) {
+      xSnprintf(buffer, n, "   N/A ");
+   } else {
+      xSnprintf(buffer, n, "%6.1f ", percent);
+   }
+}
+
 #ifdef HAVE_DELAYACCT
 static void LinuxProcess_printDelay(float delay_percent, char* buffer, int n) {
    if (isnan(delay_percent)) {
@@ -283,6 +294,9 @@ static void LinuxProcess_writeField(const Process* this, RichString* str, Proces
    case PERCENT_IO_DELAY: LinuxProcess_printDelay(lp->blkio_delay_percent, buffer, n); break;
    case PERCENT_SWAP_DELAY: LinuxProcess_printDelay(lp->swapin_delay_percent, buffer, n); break;
    #endif
+   case CGROUP_PSI_CPU: LinuxProcess_printPressure(lp->cgroup_pressure[PRESSURE_STALL_CPU], buffer, n); break;
+   case CGROUP_PSI_IO: LinuxProcess_printPressure(lp->cgroup_pressure[PRESSURE_STALL_IO], buffer, n); break;
+   case CGROUP_PSI_MEMORY: LinuxProcess_printPressure(lp->cgroup_pressure[PRESSURE_STALL_MEMORY], buffer, n); break;
    case CTXT:
       if (lp->ctxt_diff > 1000) {
          attr |= A_BOLD;
@@ -404,11 +418,77 @@ static int LinuxProcess_compareByKey(const Process* v1, const Process* v2, Proce
       return SPACESHIP_NUMBER(p1->autogroup_id, p2->autogroup_id);
    case AUTOGROUP_NICE:
       return SPACESHIP_NUMBER(p1->autogroup_nice, p2->autogroup_nice);
+   case CGROUP_PSI_CPU:
+      return SPACESHIP_NUMBER(adjustNaN(p1->cgroup_pressure[PRESSURE_STALL_CPU]), adjustNaN(p2->cgroup_pressure[PRESSURE_STALL_CPU]));
+   case CGROUP_PSI_IO:
+      return SPACESHIP_NUMBER(adjustNaN(p1->cgroup_pressure[PRESSURE_STALL_IO]), adjustNaN(p2->cgroup_pressure[PRESSURE_STALL_IO]));
+   case CGROUP_PSI_MEMORY:
+      return SPACESHIP_NUMBER(adjustNaN(p1->cgroup_pressure[PRESSURE_STALL_MEMORY]), adjustNaN(p2->cgroup_pressure[PRESSURE_STALL_MEMORY]));
    default:
       return Process_compareByKey_Base(v1, v2, key);
    }
 }
 
+static bool LinuxProcess_getFieldValue(const Process* super, ProcessField key, ProcessFieldValue* value) {
+   const LinuxProcess* lp = (const LinuxProcess*)super;
+
+   value->string = NULL;
+   value->number = 0.0;
+
+   switch (key) {
+   case CMINFLT: value->number = lp->cminflt; break;
+   case CMAJFLT: value->number = lp->cmajflt; break;
+   case M_DRS: value->number = lp->m_drs; break;
+   case M_DT: value->number = lp->m_dt; break;
+   case M_LRS: value->number = lp->m_lrs; break;
+   case M_TRS: value->number = lp->m_trs; break;
+   case M_SHARE: value->number = lp->m_share; break;
+   case M_PSS: value->number = lp->m_pss; break;
+   case M_SWAP: value->number = lp->m_swap; break;
+   case M_PSSWP: value->number = lp->m_psswp; break;
+   case UTIME: value->number = lp->utime / 100.0; break;
+   case CUTIME: value->number = lp->cutime / 100.0; break;
+   case STIME: value->number = lp->stime / 100.0; break;
+   case CSTIME: value->number = lp->cstime / 100.0; break;
+   case RCHAR: value->number = lp->io_rchar; break;
+   case WCHAR: value->number = lp->io_wchar; break;
+   case SYSCR: value->number = lp->io_syscr; break;
+   case SYSCW: value->number = lp->io_syscw; break;
+   case RBYTES: value->number = lp->io_read_bytes; break;
+   case WBYTES: value->number = lp->io_write_bytes; break;
+   case CNCLWB: value->number = lp->io_cancelled_write_bytes; break;
+   case IO_READ_RATE: value->number = adjustNaN(lp->io_rate_read_bps); break;
+   case IO_WRITE_RATE: value->number = adjustNaN(lp->io_rate_write_bps); break;
+   case IO_RATE: value->number = adjustNaN(lp->io_rate_read_bps) + adjustNaN(lp->io_rate_write_bps); break;
+   #ifdef HAVE_OPENVZ
+   case CTID: value->string = lp->ctid ? lp->ctid : ""; break;
+   case VPID: value->number = lp->vpid; break;
+   #endif
+   #ifdef HAVE_VSERVER
+   case VXID: value->number = lp->vxid; break;
+   #endif
+   case CGROUP: value->string = lp->cgroup ? lp->cgroup : ""; break;
+   case OOM: value->number = lp->oom; break;
+   #ifdef HAVE_DELAYACCT
+   case PERCENT_CPU_DELAY: value->number = lp->cpu_delay_percent; break;
+   case PERCENT_IO_DELAY: value->number = lp->blkio_delay_percent; break;
+   case PERCENT_SWAP_DELAY: value->number = lp->swapin_delay_percent; break;
+   #endif
+   case IO_PRIORITY: value->number = LinuxProcess_effectiveIOPriority(lp); break;
+   case CTXT: value->number = lp->ctxt_diff; break;
+   case SECATTR: value->string = lp->secattr ? lp->secattr : ""; break;
+   case AUTOGROUP_ID: value->number = lp->autogroup_id; break;
+   case AUTOGROUP_NICE: value->number = lp->autogroup_nice; break;
+   case CGROUP_PSI_CPU: value->number = lp->cgroup_pressure[PRESSURE_STALL_CPU]; break;
+   case CGROUP_PSI_IO: value->number = lp->cgroup_pressure[PRESSURE_STALL_IO]; break;
+   case CGROUP_PSI_MEMORY: value->number = lp->cgroup_pressure[PRESSURE_STALL_MEMORY]; break;
+   default:
+      return Process_getFieldValue_Base(super, key, value);
+   }
+
+   return true;
+}
+
 const ProcessClass LinuxProcess_class = {
    .super = {
       .extends = Class(Process),
@@ -417,5 +497,6 @@ const ProcessClass LinuxProcess_class = {
       .compare = Process_compare
    },
    .writeField = LinuxProcess_writeField,
-   .compareByKey = LinuxProcess_compareByKey
+   .compareByKey = LinuxProcess_compareByKey,
+   .getFieldValue = LinuxProcess_getFieldValue
 };
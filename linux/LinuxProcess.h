@@ -14,6 +14,7 @@ in the source distribution for its full text.
 #include <sys/types.h>
 
 #include "linux/IOPriority.h"
+#include "linux/PressureStall.h"
 #include "Object.h"
 #include "Process.h"
 #include "Settings.h"
@@ -30,6 +31,7 @@ in the source distribution for its full text.
 #define PROCESS_FLAG_LINUX_LRS_FIX   0x00010000
 #define PROCESS_FLAG_LINUX_DELAYACCT 0x00040000
 #define PROCESS_FLAG_LINUX_AUTOGROUP 0x00080000
+#define PROCESS_FLAG_LINUX_CGROUP_PSI 0x00100000
 
 typedef struct LinuxProcess_ {
    Process super;
@@ -87,6 +89,8 @@ typedef struct LinuxProcess_ {
    unsigned int vxid;
    #endif
    char* cgroup;
+   /* Share of the last interval the tasks of the cgroup were stalled ("some"), NAN if unknown */
+   float cgroup_pressure[LAST_PRESSURE_STALL_RESOURCE];
    unsigned int oom;
    #ifdef HAVE_DELAYACCT
    unsigned long long int delay_read_time;
@@ -23,11 +23,12 @@ in the source distribution for its full text.
 #include <strings.h>
 #include <time.h>
 #include <unistd.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
 #ifdef HAVE_DELAYACCT
-#include <linux/netlink.h>
 #include <linux/taskstats.h>
 #include <netlink/attr.h>
 #include <netlink/handlers.h>
@@ -45,8 +46,10 @@ in the source distribution for its full text.
 #include "Process.h"
 #include "Settings.h"
 #include "XUtils.h"
+#include "linux/CGroupUtils.h"
 #include "linux/LinuxProcess.h"
 #include "linux/Platform.h" // needed for GNU/hurd to get PATH_MAX  // IWYU pragma: keep
+#include "linux/WorkerPool.h"
 
 #if defined(MAJOR_IN_MKDEV)
 #include <sys/mkdev.h>
@@ -157,16 +160,96 @@ static void LinuxProcessList_initNetlinkSocket(LinuxProcessList* this) {
 
 #endif
 
-static void LinuxProcessList_updateCPUcount(ProcessList* super) {
-   /* Similar to get_nprocs_conf(3) / _SC_NPROCESSORS_CONF
-    * https://sourceware.org/git/?p=glibc.git;a=blob;f=sysdeps/unix/sysv/linux/getsysstats.c;hb=HEAD
-    */
+static void LinuxProcessList_initCPUEvents(LinuxProcessList* this) {
+   this->cpuEventFd = -1;
+
+   int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+   if (fd < 0)
+      return;
+
+   struct sockaddr_nl addr = {
+      .nl_family = AF_NETLINK,
+      .nl_groups = 1, /* kernel uevents */
+   };
+   if (bind(fd, (struct sockaddr*) &addr, sizeof(addr)) < 0) {
+      close(fd);
+      return;
+   }
+
+   this->cpuEventFd = fd;
+}
+
+/* Drain pending uevents and tell whether any of them was about a CPU */
+static bool LinuxProcessList_cpuTopologyChanged(LinuxProcessList* this) {
+   bool changed = this->cpuTopologyStale;
+
+   /* Without uevents re-reading the CPU lists is still cheap */
+   if (this->cpuEventFd < 0)
+      return true;
+
+   for (;;) {
+      char buffer[2048];
+      ssize_t res = recv(this->cpuEventFd, buffer, sizeof(buffer) - 1, MSG_DONTWAIT);
+      if (res < 0) {
+         if (errno == EINTR)
+            continue;
+         /* ENOBUFS: events were lost, assume the worst */
+         if (errno == ENOBUFS)
+            changed = true;
+         break;
+      }
+      if (res == 0)
+         break;
+
+      /* The message starts with "ACTION@DEVPATH", e.g. "offline@/devices/system/cpu/cpu3" */
+      buffer[res] = '\0';
+      if (strstr(buffer, "@/devices/system/cpu/cpu"))
+         changed = true;
+   }
+
+   return changed;
+}
+
+/* Parse the next range of a sysfs CPU list like "0-3,8,10-11" */
+static const char* LinuxProcessList_nextCPURange(const char* list, unsigned int* first, unsigned int* last) {
+   char* end;
+   unsigned long int from = strtoul(list, &end, 10);
+   if (end == list || from >= UINT_MAX)
+      return NULL;
+
+   unsigned long int to = from;
+   if (*end == '-') {
+      list = end + 1;
+      to = strtoul(list, &end, 10);
+      if (end == list || to >= UINT_MAX || to < from)
+         return NULL;
+   }
 
+   *first = from;
+   *last = to;
+   return *end == ',' ? end + 1 : end;
+}
+
+static void LinuxProcessList_updateCPUcount(ProcessList* super) {
    LinuxProcessList* this = (LinuxProcessList*) super;
-   unsigned int existing = 0, active = 0;
 
-   DIR* dir = opendir("/sys/devices/system/cpu");
-   if (!dir) {
+   if (super->existingCPUs != 0 && !LinuxProcessList_cpuTopologyChanged(this))
+      return;
+
+   this->cpuTopologyStale = false;
+
+   /* A cpuN directory exists for every present CPU, see also get_nprocs_conf(3) */
+   char present[4096];
+   ssize_t res = xReadfile("/sys/devices/system/cpu/present", present, sizeof(present));
+   if (res < 1)
+      res = xReadfile("/sys/devices/system/cpu/possible", present, sizeof(present));
+
+   unsigned int existing = 0;
+   unsigned int first, last;
+   for (const char* at = res > 0 ? present : ""; (at = LinuxProcessList_nextCPURange(at, &first, &last)) != NULL; )
+      existing = MAXIMUM(existing, last + 1);
+
+   if (existing == 0) {
       super->activeCPUs = 1;
       super->existingCPUs = 1;
       this->cpuData = xReallocArray(this->cpuData, 2, sizeof(CPUData));
@@ -176,57 +259,36 @@ static void LinuxProcessList_updateCPUcount(ProcessList* super) {
    }
 
    unsigned int currExisting = super->existingCPUs;
+   if (existing > currExisting) {
+      this->cpuData = xReallocArray(this->cpuData, existing + /* aggregate */ 1, sizeof(CPUData));
+      const unsigned int firstNew = currExisting ? currExisting + 1 : 0;
+      memset(&this->cpuData[firstNew], '\0', (existing + 1 - firstNew) * sizeof(CPUData));
+      for (unsigned int i = firstNew; i <= existing; i++)
+         this->cpuData[i].frequency = NAN;
+      currExisting = existing;
+   }
+   this->cpuData[0].online = true; /* average is always "online" */
+
+   unsigned int active = 0;
+   char online[4096];
+   res = xReadfile("/sys/devices/system/cpu/online", online, sizeof(online));
+   if (res < 1) {
+      /* If the file "online" does not exist count all CPUs as active */
+      for (unsigned int i = 1; i <= currExisting; i++)
+         this->cpuData[i].online = true;
+      active = currExisting;
+   } else {
+      for (unsigned int i = 1; i <= currExisting; i++)
+         this->cpuData[i].online = false;
 
-   const struct dirent* entry;
-   while ((entry = readdir(dir)) != NULL) {
-      if (entry->d_type != DT_DIR)
-         continue;
-
-      if (!String_startsWith(entry->d_name, "cpu"))
-         continue;
-
-      char *endp;
-      unsigned long int id = strtoul(entry->d_name + 3, &endp, 10);
-      if (id == ULONG_MAX || endp == entry->d_name + 3 || *endp != '\0')
-         continue;
-
-#ifdef HAVE_OPENAT
-      int cpuDirFd = openat(dirfd(dir), entry->d_name, O_DIRECTORY | O_PATH | O_NOFOLLOW);
-      if (cpuDirFd < 0)
-         continue;
-#else
-      char cpuDirFd[4096];
-      xSnprintf(cpuDirFd, sizeof(cpuDirFd), "/sys/devices/system/cpu/%s", entry->d_name);
-#endif
-
-      existing++;
-
-      /* readdir() iterates with no specific order */
-      unsigned int max = MAXIMUM(existing, id + 1);
-      if (max > currExisting) {
-         this->cpuData = xReallocArray(this->cpuData, max + /* aggregate */ 1, sizeof(CPUData));
-         for (unsigned int j = currExisting; j < max; j++) {
-            this->cpuData[j].online = false;
+      for (const char* at = online; (at = LinuxProcessList_nextCPURange(at, &first, &last)) != NULL; ) {
+         for (unsigned int id = first; id <= last && id < currExisting; id++) {
+            this->cpuData[id + 1].online = true;
+            active++;
          }
-         this->cpuData[0].online = true; /* average is always "online" */
-         currExisting = max;
       }
-
-      char buffer[8];
-      ssize_t res = xReadfileat(cpuDirFd, "online", buffer, sizeof(buffer));
-      /* If the file "online" does not exist or on failure count as active */
-      if (res < 1 || buffer[0] != '0') {
-         active++;
-         this->cpuData[id + 1].online = true;
-      } else {
-         this->cpuData[id + 1].online = false;
-      }
-
-      Compat_openatArgClose(cpuDirFd);
    }
 
-   closedir(dir);
-
 #ifdef HAVE_SENSORS_SENSORS_H
    /* When started with offline CPUs, libsensors does not monitor those,
     * even when they become online. */
@@ -234,11 +296,13 @@ static void LinuxProcessList_updateCPUcount(ProcessList* super) {
       LibSensors_reload();
 #endif
 
-   super->activeCPUs = active;
-   assert(existing == currExisting);
+   super->activeCPUs = MAXIMUM(active, 1);
    super->existingCPUs = currExisting;
 }
 
+#define CGROUP_ROOT_UNOPENED     (-2)
+#define CGROUP_ROOT_UNAVAILABLE  (-1)
+
 ProcessList* ProcessList_new(UsersTable* usersTable, Hashtable* dynamicMeters, Hashtable* dynamicColumns, Hashtable* pidMatchList, uid_t userId) {
    LinuxProcessList* this = xCalloc(1, sizeof(LinuxProcessList));
    ProcessList* pl = &(this->super);
@@ -260,6 +324,9 @@ ProcessList* ProcessList_new(UsersTable* usersTable, Hashtable* dynamicMeters, H
    // Test /proc/PID/smaps_rollup availability (faster to parse, Linux 4.14+)
    this->haveSmapsRollup = (access(PROCDIR "/self/smaps_rollup", R_OK) == 0);
 
+   this->cgroupRootFd = CGROUP_ROOT_UNOPENED;
+   this->cgroupPressure = Hashtable_new(16, true);
+
    // Read btime (the kernel boot time, as number of seconds since the epoch)
    FILE* statfile = fopen(PROCSTATFILE, "r");
    if (statfile == NULL)
@@ -281,6 +348,7 @@ ProcessList* ProcessList_new(UsersTable* usersTable, Hashtable* dynamicMeters, H
       CRT_fatalError("No btime in " PROCSTATFILE);
 
    // Initialize CPU count
+   LinuxProcessList_initCPUEvents(this);
    LinuxProcessList_updateCPUcount(pl);
 
    return pl;
@@ -290,6 +358,17 @@ void ProcessList_delete(ProcessList* pl) {
    LinuxProcessList* this = (LinuxProcessList*) pl;
    ProcessList_done(pl);
    free(this->cpuData);
+   if (this->cpuEventFd >= 0)
+      close(this->cpuEventFd);
+   for (unsigned int i = 0; i < this->cpuFreqFdsCount; i++) {
+      if (this->cpuFreqFds[i] >= 0)
+         close(this->cpuFreqFds[i]);
+   }
+   free(this->cpuFreqFds);
+   WorkerPool_delete(this->cpuFreqPool);
+   if (this->cgroupRootFd >= 0)
+      close(this->cgroupRootFd);
+   Hashtable_delete(this->cgroupPressure);
    if (this->ttyDrivers) {
       for (int i = 0; this->ttyDrivers[i].path; i++) {
          free(this->ttyDrivers[i].path);
@@ -861,6 +940,103 @@ static void LinuxProcessList_readCGroupFile(LinuxProcess* process, openat_arg_t
    free_and_xStrdup(&process->cgroup, output);
 }
 
+/* Pressure of one cgroup, read once per scan and shared by all its tasks */
+typedef struct CGroupPressureSample_ {
+   uint64_t lastUpdate;     /* realtimeMs of the scan it was read in */
+   unsigned long long stallUsec[LAST_PRESSURE_STALL_RESOURCE];
+   bool hasStall[LAST_PRESSURE_STALL_RESOURCE];
+   float percent[LAST_PRESSURE_STALL_RESOURCE];
+} CGroupPressureSample;
+
+static int LinuxProcessList_cgroupRoot(LinuxProcessList* this) {
+   if (this->cgroupRootFd == CGROUP_ROOT_UNOPENED) {
+      char* mountPoint = CGroup_findMountPoint();
+      int fd = mountPoint ? open(mountPoint, O_RDONLY | O_DIRECTORY | O_CLOEXEC) : -1;
+      this->cgroupRootFd = fd >= 0 ? fd : CGROUP_ROOT_UNAVAILABLE;
+      free(mountPoint);
+   }
+   return this->cgroupRootFd;
+}
+
+static void LinuxProcessList_readCGroupPressure(LinuxProcessList* this, LinuxProcess* process) {
+   for (int r = 0; r < LAST_PRESSURE_STALL_RESOURCE; r++)
+      process->cgroup_pressure[r] = NAN;
+
+   int rootFd = LinuxProcessList_cgroupRoot(this);
+   if (rootFd < 0)
+      return;
+
+   char path[PROC_LINE_LENGTH + 1];
+   if (!CGroup_unifiedPath(process->cgroup, path, sizeof(path)))
+      return;
+
+   struct stat sb;
+   if (fstatat(rootFd, path, &sb, 0) != 0)
+      return;
+
+   const uint64_t now = this->super.realtimeMs;
+   CGroupPressureSample* sample = Hashtable_get(this->cgroupPressure, (ht_key_t)sb.st_ino);
+   if (!sample) {
+      sample = xCalloc(1, sizeof(CGroupPressureSample));
+      Hashtable_put(this->cgroupPressure, (ht_key_t)sb.st_ino, sample);
+   }
+
+   if (sample->lastUpdate != now) {
+      int dirFd = openat(rootFd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      for (int r = 0; r < LAST_PRESSURE_STALL_RESOURCE; r++) {
+         PressureStallData data;
+         if (dirFd < 0 || !CGroup_readPressure(dirFd, (PressureStallResource)r, &data)) {
+            sample->hasStall[r] = false;
+            sample->percent[r] = NAN;
+            continue;
+         }
+
+         /* the running average stands in until there is an interval */
+         if (sample->hasStall[r])
+            sample->percent[r] = PressureStall_percent(data.some.total, sample->stallUsec[r], now - sample->lastUpdate);
+         else
+            sample->percent[r] = data.some.avg10;
+         sample->stallUsec[r] = data.some.total;
+         sample->hasStall[r] = true;
+      }
+      if (dirFd >= 0)
+         close(dirFd);
+      sample->lastUpdate = now;
+   }
+
+   for (int r = 0; r < LAST_PRESSURE_STALL_RESOURCE; r++)
+      process->cgroup_pressure[r] = sample->percent[r];
+}
+
+typedef struct CGroupPressureStale_ {
+   uint64_t now;
+   ht_key_t* keys;
+   size_t count;
+   size_t size;
+} CGroupPressureStale;
+
+static void LinuxProcessList_collectStalePressure(ht_key_t key, void* value, void* userData) {
+   const CGroupPressureSample* sample = value;
+   CGroupPressureStale* stale = userData;
+   if (sample->lastUpdate == stale->now)
+      return;
+
+   if (stale->count == stale->size) {
+      stale->size = stale->size ? stale->size * 2 : 16;
+      stale->keys = xReallocArray(stale->keys, stale->size, sizeof(ht_key_t));
+   }
+   stale->keys[stale->count++] = key;
+}
+
+/* Forget cgroups which had no task in the last scan */
+static void LinuxProcessList_pruneCGroupPressure(LinuxProcessList* this) {
+   CGroupPressureStale stale = { .now = this->super.realtimeMs };
+   Hashtable_foreach(this->cgroupPressure, LinuxProcessList_collectStalePressure, &stale);
+   for (size_t i = 0; i < stale.count; i++)
+      Hashtable_remove(this->cgroupPressure, stale.keys[i]);
+   free(stale.keys);
+}
+
 #ifdef HAVE_VSERVER
 
 static void LinuxProcessList_readVServerData(LinuxProcess* process, openat_arg_t procFd) {
@@ -1341,6 +1517,7 @@ static bool LinuxProcessList_recurseProcTree(LinuxProcessList* this, openat_arg_
    }
 
    const unsigned int activeCPUs = pl->activeCPUs;
+   const uint32_t scanFlags = ProcessList_scanFlags(pl);
    const bool hideKernelThreads = settings->hideKernelThreads;
    const bool hideUserlandThreads = settings->hideUserlandThreads;
    while ((entry = readdir(dir)) != NULL) {
@@ -1417,49 +1594,9 @@ static bool LinuxProcessList_recurseProcTree(LinuxProcessList* this, openat_arg_
          continue;
       }
 
-      if (settings->flags & PROCESS_FLAG_IO)
-         LinuxProcessList_readIoFile(lp, procFd, pl->realtimeMs);
-
       if (!LinuxProcessList_readStatmFile(lp, procFd))
          goto errorReadingProcess;
 
-      {
-         bool prev = proc->usesDeletedLib;
-
-         if ((lp->m_lrs == 0 && (settings->flags & PROCESS_FLAG_LINUX_LRS_FIX)) ||
-             (settings->highlightDeletedExe && !proc->procExeDeleted && !proc->isKernelThread && !proc->isUserlandThread)) {
-            // Check if we really should recalculate the M_LRS value for this process
-            uint64_t passedTimeInMs = pl->realtimeMs - lp->last_mlrs_calctime;
-
-            uint64_t recheck = ((uint64_t)rand()) % 2048;
-
-            if (passedTimeInMs > 2000 || passedTimeInMs > recheck) {
-               lp->last_mlrs_calctime = pl->realtimeMs;
-               LinuxProcessList_readMaps(lp, procFd, settings->flags & PROCESS_FLAG_LINUX_LRS_FIX, settings->highlightDeletedExe);
-            }
-         } else {
-            /* Copy from process structure in threads and reset if setting got disabled */
-            proc->usesDeletedLib = (proc->isUserlandThread && parent) ? parent->usesDeletedLib : false;
-         }
-
-         proc->mergedCommand.exeChanged |= prev ^ proc->usesDeletedLib;
-      }
-
-      if ((settings->flags & PROCESS_FLAG_LINUX_SMAPS) && !Process_isKernelThread(proc)) {
-         if (!parent) {
-            // Read smaps file of each process only every second pass to improve performance
-            static int smaps_flag = 0;
-            if ((pid & 1) == smaps_flag) {
-               LinuxProcessList_readSmapsFile(lp, procFd, this->haveSmapsRollup);
-            }
-            if (pid == 1) {
-               smaps_flag = !smaps_flag;
-            }
-         } else {
-            lp->m_pss = ((const LinuxProcess*)parent)->m_pss;
-         }
-      }
-
       char statCommand[MAX_NAME + 1];
       unsigned long long int lasttimes = (lp->utime + lp->stime);
       unsigned long int tty_nr = proc->tty_nr;
@@ -1471,7 +1608,7 @@ static bool LinuxProcessList_recurseProcTree(LinuxProcessList* this, openat_arg_
          proc->tty_name = LinuxProcessList_updateTtyDevice(this->ttyDrivers, proc->tty_nr);
       }
 
-      if (settings->flags & PROCESS_FLAG_LINUX_IOPRIO) {
+      if (scanFlags & PROCESS_FLAG_LINUX_IOPRIO) {
          LinuxProcess_updateIOPriority(lp);
       }
 
@@ -1486,13 +1623,13 @@ static bool LinuxProcessList_recurseProcTree(LinuxProcessList* this, openat_arg_
       if (!preExisting) {
 
          #ifdef HAVE_OPENVZ
-         if (settings->flags & PROCESS_FLAG_LINUX_OPENVZ) {
+         if (scanFlags & PROCESS_FLAG_LINUX_OPENVZ) {
             LinuxProcessList_readOpenVZData(lp, procFd);
          }
          #endif
 
          #ifdef HAVE_VSERVER
-         if (settings->flags & PROCESS_FLAG_LINUX_VSERVER) {
+         if (scanFlags & PROCESS_FLAG_LINUX_VSERVER) {
             LinuxProcessList_readVServerData(lp, procFd);
          }
          #endif
@@ -1512,33 +1649,84 @@ static bool LinuxProcessList_recurseProcTree(LinuxProcessList* this, openat_arg_
          }
       }
 
+      /*
+       * The following collectors are comparatively expensive. Skip them for
+       * processes hidden by the active filters or, in lazy mode, not in view.
+       * The filters only depend on data gathered above.
+       */
+      const bool wantsDetails = ProcessList_wantsDetails(pl, proc);
+
+      if ((scanFlags & PROCESS_FLAG_IO) && wantsDetails)
+         LinuxProcessList_readIoFile(lp, procFd, pl->realtimeMs);
+
+      {
+         bool prev = proc->usesDeletedLib;
+
+         if ((lp->m_lrs == 0 && (scanFlags & PROCESS_FLAG_LINUX_LRS_FIX)) ||
+             (settings->highlightDeletedExe && !proc->procExeDeleted && !proc->isKernelThread && !proc->isUserlandThread)) {
+            // Check if we really should recalculate the M_LRS value for this process
+            uint64_t passedTimeInMs = pl->realtimeMs - lp->last_mlrs_calctime;
+
+            uint64_t recheck = ((uint64_t)rand()) % 2048;
+
+            if (wantsDetails && (passedTimeInMs > 2000 || passedTimeInMs > recheck)) {
+               lp->last_mlrs_calctime = pl->realtimeMs;
+               LinuxProcessList_readMaps(lp, procFd, scanFlags & PROCESS_FLAG_LINUX_LRS_FIX, settings->highlightDeletedExe);
+            }
+         } else {
+            /* Copy from process structure in threads and reset if setting got disabled */
+            proc->usesDeletedLib = (proc->isUserlandThread && parent) ? parent->usesDeletedLib : false;
+         }
+
+         proc->mergedCommand.exeChanged |= prev ^ proc->usesDeletedLib;
+      }
+
+      if ((scanFlags & PROCESS_FLAG_LINUX_SMAPS) && !Process_isKernelThread(proc)) {
+         if (!parent) {
+            // Read smaps file of each process only every second pass to improve performance
+            static int smaps_flag = 0;
+            if ((pid & 1) == smaps_flag && wantsDetails) {
+               LinuxProcessList_readSmapsFile(lp, procFd, this->haveSmapsRollup);
+            }
+            if (pid == 1) {
+               smaps_flag = !smaps_flag;
+            }
+         } else {
+            lp->m_pss = ((const LinuxProcess*)parent)->m_pss;
+         }
+      }
+
       #ifdef HAVE_DELAYACCT
-      if (settings->flags & PROCESS_FLAG_LINUX_DELAYACCT) {
+      if ((scanFlags & PROCESS_FLAG_LINUX_DELAYACCT) && wantsDetails) {
          LinuxProcessList_readDelayAcctData(this, lp);
       }
       #endif
 
-      if (settings->flags & PROCESS_FLAG_LINUX_CGROUP) {
+      if (scanFlags & PROCESS_FLAG_LINUX_CGROUP) {
          LinuxProcessList_readCGroupFile(lp, procFd);
       }
 
-      if (settings->flags & PROCESS_FLAG_LINUX_OOM) {
+      if (scanFlags & PROCESS_FLAG_LINUX_CGROUP_PSI) {
+         LinuxProcessList_readCGroupPressure(this, lp);
+      }
+
+      if (scanFlags & PROCESS_FLAG_LINUX_OOM) {
          LinuxProcessList_readOomData(lp, procFd);
       }
 
-      if (settings->flags & PROCESS_FLAG_LINUX_CTXT) {
+      if (scanFlags & PROCESS_FLAG_LINUX_CTXT) {
          LinuxProcessList_readCtxtData(lp, procFd);
       }
 
-      if (settings->flags & PROCESS_FLAG_LINUX_SECATTR) {
+      if (scanFlags & PROCESS_FLAG_LINUX_SECATTR) {
          LinuxProcessList_readSecattrData(lp, procFd);
       }
 
-      if (settings->flags & PROCESS_FLAG_CWD) {
+      if ((scanFlags & PROCESS_FLAG_CWD) && wantsDetails) {
          LinuxProcessList_readCwd(lp, procFd);
       }
 
-      if ((settings->flags & PROCESS_FLAG_LINUX_AUTOGROUP) && this->haveAutogroup) {
+      if ((scanFlags & PROCESS_FLAG_LINUX_AUTOGROUP) && this->haveAutogroup) {
          LinuxProcessList_readAutogroup(lp, procFd);
       }
 
@@ -1877,15 +2065,24 @@ static inline double LinuxProcessList_scanCPUTime(ProcessList* super) {
          adjCpuId = cpuid + 1;
       }
 
-      if (adjCpuId > super->existingCPUs)
+      if (adjCpuId > super->existingCPUs) {
+         this->cpuTopologyStale = true;
          break;
+      }
 
       for (unsigned int j = lastAdjCpuId + 1; j < adjCpuId; j++) {
          // Skipped an ID, but /proc/stat is ordered => got offline CPU
+         if (this->cpuData[j].online)
+            this->cpuTopologyStale = true;
          memset(&(this->cpuData[j]), '\0', sizeof(CPUData));
+         this->cpuData[j].frequency = NAN;
       }
       lastAdjCpuId = adjCpuId;
 
+      // Listed in /proc/stat, so the CPU is online (missed uevent?)
+      if (adjCpuId > 0 && !this->cpuData[adjCpuId].online)
+         this->cpuTopologyStale = true;
+
       // Guest time is already accounted in usertime
       usertime -= guest;
       nicetime -= guestnice;
@@ -1925,6 +2122,11 @@ static inline double LinuxProcessList_scanCPUTime(ProcessList* super) {
       cpuData->totalTime = totaltime;
    }
 
+   for (unsigned int j = lastAdjCpuId + 1; j <= existingCPUs; j++) {
+      if (this->cpuData[j].online)
+         this->cpuTopologyStale = true;
+   }
+
    double period = (double)this->cpuData[0].totalPeriod / super->activeCPUs;
 
    char buffer[PROC_LINE_LENGTH + 1];
@@ -1940,69 +2142,145 @@ static inline double LinuxProcessList_scanCPUTime(ProcessList* super) {
    return period;
 }
 
-static int scanCPUFreqencyFromSysCPUFreq(LinuxProcessList* this) {
-   unsigned int existingCPUs = this->super.existingCPUs;
-   int numCPUsWithFrequency = 0;
-   unsigned long totalFrequency = 0;
+#define CPUFREQ_FD_UNOPENED     (-2)
+#define CPUFREQ_FD_UNAVAILABLE  (-1)
 
-   /*
-    * On some AMD and Intel CPUs read()ing scaling_cur_freq is quite slow (> 1ms). This delay
-    * accumulates for every core. For details see issue#471.
-    * If the read on CPU 0 takes longer than 500us bail out and fall back to reading the
-    * frequencies from /proc/cpuinfo.
-    * Once the condition has been met, bail out early for the next couple of scans.
-    */
-   static int timeout = 0;
+/* Time after which no further scaling_cur_freq is read in a scan, whatever
+ * the number of CPUs; CPUs not reached keep their last value */
+#define CPUFREQ_SCAN_BUDGET_US 1000
 
-   if (timeout > 0) {
-      timeout--;
-      return -1;
+/* Reads slower than this on average are spread over threads */
+#define CPUFREQ_SLOW_READ_US 100
+
+typedef struct CPUFreqScan_ {
+   LinuxProcessList* this;
+   unsigned int first;
+   unsigned int count;
+   struct timespec start;
+} CPUFreqScan;
+
+static long long elapsedUs(const struct timespec* start) {
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (now.tv_sec - start->tv_sec) * 1000000LL + (now.tv_nsec - start->tv_nsec) / 1000;
+}
+
+/* Runs in a worker: touches nothing but the data and file of one CPU */
+static bool scanCPUFreqencyOfCPU(void* context, size_t index) {
+   const CPUFreqScan* scan = context;
+   LinuxProcessList* this = scan->this;
+   unsigned int id = (unsigned int)((scan->first + index) % scan->count);
+   CPUData* cpuData = &this->cpuData[id + 1];
+
+   if (!ProcessList_isCPUonline(&this->super, id)) {
+      cpuData->frequency = NAN;
+      return true;
    }
 
-   for (unsigned int i = 0; i < existingCPUs; ++i) {
-      if (!ProcessList_isCPUonline(&this->super, i))
-         continue;
+   int* fd = &this->cpuFreqFds[id];
+   if (*fd == CPUFREQ_FD_UNAVAILABLE)
+      return true;
 
+   if (*fd == CPUFREQ_FD_UNOPENED) {
       char pathBuffer[64];
-      xSnprintf(pathBuffer, sizeof(pathBuffer), "/sys/devices/system/cpu/cpu%u/cpufreq/scaling_cur_freq", i);
+      xSnprintf(pathBuffer, sizeof(pathBuffer), "/sys/devices/system/cpu/cpu%u/cpufreq/scaling_cur_freq", id);
+      *fd = open(pathBuffer, O_RDONLY | O_CLOEXEC);
+      if (*fd < 0) {
+         *fd = CPUFREQ_FD_UNAVAILABLE;
+         return true;
+      }
+   }
 
-      struct timespec start;
-      if (i == 0)
-         clock_gettime(CLOCK_MONOTONIC, &start);
+   char buffer[32];
+   ssize_t res = pread(*fd, buffer, sizeof(buffer) - 1, 0);
+   if (res < 1) {
+      /* e.g. the cpufreq policy went away, reopen on the next scan */
+      close(*fd);
+      *fd = CPUFREQ_FD_UNOPENED;
+      cpuData->frequency = NAN;
+      return true;
+   }
+   buffer[res] = '\0';
 
-      FILE* file = fopen(pathBuffer, "r");
-      if (!file)
-         return -errno;
+   char* end;
+   unsigned long frequency = strtoul(buffer, &end, 10);
+   /* convert kHz to MHz */
+   cpuData->frequency = end != buffer ? (double)(frequency / 1000) : NAN;
 
-      unsigned long frequency;
-      if (fscanf(file, "%lu", &frequency) == 1) {
-         /* convert kHz to MHz */
-         frequency = frequency / 1000;
-         this->cpuData[i + 1].frequency = frequency;
-         numCPUsWithFrequency++;
-         totalFrequency += frequency;
-      }
+   return elapsedUs(&scan->start) <= CPUFREQ_SCAN_BUDGET_US;
+}
 
-      fclose(file);
+static int scanCPUFreqencyFromSysCPUFreq(LinuxProcessList* this) {
+   unsigned int existingCPUs = this->super.existingCPUs;
 
-      if (i == 0) {
-         struct timespec end;
-         clock_gettime(CLOCK_MONOTONIC, &end);
-         const time_t timeTakenUs = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
-         if (timeTakenUs > 500) {
-            timeout = 30;
-            return -1;
-         }
+   if (this->cpuFreqFdsCount < existingCPUs) {
+      this->cpuFreqFds = xReallocArray(this->cpuFreqFds, existingCPUs, sizeof(int));
+      for (unsigned int i = this->cpuFreqFdsCount; i < existingCPUs; i++)
+         this->cpuFreqFds[i] = CPUFREQ_FD_UNOPENED;
+      this->cpuFreqFdsCount = existingCPUs;
+   }
+
+   /*
+    * On some AMD and Intel CPUs read()ing scaling_cur_freq is quite slow (> 1ms), as the
+    * kernel has to ask the remote core. This delay accumulates for every core, see
+    * issue#471. Keep the files open, read them from the threads of a pool once they turn
+    * out to be slow, and stop sampling once the time budget is spent; the next scan
+    * continues with the CPUs not reached.
+    */
+   CPUFreqScan scan = {
+      .this = this,
+      .first = this->cpuFreqNext < existingCPUs ? this->cpuFreqNext : 0,
+      .count = existingCPUs,
+   };
+   clock_gettime(CLOCK_MONOTONIC, &scan.start);
+
+   size_t reached = 0;
+   if (this->cpuFreqPool) {
+      reached = WorkerPool_run(this->cpuFreqPool, existingCPUs, 1, scanCPUFreqencyOfCPU, &scan);
+   } else {
+      while (reached < existingCPUs) {
+         if (!scanCPUFreqencyOfCPU(&scan, reached++))
+            break;
       }
+   }
+   this->cpuFreqNext = (unsigned int)((scan.first + reached) % existingCPUs);
+
+   /* timed one by one, slow files stay slow */
+   if (!this->cpuFreqPool && reached > 0 && elapsedUs(&scan.start) / (long long)reached > CPUFREQ_SLOW_READ_US)
+      this->cpuFreqPool = WorkerPool_new(WORKER_POOL_MAX_THREADS);
 
+   int numCPUsWithFrequency = 0;
+   double totalFrequency = 0;
+   for (unsigned int i = 0; i < existingCPUs; i++) {
+      /* offline CPUs the scan did not reach may still hold a stale value */
+      if (this->cpuFreqFds[i] == CPUFREQ_FD_UNAVAILABLE || !ProcessList_isCPUonline(&this->super, i))
+         this->cpuData[i + 1].frequency = NAN;
+
+      if (!isnan(this->cpuData[i + 1].frequency)) {
+         numCPUsWithFrequency++;
+         totalFrequency += this->cpuData[i + 1].frequency;
+      }
    }
 
-   if (numCPUsWithFrequency > 0)
-      this->cpuData[0].frequency = (double)totalFrequency / numCPUsWithFrequency;
+   if (numCPUsWithFrequency == 0)
+      return -1;
 
+   this->cpuData[0].frequency = totalFrequency / numCPUsWithFrequency;
    return 0;
 }
 
+/* Value of a "key : value" line of /proc/cpuinfo, NULL if the key does not match */
+static const char* cpuinfoValue(const char* line, const char* key) {
+   if (!String_startsWith(line, key))
+      return NULL;
+
+   line += strlen(key);
+   while (*line == ' ' || *line == '\t')
+      line++;
+
+   return *line == ':' ? line + 1 : NULL;
+}
+
 static void scanCPUFreqencyFromCPUinfo(LinuxProcessList* this) {
    FILE* file = fopen(PROCCPUINFOFILE, "r");
    if (file == NULL)
@@ -2014,37 +2292,42 @@ static void scanCPUFreqencyFromCPUinfo(LinuxProcessList* this) {
    int cpuid = -1;
 
    while (!feof(file)) {
-      double frequency;
       char buffer[PROC_LINE_LENGTH];
 
       if (fgets(buffer, PROC_LINE_LENGTH, file) == NULL)
          break;
 
-      if (
-         (sscanf(buffer, "processor : %d", &cpuid) == 1) ||
-         (sscanf(buffer, "processor: %d", &cpuid) == 1)
-      ) {
+      const char* value;
+      if ((value = cpuinfoValue(buffer, "processor")) != NULL) {
+         cpuid = (int)strtol(value, NULL, 10);
          continue;
-      } else if (
-         (sscanf(buffer, "cpu MHz : %lf", &frequency) == 1) ||
-         (sscanf(buffer, "cpu MHz: %lf", &frequency) == 1) ||
-         (sscanf(buffer, "clock : %lfMHz", &frequency) == 1) ||
-         (sscanf(buffer, "clock: %lfMHz", &frequency) == 1)
-      ) {
-         if (cpuid < 0 || (unsigned int)cpuid > (existingCPUs - 1)) {
-            continue;
-         }
+      }
 
-         CPUData* cpuData = &(this->cpuData[cpuid + 1]);
-         /* do not override sysfs data */
-         if (isnan(cpuData->frequency)) {
-            cpuData->frequency = frequency;
-         }
-         numCPUsWithFrequency++;
-         totalFrequency += frequency;
-      } else if (buffer[0] == '\n') {
+      if (buffer[0] == '\n') {
          cpuid = -1;
+         continue;
       }
+
+      /* "cpu MHz : 2400.000" on x86, "clock : 2400.000000MHz" on ppc */
+      if ((value = cpuinfoValue(buffer, "cpu MHz")) == NULL &&
+          (value = cpuinfoValue(buffer, "clock")) == NULL)
+         continue;
+
+      char* end;
+      double frequency = strtod(value, &end);
+      if (end == value)
+         continue;
+
+      if (cpuid < 0 || (unsigned int)cpuid > (existingCPUs - 1))
+         continue;
+
+      CPUData* cpuData = &(this->cpuData[cpuid + 1]);
+      /* do not override sysfs data */
+      if (isnan(cpuData->frequency)) {
+         cpuData->frequency = frequency;
+      }
+      numCPUsWithFrequency++;
+      totalFrequency += frequency;
    }
    fclose(file);
 
@@ -2054,16 +2337,16 @@ static void scanCPUFreqencyFromCPUinfo(LinuxProcessList* this) {
 }
 
 static void LinuxProcessList_scanCPUFrequency(LinuxProcessList* this) {
+   if (scanCPUFreqencyFromSysCPUFreq(this) == 0) {
+      return;
+   }
+
    unsigned int existingCPUs = this->super.existingCPUs;
 
    for (unsigned int i = 0; i <= existingCPUs; i++) {
       this->cpuData[i].frequency = NAN;
    }
 
-   if (scanCPUFreqencyFromSysCPUFreq(this) == 0) {
-      return;
-   }
-
    scanCPUFreqencyFromCPUinfo(this);
 }
 
@@ -2092,7 +2375,7 @@ void ProcessList_goThroughEntries(ProcessList* super, bool pauseProcessUpdate) {
       return;
    }
 
-   if (settings->flags & PROCESS_FLAG_LINUX_AUTOGROUP) {
+   if (ProcessList_scanFlags(super) & PROCESS_FLAG_LINUX_AUTOGROUP) {
       // Refer to sched(7) 'autogroup feature' section
       // The kernel feature can be enabled/disabled through procfs at
       // any time, so check for it at the start of each sample - only
@@ -2111,6 +2394,12 @@ void ProcessList_goThroughEntries(ProcessList* super, bool pauseProcessUpdate) {
 #endif
 
    LinuxProcessList_recurseProcTree(this, rootFd, PROCDIR, NULL, period);
+
+   if (ProcessList_scanFlags(super) & PROCESS_FLAG_LINUX_CGROUP_PSI) {
+      LinuxProcessList_pruneCGroupPressure(this);
+   } else {
+      Hashtable_clear(this->cgroupPressure);
+   }
 }
 
 bool ProcessList_isCPUonline(const ProcessList* super, unsigned int id) {
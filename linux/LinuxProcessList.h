@@ -16,6 +16,7 @@ in the source distribution for its full text.
 #include "ProcessList.h"
 #include "UsersTable.h"
 #include "ZramStats.h"
+#include "linux/WorkerPool.h"
 #include "zfs/ZfsArcStats.h"
 
 #define HTOP_HUGEPAGE_BASE_SHIFT 16
@@ -68,11 +69,21 @@ typedef struct LinuxProcessList_ {
    ProcessList super;
 
    CPUData* cpuData;
+   int cpuEventFd;          /* kernel uevent socket reporting CPU hotplug, or -1 */
+   bool cpuTopologyStale;
+
+   int* cpuFreqFds;         /* open scaling_cur_freq files, indexed by CPU id */
+   unsigned int cpuFreqFdsCount;
+   unsigned int cpuFreqNext;  /* CPU to start sampling at in the next scan */
+   WorkerPool* cpuFreqPool; /* reads slow scaling_cur_freq files, NULL while they are fast */
 
    TtyDriver* ttyDrivers;
    bool haveSmapsRollup;
    bool haveAutogroup;
 
+   int cgroupRootFd;        /* cgroup v2 hierarchy, -1 if none, -2 not opened yet */
+   Hashtable* cgroupPressure;  /* CGroupPressureSample by cgroup inode */
+
    #ifdef HAVE_DELAYACCT
    struct nl_sock* netlink_socket;
    int netlink_family;
@@ -21,16 +21,20 @@ in the source distribution for its full text.
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
 
 #include "BatteryMeter.h"
 #include "ClockMeter.h"
 #include "Compat.h"
 #include "CPUMeter.h"
+#include "CRT.h"
 #include "DateMeter.h"
 #include "DateTimeMeter.h"
 #include "DiskIOMeter.h"
 #include "HostnameMeter.h"
 #include "HugePageMeter.h"
+#include "InfoScreen.h"
 #include "LoadAverageMeter.h"
 #include "Macros.h"
 #include "MainPanel.h"
@@ -48,12 +52,19 @@ in the source distribution for its full text.
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
 #include "TasksMeter.h"
+#include "TraceScreen.h"
 #include "UptimeMeter.h"
 #include "XUtils.h"
+#include "linux/CGroupScreen.h"
+#include "linux/FileHoldersScreen.h"
+#include "linux/FileIndex.h"
 #include "linux/IOPriority.h"
 #include "linux/IOPriorityPanel.h"
 #include "linux/LinuxProcess.h"
 #include "linux/LinuxProcessList.h"
+#include "linux/PressureStall.h"
+#include "linux/SocketTable.h"
+#include "linux/SyscallScreen.h"
 #include "linux/SystemdMeter.h"
 #include "linux/ZramMeter.h"
 #include "linux/ZramStats.h"
@@ -133,7 +144,7 @@ static Htop_Reaction Platform_actionSetIOPriority(State* st) {
    if (Settings_isReadonly())
       return HTOP_OK;
 
-   const LinuxProcess* p = (const LinuxProcess*) Panel_getSelected((Panel*)st->mainPanel);
+   const LinuxProcess* p = (const LinuxProcess*) MainPanel_getSelectedProcess(st->mainPanel);
    if (!p)
       return HTOP_OK;
 
@@ -179,8 +190,54 @@ static Htop_Reaction Platform_actionLowerAutogroupPriority(State* st) {
    return changed ? HTOP_REFRESH : HTOP_OK;
 }
 
+static Htop_Reaction Platform_actionShowCGroups(ATTR_UNUSED State* st) {
+   CGroupScreen* cgs = CGroupScreen_new();
+   InfoScreen_run((InfoScreen*)cgs);
+   CGroupScreen_delete((Object*)cgs);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionShowFileHolders(ATTR_UNUSED State* st) {
+   FileHoldersScreen* fhs = FileHoldersScreen_new();
+   InfoScreen_run((InfoScreen*)fhs);
+   FileHoldersScreen_delete((Object*)fhs);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+/* Counts syscalls natively, strace(1) remains one key away and takes over
+ * where the process cannot be traced so */
+static Htop_Reaction Platform_actionTraceSyscalls(State* st) {
+   if (Settings_isReadonly())
+      return HTOP_OK;
+
+   const Process* p = MainPanel_getSelectedProcess(st->mainPanel);
+   if (!p)
+      return HTOP_OK;
+
+   SyscallScreen* ss = SyscallScreen_new(p);
+   if (SyscallScreen_attach(ss)) {
+      InfoScreen_run((InfoScreen*)ss);
+   } else {
+      TraceScreen* ts = TraceScreen_new(p);
+      if (TraceScreen_forkTracer(ts))
+         InfoScreen_run((InfoScreen*)ts);
+      TraceScreen_delete((Object*)ts);
+   }
+   SyscallScreen_delete((Object*)ss);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
 void Platform_setBindings(Htop_Action* keys) {
+   keys['G'] = Platform_actionShowCGroups;
+   keys['L'] = Platform_actionShowFileHolders;
    keys['i'] = Platform_actionSetIOPriority;
+   keys['s'] = Platform_actionTraceSyscalls;
    keys['{'] = Platform_actionLowerAutogroupPriority;
    keys['}'] = Platform_actionHigherAutogroupPriority;
    keys[KEY_F(19)] = Platform_actionLowerAutogroupPriority;  // Shift-F7
@@ -217,6 +274,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs8Meter_class,
    &BlankMeter_class,
    &PressureStallCPUSomeMeter_class,
+   &PressureStallCPUFullMeter_class,
    &PressureStallIOSomeMeter_class,
    &PressureStallIOFullMeter_class,
    &PressureStallMemorySomeMeter_class,
@@ -406,61 +464,63 @@ char* Platform_getProcessEnv(pid_t pid) {
    return env;
 }
 
-/*
- * Return the absolute path of a file given its pid&inode number
- *
- * Based on implementation of lslocks from util-linux:
- * https://sources.debian.org/src/util-linux/2.36-3/misc-utils/lslocks.c/#L162
- */
-char* Platform_getInodeFilename(pid_t pid, ino_t inode) {
-   struct stat sb;
-   const struct dirent* de;
-   DIR* dirp;
-   ssize_t len;
-   int fd;
-
-   char path[PATH_MAX];
-   char sym[PATH_MAX];
-   char* ret = NULL;
-
-   memset(path, 0, sizeof(path));
-   memset(sym, 0, sizeof(sym));
-
-   xSnprintf(path, sizeof(path), "%s/%d/fd/", PROCDIR, pid);
-   if (strlen(path) >= (sizeof(path) - 2))
-      return NULL;
+typedef struct Platform_InodePath_ {
+   ino_t inode;
+   char path[];
+} Platform_InodePath;
 
-   if (!(dirp = opendir(path)))
-      return NULL;
+/* Paths of all files open in the process by inode, in a single walk of
+ * its descriptors */
+static Hashtable* Platform_getInodePaths(pid_t pid) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/fd", pid);
 
-   if ((fd = dirfd(dirp)) < 0 )
-      goto out;
+   Hashtable* paths = Hashtable_new(64, true);
+   DIR* dirp = opendir(path);
+   if (!dirp)
+      return paths;
 
+   int fd = dirfd(dirp);
+   const struct dirent* de;
    while ((de = readdir(dirp))) {
-      if (String_eq(de->d_name, ".") || String_eq(de->d_name, ".."))
+      if (!isdigit((unsigned char)de->d_name[0]))
          continue;
 
-      /* care only for numerical descriptors */
-      if (!strtoull(de->d_name, (char **) NULL, 10))
+      struct stat sb;
+      if (Compat_fstatat(fd, path, de->d_name, &sb, 0) != 0)
          continue;
 
-      if (!Compat_fstatat(fd, path, de->d_name, &sb, 0) && inode != sb.st_ino)
+      char sym[PATH_MAX];
+      ssize_t len = Compat_readlinkat(fd, path, de->d_name, sym, sizeof(sym) - 1);
+      if (len < 1)
          continue;
 
-      if ((len = Compat_readlinkat(fd, path, de->d_name, sym, sizeof(sym) - 1)) < 1)
-         goto out;
-
-      sym[len] = '\0';
-
-      ret = xStrdup(sym);
-      break;
+      Platform_InodePath* entry = xMalloc(sizeof(Platform_InodePath) + (size_t)len + 1);
+      entry->inode = sb.st_ino;
+      memcpy(entry->path, sym, (size_t)len);
+      entry->path[len] = '\0';
+      Hashtable_put(paths, (ht_key_t) sb.st_ino, entry);
    }
 
-out:
    closedir(dirp);
-   return ret;
+   return paths;
+}
+
+/* Next space separated field of a line, terminated in place */
+static char* Platform_nextField(char** at) {
+   char* field = *at + strspn(*at, " ");
+   if (!*field || *field == '\n')
+      return NULL;
+
+   char* end = field + strcspn(field, " \n");
+   if (*end)
+      *end++ = '\0';
+   *at = end;
+   return field;
 }
 
+/* e.g. "1: POSIX  ADVISORY  WRITE 1234 08:02:131090 0 EOF"; waiters,
+ * as "1: -> POSIX ...", are skipped */
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    FileLocks_ProcessData* pdata = xCalloc(1, sizeof(FileLocks_ProcessData));
 
@@ -470,44 +530,53 @@ FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
       return pdata;
    }
 
+   Hashtable* paths = NULL;
    char buffer[1024];
    FileLocks_LockData** data_ref = &pdata->locks;
-   while(fgets(buffer, sizeof(buffer), f)) {
+   while (fgets(buffer, sizeof(buffer), f)) {
       if (!strchr(buffer, '\n'))
          continue;
 
-      int lock_id;
-      char lock_type[16];
-      char lock_excl[16];
-      char lock_rw[16];
-      pid_t lock_pid;
-      unsigned int lock_dev[2];
-      uint64_t lock_inode;
-      char lock_start[25];
-      char lock_end[25];
-
-      if (10 != sscanf(buffer, "%d:  %15s  %15s %15s %d %x:%x:%"PRIu64" %24s %24s",
-         &lock_id, lock_type, lock_excl, lock_rw, &lock_pid,
-         &lock_dev[0], &lock_dev[1], &lock_inode,
-         lock_start, lock_end))
+      char* at = buffer;
+      char* fields[8];
+      size_t n = 0;
+      while (n < ARRAYSIZE(fields) && (fields[n] = Platform_nextField(&at)))
+         n++;
+      if (n < ARRAYSIZE(fields))
          continue;
 
-      if (pid != lock_pid)
+      char* end;
+      pid_t lock_pid = (pid_t) strtol(fields[4], &end, 10);
+      if (pid != lock_pid || *end)
          continue;
 
+      char* device = fields[5];
+      unsigned int lock_dev[2];
+      lock_dev[0] = (unsigned int) strtoul(device, &device, 16);
+      if (*device++ != ':')
+         continue;
+      lock_dev[1] = (unsigned int) strtoul(device, &device, 16);
+      if (*device++ != ':')
+         continue;
+      uint64_t lock_inode = strtoull(device, NULL, 10);
+
+      if (!paths)
+         paths = Platform_getInodePaths(pid);
+      const Platform_InodePath* path = Hashtable_get(paths, (ht_key_t) lock_inode);
+
       FileLocks_LockData* ldata = xCalloc(1, sizeof(FileLocks_LockData));
       FileLocks_Data* data = &ldata->data;
-      data->id = lock_id;
-      data->locktype = xStrdup(lock_type);
-      data->exclusive = xStrdup(lock_excl);
-      data->readwrite = xStrdup(lock_rw);
-      data->filename = Platform_getInodeFilename(lock_pid, lock_inode);
+      data->id = (int) strtol(fields[0], NULL, 10);
+      data->locktype = xStrdup(fields[1]);
+      data->exclusive = xStrdup(fields[2]);
+      data->readwrite = xStrdup(fields[3]);
+      data->filename = path && path->inode == lock_inode ? xStrdup(path->path) : NULL;
       data->dev[0] = lock_dev[0];
       data->dev[1] = lock_dev[1];
       data->inode = lock_inode;
-      data->start = strtoull(lock_start, NULL, 10);
-      if (!String_eq(lock_end, "EOF")) {
-         data->end = strtoull(lock_end, NULL, 10);
+      data->start = strtoull(fields[6], NULL, 10);
+      if (!String_eq(fields[7], "EOF")) {
+         data->end = strtoull(fields[7], NULL, 10);
       } else {
          data->end = ULLONG_MAX;
       }
@@ -516,77 +585,261 @@ FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
       data_ref = &ldata->next;
    }
 
+   if (paths)
+      Hashtable_delete(paths);
    fclose(f);
    return pdata;
 }
 
-void Platform_getPressureStall(const char* file, bool some, double* ten, double* sixty, double* threehundred) {
-   *ten = *sixty = *threehundred = 0;
-   char procname[128];
-   xSnprintf(procname, sizeof(procname), PROCDIR "/pressure/%s", file);
-   FILE* fd = fopen(procname, "r");
-   if (!fd) {
-      *ten = *sixty = *threehundred = NAN;
+/* Sockets seen by the open files screen, kept between its refreshes */
+static SocketTable* Platform_sockets;
+
+static void Platform_addFile(OpenFiles_FileData*** next, const char* fd, int dirfd, const char* dirpath, const char* name, const char* infopath, pid_t pid) {
+   char target[PATH_MAX];
+   ssize_t len = Compat_readlinkat(dirfd, dirpath, name, target, sizeof(target) - 1);
+   if (len < 0)
       return;
+   target[len] = '\0';
+
+   OpenFiles_FileData* fdata = xCalloc(1, sizeof(OpenFiles_FileData));
+   char** data = fdata->data.data;
+   data[OPENFILES_FD] = xStrdup(fd);
+
+   struct stat sb;
+   if (Compat_fstatat(dirfd, dirpath, name, &sb, 0) == 0) {
+      const char* type = FileIndex_typeName(sb.st_mode, target);
+
+      xAsprintf(&data[OPENFILES_DEVICE], "%u,%u", major(sb.st_dev), minor(sb.st_dev));
+      xAsprintf(&data[OPENFILES_INODE], "%llu", (unsigned long long) sb.st_ino);
+      if (S_ISREG(sb.st_mode) || S_ISDIR(sb.st_mode))
+         xAsprintf(&data[OPENFILES_SIZE], "%lld", (long long) sb.st_size);
+
+      const SocketTable_Entry* socket = NULL;
+      if (S_ISSOCK(sb.st_mode)) {
+         if (!Platform_sockets)
+            Platform_sockets = SocketTable_new();
+         socket = SocketTable_lookup(Platform_sockets, pid, sb.st_ino);
+      }
+      if (socket) {
+         type = socket->type;
+         if (socket->protocol)
+            free_and_xStrdup(&data[OPENFILES_INODE], socket->protocol);
+         data[OPENFILES_NAME] = xStrdup(socket->name);
+      }
+      data[OPENFILES_TYPE] = xStrdup(type);
    }
-   int total = fscanf(fd, "some avg10=%32lf avg60=%32lf avg300=%32lf total=%*f ", ten, sixty, threehundred);
-   if (!some) {
-      total = fscanf(fd, "full avg10=%32lf avg60=%32lf avg300=%32lf total=%*f ", ten, sixty, threehundred);
+   if (!data[OPENFILES_NAME])
+      data[OPENFILES_NAME] = xStrdup(target);
+
+   /* "pos:\t0\nflags:\t02100002\n..." */
+   if (infopath) {
+      char filename[64];
+      char info[256];
+      xSnprintf(filename, sizeof(filename), "%s/%s", infopath, name);
+      if (xReadfile(filename, info, sizeof(info)) > 0) {
+         const char* flags = strstr(info, "flags:");
+         if (flags) {
+            switch (strtoul(flags + strlen("flags:"), NULL, 8) & O_ACCMODE) {
+               case O_RDONLY: data[OPENFILES_ACCESS] = xStrdup("r"); break;
+               case O_WRONLY: data[OPENFILES_ACCESS] = xStrdup("w"); break;
+               case O_RDWR:   data[OPENFILES_ACCESS] = xStrdup("u"); break;
+               default: break;
+            }
+         }
+      }
    }
-   (void) total;
-   assert(total == 3);
-   fclose(fd);
+
+   **next = fdata;
+   *next = &fdata->next;
 }
 
-bool Platform_getDiskIO(DiskIOData* data) {
+OpenFiles_ProcessData* Platform_getProcessFiles(pid_t pid) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/fd", pid);
+   DIR* dirp = opendir(path);
+   if (!dirp)
+      return NULL;
+
+   char infopath[64];
+   xSnprintf(infopath, sizeof(infopath), PROCDIR "/%d/fdinfo", pid);
+
+   char procpath[64];
+   xSnprintf(procpath, sizeof(procpath), PROCDIR "/%d", pid);
+   int procfd = open(procpath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+   /* socket states change, and new ones appear, between refreshes */
+   if (Platform_sockets)
+      SocketTable_expire(Platform_sockets);
+
+   OpenFiles_ProcessData* pdata = xCalloc(1, sizeof(OpenFiles_ProcessData));
+   OpenFiles_FileData** next = &pdata->files;
+
+   if (procfd >= 0) {
+      Platform_addFile(&next, "cwd", procfd, procpath, "cwd", NULL, pid);
+      Platform_addFile(&next, "rtd", procfd, procpath, "root", NULL, pid);
+      Platform_addFile(&next, "txt", procfd, procpath, "exe", NULL, pid);
+      close(procfd);
+   }
+
+   int fd = dirfd(dirp);
+   const struct dirent* de;
+   while ((de = readdir(dirp))) {
+      if (!isdigit((unsigned char)de->d_name[0]))
+         continue;
+      Platform_addFile(&next, de->d_name, fd, path, de->d_name, infopath, pid);
+   }
+
+   closedir(dirp);
+   return pdata;
+}
+
+#define PRESSURE_FD_UNOPENED     (-2)
+#define PRESSURE_FD_UNAVAILABLE  (-1)
+
+static int Platform_pressureFds[LAST_PRESSURE_STALL_RESOURCE] = {
+   PRESSURE_FD_UNOPENED,
+   PRESSURE_FD_UNOPENED,
+   PRESSURE_FD_UNOPENED,
+};
+
+bool Platform_getPressureStall(PressureStallResource resource, PressureStallData* data) {
+   int* fd = &Platform_pressureFds[resource];
+   if (*fd == PRESSURE_FD_UNAVAILABLE)
+      return false;
+
+   if (*fd == PRESSURE_FD_UNOPENED) {
+      char procname[64];
+      xSnprintf(procname, sizeof(procname), PROCDIR "/pressure/%s", PressureStall_resourceNames[resource]);
+      *fd = open(procname, O_RDONLY | O_CLOEXEC);
+      if (*fd < 0) {
+         /* kernel without PSI support, or booted with psi=0 */
+         *fd = PRESSURE_FD_UNAVAILABLE;
+         return false;
+      }
+   }
+
+   char buffer[256];
+   ssize_t res = pread(*fd, buffer, sizeof(buffer) - 1, 0);
+   if (res < 1) {
+      close(*fd);
+      *fd = PRESSURE_FD_UNOPENED;
+      return false;
+   }
+   buffer[res] = '\0';
+
+   return PressureStall_parse(buffer, data);
+}
+
+/* e.g. sda1, vdb2, xvda1, mmcblk0p1, nvme0n1p1 */
+static bool Platform_isDiskPartition(const char* name) {
+   const char* p = NULL;
+   if (String_startsWith(name, "sd") || String_startsWith(name, "hd") || String_startsWith(name, "vd"))
+      p = name + 2;
+   else if (String_startsWith(name, "xvd"))
+      p = name + 3;
+
+   if (p) {
+      const char* letters = p;
+      while (isalpha((unsigned char)*p))
+         p++;
+      return p > letters && isdigit((unsigned char)*p);
+   }
+
+   p = strrchr(name, 'p');
+   if (!p || p == name || !isdigit((unsigned char)p[-1]) || !isdigit((unsigned char)p[1]))
+      return false;
+
+   for (p++; *p; p++) {
+      if (!isdigit((unsigned char)*p))
+         return false;
+   }
+   return true;
+}
+
+/* Parse up to count decimal fields; returns the number of fields read */
+static int Platform_parseCounters(const char* str, unsigned long long int* fields, int count) {
+   int n = 0;
+   for (; n < count; n++) {
+      char* end;
+      fields[n] = strtoull(str, &end, 10);
+      if (end == str)
+         break;
+      str = end;
+   }
+   return n;
+}
+
+bool Platform_getDiskIO(DiskIOData* data, DiskIODevices* devices) {
    FILE* fd = fopen(PROCDIR "/diskstats", "r");
    if (!fd)
       return false;
 
-   unsigned long long int read_sum = 0, write_sum = 0, timeSpend_sum = 0;
+   unsigned long long int read_sum = 0, write_sum = 0, timeSpend_sum = 0, reads_sum = 0, writes_sum = 0;
    char lineBuffer[256];
    while (fgets(lineBuffer, sizeof(lineBuffer), fd)) {
-      char diskname[32];
-      unsigned long long int read_tmp, write_tmp, timeSpend_tmp;
-      if (sscanf(lineBuffer, "%*d %*d %31s %*u %*u %llu %*u %*u %*u %llu %*u %*u %llu", diskname, &read_tmp, &write_tmp, &timeSpend_tmp) == 4) {
-         if (String_startsWith(diskname, "dm-"))
-            continue;
+      /* major minor name reads merged sectors ms writes merged sectors ms in-flight io-ms ... */
+      char* diskname = lineBuffer;
+      for (int i = 0; i < 2; i++) {
+         while (*diskname == ' ')
+            diskname++;
+         while (isdigit((unsigned char)*diskname))
+            diskname++;
+      }
+      while (*diskname == ' ')
+         diskname++;
 
-         if (String_startsWith(diskname, "zram"))
-            continue;
+      char* end = diskname;
+      while (*end && *end != ' ')
+         end++;
+      if (end == diskname || *end == '\0')
+         continue;
+      *end = '\0';
 
-         /* only count root disks, e.g. do not count IO from sda and sda1 twice */
-         if ((diskname[0] == 's' || diskname[0] == 'h')
-             && diskname[1] == 'd'
-             && isalpha((unsigned char)diskname[2])
-             && isdigit((unsigned char)diskname[3]))
-            continue;
+      unsigned long long int fields[10];
+      if (Platform_parseCounters(end + 1, fields, ARRAYSIZE(fields)) != (int)ARRAYSIZE(fields))
+         continue;
 
-         /* only count root disks, e.g. do not count IO from mmcblk0 and mmcblk0p1 twice */
-         if (diskname[0] == 'm'
-             && diskname[1] == 'm'
-             && diskname[2] == 'c'
-             && diskname[3] == 'b'
-             && diskname[4] == 'l'
-             && diskname[5] == 'k'
-             && isdigit((unsigned char)diskname[6])
-             && diskname[7] == 'p')
-            continue;
+      if (Platform_isDiskPartition(diskname))
+         continue;
 
-         read_sum += read_tmp;
-         write_sum += write_tmp;
-         timeSpend_sum += timeSpend_tmp;
+      const DiskIOData device = {
+         .totalBytesRead = 512 * fields[2], /* multiply with sector size */
+         .totalBytesWritten = 512 * fields[6],
+         .totalMsTimeSpend = fields[9],
+         .numReads = fields[0],
+         .numWrites = fields[4],
+      };
+
+      if (devices) {
+         DiskIODevice* entry = DiskIODevices_get(devices, diskname);
+         entry->data = device;
+         entry->present = true;
       }
+
+      /* do not count IO on stacked devices twice */
+      if (String_startsWith(diskname, "dm-"))
+         continue;
+
+      if (String_startsWith(diskname, "zram"))
+         continue;
+
+      read_sum += fields[2];
+      write_sum += fields[6];
+      timeSpend_sum += fields[9];
+      reads_sum += fields[0];
+      writes_sum += fields[4];
    }
    fclose(fd);
    /* multiply with sector size */
    data->totalBytesRead = 512 * read_sum;
    data->totalBytesWritten = 512 * write_sum;
    data->totalMsTimeSpend = timeSpend_sum;
+   data->numReads = reads_sum;
+   data->numWrites = writes_sum;
    return true;
 }
 
-bool Platform_getNetworkIO(NetworkIOData* data) {
+bool Platform_getNetworkIO(NetworkIOData* data, NetworkIOInterfaces* interfaces) {
    FILE* fd = fopen(PROCDIR "/net/dev", "r");
    if (!fd)
       return false;
@@ -594,23 +847,40 @@ bool Platform_getNetworkIO(NetworkIOData* data) {
    memset(data, 0, sizeof(NetworkIOData));
    char lineBuffer[512];
    while (fgets(lineBuffer, sizeof(lineBuffer), fd)) {
-      char interfaceName[32];
-      unsigned long long int bytesReceived, packetsReceived, bytesTransmitted, packetsTransmitted;
-      if (sscanf(lineBuffer, "%31s %llu %llu %*u %*u %*u %*u %*u %*u %llu %llu",
-                             interfaceName,
-                             &bytesReceived,
-                             &packetsReceived,
-                             &bytesTransmitted,
-                             &packetsTransmitted) != 5)
+      /* "  eth0: rx-bytes rx-packets 6 more rx fields tx-bytes tx-packets ..."; the header lines have no colon */
+      char* colon = strchr(lineBuffer, ':');
+      if (!colon)
          continue;
+      *colon = '\0';
+
+      const char* interfaceName = lineBuffer;
+      while (*interfaceName == ' ')
+         interfaceName++;
 
-      if (String_eq(interfaceName, "lo:"))
+      unsigned long long int fields[10];
+      if (Platform_parseCounters(colon + 1, fields, ARRAYSIZE(fields)) != (int)ARRAYSIZE(fields))
          continue;
 
-      data->bytesReceived += bytesReceived;
-      data->packetsReceived += packetsReceived;
-      data->bytesTransmitted += bytesTransmitted;
-      data->packetsTransmitted += packetsTransmitted;
+      const NetworkIOData interface = {
+         .bytesReceived = fields[0],
+         .packetsReceived = fields[1],
+         .bytesTransmitted = fields[8],
+         .packetsTransmitted = fields[9],
+      };
+
+      if (interfaces) {
+         NetworkIOInterface* entry = NetworkIOInterfaces_get(interfaces, interfaceName);
+         entry->data = interface;
+         entry->present = true;
+      }
+
+      if (String_eq(interfaceName, "lo"))
+         continue;
+
+      data->bytesReceived += interface.bytesReceived;
+      data->packetsReceived += interface.packetsReceived;
+      data->bytesTransmitted += interface.bytesTransmitted;
+      data->packetsTransmitted += interface.packetsTransmitted;
    }
 
    fclose(fd);
@@ -1048,6 +1318,15 @@ void Platform_init(void) {
 }
 
 void Platform_done(void) {
+   SocketTable_delete(Platform_sockets);
+   Platform_sockets = NULL;
+
+   for (size_t i = 0; i < ARRAYSIZE(Platform_pressureFds); i++) {
+      if (Platform_pressureFds[i] >= 0)
+         close(Platform_pressureFds[i]);
+      Platform_pressureFds[i] = PRESSURE_FD_UNOPENED;
+   }
+
 #ifdef HAVE_SENSORS_SENSORS_H
    LibSensors_cleanup();
 #endif
@@ -23,6 +23,7 @@ in the source distribution for its full text.
 #include "Macros.h"
 #include "Meter.h"
 #include "NetworkIOMeter.h"
+#include "OpenFilesScreen.h"
 #include "Process.h"
 #include "ProcessLocksScreen.h"
 #include "RichString.h"
@@ -30,6 +31,7 @@ in the source distribution for its full text.
 #include "generic/gettime.h"
 #include "generic/hostname.h"
 #include "generic/uname.h"
+#include "linux/PressureStall.h"
 
 /* GNU/Hurd does not have PATH_MAX in limits.h */
 #ifndef PATH_MAX
@@ -71,15 +73,15 @@ void Platform_setZfsCompressedArcValues(Meter* this);
 
 char* Platform_getProcessEnv(pid_t pid);
 
-char* Platform_getInodeFilename(pid_t pid, ino_t inode);
-
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid);
 
-void Platform_getPressureStall(const char* file, bool some, double* ten, double* sixty, double* threehundred);
+OpenFiles_ProcessData* Platform_getProcessFiles(pid_t pid);
+
+bool Platform_getPressureStall(PressureStallResource resource, PressureStallData* data);
 
-bool Platform_getDiskIO(DiskIOData* data);
+bool Platform_getDiskIO(DiskIOData* data, DiskIODevices* devices);
 
-bool Platform_getNetworkIO(NetworkIOData* data);
+bool Platform_getNetworkIO(NetworkIOData* data, NetworkIOInterfaces* interfaces);
 
 void Platform_getBattery(double* percent, ACPresence* isOnAC);
 
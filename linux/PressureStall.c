@@ -0,0 +1,67 @@
+/*
+htop - PressureStall.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/PressureStall.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "XUtils.h"
+
+
+const char* const PressureStall_resourceNames[LAST_PRESSURE_STALL_RESOURCE] = {
+   [PRESSURE_STALL_CPU] = "cpu",
+   [PRESSURE_STALL_IO] = "io",
+   [PRESSURE_STALL_MEMORY] = "memory",
+};
+
+/* e.g. "avg10=0.12 avg60=0.05 avg300=0.01 total=123456" */
+static void PressureStall_parseLine(const char* line, PressureStallLine* out) {
+   out->valid = true;
+
+   for (const char* at = line; *at && *at != '\n'; ) {
+      while (*at == ' ')
+         at++;
+
+      char* end = NULL;
+      if (String_startsWith(at, "avg10=")) {
+         out->avg10 = strtod(at + strlen("avg10="), &end);
+      } else if (String_startsWith(at, "avg60=")) {
+         out->avg60 = strtod(at + strlen("avg60="), &end);
+      } else if (String_startsWith(at, "avg300=")) {
+         out->avg300 = strtod(at + strlen("avg300="), &end);
+      } else if (String_startsWith(at, "total=")) {
+         out->total = strtoull(at + strlen("total="), &end, 10);
+      }
+
+      if (end)
+         at = end;
+
+      /* skip to the next field */
+      while (*at && *at != ' ' && *at != '\n')
+         at++;
+   }
+}
+
+bool PressureStall_parse(const char* buffer, PressureStallData* data) {
+   memset(data, 0, sizeof(*data));
+
+   for (const char* line = buffer; line && *line; ) {
+      if (String_startsWith(line, "some "))
+         PressureStall_parseLine(line + strlen("some "), &data->some);
+      else if (String_startsWith(line, "full "))
+         PressureStall_parseLine(line + strlen("full "), &data->full);
+
+      line = strchr(line, '\n');
+      if (line)
+         line++;
+   }
+
+   return data->some.valid;
+}
@@ -0,0 +1,49 @@
+#ifndef HEADER_PressureStall
+#define HEADER_PressureStall
+/*
+htop - PressureStall.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+typedef enum PressureStallResource_ {
+   PRESSURE_STALL_CPU,
+   PRESSURE_STALL_IO,
+   PRESSURE_STALL_MEMORY,
+   LAST_PRESSURE_STALL_RESOURCE
+} PressureStallResource;
+
+/* File names in /proc/pressure, as well as cgroup "<name>.pressure" files */
+extern const char* const PressureStall_resourceNames[LAST_PRESSURE_STALL_RESOURCE];
+
+typedef struct PressureStallLine_ {
+   bool valid;
+   double avg10;                 /* percent */
+   double avg60;
+   double avg300;
+   unsigned long long total;     /* stalled time in microseconds */
+} PressureStallLine;
+
+typedef struct PressureStallData_ {
+   PressureStallLine some;
+   PressureStallLine full;
+} PressureStallData;
+
+/* Parse the contents of a pressure file; false if it has no "some" line */
+bool PressureStall_parse(const char* buffer, PressureStallData* data);
+
+/* Share of the interval spent stalled, in percent */
+static inline double PressureStall_percent(unsigned long long total, unsigned long long previous, uint64_t intervalMs) {
+   if (intervalMs == 0 || total < previous)
+      return 0.0;
+
+   double percent = (double)(total - previous) / (double)intervalMs / 10.0;
+   return percent > 100.0 ? 100.0 : percent;
+}
+
+#endif
@@ -8,31 +8,78 @@ in the source distribution for its full text.
 
 #include "linux/PressureStallMeter.h"
 
+#include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "CRT.h"
 #include "Meter.h"
 #include "Object.h"
 #include "Platform.h"
+#include "ProcessList.h"
 #include "RichString.h"
 #include "XUtils.h"
+#include "linux/PressureStall.h"
 
 
 static const int PressureStallMeter_attributes[] = {
+   PRESSURE_STALL_TEN,
    PRESSURE_STALL_TEN,
    PRESSURE_STALL_SIXTY,
    PRESSURE_STALL_THREEHUNDRED
 };
 
+typedef struct PressureStallSample_ {
+   uint64_t lastUpdate;
+   bool valid;
+   bool hasPrevious;
+   PressureStallData data;
+   unsigned long long previousSome;
+   unsigned long long previousFull;
+   double somePercent;           /* share of the last interval spent stalled */
+   double fullPercent;
+} PressureStallSample;
+
+/* Shared by all meters, so that every pressure file is read once per update */
+static PressureStallSample PressureStallMeter_samples[LAST_PRESSURE_STALL_RESOURCE];
+
+static const PressureStallSample* PressureStallMeter_sample(const ProcessList* pl, PressureStallResource resource) {
+   PressureStallSample* sample = &PressureStallMeter_samples[resource];
+   if (sample->lastUpdate == pl->realtimeMs)
+      return sample;
+
+   uint64_t passedTimeInMs = pl->realtimeMs - sample->lastUpdate;
+   sample->lastUpdate = pl->realtimeMs;
+
+   sample->valid = Platform_getPressureStall(resource, &sample->data);
+   if (!sample->valid) {
+      sample->hasPrevious = false;
+      return sample;
+   }
+
+   if (sample->hasPrevious) {
+      sample->somePercent = PressureStall_percent(sample->data.some.total, sample->previousSome, passedTimeInMs);
+      sample->fullPercent = PressureStall_percent(sample->data.full.total, sample->previousFull, passedTimeInMs);
+   } else {
+      sample->somePercent = 0.0;
+      sample->fullPercent = 0.0;
+   }
+
+   sample->previousSome = sample->data.some.total;
+   sample->previousFull = sample->data.full.total;
+   sample->hasPrevious = true;
+   return sample;
+}
+
 static void PressureStallMeter_updateValues(Meter* this) {
-   const char* file;
+   PressureStallResource resource;
    if (strstr(Meter_name(this), "CPU")) {
-      file = "cpu";
+      resource = PRESSURE_STALL_CPU;
    } else if (strstr(Meter_name(this), "IO")) {
-      file = "io";
+      resource = PRESSURE_STALL_IO;
    } else {
-      file = "memory";
+      resource = PRESSURE_STALL_MEMORY;
    }
 
    bool some;
@@ -42,12 +89,21 @@ static void PressureStallMeter_updateValues(Meter* this) {
       some = false;
    }
 
-   Platform_getPressureStall(file, some, &this->values[0], &this->values[1], &this->values[2]);
+   const PressureStallSample* sample = PressureStallMeter_sample(this->pl, resource);
+   const PressureStallLine* line = some ? &sample->data.some : &sample->data.full;
+   if (sample->valid && line->valid) {
+      this->values[0] = some ? sample->somePercent : sample->fullPercent;
+      this->values[1] = line->avg10;
+      this->values[2] = line->avg60;
+      this->values[3] = line->avg300;
+   } else {
+      this->values[0] = this->values[1] = this->values[2] = this->values[3] = NAN;
+   }
 
-   /* only print bar for ten (not sixty and threehundred), cause the sum is meaningless */
+   /* only print bar and graph for the last interval, cause the sum is meaningless */
    this->curItems = 1;
 
-   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%s %s %5.2lf%% %5.2lf%% %5.2lf%%", some ? "some" : "full", file, this->values[0], this->values[1], this->values[2]);
+   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%s %s %5.2lf%% (%5.2lf%% %5.2lf%% %5.2lf%%)", some ? "some" : "full", PressureStall_resourceNames[resource], this->values[0], this->values[1], this->values[2], this->values[3]);
 }
 
 static void PressureStallMeter_display(const Object* cast, RichString* out) {
@@ -56,10 +112,13 @@ static void PressureStallMeter_display(const Object* cast, RichString* out) {
    int len;
 
    len = xSnprintf(buffer, sizeof(buffer), "%5.2lf%% ", this->values[0]);
-   RichString_appendnAscii(out, CRT_colors[PRESSURE_STALL_TEN], buffer, len);
+   RichString_appendnAscii(out, CRT_colors[METER_VALUE], buffer, len);
+   RichString_appendAscii(out, CRT_colors[METER_TEXT], "avg ");
    len = xSnprintf(buffer, sizeof(buffer), "%5.2lf%% ", this->values[1]);
-   RichString_appendnAscii(out, CRT_colors[PRESSURE_STALL_SIXTY], buffer, len);
+   RichString_appendnAscii(out, CRT_colors[PRESSURE_STALL_TEN], buffer, len);
    len = xSnprintf(buffer, sizeof(buffer), "%5.2lf%% ", this->values[2]);
+   RichString_appendnAscii(out, CRT_colors[PRESSURE_STALL_SIXTY], buffer, len);
+   len = xSnprintf(buffer, sizeof(buffer), "%5.2lf%% ", this->values[3]);
    RichString_appendnAscii(out, CRT_colors[PRESSURE_STALL_THREEHUNDRED], buffer, len);
 }
 
@@ -71,7 +130,7 @@ const MeterClass PressureStallCPUSomeMeter_class = {
    },
    .updateValues = PressureStallMeter_updateValues,
    .defaultMode = TEXT_METERMODE,
-   .maxItems = 3,
+   .maxItems = 4,
    .total = 100.0,
    .attributes = PressureStallMeter_attributes,
    .name = "PressureStallCPUSome",
@@ -80,6 +139,23 @@ const MeterClass PressureStallCPUSomeMeter_class = {
    .description = "Pressure Stall Information, some cpu"
 };
 
+const MeterClass PressureStallCPUFullMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = PressureStallMeter_display,
+   },
+   .updateValues = PressureStallMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .maxItems = 4,
+   .total = 100.0,
+   .attributes = PressureStallMeter_attributes,
+   .name = "PressureStallCPUFull",
+   .uiName = "PSI full CPU",
+   .caption = "PSI full CPU:    ",
+   .description = "Pressure Stall Information, full cpu"
+};
+
 const MeterClass PressureStallIOSomeMeter_class = {
    .super = {
       .extends = Class(Meter),
@@ -88,7 +164,7 @@ const MeterClass PressureStallIOSomeMeter_class = {
    },
    .updateValues = PressureStallMeter_updateValues,
    .defaultMode = TEXT_METERMODE,
-   .maxItems = 3,
+   .maxItems = 4,
    .total = 100.0,
    .attributes = PressureStallMeter_attributes,
    .name = "PressureStallIOSome",
@@ -105,7 +181,7 @@ const MeterClass PressureStallIOFullMeter_class = {
    },
    .updateValues = PressureStallMeter_updateValues,
    .defaultMode = TEXT_METERMODE,
-   .maxItems = 3,
+   .maxItems = 4,
    .total = 100.0,
    .attributes = PressureStallMeter_attributes,
    .name = "PressureStallIOFull",
@@ -122,7 +198,7 @@ const MeterClass PressureStallMemorySomeMeter_class = {
    },
    .updateValues = PressureStallMeter_updateValues,
    .defaultMode = TEXT_METERMODE,
-   .maxItems = 3,
+   .maxItems = 4,
    .total = 100.0,
    .attributes = PressureStallMeter_attributes,
    .name = "PressureStallMemorySome",
@@ -139,7 +215,7 @@ const MeterClass PressureStallMemoryFullMeter_class = {
    },
    .updateValues = PressureStallMeter_updateValues,
    .defaultMode = TEXT_METERMODE,
-   .maxItems = 3,
+   .maxItems = 4,
    .total = 100.0,
    .attributes = PressureStallMeter_attributes,
    .name = "PressureStallMemoryFull",
@@ -15,6 +15,8 @@ in the source distribution for its full text.
 
 extern const MeterClass PressureStallCPUSomeMeter_class;
 
+extern const MeterClass PressureStallCPUFullMeter_class;
+
 extern const MeterClass PressureStallIOSomeMeter_class;
 
 extern const MeterClass PressureStallIOFullMeter_class;
@@ -46,6 +46,9 @@ in the source distribution for its full text.
    SECATTR = 123,                \
    AUTOGROUP_ID = 127,           \
    AUTOGROUP_NICE = 128,         \
+   CGROUP_PSI_CPU = 129,         \
+   CGROUP_PSI_IO = 130,          \
+   CGROUP_PSI_MEMORY = 131,      \
    // End of list
 
 
@@ -0,0 +1,280 @@
+/*
+htop - SocketTable.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/SocketTable.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/stat.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+#include "linux/LinuxProcessList.h"
+
+
+/* Fields of a line of the tables, up to the inode */
+#define SOCKET_TABLE_FIELDS 10
+
+static const char* const SocketTable_tcpStates[] = {
+   [0x01] = "ESTABLISHED",
+   [0x02] = "SYN_SENT",
+   [0x03] = "SYN_RECV",
+   [0x04] = "FIN_WAIT1",
+   [0x05] = "FIN_WAIT2",
+   [0x06] = "TIME_WAIT",
+   [0x07] = "CLOSE",
+   [0x08] = "CLOSE_WAIT",
+   [0x09] = "LAST_ACK",
+   [0x0A] = "LISTEN",
+   [0x0B] = "CLOSING",
+};
+
+SocketTable* SocketTable_new(void) {
+   SocketTable* this = xMalloc(sizeof(SocketTable));
+   this->sockets = Hashtable_new(256, true);
+   this->scanned = Hashtable_new(8, false);
+   this->processes = Hashtable_new(64, true);
+   return this;
+}
+
+void SocketTable_delete(SocketTable* this) {
+   if (!this)
+      return;
+
+   Hashtable_delete(this->sockets);
+   Hashtable_delete(this->scanned);
+   Hashtable_delete(this->processes);
+   free(this);
+}
+
+void SocketTable_expire(SocketTable* this) {
+   Hashtable_clear(this->sockets);
+   Hashtable_clear(this->scanned);
+   Hashtable_clear(this->processes);
+}
+
+/* Splits whitespace separated fields of line in place, up to max; the rest
+ * of the line, if any, is left after the last one */
+static size_t SocketTable_split(char* line, char** fields, size_t max, char** rest) {
+   size_t count = 0;
+   char* at = line;
+   *rest = NULL;
+
+   while (count < max) {
+      while (*at == ' ' || *at == '\t')
+         at++;
+      if (!*at || *at == '\n')
+         return count;
+
+      fields[count++] = at;
+      while (*at && *at != ' ' && *at != '\t' && *at != '\n')
+         at++;
+      if (!*at)
+         return count;
+      if (*at == '\n') {
+         *at = '\0';
+         return count;
+      }
+      *at++ = '\0';
+   }
+
+   while (*at == ' ' || *at == '\t')
+      at++;
+   char* end = strchr(at, '\n');
+   if (end)
+      *end = '\0';
+   if (*at)
+      *rest = at;
+   return count;
+}
+
+static void SocketTable_add(SocketTable* this, ino_t inode, const char* type, const char* protocol, const char* name) {
+   size_t length = strlen(name);
+   SocketTable_Entry* entry = xMalloc(sizeof(SocketTable_Entry) + length + 1);
+   entry->inode = inode;
+   entry->type = type;
+   entry->protocol = protocol;
+   memcpy(entry->name, name, length + 1);
+   Hashtable_put(this->sockets, (ht_key_t) inode, entry);
+}
+
+/* e.g. "0100007F:0016", the address in words of host byte order */
+static bool SocketTable_formatAddress(const char* hex, bool ipv6, char* buffer, size_t size, bool* any) {
+   const char* colon = strchr(hex, ':');
+   size_t words = ipv6 ? 4 : 1;
+   if (!colon || (size_t)(colon - hex) != words * 8)
+      return false;
+
+   uint32_t address[4] = {0};
+   for (size_t i = 0; i < words; i++) {
+      char word[9];
+      memcpy(word, hex + i * 8, 8);
+      word[8] = '\0';
+      address[i] = (uint32_t) strtoul(word, NULL, 16);
+   }
+   unsigned long port = strtoul(colon + 1, NULL, 16);
+   *any = !(address[0] | address[1] | address[2] | address[3]);
+
+   char text[INET6_ADDRSTRLEN];
+   if (*any) {
+      xSnprintf(buffer, size, "*:%lu", port);
+   } else if (ipv6) {
+      struct in6_addr in6;
+      memcpy(&in6, address, sizeof(in6));
+      inet_ntop(AF_INET6, &in6, text, sizeof(text));
+      xSnprintf(buffer, size, "[%s]:%lu", text, port);
+   } else {
+      struct in_addr in;
+      memcpy(&in, address, sizeof(in));
+      inet_ntop(AF_INET, &in, text, sizeof(text));
+      xSnprintf(buffer, size, "%s:%lu", text, port);
+   }
+   return true;
+}
+
+/* "sl local_address rem_address st tx_queue:rx_queue tr:tm->when retrnsmt uid timeout inode ..." */
+static void SocketTable_readInet(SocketTable* this, FILE* file, bool ipv6, bool tcp) {
+   const char* type = ipv6 ? "IPv6" : "IPv4";
+   const char* protocol = tcp ? "TCP" : "UDP";
+   char line[512];
+
+   if (!fgets(line, sizeof(line), file))
+      return;
+
+   while (fgets(line, sizeof(line), file)) {
+      char* fields[SOCKET_TABLE_FIELDS];
+      char* rest;
+      if (SocketTable_split(line, fields, SOCKET_TABLE_FIELDS, &rest) < SOCKET_TABLE_FIELDS)
+         continue;
+
+      ino_t inode = strtoull(fields[9], NULL, 10);
+      if (!inode)
+         continue;
+
+      char local[INET6_ADDRSTRLEN + 16];
+      char remote[INET6_ADDRSTRLEN + 16];
+      bool localAny, remoteAny;
+      if (!SocketTable_formatAddress(fields[1], ipv6, local, sizeof(local), &localAny) ||
+          !SocketTable_formatAddress(fields[2], ipv6, remote, sizeof(remote), &remoteAny))
+         continue;
+
+      unsigned long state = strtoul(fields[3], NULL, 16);
+      const char* stateName = tcp && state < ARRAYSIZE(SocketTable_tcpStates) ? SocketTable_tcpStates[state] : NULL;
+
+      char name[2 * sizeof(local) + 32];
+      int length = xSnprintf(name, sizeof(name), "%s", local);
+      if (!remoteAny)
+         length += xSnprintf(name + length, sizeof(name) - length, "->%s", remote);
+      if (stateName)
+         xSnprintf(name + length, sizeof(name) - length, " (%s)", stateName);
+
+      SocketTable_add(this, inode, type, protocol, name);
+   }
+}
+
+/* "Num RefCount Protocol Flags Type St Inode Path" */
+static void SocketTable_readUnix(SocketTable* this, FILE* file) {
+   char line[512];
+
+   if (!fgets(line, sizeof(line), file))
+      return;
+
+   while (fgets(line, sizeof(line), file)) {
+      char* fields[7];
+      char* path;
+      if (SocketTable_split(line, fields, ARRAYSIZE(fields), &path) < ARRAYSIZE(fields))
+         continue;
+
+      ino_t inode = strtoull(fields[6], NULL, 10);
+      if (!inode)
+         continue;
+
+      const char* kind;
+      switch (strtoul(fields[4], NULL, 16)) {
+         case 1: kind = "STREAM"; break;
+         case 2: kind = "DGRAM"; break;
+         case 5: kind = "SEQPACKET"; break;
+         default: kind = "?"; break;
+      }
+
+      char name[sizeof(line) + 32];
+      if (path)
+         xSnprintf(name, sizeof(name), "%s type=%s", path, kind);
+      else
+         xSnprintf(name, sizeof(name), "type=%s", kind);
+
+      SocketTable_add(this, inode, "unix", NULL, name);
+   }
+}
+
+static void SocketTable_scan(SocketTable* this, pid_t pid) {
+   static const struct {
+      const char* name;
+      bool ipv6;
+      bool tcp;
+   } tables[] = {
+      { "tcp", false, true },
+      { "tcp6", true, true },
+      { "udp", false, false },
+      { "udp6", true, false },
+   };
+
+   char path[64];
+   for (size_t i = 0; i < ARRAYSIZE(tables); i++) {
+      xSnprintf(path, sizeof(path), PROCDIR "/%d/net/%s", pid, tables[i].name);
+      FILE* file = fopen(path, "r");
+      if (!file)
+         continue;
+      SocketTable_readInet(this, file, tables[i].ipv6, tables[i].tcp);
+      fclose(file);
+   }
+
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/net/unix", pid);
+   FILE* file = fopen(path, "r");
+   if (file) {
+      SocketTable_readUnix(this, file);
+      fclose(file);
+   }
+}
+
+const SocketTable_Entry* SocketTable_lookup(SocketTable* this, pid_t pid, ino_t inode) {
+   const SocketTable_Entry* entry = Hashtable_get(this->sockets, (ht_key_t) inode);
+   if (entry && entry->inode == inode)
+      return entry;
+
+   /* sockets in no table, e.g. netlink ones, come back on every refresh */
+   SocketTable_Process* process = Hashtable_get(this->processes, (ht_key_t) pid);
+   if (!process) {
+      char path[64];
+      struct stat sb;
+      xSnprintf(path, sizeof(path), PROCDIR "/%d/ns/net", pid);
+
+      process = xCalloc(1, sizeof(SocketTable_Process));
+      process->namespace = stat(path, &sb) == 0 ? sb.st_ino : 0;
+      Hashtable_put(this->processes, (ht_key_t) pid, process);
+   }
+
+   /* without the namespace, the tables as seen by this process are read */
+   if (process->scanned || (process->namespace && Hashtable_get(this->scanned, (ht_key_t) process->namespace)))
+      return NULL;
+
+   SocketTable_scan(this, pid);
+   process->scanned = true;
+   if (process->namespace)
+      Hashtable_put(this->scanned, (ht_key_t) process->namespace, this);
+
+   entry = Hashtable_get(this->sockets, (ht_key_t) inode);
+   return entry && entry->inode == inode ? entry : NULL;
+}
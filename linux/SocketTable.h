@@ -0,0 +1,49 @@
+#ifndef HEADER_SocketTable
+#define HEADER_SocketTable
+/*
+htop - SocketTable.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+
+
+typedef struct SocketTable_Entry_ {
+   ino_t inode;
+   const char* type;          /* as lsof(8) names it: IPv4, IPv6 or unix */
+   const char* protocol;      /* TCP or UDP, NULL for unix sockets */
+   char name[];               /* addresses and state, or path and type */
+} SocketTable_Entry;
+
+/* A process a socket was looked up for */
+typedef struct SocketTable_Process_ {
+   ino_t namespace;           /* of its network namespace, 0 where it may not be inspected */
+   bool scanned;              /* its own tables were read, for want of the namespace */
+} SocketTable_Process;
+
+/* Sockets of /proc/PID/net/{tcp,tcp6,udp,udp6,unix} by inode, read once
+ * per network namespace and kept until the next expiry */
+typedef struct SocketTable_ {
+   Hashtable* sockets;
+   Hashtable* scanned;        /* network namespaces read since the last expiry */
+   Hashtable* processes;      /* SocketTable_Process by pid, since the last expiry */
+} SocketTable;
+
+SocketTable* SocketTable_new(void);
+
+void SocketTable_delete(SocketTable* this);
+
+/* Forgets all sockets, so the next lookups read the tables again with the
+ * current states and without closed sockets */
+void SocketTable_expire(SocketTable* this);
+
+/* The socket with the inode, as seen by the process; NULL if it is not in
+ * the tables, e.g. a netlink socket */
+const SocketTable_Entry* SocketTable_lookup(SocketTable* this, pid_t pid, ino_t inode);
+
+#endif
@@ -0,0 +1,231 @@
+/*
+htop - SyscallScreen.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/SyscallScreen.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FunctionBar.h"
+#include "Macros.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "TraceScreen.h"
+#include "Vector.h"
+#include "XUtils.h"
+#include "generic/gettime.h"
+
+
+static const char* const SyscallScreenFunctions[] = {"Search ", "Filter ", "SortBy ", "Reset  ", "Strace ", "Freeze ", "Done   ", NULL};
+
+static const char* const SyscallScreenKeys[] = {"F3", "F4", "F6", "F7", "F8", "F9", "Esc"};
+
+static const int SyscallScreenEvents[] = {KEY_F(3), KEY_F(4), KEY_F(6), KEY_F(7), KEY_F(8), KEY_F(9), 27};
+
+static const char* const SyscallScreen_sortNames[LAST_SYSCALL_SORT] = {
+   [SYSCALL_SORT_TIME] = "total time",
+   [SYSCALL_SORT_CALLS] = "calls",
+   [SYSCALL_SORT_MAX] = "max latency",
+};
+
+typedef struct SyscallScreen_Entry_ {
+   unsigned int nr;
+   uint64_t key;
+   SyscallTracer_Call call;
+} SyscallScreen_Entry;
+
+SyscallScreen* SyscallScreen_new(const Process* process) {
+   SyscallScreen* this = xCalloc(1, sizeof(SyscallScreen));
+   Object_setClass(this, Class(SyscallScreen));
+   FunctionBar* fuBar = FunctionBar_new(SyscallScreenFunctions, SyscallScreenKeys, SyscallScreenEvents);
+   return (SyscallScreen*) InfoScreen_init(&this->super, process, fuBar, LINES - 2, "     CALLS   TOTAL ms  %TIME     AVG us     MAX us  SYSCALL");
+}
+
+void SyscallScreen_delete(Object* cast) {
+   SyscallScreen* this = (SyscallScreen*) cast;
+   SyscallTracer_delete(this->tracer);
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+bool SyscallScreen_attach(SyscallScreen* this) {
+   this->tracer = SyscallTracer_new(this->super.process->pid);
+   this->error = this->tracer ? 0 : errno;
+   Generic_gettime_monotonic(&this->since);
+   return this->tracer != NULL;
+}
+
+static void SyscallScreen_draw(InfoScreen* super) {
+   const SyscallScreen* this = (const SyscallScreen*) super;
+   const SyscallTracer_Shared* shared = this->tracer ? this->tracer->shared : NULL;
+
+   char status[96];
+   if (!shared) {
+      xSnprintf(status, sizeof(status), "not traced: %s", strerror(this->error));
+   } else if (shared->done && shared->error) {
+      xSnprintf(status, sizeof(status), "tracing stopped: %s", strerror(shared->error));
+   } else if (shared->done) {
+      xSnprintf(status, sizeof(status), "process exited");
+   } else {
+      xSnprintf(status, sizeof(status), "%"PRIu64" threads%s", shared->threads, this->frozen ? ", frozen" : "");
+   }
+
+   InfoScreen_drawTitled(super, "Syscalls of process %d - %s, stopped at every call: %"PRIu64" calls in %"PRIu64"s by %s, %s",
+      super->process->pid, Process_getCommand(super->process),
+      this->calls, this->elapsed / 1000, SyscallScreen_sortNames[this->sort], status);
+}
+
+static int SyscallScreen_compareEntries(const void* v1, const void* v2) {
+   const SyscallScreen_Entry* e1 = v1;
+   const SyscallScreen_Entry* e2 = v2;
+
+   int r = SPACESHIP_NUMBER(e2->key, e1->key);
+   return r ? r : SPACESHIP_NUMBER(e1->nr, e2->nr);
+}
+
+static void SyscallScreen_scan(InfoScreen* super) {
+   SyscallScreen* this = (SyscallScreen*) super;
+   Panel* panel = super->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+
+   if (!this->tracer)
+      return;
+
+   uint64_t now;
+   Generic_gettime_monotonic(&now);
+   this->elapsed = now - this->since;
+
+   /* a copy, as the tracing process goes on counting, and none of the
+    * counts it is yet to clear */
+   SyscallTracer_Call calls[ARRAYSIZE(this->tracer->shared->calls)];
+   if (SyscallTracer_pending(this->tracer))
+      memset(calls, 0, sizeof(calls));
+   else
+      memcpy(calls, this->tracer->shared->calls, sizeof(calls));
+
+   SyscallScreen_Entry entries[ARRAYSIZE(calls)];
+   size_t count = 0;
+   this->calls = 0;
+   this->total = 0;
+
+   for (unsigned int nr = 0; nr < ARRAYSIZE(calls); nr++) {
+      const SyscallTracer_Call* call = &calls[nr];
+      if (!call->count)
+         continue;
+
+      this->calls += call->count;
+      this->total += call->total;
+
+      uint64_t key;
+      switch (this->sort) {
+         case SYSCALL_SORT_CALLS: key = call->count; break;
+         case SYSCALL_SORT_MAX: key = call->max; break;
+         default: key = call->total; break;
+      }
+      entries[count++] = (SyscallScreen_Entry) { .nr = nr, .key = key, .call = *call };
+   }
+   qsort(entries, count, sizeof(SyscallScreen_Entry), SyscallScreen_compareEntries);
+
+   for (size_t i = 0; i < count; i++) {
+      const SyscallScreen_Entry* entry = &entries[i];
+      const SyscallTracer_Call* call = &entry->call;
+
+      char unknown[32];
+      const char* name = SyscallTracer_name(entry->nr);
+      if (entry->nr == SYSCALL_TRACER_FOREIGN) {
+         name = "(other ABI)";
+      } else if (entry->nr == SYSCALL_TRACER_HIGHER) {
+         name = "(higher numbers)";
+      } else if (!name) {
+         xSnprintf(unknown, sizeof(unknown), "syscall_%u", entry->nr);
+         name = unknown;
+      }
+
+      char line[128];
+      xSnprintf(line, sizeof(line), "%10"PRIu64" %10.3f %6.1f %10.1f %10.1f  %s",
+         call->count,
+         call->total / 1e6,
+         this->total ? 100.0 * call->total / this->total : 0.0,
+         call->total / 1e3 / call->count,
+         call->max / 1e3,
+         name);
+      InfoScreen_addLine(super, line);
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+static void SyscallScreen_refresh(InfoScreen* super) {
+   Vector_prune(super->lines);
+   InfoScreen_scan(super);
+   InfoScreen_draw(super);
+}
+
+static void SyscallScreen_onErr(InfoScreen* super) {
+   if (!((SyscallScreen*) super)->frozen)
+      SyscallScreen_refresh(super);
+}
+
+/* Hands the process over to strace, which cannot attach while it is traced */
+static void SyscallScreen_strace(SyscallScreen* this) {
+   SyscallTracer_delete(this->tracer);
+   this->tracer = NULL;
+
+   TraceScreen* ts = TraceScreen_new(this->super.process);
+   if (TraceScreen_forkTracer(ts))
+      InfoScreen_run((InfoScreen*)ts);
+   TraceScreen_delete((Object*)ts);
+   clear();
+
+   SyscallScreen_attach(this);
+}
+
+static bool SyscallScreen_onKey(InfoScreen* super, int ch) {
+   SyscallScreen* this = (SyscallScreen*) super;
+   switch (ch) {
+      case 'o':
+      case KEY_F(6):
+         this->sort = (this->sort + 1) % LAST_SYSCALL_SORT;
+         SyscallScreen_refresh(super);
+         return true;
+      case 'r':
+      case KEY_F(7):
+         if (this->tracer)
+            SyscallTracer_reset(this->tracer);
+         Generic_gettime_monotonic(&this->since);
+         SyscallScreen_refresh(super);
+         return true;
+      case 's':
+      case KEY_F(8):
+         SyscallScreen_strace(this);
+         SyscallScreen_refresh(super);
+         return true;
+      case 't':
+      case KEY_F(9):
+         this->frozen = !this->frozen;
+         FunctionBar_setLabel(super->display->defaultBar, KEY_F(9), this->frozen ? "Resume " : "Freeze ");
+         InfoScreen_draw(super);
+         return true;
+   }
+   return false;
+}
+
+const InfoScreenClass SyscallScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = SyscallScreen_delete
+   },
+   .scan = SyscallScreen_scan,
+   .draw = SyscallScreen_draw,
+   .onErr = SyscallScreen_onErr,
+   .onKey = SyscallScreen_onKey,
+};
@@ -0,0 +1,47 @@
+#ifndef HEADER_SyscallScreen
+#define HEADER_SyscallScreen
+/*
+htop - SyscallScreen.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "Process.h"
+#include "linux/SyscallTracer.h"
+
+
+typedef enum SyscallScreen_Sort_ {
+   SYSCALL_SORT_TIME,
+   SYSCALL_SORT_CALLS,
+   SYSCALL_SORT_MAX,
+   LAST_SYSCALL_SORT
+} SyscallScreen_Sort;
+
+typedef struct SyscallScreen_ {
+   InfoScreen super;
+   SyscallTracer* tracer;     /* NULL while strace traces instead */
+   SyscallScreen_Sort sort;
+   bool frozen;
+   int error;                 /* why the process is not traced */
+   uint64_t since;            /* monotonic milliseconds counting started at */
+   uint64_t elapsed;          /* of counting, at the last scan */
+   uint64_t calls;            /* totals of the last scan */
+   uint64_t total;
+} SyscallScreen;
+
+extern const InfoScreenClass SyscallScreen_class;
+
+SyscallScreen* SyscallScreen_new(const Process* process);
+
+void SyscallScreen_delete(Object* cast);
+
+/* Starts counting; false with errno set if the process cannot be traced */
+bool SyscallScreen_attach(SyscallScreen* this);
+
+#endif
@@ -0,0 +1,1747 @@
+/*
+htop - SyscallTracer.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/SyscallTracer.h"
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/audit.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/ptrace.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+#include "CRT.h"
+#include "Hashtable.h"
+#include "Macros.h"
+#include "XUtils.h"
+
+#include "linux/LinuxProcessList.h"
+
+
+typedef struct SyscallTracer_Name_ {
+   unsigned int nr;
+   const char* name;
+} SyscallTracer_Name;
+
+#define SYSCALL_TRACER_NAME(name_) { __NR_##name_, #name_ }
+
+/* Searched rather than indexed: some architectures give one number two names */
+static const SyscallTracer_Name SyscallTracer_names[] = {
+#ifdef __NR__llseek
+   SYSCALL_TRACER_NAME(_llseek),
+#endif
+#ifdef __NR__newselect
+   SYSCALL_TRACER_NAME(_newselect),
+#endif
+#ifdef __NR__sysctl
+   SYSCALL_TRACER_NAME(_sysctl),
+#endif
+#ifdef __NR_accept
+   SYSCALL_TRACER_NAME(accept),
+#endif
+#ifdef __NR_accept4
+   SYSCALL_TRACER_NAME(accept4),
+#endif
+#ifdef __NR_access
+   SYSCALL_TRACER_NAME(access),
+#endif
+#ifdef __NR_acct
+   SYSCALL_TRACER_NAME(acct),
+#endif
+#ifdef __NR_add_key
+   SYSCALL_TRACER_NAME(add_key),
+#endif
+#ifdef __NR_adjtimex
+   SYSCALL_TRACER_NAME(adjtimex),
+#endif
+#ifdef __NR_afs_syscall
+   SYSCALL_TRACER_NAME(afs_syscall),
+#endif
+#ifdef __NR_alarm
+   SYSCALL_TRACER_NAME(alarm),
+#endif
+#ifdef __NR_arch_prctl
+   SYSCALL_TRACER_NAME(arch_prctl),
+#endif
+#ifdef __NR_bdflush
+   SYSCALL_TRACER_NAME(bdflush),
+#endif
+#ifdef __NR_bind
+   SYSCALL_TRACER_NAME(bind),
+#endif
+#ifdef __NR_bpf
+   SYSCALL_TRACER_NAME(bpf),
+#endif
+#ifdef __NR_break
+   SYSCALL_TRACER_NAME(break),
+#endif
+#ifdef __NR_brk
+   SYSCALL_TRACER_NAME(brk),
+#endif
+#ifdef __NR_capget
+   SYSCALL_TRACER_NAME(capget),
+#endif
+#ifdef __NR_capset
+   SYSCALL_TRACER_NAME(capset),
+#endif
+#ifdef __NR_chdir
+   SYSCALL_TRACER_NAME(chdir),
+#endif
+#ifdef __NR_chmod
+   SYSCALL_TRACER_NAME(chmod),
+#endif
+#ifdef __NR_chown
+   SYSCALL_TRACER_NAME(chown),
+#endif
+#ifdef __NR_chown32
+   SYSCALL_TRACER_NAME(chown32),
+#endif
+#ifdef __NR_chroot
+   SYSCALL_TRACER_NAME(chroot),
+#endif
+#ifdef __NR_clock_adjtime
+   SYSCALL_TRACER_NAME(clock_adjtime),
+#endif
+#ifdef __NR_clock_adjtime64
+   SYSCALL_TRACER_NAME(clock_adjtime64),
+#endif
+#ifdef __NR_clock_getres
+   SYSCALL_TRACER_NAME(clock_getres),
+#endif
+#ifdef __NR_clock_getres_time64
+   SYSCALL_TRACER_NAME(clock_getres_time64),
+#endif
+#ifdef __NR_clock_gettime
+   SYSCALL_TRACER_NAME(clock_gettime),
+#endif
+#ifdef __NR_clock_gettime64
+   SYSCALL_TRACER_NAME(clock_gettime64),
+#endif
+#ifdef __NR_clock_nanosleep
+   SYSCALL_TRACER_NAME(clock_nanosleep),
+#endif
+#ifdef __NR_clock_nanosleep_time64
+   SYSCALL_TRACER_NAME(clock_nanosleep_time64),
+#endif
+#ifdef __NR_clock_settime
+   SYSCALL_TRACER_NAME(clock_settime),
+#endif
+#ifdef __NR_clock_settime64
+   SYSCALL_TRACER_NAME(clock_settime64),
+#endif
+#ifdef __NR_clone
+   SYSCALL_TRACER_NAME(clone),
+#endif
+#ifdef __NR_clone3
+   SYSCALL_TRACER_NAME(clone3),
+#endif
+#ifdef __NR_close
+   SYSCALL_TRACER_NAME(close),
+#endif
+#ifdef __NR_close_range
+   SYSCALL_TRACER_NAME(close_range),
+#endif
+#ifdef __NR_connect
+   SYSCALL_TRACER_NAME(connect),
+#endif
+#ifdef __NR_copy_file_range
+   SYSCALL_TRACER_NAME(copy_file_range),
+#endif
+#ifdef __NR_creat
+   SYSCALL_TRACER_NAME(creat),
+#endif
+#ifdef __NR_create_module
+   SYSCALL_TRACER_NAME(create_module),
+#endif
+#ifdef __NR_delete_module
+   SYSCALL_TRACER_NAME(delete_module),
+#endif
+#ifdef __NR_dup
+   SYSCALL_TRACER_NAME(dup),
+#endif
+#ifdef __NR_dup2
+   SYSCALL_TRACER_NAME(dup2),
+#endif
+#ifdef __NR_dup3
+   SYSCALL_TRACER_NAME(dup3),
+#endif
+#ifdef __NR_epoll_create
+   SYSCALL_TRACER_NAME(epoll_create),
+#endif
+#ifdef __NR_epoll_create1
+   SYSCALL_TRACER_NAME(epoll_create1),
+#endif
+#ifdef __NR_epoll_ctl
+   SYSCALL_TRACER_NAME(epoll_ctl),
+#endif
+#ifdef __NR_epoll_ctl_old
+   SYSCALL_TRACER_NAME(epoll_ctl_old),
+#endif
+#ifdef __NR_epoll_pwait
+   SYSCALL_TRACER_NAME(epoll_pwait),
+#endif
+#ifdef __NR_epoll_pwait2
+   SYSCALL_TRACER_NAME(epoll_pwait2),
+#endif
+#ifdef __NR_epoll_wait
+   SYSCALL_TRACER_NAME(epoll_wait),
+#endif
+#ifdef __NR_epoll_wait_old
+   SYSCALL_TRACER_NAME(epoll_wait_old),
+#endif
+#ifdef __NR_eventfd
+   SYSCALL_TRACER_NAME(eventfd),
+#endif
+#ifdef __NR_eventfd2
+   SYSCALL_TRACER_NAME(eventfd2),
+#endif
+#ifdef __NR_execve
+   SYSCALL_TRACER_NAME(execve),
+#endif
+#ifdef __NR_execveat
+   SYSCALL_TRACER_NAME(execveat),
+#endif
+#ifdef __NR_exit
+   SYSCALL_TRACER_NAME(exit),
+#endif
+#ifdef __NR_exit_group
+   SYSCALL_TRACER_NAME(exit_group),
+#endif
+#ifdef __NR_faccessat
+   SYSCALL_TRACER_NAME(faccessat),
+#endif
+#ifdef __NR_faccessat2
+   SYSCALL_TRACER_NAME(faccessat2),
+#endif
+#ifdef __NR_fadvise64
+   SYSCALL_TRACER_NAME(fadvise64),
+#endif
+#ifdef __NR_fadvise64_64
+   SYSCALL_TRACER_NAME(fadvise64_64),
+#endif
+#ifdef __NR_fallocate
+   SYSCALL_TRACER_NAME(fallocate),
+#endif
+#ifdef __NR_fanotify_init
+   SYSCALL_TRACER_NAME(fanotify_init),
+#endif
+#ifdef __NR_fanotify_mark
+   SYSCALL_TRACER_NAME(fanotify_mark),
+#endif
+#ifdef __NR_fchdir
+   SYSCALL_TRACER_NAME(fchdir),
+#endif
+#ifdef __NR_fchmod
+   SYSCALL_TRACER_NAME(fchmod),
+#endif
+#ifdef __NR_fchmodat
+   SYSCALL_TRACER_NAME(fchmodat),
+#endif
+#ifdef __NR_fchown
+   SYSCALL_TRACER_NAME(fchown),
+#endif
+#ifdef __NR_fchown32
+   SYSCALL_TRACER_NAME(fchown32),
+#endif
+#ifdef __NR_fchownat
+   SYSCALL_TRACER_NAME(fchownat),
+#endif
+#ifdef __NR_fcntl
+   SYSCALL_TRACER_NAME(fcntl),
+#endif
+#ifdef __NR_fcntl64
+   SYSCALL_TRACER_NAME(fcntl64),
+#endif
+#ifdef __NR_fdatasync
+   SYSCALL_TRACER_NAME(fdatasync),
+#endif
+#ifdef __NR_fgetxattr
+   SYSCALL_TRACER_NAME(fgetxattr),
+#endif
+#ifdef __NR_finit_module
+   SYSCALL_TRACER_NAME(finit_module),
+#endif
+#ifdef __NR_flistxattr
+   SYSCALL_TRACER_NAME(flistxattr),
+#endif
+#ifdef __NR_flock
+   SYSCALL_TRACER_NAME(flock),
+#endif
+#ifdef __NR_fork
+   SYSCALL_TRACER_NAME(fork),
+#endif
+#ifdef __NR_fremovexattr
+   SYSCALL_TRACER_NAME(fremovexattr),
+#endif
+#ifdef __NR_fsconfig
+   SYSCALL_TRACER_NAME(fsconfig),
+#endif
+#ifdef __NR_fsetxattr
+   SYSCALL_TRACER_NAME(fsetxattr),
+#endif
+#ifdef __NR_fsmount
+   SYSCALL_TRACER_NAME(fsmount),
+#endif
+#ifdef __NR_fsopen
+   SYSCALL_TRACER_NAME(fsopen),
+#endif
+#ifdef __NR_fspick
+   SYSCALL_TRACER_NAME(fspick),
+#endif
+#ifdef __NR_fstat
+   SYSCALL_TRACER_NAME(fstat),
+#endif
+#ifdef __NR_fstat64
+   SYSCALL_TRACER_NAME(fstat64),
+#endif
+#ifdef __NR_fstatat64
+   SYSCALL_TRACER_NAME(fstatat64),
+#endif
+#ifdef __NR_fstatfs
+   SYSCALL_TRACER_NAME(fstatfs),
+#endif
+#ifdef __NR_fstatfs64
+   SYSCALL_TRACER_NAME(fstatfs64),
+#endif
+#ifdef __NR_fsync
+   SYSCALL_TRACER_NAME(fsync),
+#endif
+#ifdef __NR_ftime
+   SYSCALL_TRACER_NAME(ftime),
+#endif
+#ifdef __NR_ftruncate
+   SYSCALL_TRACER_NAME(ftruncate),
+#endif
+#ifdef __NR_ftruncate64
+   SYSCALL_TRACER_NAME(ftruncate64),
+#endif
+#ifdef __NR_futex
+   SYSCALL_TRACER_NAME(futex),
+#endif
+#ifdef __NR_futex_time64
+   SYSCALL_TRACER_NAME(futex_time64),
+#endif
+#ifdef __NR_futex_waitv
+   SYSCALL_TRACER_NAME(futex_waitv),
+#endif
+#ifdef __NR_futimesat
+   SYSCALL_TRACER_NAME(futimesat),
+#endif
+#ifdef __NR_get_kernel_syms
+   SYSCALL_TRACER_NAME(get_kernel_syms),
+#endif
+#ifdef __NR_get_mempolicy
+   SYSCALL_TRACER_NAME(get_mempolicy),
+#endif
+#ifdef __NR_get_robust_list
+   SYSCALL_TRACER_NAME(get_robust_list),
+#endif
+#ifdef __NR_get_thread_area
+   SYSCALL_TRACER_NAME(get_thread_area),
+#endif
+#ifdef __NR_getcpu
+   SYSCALL_TRACER_NAME(getcpu),
+#endif
+#ifdef __NR_getcwd
+   SYSCALL_TRACER_NAME(getcwd),
+#endif
+#ifdef __NR_getdents
+   SYSCALL_TRACER_NAME(getdents),
+#endif
+#ifdef __NR_getdents64
+   SYSCALL_TRACER_NAME(getdents64),
+#endif
+#ifdef __NR_getegid
+   SYSCALL_TRACER_NAME(getegid),
+#endif
+#ifdef __NR_getegid32
+   SYSCALL_TRACER_NAME(getegid32),
+#endif
+#ifdef __NR_geteuid
+   SYSCALL_TRACER_NAME(geteuid),
+#endif
+#ifdef __NR_geteuid32
+   SYSCALL_TRACER_NAME(geteuid32),
+#endif
+#ifdef __NR_getgid
+   SYSCALL_TRACER_NAME(getgid),
+#endif
+#ifdef __NR_getgid32
+   SYSCALL_TRACER_NAME(getgid32),
+#endif
+#ifdef __NR_getgroups
+   SYSCALL_TRACER_NAME(getgroups),
+#endif
+#ifdef __NR_getgroups32
+   SYSCALL_TRACER_NAME(getgroups32),
+#endif
+#ifdef __NR_getitimer
+   SYSCALL_TRACER_NAME(getitimer),
+#endif
+#ifdef __NR_getpeername
+   SYSCALL_TRACER_NAME(getpeername),
+#endif
+#ifdef __NR_getpgid
+   SYSCALL_TRACER_NAME(getpgid),
+#endif
+#ifdef __NR_getpgrp
+   SYSCALL_TRACER_NAME(getpgrp),
+#endif
+#ifdef __NR_getpid
+   SYSCALL_TRACER_NAME(getpid),
+#endif
+#ifdef __NR_getpmsg
+   SYSCALL_TRACER_NAME(getpmsg),
+#endif
+#ifdef __NR_getppid
+   SYSCALL_TRACER_NAME(getppid),
+#endif
+#ifdef __NR_getpriority
+   SYSCALL_TRACER_NAME(getpriority),
+#endif
+#ifdef __NR_getrandom
+   SYSCALL_TRACER_NAME(getrandom),
+#endif
+#ifdef __NR_getresgid
+   SYSCALL_TRACER_NAME(getresgid),
+#endif
+#ifdef __NR_getresgid32
+   SYSCALL_TRACER_NAME(getresgid32),
+#endif
+#ifdef __NR_getresuid
+   SYSCALL_TRACER_NAME(getresuid),
+#endif
+#ifdef __NR_getresuid32
+   SYSCALL_TRACER_NAME(getresuid32),
+#endif
+#ifdef __NR_getrlimit
+   SYSCALL_TRACER_NAME(getrlimit),
+#endif
+#ifdef __NR_getrusage
+   SYSCALL_TRACER_NAME(getrusage),
+#endif
+#ifdef __NR_getsid
+   SYSCALL_TRACER_NAME(getsid),
+#endif
+#ifdef __NR_getsockname
+   SYSCALL_TRACER_NAME(getsockname),
+#endif
+#ifdef __NR_getsockopt
+   SYSCALL_TRACER_NAME(getsockopt),
+#endif
+#ifdef __NR_gettid
+   SYSCALL_TRACER_NAME(gettid),
+#endif
+#ifdef __NR_gettimeofday
+   SYSCALL_TRACER_NAME(gettimeofday),
+#endif
+#ifdef __NR_getuid
+   SYSCALL_TRACER_NAME(getuid),
+#endif
+#ifdef __NR_getuid32
+   SYSCALL_TRACER_NAME(getuid32),
+#endif
+#ifdef __NR_getxattr
+   SYSCALL_TRACER_NAME(getxattr),
+#endif
+#ifdef __NR_gtty
+   SYSCALL_TRACER_NAME(gtty),
+#endif
+#ifdef __NR_idle
+   SYSCALL_TRACER_NAME(idle),
+#endif
+#ifdef __NR_init_module
+   SYSCALL_TRACER_NAME(init_module),
+#endif
+#ifdef __NR_inotify_add_watch
+   SYSCALL_TRACER_NAME(inotify_add_watch),
+#endif
+#ifdef __NR_inotify_init
+   SYSCALL_TRACER_NAME(inotify_init),
+#endif
+#ifdef __NR_inotify_init1
+   SYSCALL_TRACER_NAME(inotify_init1),
+#endif
+#ifdef __NR_inotify_rm_watch
+   SYSCALL_TRACER_NAME(inotify_rm_watch),
+#endif
+#ifdef __NR_io_cancel
+   SYSCALL_TRACER_NAME(io_cancel),
+#endif
+#ifdef __NR_io_destroy
+   SYSCALL_TRACER_NAME(io_destroy),
+#endif
+#ifdef __NR_io_getevents
+   SYSCALL_TRACER_NAME(io_getevents),
+#endif
+#ifdef __NR_io_pgetevents
+   SYSCALL_TRACER_NAME(io_pgetevents),
+#endif
+#ifdef __NR_io_pgetevents_time64
+   SYSCALL_TRACER_NAME(io_pgetevents_time64),
+#endif
+#ifdef __NR_io_setup
+   SYSCALL_TRACER_NAME(io_setup),
+#endif
+#ifdef __NR_io_submit
+   SYSCALL_TRACER_NAME(io_submit),
+#endif
+#ifdef __NR_io_uring_enter
+   SYSCALL_TRACER_NAME(io_uring_enter),
+#endif
+#ifdef __NR_io_uring_register
+   SYSCALL_TRACER_NAME(io_uring_register),
+#endif
+#ifdef __NR_io_uring_setup
+   SYSCALL_TRACER_NAME(io_uring_setup),
+#endif
+#ifdef __NR_ioctl
+   SYSCALL_TRACER_NAME(ioctl),
+#endif
+#ifdef __NR_ioperm
+   SYSCALL_TRACER_NAME(ioperm),
+#endif
+#ifdef __NR_iopl
+   SYSCALL_TRACER_NAME(iopl),
+#endif
+#ifdef __NR_ioprio_get
+   SYSCALL_TRACER_NAME(ioprio_get),
+#endif
+#ifdef __NR_ioprio_set
+   SYSCALL_TRACER_NAME(ioprio_set),
+#endif
+#ifdef __NR_ipc
+   SYSCALL_TRACER_NAME(ipc),
+#endif
+#ifdef __NR_kcmp
+   SYSCALL_TRACER_NAME(kcmp),
+#endif
+#ifdef __NR_kexec_file_load
+   SYSCALL_TRACER_NAME(kexec_file_load),
+#endif
+#ifdef __NR_kexec_load
+   SYSCALL_TRACER_NAME(kexec_load),
+#endif
+#ifdef __NR_keyctl
+   SYSCALL_TRACER_NAME(keyctl),
+#endif
+#ifdef __NR_kill
+   SYSCALL_TRACER_NAME(kill),
+#endif
+#ifdef __NR_landlock_add_rule
+   SYSCALL_TRACER_NAME(landlock_add_rule),
+#endif
+#ifdef __NR_landlock_create_ruleset
+   SYSCALL_TRACER_NAME(landlock_create_ruleset),
+#endif
+#ifdef __NR_landlock_restrict_self
+   SYSCALL_TRACER_NAME(landlock_restrict_self),
+#endif
+#ifdef __NR_lchown
+   SYSCALL_TRACER_NAME(lchown),
+#endif
+#ifdef __NR_lchown32
+   SYSCALL_TRACER_NAME(lchown32),
+#endif
+#ifdef __NR_lgetxattr
+   SYSCALL_TRACER_NAME(lgetxattr),
+#endif
+#ifdef __NR_link
+   SYSCALL_TRACER_NAME(link),
+#endif
+#ifdef __NR_linkat
+   SYSCALL_TRACER_NAME(linkat),
+#endif
+#ifdef __NR_listen
+   SYSCALL_TRACER_NAME(listen),
+#endif
+#ifdef __NR_listxattr
+   SYSCALL_TRACER_NAME(listxattr),
+#endif
+#ifdef __NR_llistxattr
+   SYSCALL_TRACER_NAME(llistxattr),
+#endif
+#ifdef __NR_llseek
+   SYSCALL_TRACER_NAME(llseek),
+#endif
+#ifdef __NR_lock
+   SYSCALL_TRACER_NAME(lock),
+#endif
+#ifdef __NR_lookup_dcookie
+   SYSCALL_TRACER_NAME(lookup_dcookie),
+#endif
+#ifdef __NR_lremovexattr
+   SYSCALL_TRACER_NAME(lremovexattr),
+#endif
+#ifdef __NR_lseek
+   SYSCALL_TRACER_NAME(lseek),
+#endif
+#ifdef __NR_lsetxattr
+   SYSCALL_TRACER_NAME(lsetxattr),
+#endif
+#ifdef __NR_lstat
+   SYSCALL_TRACER_NAME(lstat),
+#endif
+#ifdef __NR_lstat64
+   SYSCALL_TRACER_NAME(lstat64),
+#endif
+#ifdef __NR_madvise
+   SYSCALL_TRACER_NAME(madvise),
+#endif
+#ifdef __NR_mbind
+   SYSCALL_TRACER_NAME(mbind),
+#endif
+#ifdef __NR_membarrier
+   SYSCALL_TRACER_NAME(membarrier),
+#endif
+#ifdef __NR_memfd_create
+   SYSCALL_TRACER_NAME(memfd_create),
+#endif
+#ifdef __NR_memfd_secret
+   SYSCALL_TRACER_NAME(memfd_secret),
+#endif
+#ifdef __NR_migrate_pages
+   SYSCALL_TRACER_NAME(migrate_pages),
+#endif
+#ifdef __NR_mincore
+   SYSCALL_TRACER_NAME(mincore),
+#endif
+#ifdef __NR_mkdir
+   SYSCALL_TRACER_NAME(mkdir),
+#endif
+#ifdef __NR_mkdirat
+   SYSCALL_TRACER_NAME(mkdirat),
+#endif
+#ifdef __NR_mknod
+   SYSCALL_TRACER_NAME(mknod),
+#endif
+#ifdef __NR_mknodat
+   SYSCALL_TRACER_NAME(mknodat),
+#endif
+#ifdef __NR_mlock
+   SYSCALL_TRACER_NAME(mlock),
+#endif
+#ifdef __NR_mlock2
+   SYSCALL_TRACER_NAME(mlock2),
+#endif
+#ifdef __NR_mlockall
+   SYSCALL_TRACER_NAME(mlockall),
+#endif
+#ifdef __NR_mmap
+   SYSCALL_TRACER_NAME(mmap),
+#endif
+#ifdef __NR_mmap2
+   SYSCALL_TRACER_NAME(mmap2),
+#endif
+#ifdef __NR_modify_ldt
+   SYSCALL_TRACER_NAME(modify_ldt),
+#endif
+#ifdef __NR_mount
+   SYSCALL_TRACER_NAME(mount),
+#endif
+#ifdef __NR_mount_setattr
+   SYSCALL_TRACER_NAME(mount_setattr),
+#endif
+#ifdef __NR_move_mount
+   SYSCALL_TRACER_NAME(move_mount),
+#endif
+#ifdef __NR_move_pages
+   SYSCALL_TRACER_NAME(move_pages),
+#endif
+#ifdef __NR_mprotect
+   SYSCALL_TRACER_NAME(mprotect),
+#endif
+#ifdef __NR_mpx
+   SYSCALL_TRACER_NAME(mpx),
+#endif
+#ifdef __NR_mq_getsetattr
+   SYSCALL_TRACER_NAME(mq_getsetattr),
+#endif
+#ifdef __NR_mq_notify
+   SYSCALL_TRACER_NAME(mq_notify),
+#endif
+#ifdef __NR_mq_open
+   SYSCALL_TRACER_NAME(mq_open),
+#endif
+#ifdef __NR_mq_timedreceive
+   SYSCALL_TRACER_NAME(mq_timedreceive),
+#endif
+#ifdef __NR_mq_timedreceive_time64
+   SYSCALL_TRACER_NAME(mq_timedreceive_time64),
+#endif
+#ifdef __NR_mq_timedsend
+   SYSCALL_TRACER_NAME(mq_timedsend),
+#endif
+#ifdef __NR_mq_timedsend_time64
+   SYSCALL_TRACER_NAME(mq_timedsend_time64),
+#endif
+#ifdef __NR_mq_unlink
+   SYSCALL_TRACER_NAME(mq_unlink),
+#endif
+#ifdef __NR_mremap
+   SYSCALL_TRACER_NAME(mremap),
+#endif
+#ifdef __NR_msgctl
+   SYSCALL_TRACER_NAME(msgctl),
+#endif
+#ifdef __NR_msgget
+   SYSCALL_TRACER_NAME(msgget),
+#endif
+#ifdef __NR_msgrcv
+   SYSCALL_TRACER_NAME(msgrcv),
+#endif
+#ifdef __NR_msgsnd
+   SYSCALL_TRACER_NAME(msgsnd),
+#endif
+#ifdef __NR_msync
+   SYSCALL_TRACER_NAME(msync),
+#endif
+#ifdef __NR_munlock
+   SYSCALL_TRACER_NAME(munlock),
+#endif
+#ifdef __NR_munlockall
+   SYSCALL_TRACER_NAME(munlockall),
+#endif
+#ifdef __NR_munmap
+   SYSCALL_TRACER_NAME(munmap),
+#endif
+#ifdef __NR_name_to_handle_at
+   SYSCALL_TRACER_NAME(name_to_handle_at),
+#endif
+#ifdef __NR_nanosleep
+   SYSCALL_TRACER_NAME(nanosleep),
+#endif
+#ifdef __NR_newfstatat
+   SYSCALL_TRACER_NAME(newfstatat),
+#endif
+#ifdef __NR_nfsservctl
+   SYSCALL_TRACER_NAME(nfsservctl),
+#endif
+#ifdef __NR_nice
+   SYSCALL_TRACER_NAME(nice),
+#endif
+#ifdef __NR_oldfstat
+   SYSCALL_TRACER_NAME(oldfstat),
+#endif
+#ifdef __NR_oldlstat
+   SYSCALL_TRACER_NAME(oldlstat),
+#endif
+#ifdef __NR_oldolduname
+   SYSCALL_TRACER_NAME(oldolduname),
+#endif
+#ifdef __NR_oldstat
+   SYSCALL_TRACER_NAME(oldstat),
+#endif
+#ifdef __NR_olduname
+   SYSCALL_TRACER_NAME(olduname),
+#endif
+#ifdef __NR_open
+   SYSCALL_TRACER_NAME(open),
+#endif
+#ifdef __NR_open_by_handle_at
+   SYSCALL_TRACER_NAME(open_by_handle_at),
+#endif
+#ifdef __NR_open_tree
+   SYSCALL_TRACER_NAME(open_tree),
+#endif
+#ifdef __NR_openat
+   SYSCALL_TRACER_NAME(openat),
+#endif
+#ifdef __NR_openat2
+   SYSCALL_TRACER_NAME(openat2),
+#endif
+#ifdef __NR_pause
+   SYSCALL_TRACER_NAME(pause),
+#endif
+#ifdef __NR_perf_event_open
+   SYSCALL_TRACER_NAME(perf_event_open),
+#endif
+#ifdef __NR_personality
+   SYSCALL_TRACER_NAME(personality),
+#endif
+#ifdef __NR_pidfd_getfd
+   SYSCALL_TRACER_NAME(pidfd_getfd),
+#endif
+#ifdef __NR_pidfd_open
+   SYSCALL_TRACER_NAME(pidfd_open),
+#endif
+#ifdef __NR_pidfd_send_signal
+   SYSCALL_TRACER_NAME(pidfd_send_signal),
+#endif
+#ifdef __NR_pipe
+   SYSCALL_TRACER_NAME(pipe),
+#endif
+#ifdef __NR_pipe2
+   SYSCALL_TRACER_NAME(pipe2),
+#endif
+#ifdef __NR_pivot_root
+   SYSCALL_TRACER_NAME(pivot_root),
+#endif
+#ifdef __NR_pkey_alloc
+   SYSCALL_TRACER_NAME(pkey_alloc),
+#endif
+#ifdef __NR_pkey_free
+   SYSCALL_TRACER_NAME(pkey_free),
+#endif
+#ifdef __NR_pkey_mprotect
+   SYSCALL_TRACER_NAME(pkey_mprotect),
+#endif
+#ifdef __NR_poll
+   SYSCALL_TRACER_NAME(poll),
+#endif
+#ifdef __NR_ppoll
+   SYSCALL_TRACER_NAME(ppoll),
+#endif
+#ifdef __NR_ppoll_time64
+   SYSCALL_TRACER_NAME(ppoll_time64),
+#endif
+#ifdef __NR_prctl
+   SYSCALL_TRACER_NAME(prctl),
+#endif
+#ifdef __NR_pread64
+   SYSCALL_TRACER_NAME(pread64),
+#endif
+#ifdef __NR_preadv
+   SYSCALL_TRACER_NAME(preadv),
+#endif
+#ifdef __NR_preadv2
+   SYSCALL_TRACER_NAME(preadv2),
+#endif
+#ifdef __NR_prlimit64
+   SYSCALL_TRACER_NAME(prlimit64),
+#endif
+#ifdef __NR_process_madvise
+   SYSCALL_TRACER_NAME(process_madvise),
+#endif
+#ifdef __NR_process_mrelease
+   SYSCALL_TRACER_NAME(process_mrelease),
+#endif
+#ifdef __NR_process_vm_readv
+   SYSCALL_TRACER_NAME(process_vm_readv),
+#endif
+#ifdef __NR_process_vm_writev
+   SYSCALL_TRACER_NAME(process_vm_writev),
+#endif
+#ifdef __NR_prof
+   SYSCALL_TRACER_NAME(prof),
+#endif
+#ifdef __NR_profil
+   SYSCALL_TRACER_NAME(profil),
+#endif
+#ifdef __NR_pselect6
+   SYSCALL_TRACER_NAME(pselect6),
+#endif
+#ifdef __NR_pselect6_time64
+   SYSCALL_TRACER_NAME(pselect6_time64),
+#endif
+#ifdef __NR_ptrace
+   SYSCALL_TRACER_NAME(ptrace),
+#endif
+#ifdef __NR_putpmsg
+   SYSCALL_TRACER_NAME(putpmsg),
+#endif
+#ifdef __NR_pwrite64
+   SYSCALL_TRACER_NAME(pwrite64),
+#endif
+#ifdef __NR_pwritev
+   SYSCALL_TRACER_NAME(pwritev),
+#endif
+#ifdef __NR_pwritev2
+   SYSCALL_TRACER_NAME(pwritev2),
+#endif
+#ifdef __NR_query_module
+   SYSCALL_TRACER_NAME(query_module),
+#endif
+#ifdef __NR_quotactl
+   SYSCALL_TRACER_NAME(quotactl),
+#endif
+#ifdef __NR_quotactl_fd
+   SYSCALL_TRACER_NAME(quotactl_fd),
+#endif
+#ifdef __NR_read
+   SYSCALL_TRACER_NAME(read),
+#endif
+#ifdef __NR_readahead
+   SYSCALL_TRACER_NAME(readahead),
+#endif
+#ifdef __NR_readdir
+   SYSCALL_TRACER_NAME(readdir),
+#endif
+#ifdef __NR_readlink
+   SYSCALL_TRACER_NAME(readlink),
+#endif
+#ifdef __NR_readlinkat
+   SYSCALL_TRACER_NAME(readlinkat),
+#endif
+#ifdef __NR_readv
+   SYSCALL_TRACER_NAME(readv),
+#endif
+#ifdef __NR_reboot
+   SYSCALL_TRACER_NAME(reboot),
+#endif
+#ifdef __NR_recvfrom
+   SYSCALL_TRACER_NAME(recvfrom),
+#endif
+#ifdef __NR_recvmmsg
+   SYSCALL_TRACER_NAME(recvmmsg),
+#endif
+#ifdef __NR_recvmmsg_time64
+   SYSCALL_TRACER_NAME(recvmmsg_time64),
+#endif
+#ifdef __NR_recvmsg
+   SYSCALL_TRACER_NAME(recvmsg),
+#endif
+#ifdef __NR_remap_file_pages
+   SYSCALL_TRACER_NAME(remap_file_pages),
+#endif
+#ifdef __NR_removexattr
+   SYSCALL_TRACER_NAME(removexattr),
+#endif
+#ifdef __NR_rename
+   SYSCALL_TRACER_NAME(rename),
+#endif
+#ifdef __NR_renameat
+   SYSCALL_TRACER_NAME(renameat),
+#endif
+#ifdef __NR_renameat2
+   SYSCALL_TRACER_NAME(renameat2),
+#endif
+#ifdef __NR_request_key
+   SYSCALL_TRACER_NAME(request_key),
+#endif
+#ifdef __NR_restart_syscall
+   SYSCALL_TRACER_NAME(restart_syscall),
+#endif
+#ifdef __NR_rmdir
+   SYSCALL_TRACER_NAME(rmdir),
+#endif
+#ifdef __NR_rseq
+   SYSCALL_TRACER_NAME(rseq),
+#endif
+#ifdef __NR_rt_sigaction
+   SYSCALL_TRACER_NAME(rt_sigaction),
+#endif
+#ifdef __NR_rt_sigpending
+   SYSCALL_TRACER_NAME(rt_sigpending),
+#endif
+#ifdef __NR_rt_sigprocmask
+   SYSCALL_TRACER_NAME(rt_sigprocmask),
+#endif
+#ifdef __NR_rt_sigqueueinfo
+   SYSCALL_TRACER_NAME(rt_sigqueueinfo),
+#endif
+#ifdef __NR_rt_sigreturn
+   SYSCALL_TRACER_NAME(rt_sigreturn),
+#endif
+#ifdef __NR_rt_sigsuspend
+   SYSCALL_TRACER_NAME(rt_sigsuspend),
+#endif
+#ifdef __NR_rt_sigtimedwait
+   SYSCALL_TRACER_NAME(rt_sigtimedwait),
+#endif
+#ifdef __NR_rt_sigtimedwait_time64
+   SYSCALL_TRACER_NAME(rt_sigtimedwait_time64),
+#endif
+#ifdef __NR_rt_tgsigqueueinfo
+   SYSCALL_TRACER_NAME(rt_tgsigqueueinfo),
+#endif
+#ifdef __NR_sched_get_priority_max
+   SYSCALL_TRACER_NAME(sched_get_priority_max),
+#endif
+#ifdef __NR_sched_get_priority_min
+   SYSCALL_TRACER_NAME(sched_get_priority_min),
+#endif
+#ifdef __NR_sched_getaffinity
+   SYSCALL_TRACER_NAME(sched_getaffinity),
+#endif
+#ifdef __NR_sched_getattr
+   SYSCALL_TRACER_NAME(sched_getattr),
+#endif
+#ifdef __NR_sched_getparam
+   SYSCALL_TRACER_NAME(sched_getparam),
+#endif
+#ifdef __NR_sched_getscheduler
+   SYSCALL_TRACER_NAME(sched_getscheduler),
+#endif
+#ifdef __NR_sched_rr_get_interval
+   SYSCALL_TRACER_NAME(sched_rr_get_interval),
+#endif
+#ifdef __NR_sched_rr_get_interval_time64
+   SYSCALL_TRACER_NAME(sched_rr_get_interval_time64),
+#endif
+#ifdef __NR_sched_setaffinity
+   SYSCALL_TRACER_NAME(sched_setaffinity),
+#endif
+#ifdef __NR_sched_setattr
+   SYSCALL_TRACER_NAME(sched_setattr),
+#endif
+#ifdef __NR_sched_setparam
+   SYSCALL_TRACER_NAME(sched_setparam),
+#endif
+#ifdef __NR_sched_setscheduler
+   SYSCALL_TRACER_NAME(sched_setscheduler),
+#endif
+#ifdef __NR_sched_yield
+   SYSCALL_TRACER_NAME(sched_yield),
+#endif
+#ifdef __NR_seccomp
+   SYSCALL_TRACER_NAME(seccomp),
+#endif
+#ifdef __NR_security
+   SYSCALL_TRACER_NAME(security),
+#endif
+#ifdef __NR_select
+   SYSCALL_TRACER_NAME(select),
+#endif
+#ifdef __NR_semctl
+   SYSCALL_TRACER_NAME(semctl),
+#endif
+#ifdef __NR_semget
+   SYSCALL_TRACER_NAME(semget),
+#endif
+#ifdef __NR_semop
+   SYSCALL_TRACER_NAME(semop),
+#endif
+#ifdef __NR_semtimedop
+   SYSCALL_TRACER_NAME(semtimedop),
+#endif
+#ifdef __NR_semtimedop_time64
+   SYSCALL_TRACER_NAME(semtimedop_time64),
+#endif
+#ifdef __NR_sendfile
+   SYSCALL_TRACER_NAME(sendfile),
+#endif
+#ifdef __NR_sendfile64
+   SYSCALL_TRACER_NAME(sendfile64),
+#endif
+#ifdef __NR_sendmmsg
+   SYSCALL_TRACER_NAME(sendmmsg),
+#endif
+#ifdef __NR_sendmsg
+   SYSCALL_TRACER_NAME(sendmsg),
+#endif
+#ifdef __NR_sendto
+   SYSCALL_TRACER_NAME(sendto),
+#endif
+#ifdef __NR_set_mempolicy
+   SYSCALL_TRACER_NAME(set_mempolicy),
+#endif
+#ifdef __NR_set_mempolicy_home_node
+   SYSCALL_TRACER_NAME(set_mempolicy_home_node),
+#endif
+#ifdef __NR_set_robust_list
+   SYSCALL_TRACER_NAME(set_robust_list),
+#endif
+#ifdef __NR_set_thread_area
+   SYSCALL_TRACER_NAME(set_thread_area),
+#endif
+#ifdef __NR_set_tid_address
+   SYSCALL_TRACER_NAME(set_tid_address),
+#endif
+#ifdef __NR_setdomainname
+   SYSCALL_TRACER_NAME(setdomainname),
+#endif
+#ifdef __NR_setfsgid
+   SYSCALL_TRACER_NAME(setfsgid),
+#endif
+#ifdef __NR_setfsgid32
+   SYSCALL_TRACER_NAME(setfsgid32),
+#endif
+#ifdef __NR_setfsuid
+   SYSCALL_TRACER_NAME(setfsuid),
+#endif
+#ifdef __NR_setfsuid32
+   SYSCALL_TRACER_NAME(setfsuid32),
+#endif
+#ifdef __NR_setgid
+   SYSCALL_TRACER_NAME(setgid),
+#endif
+#ifdef __NR_setgid32
+   SYSCALL_TRACER_NAME(setgid32),
+#endif
+#ifdef __NR_setgroups
+   SYSCALL_TRACER_NAME(setgroups),
+#endif
+#ifdef __NR_setgroups32
+   SYSCALL_TRACER_NAME(setgroups32),
+#endif
+#ifdef __NR_sethostname
+   SYSCALL_TRACER_NAME(sethostname),
+#endif
+#ifdef __NR_setitimer
+   SYSCALL_TRACER_NAME(setitimer),
+#endif
+#ifdef __NR_setns
+   SYSCALL_TRACER_NAME(setns),
+#endif
+#ifdef __NR_setpgid
+   SYSCALL_TRACER_NAME(setpgid),
+#endif
+#ifdef __NR_setpriority
+   SYSCALL_TRACER_NAME(setpriority),
+#endif
+#ifdef __NR_setregid
+   SYSCALL_TRACER_NAME(setregid),
+#endif
+#ifdef __NR_setregid32
+   SYSCALL_TRACER_NAME(setregid32),
+#endif
+#ifdef __NR_setresgid
+   SYSCALL_TRACER_NAME(setresgid),
+#endif
+#ifdef __NR_setresgid32
+   SYSCALL_TRACER_NAME(setresgid32),
+#endif
+#ifdef __NR_setresuid
+   SYSCALL_TRACER_NAME(setresuid),
+#endif
+#ifdef __NR_setresuid32
+   SYSCALL_TRACER_NAME(setresuid32),
+#endif
+#ifdef __NR_setreuid
+   SYSCALL_TRACER_NAME(setreuid),
+#endif
+#ifdef __NR_setreuid32
+   SYSCALL_TRACER_NAME(setreuid32),
+#endif
+#ifdef __NR_setrlimit
+   SYSCALL_TRACER_NAME(setrlimit),
+#endif
+#ifdef __NR_setsid
+   SYSCALL_TRACER_NAME(setsid),
+#endif
+#ifdef __NR_setsockopt
+   SYSCALL_TRACER_NAME(setsockopt),
+#endif
+#ifdef __NR_settimeofday
+   SYSCALL_TRACER_NAME(settimeofday),
+#endif
+#ifdef __NR_setuid
+   SYSCALL_TRACER_NAME(setuid),
+#endif
+#ifdef __NR_setuid32
+   SYSCALL_TRACER_NAME(setuid32),
+#endif
+#ifdef __NR_setxattr
+   SYSCALL_TRACER_NAME(setxattr),
+#endif
+#ifdef __NR_sgetmask
+   SYSCALL_TRACER_NAME(sgetmask),
+#endif
+#ifdef __NR_shmat
+   SYSCALL_TRACER_NAME(shmat),
+#endif
+#ifdef __NR_shmctl
+   SYSCALL_TRACER_NAME(shmctl),
+#endif
+#ifdef __NR_shmdt
+   SYSCALL_TRACER_NAME(shmdt),
+#endif
+#ifdef __NR_shmget
+   SYSCALL_TRACER_NAME(shmget),
+#endif
+#ifdef __NR_shutdown
+   SYSCALL_TRACER_NAME(shutdown),
+#endif
+#ifdef __NR_sigaction
+   SYSCALL_TRACER_NAME(sigaction),
+#endif
+#ifdef __NR_sigaltstack
+   SYSCALL_TRACER_NAME(sigaltstack),
+#endif
+#ifdef __NR_signal
+   SYSCALL_TRACER_NAME(signal),
+#endif
+#ifdef __NR_signalfd
+   SYSCALL_TRACER_NAME(signalfd),
+#endif
+#ifdef __NR_signalfd4
+   SYSCALL_TRACER_NAME(signalfd4),
+#endif
+#ifdef __NR_sigpending
+   SYSCALL_TRACER_NAME(sigpending),
+#endif
+#ifdef __NR_sigprocmask
+   SYSCALL_TRACER_NAME(sigprocmask),
+#endif
+#ifdef __NR_sigreturn
+   SYSCALL_TRACER_NAME(sigreturn),
+#endif
+#ifdef __NR_sigsuspend
+   SYSCALL_TRACER_NAME(sigsuspend),
+#endif
+#ifdef __NR_socket
+   SYSCALL_TRACER_NAME(socket),
+#endif
+#ifdef __NR_socketcall
+   SYSCALL_TRACER_NAME(socketcall),
+#endif
+#ifdef __NR_socketpair
+   SYSCALL_TRACER_NAME(socketpair),
+#endif
+#ifdef __NR_splice
+   SYSCALL_TRACER_NAME(splice),
+#endif
+#ifdef __NR_ssetmask
+   SYSCALL_TRACER_NAME(ssetmask),
+#endif
+#ifdef __NR_stat
+   SYSCALL_TRACER_NAME(stat),
+#endif
+#ifdef __NR_stat64
+   SYSCALL_TRACER_NAME(stat64),
+#endif
+#ifdef __NR_statfs
+   SYSCALL_TRACER_NAME(statfs),
+#endif
+#ifdef __NR_statfs64
+   SYSCALL_TRACER_NAME(statfs64),
+#endif
+#ifdef __NR_statx
+   SYSCALL_TRACER_NAME(statx),
+#endif
+#ifdef __NR_stime
+   SYSCALL_TRACER_NAME(stime),
+#endif
+#ifdef __NR_stty
+   SYSCALL_TRACER_NAME(stty),
+#endif
+#ifdef __NR_swapoff
+   SYSCALL_TRACER_NAME(swapoff),
+#endif
+#ifdef __NR_swapon
+   SYSCALL_TRACER_NAME(swapon),
+#endif
+#ifdef __NR_symlink
+   SYSCALL_TRACER_NAME(symlink),
+#endif
+#ifdef __NR_symlinkat
+   SYSCALL_TRACER_NAME(symlinkat),
+#endif
+#ifdef __NR_sync
+   SYSCALL_TRACER_NAME(sync),
+#endif
+#ifdef __NR_sync_file_range
+   SYSCALL_TRACER_NAME(sync_file_range),
+#endif
+#ifdef __NR_sync_file_range2
+   SYSCALL_TRACER_NAME(sync_file_range2),
+#endif
+#ifdef __NR_syncfs
+   SYSCALL_TRACER_NAME(syncfs),
+#endif
+#ifdef __NR_sysfs
+   SYSCALL_TRACER_NAME(sysfs),
+#endif
+#ifdef __NR_sysinfo
+   SYSCALL_TRACER_NAME(sysinfo),
+#endif
+#ifdef __NR_syslog
+   SYSCALL_TRACER_NAME(syslog),
+#endif
+#ifdef __NR_tee
+   SYSCALL_TRACER_NAME(tee),
+#endif
+#ifdef __NR_tgkill
+   SYSCALL_TRACER_NAME(tgkill),
+#endif
+#ifdef __NR_time
+   SYSCALL_TRACER_NAME(time),
+#endif
+#ifdef __NR_timer_create
+   SYSCALL_TRACER_NAME(timer_create),
+#endif
+#ifdef __NR_timer_delete
+   SYSCALL_TRACER_NAME(timer_delete),
+#endif
+#ifdef __NR_timer_getoverrun
+   SYSCALL_TRACER_NAME(timer_getoverrun),
+#endif
+#ifdef __NR_timer_gettime
+   SYSCALL_TRACER_NAME(timer_gettime),
+#endif
+#ifdef __NR_timer_gettime64
+   SYSCALL_TRACER_NAME(timer_gettime64),
+#endif
+#ifdef __NR_timer_settime
+   SYSCALL_TRACER_NAME(timer_settime),
+#endif
+#ifdef __NR_timer_settime64
+   SYSCALL_TRACER_NAME(timer_settime64),
+#endif
+#ifdef __NR_timerfd_create
+   SYSCALL_TRACER_NAME(timerfd_create),
+#endif
+#ifdef __NR_timerfd_gettime
+   SYSCALL_TRACER_NAME(timerfd_gettime),
+#endif
+#ifdef __NR_timerfd_gettime64
+   SYSCALL_TRACER_NAME(timerfd_gettime64),
+#endif
+#ifdef __NR_timerfd_settime
+   SYSCALL_TRACER_NAME(timerfd_settime),
+#endif
+#ifdef __NR_timerfd_settime64
+   SYSCALL_TRACER_NAME(timerfd_settime64),
+#endif
+#ifdef __NR_times
+   SYSCALL_TRACER_NAME(times),
+#endif
+#ifdef __NR_tkill
+   SYSCALL_TRACER_NAME(tkill),
+#endif
+#ifdef __NR_truncate
+   SYSCALL_TRACER_NAME(truncate),
+#endif
+#ifdef __NR_truncate64
+   SYSCALL_TRACER_NAME(truncate64),
+#endif
+#ifdef __NR_tuxcall
+   SYSCALL_TRACER_NAME(tuxcall),
+#endif
+#ifdef __NR_ugetrlimit
+   SYSCALL_TRACER_NAME(ugetrlimit),
+#endif
+#ifdef __NR_ulimit
+   SYSCALL_TRACER_NAME(ulimit),
+#endif
+#ifdef __NR_umask
+   SYSCALL_TRACER_NAME(umask),
+#endif
+#ifdef __NR_umount
+   SYSCALL_TRACER_NAME(umount),
+#endif
+#ifdef __NR_umount2
+   SYSCALL_TRACER_NAME(umount2),
+#endif
+#ifdef __NR_uname
+   SYSCALL_TRACER_NAME(uname),
+#endif
+#ifdef __NR_unlink
+   SYSCALL_TRACER_NAME(unlink),
+#endif
+#ifdef __NR_unlinkat
+   SYSCALL_TRACER_NAME(unlinkat),
+#endif
+#ifdef __NR_unshare
+   SYSCALL_TRACER_NAME(unshare),
+#endif
+#ifdef __NR_uselib
+   SYSCALL_TRACER_NAME(uselib),
+#endif
+#ifdef __NR_userfaultfd
+   SYSCALL_TRACER_NAME(userfaultfd),
+#endif
+#ifdef __NR_ustat
+   SYSCALL_TRACER_NAME(ustat),
+#endif
+#ifdef __NR_utime
+   SYSCALL_TRACER_NAME(utime),
+#endif
+#ifdef __NR_utimensat
+   SYSCALL_TRACER_NAME(utimensat),
+#endif
+#ifdef __NR_utimensat_time64
+   SYSCALL_TRACER_NAME(utimensat_time64),
+#endif
+#ifdef __NR_utimes
+   SYSCALL_TRACER_NAME(utimes),
+#endif
+#ifdef __NR_vfork
+   SYSCALL_TRACER_NAME(vfork),
+#endif
+#ifdef __NR_vhangup
+   SYSCALL_TRACER_NAME(vhangup),
+#endif
+#ifdef __NR_vm86
+   SYSCALL_TRACER_NAME(vm86),
+#endif
+#ifdef __NR_vm86old
+   SYSCALL_TRACER_NAME(vm86old),
+#endif
+#ifdef __NR_vmsplice
+   SYSCALL_TRACER_NAME(vmsplice),
+#endif
+#ifdef __NR_vserver
+   SYSCALL_TRACER_NAME(vserver),
+#endif
+#ifdef __NR_wait4
+   SYSCALL_TRACER_NAME(wait4),
+#endif
+#ifdef __NR_waitid
+   SYSCALL_TRACER_NAME(waitid),
+#endif
+#ifdef __NR_waitpid
+   SYSCALL_TRACER_NAME(waitpid),
+#endif
+#ifdef __NR_write
+   SYSCALL_TRACER_NAME(write),
+#endif
+#ifdef __NR_writev
+   SYSCALL_TRACER_NAME(writev),
+#endif
+};
+
+const char* SyscallTracer_name(unsigned int nr) {
+   for (size_t i = 0; i < ARRAYSIZE(SyscallTracer_names); i++) {
+      if (SyscallTracer_names[i].nr == nr)
+         return SyscallTracer_names[i].name;
+   }
+   return NULL;
+}
+
+#ifdef PTRACE_GET_SYSCALL_INFO
+
+#define SYSCALL_TRACER_OPTIONS (PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_TRACEEXEC)
+
+/* The ABI the names above are of; unchecked on other architectures */
+#if defined(__x86_64__)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_X86_64
+#elif defined(__i386__)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_I386
+#elif defined(__aarch64__) && !defined(__AARCH64EB__)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_AARCH64
+#elif defined(__arm__) && defined(__ARMEB__)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_ARMEB
+#elif defined(__arm__)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_ARM
+#elif defined(__powerpc64__) && defined(__LITTLE_ENDIAN__)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_PPC64LE
+#elif defined(__powerpc64__)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_PPC64
+#elif defined(__powerpc__)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_PPC
+#elif defined(__s390x__)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_S390X
+#elif defined(__s390__)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_S390
+#elif defined(__riscv) && __riscv_xlen == 64 && defined(AUDIT_ARCH_RISCV64)
+#define SYSCALL_TRACER_ARCH AUDIT_ARCH_RISCV64
+#endif
+
+/* A traced thread, known to the tracing process only */
+typedef struct SyscallTracer_Thread_ {
+   uint64_t entered;          /* monotonic nanoseconds at the entry stop */
+   unsigned int slot;
+   bool inCall;
+} SyscallTracer_Thread;
+
+typedef struct SyscallTracer_State_ {
+   SyscallTracer_Shared* shared;
+   Hashtable* threads;        /* SyscallTracer_Thread by tid */
+   uint64_t count;
+   unsigned long resets;      /* of htop, the counters were cleared for */
+} SyscallTracer_State;
+
+static uint64_t SyscallTracer_now(void) {
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+static SyscallTracer_Thread* SyscallTracer_thread(SyscallTracer_State* state, pid_t tid) {
+   SyscallTracer_Thread* thread = Hashtable_get(state->threads, (ht_key_t) tid);
+   if (!thread) {
+      thread = xCalloc(1, sizeof(SyscallTracer_Thread));
+      Hashtable_put(state->threads, (ht_key_t) tid, thread);
+      state->shared->threads = ++state->count;
+   }
+   return thread;
+}
+
+static void SyscallTracer_forget(SyscallTracer_State* state, pid_t tid) {
+   if (!Hashtable_get(state->threads, (ht_key_t) tid))
+      return;
+
+   Hashtable_remove(state->threads, (ht_key_t) tid);
+   state->shared->threads = --state->count;
+}
+
+static int SyscallTracer_seize(SyscallTracer_State* state, pid_t tid) {
+   if (ptrace(PTRACE_SEIZE, tid, NULL, (void*) SYSCALL_TRACER_OPTIONS) != 0)
+      return errno;
+
+   /* the stop this causes is where syscall stops get requested */
+   ptrace(PTRACE_INTERRUPT, tid, NULL, NULL);
+   SyscallTracer_thread(state, tid);
+   return 0;
+}
+
+/* Threads started by ones not yet attached turn up on the next pass */
+static void SyscallTracer_seizeThreads(SyscallTracer_State* state, pid_t pid) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/task", pid);
+
+   for (bool added = true; added; ) {
+      added = false;
+
+      DIR* dirp = opendir(path);
+      if (!dirp)
+         return;
+
+      const struct dirent* de;
+      while ((de = readdir(dirp))) {
+         if (!isdigit((unsigned char)de->d_name[0]))
+            continue;
+
+         pid_t tid = atoi(de->d_name);
+         if (!Hashtable_get(state->threads, (ht_key_t) tid) && SyscallTracer_seize(state, tid) == 0)
+            added = true;
+      }
+      closedir(dirp);
+   }
+}
+
+static bool SyscallTracer_isForeign(const struct __ptrace_syscall_info* info) {
+#ifdef SYSCALL_TRACER_ARCH
+   if (info->arch != SYSCALL_TRACER_ARCH)
+      return true;
+#endif
+
+#ifdef __X32_SYSCALL_BIT
+   /* x32 calls share the architecture of x86_64 ones, a bit of the number tells them apart */
+   bool x32 = info->entry.nr & __X32_SYSCALL_BIT;
+#ifdef __ILP32__
+   return !x32;
+#else
+   return x32;
+#endif
+#else
+   (void) info;
+   return false;
+#endif
+}
+
+static void SyscallTracer_leaveCall(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   SyscallTracer_Thread* thread = value;
+   thread->inCall = false;
+}
+
+/* Only the tracing process writes the counters, so htop asks for a reset
+ * rather than clearing them under it; calls entered before are dropped */
+static void SyscallTracer_clear(SyscallTracer_State* state) {
+   unsigned long resets = state->shared->resets;
+   if (resets == state->resets)
+      return;
+
+   memset(state->shared->calls, 0, sizeof(state->shared->calls));
+   Hashtable_foreach(state->threads, SyscallTracer_leaveCall, NULL);
+   state->resets = resets;
+   state->shared->cleared = resets;
+}
+
+static bool SyscallTracer_syscallStop(SyscallTracer_State* state, pid_t tid) {
+   struct __ptrace_syscall_info info;
+   if (ptrace(PTRACE_GET_SYSCALL_INFO, tid, (void*) sizeof(info), &info) <= 0) {
+      /* a thread killed meanwhile is reported by waitpid() next */
+      if (errno == ESRCH)
+         return true;
+
+      /* a kernel before Linux 5.3 */
+      state->shared->error = errno;
+      return false;
+   }
+
+   SyscallTracer_clear(state);
+
+   uint64_t now = SyscallTracer_now();
+   SyscallTracer_Thread* thread = SyscallTracer_thread(state, tid);
+
+   if (info.op == PTRACE_SYSCALL_INFO_ENTRY) {
+      if (SyscallTracer_isForeign(&info))
+         thread->slot = SYSCALL_TRACER_FOREIGN;
+      else if (info.entry.nr >= SYSCALL_TRACER_CALLS)
+         thread->slot = SYSCALL_TRACER_HIGHER;
+      else
+         thread->slot = (unsigned int) info.entry.nr;
+      thread->entered = now;
+      thread->inCall = true;
+      state->shared->calls[thread->slot].count++;
+   } else if (info.op == PTRACE_SYSCALL_INFO_EXIT && thread->inCall) {
+      SyscallTracer_Call* call = &state->shared->calls[thread->slot];
+      uint64_t elapsed = now - thread->entered;
+      call->total += elapsed;
+      call->max = MAXIMUM(call->max, elapsed);
+      thread->inCall = false;
+   }
+   return true;
+}
+
+/* The thread that called execve() takes over the id of the leader */
+static void SyscallTracer_exec(SyscallTracer_State* state, pid_t tid) {
+   unsigned long former;
+   if (ptrace(PTRACE_GETEVENTMSG, tid, NULL, &former) != 0 || (pid_t) former == tid)
+      return;
+
+   const SyscallTracer_Thread* from = Hashtable_get(state->threads, (ht_key_t) former);
+   if (!from)
+      return;
+
+   *SyscallTracer_thread(state, tid) = *from;
+   SyscallTracer_forget(state, (pid_t) former);
+}
+
+static void SyscallTracer_run(SyscallTracer_State* state) {
+   while (state->count > 0) {
+      int status;
+      pid_t tid = waitpid(-1, &status, __WALL);
+      if (tid < 0) {
+         if (errno == EINTR)
+            continue;
+         return;
+      }
+
+      if (WIFEXITED(status) || WIFSIGNALED(status)) {
+         SyscallTracer_forget(state, tid);
+         continue;
+      }
+      if (!WIFSTOPPED(status))
+         continue;
+
+      /* new threads are attached by the kernel and report here first */
+      SyscallTracer_thread(state, tid);
+
+      int sig = WSTOPSIG(status);
+      unsigned int event = (unsigned int) status >> 16;
+      int inject = 0;
+
+      if (sig == (SIGTRAP | 0x80)) {
+         if (!SyscallTracer_syscallStop(state, tid))
+            return;
+      } else if (event == PTRACE_EVENT_STOP) {
+         if (sig == SIGSTOP || sig == SIGTSTP || sig == SIGTTIN || sig == SIGTTOU) {
+            /* a group-stop: the thread stays stopped until continued */
+            ptrace(PTRACE_LISTEN, tid, NULL, NULL);
+            continue;
+         }
+      } else if (event == PTRACE_EVENT_EXEC) {
+         SyscallTracer_exec(state, tid);
+      } else if (event == 0) {
+         inject = sig;
+      }
+
+      ptrace(PTRACE_SYSCALL, tid, NULL, (void*)(intptr_t) inject);
+   }
+}
+
+ATTR_NORETURN
+static void SyscallTracer_trace(SyscallTracer_Shared* shared, pid_t pid, int reply) {
+   /* the handlers of htop would restore the terminal */
+   CRT_resetSignalHandlers();
+
+   SyscallTracer_State state = {
+      .shared = shared,
+      .threads = Hashtable_new(16, true),
+   };
+
+   int error = SyscallTracer_seize(&state, pid);
+   (void)! write(reply, &error, sizeof(error));
+   close(reply);
+   if (error)
+      _exit(1);
+
+   SyscallTracer_seizeThreads(&state, pid);
+   SyscallTracer_run(&state);
+
+   shared->done = true;
+   _exit(0);
+}
+
+#endif /* PTRACE_GET_SYSCALL_INFO */
+
+SyscallTracer* SyscallTracer_new(pid_t pid) {
+#ifndef PTRACE_GET_SYSCALL_INFO
+   (void) pid;
+   errno = ENOSYS;
+   return NULL;
+#else
+   SyscallTracer_Shared* shared = mmap(NULL, sizeof(SyscallTracer_Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   if (shared == MAP_FAILED)
+      return NULL;
+
+   int fdpair[2];
+   if (pipe(fdpair) == -1) {
+      int error = errno;
+      munmap(shared, sizeof(SyscallTracer_Shared));
+      errno = error;
+      return NULL;
+   }
+
+   pid_t parent = getpid();
+   pid_t child = fork();
+   if (child == -1) {
+      int error = errno;
+      close(fdpair[0]);
+      close(fdpair[1]);
+      munmap(shared, sizeof(SyscallTracer_Shared));
+      errno = error;
+      return NULL;
+   }
+
+   if (child == 0) {
+      close(fdpair[0]);
+
+      /* stop tracing when htop goes away */
+      prctl(PR_SET_PDEATHSIG, SIGKILL);
+      if (getppid() != parent)
+         _exit(1);
+
+      SyscallTracer_trace(shared, pid, fdpair[1]);
+   }
+
+   close(fdpair[1]);
+
+   int error = 0;
+   ssize_t n;
+   do {
+      n = read(fdpair[0], &error, sizeof(error));
+   } while (n < 0 && errno == EINTR);
+   close(fdpair[0]);
+
+   if (n != (ssize_t) sizeof(error) || error) {
+      waitpid(child, NULL, 0);
+      munmap(shared, sizeof(SyscallTracer_Shared));
+      errno = n == (ssize_t) sizeof(error) ? error : ECHILD;
+      return NULL;
+   }
+
+   SyscallTracer* this = xMalloc(sizeof(SyscallTracer));
+   this->pid = pid;
+   this->child = child;
+   this->shared = shared;
+   return this;
+#endif
+}
+
+void SyscallTracer_delete(SyscallTracer* this) {
+   if (!this)
+      return;
+
+   /* the kernel detaches all threads when their tracer dies */
+   kill(this->child, SIGKILL);
+   waitpid(this->child, NULL, 0);
+   munmap(this->shared, sizeof(SyscallTracer_Shared));
+   free(this);
+}
+
+void SyscallTracer_reset(SyscallTracer* this) {
+   this->shared->resets++;
+}
+
+bool SyscallTracer_pending(const SyscallTracer* this) {
+   return this->shared->cleared != this->shared->resets;
+}
@@ -0,0 +1,69 @@
+#ifndef HEADER_SyscallTracer
+#define HEADER_SyscallTracer
+/*
+htop - SyscallTracer.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+
+/* System call numbers counted apart, each in the slot of its number */
+#define SYSCALL_TRACER_CALLS 1024
+
+/* The slot after those of the numbers, for calls of another ABI than htop's,
+ * e.g. 32-bit calls of a 64-bit process, whose numbers mean other calls */
+#define SYSCALL_TRACER_FOREIGN SYSCALL_TRACER_CALLS
+
+/* The slot shared by the numbers from SYSCALL_TRACER_CALLS up */
+#define SYSCALL_TRACER_HIGHER (SYSCALL_TRACER_CALLS + 1)
+
+#define SYSCALL_TRACER_SLOTS (SYSCALL_TRACER_CALLS + 2)
+
+typedef struct SyscallTracer_Call_ {
+   uint64_t count;            /* calls entered */
+   uint64_t total;            /* nanoseconds spent in calls that returned */
+   uint64_t max;
+} SyscallTracer_Call;
+
+/* Written by the tracing process only, read by htop while it runs, but
+ * for resets */
+typedef struct SyscallTracer_Shared_ {
+   SyscallTracer_Call calls[SYSCALL_TRACER_SLOTS];
+   uint64_t threads;          /* currently traced */
+   int error;                 /* errno that ended tracing, 0 if the process exited */
+   bool done;
+   unsigned long resets;      /* raised by htop to have the counters cleared */
+   unsigned long cleared;     /* the resets the counters were last cleared for */
+} SyscallTracer_Shared;
+
+/* Counts the system calls of a process in a forked tracing process, which
+ * attaches to all of its threads with PTRACE_SEIZE and only adds to the
+ * shared counters at each stop; like strace -c, every call stops the
+ * thread on entry and on exit, which slows down a process making many */
+typedef struct SyscallTracer_ {
+   pid_t pid;
+   pid_t child;
+   SyscallTracer_Shared* shared;
+} SyscallTracer;
+
+/* NULL with errno set if the process could not be attached */
+SyscallTracer* SyscallTracer_new(pid_t pid);
+
+/* Detaches from the process, which goes on unaffected */
+void SyscallTracer_delete(SyscallTracer* this);
+
+/* Has the tracing process clear the counters at the next stop; until then
+ * SyscallTracer_pending is true */
+void SyscallTracer_reset(SyscallTracer* this);
+
+bool SyscallTracer_pending(const SyscallTracer* this);
+
+/* The name of a system call of this architecture, NULL if unknown */
+const char* SyscallTracer_name(unsigned int nr);
+
+#endif
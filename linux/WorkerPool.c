@@ -0,0 +1,154 @@
+/*
+htop - WorkerPool.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/WorkerPool.h"
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+
+struct WorkerPool_ {
+   pthread_mutex_t lock;
+   pthread_cond_t wake;       /* a run started, or the pool is deleted */
+   pthread_cond_t idle;       /* the last thread of the pool is done with a run */
+   pthread_t threads[WORKER_POOL_MAX_THREADS];
+   size_t threadCount;        /* without the calling thread */
+   size_t busy;               /* threads of the pool not done with the run */
+   unsigned long generation;  /* of the current run */
+   bool quit;
+
+   /* the current run */
+   size_t count;
+   size_t next;
+   size_t batch;
+   bool stopped;
+   WorkerPool_Work work;
+   void* context;
+};
+
+static void WorkerPool_work(WorkerPool* this) {
+   for (;;) {
+      pthread_mutex_lock(&this->lock);
+      size_t first = this->stopped ? this->count : this->next;
+      size_t last = MINIMUM(first + this->batch, this->count);
+      if (!this->stopped)
+         this->next = last;
+      pthread_mutex_unlock(&this->lock);
+
+      if (first >= last)
+         return;
+
+      bool going = true;
+      for (size_t i = first; i < last; i++)
+         going = this->work(this->context, i) && going;
+
+      if (!going) {
+         pthread_mutex_lock(&this->lock);
+         this->stopped = true;
+         pthread_mutex_unlock(&this->lock);
+      }
+   }
+}
+
+static void* WorkerPool_thread(void* arg) {
+   WorkerPool* this = arg;
+   unsigned long seen = 0;
+
+   pthread_mutex_lock(&this->lock);
+   for (;;) {
+      while (!this->quit && this->generation == seen)
+         pthread_cond_wait(&this->wake, &this->lock);
+      if (this->quit)
+         break;
+
+      seen = this->generation;
+      pthread_mutex_unlock(&this->lock);
+
+      WorkerPool_work(this);
+
+      pthread_mutex_lock(&this->lock);
+      if (--this->busy == 0)
+         pthread_cond_signal(&this->idle);
+   }
+   pthread_mutex_unlock(&this->lock);
+   return NULL;
+}
+
+WorkerPool* WorkerPool_new(size_t maxThreads) {
+   WorkerPool* this = xCalloc(1, sizeof(WorkerPool));
+   pthread_mutex_init(&this->lock, NULL);
+   pthread_cond_init(&this->wake, NULL);
+   pthread_cond_init(&this->idle, NULL);
+
+   long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+   size_t threads = cpus > 1 ? MINIMUM((size_t)cpus, WORKER_POOL_MAX_THREADS) : 1;
+   threads = MINIMUM(threads, maxThreads);
+
+   /* signals are for the main thread, e.g. the resize handler of curses */
+   sigset_t all, saved;
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK, &all, &saved);
+   for (size_t i = 1; i < threads; i++) {
+      if (pthread_create(&this->threads[this->threadCount], NULL, WorkerPool_thread, this) != 0)
+         break;
+      this->threadCount++;
+   }
+   pthread_sigmask(SIG_SETMASK, &saved, NULL);
+
+   return this;
+}
+
+void WorkerPool_delete(WorkerPool* this) {
+   if (!this)
+      return;
+
+   pthread_mutex_lock(&this->lock);
+   this->quit = true;
+   pthread_cond_broadcast(&this->wake);
+   pthread_mutex_unlock(&this->lock);
+
+   for (size_t i = 0; i < this->threadCount; i++)
+      pthread_join(this->threads[i], NULL);
+
+   pthread_cond_destroy(&this->idle);
+   pthread_cond_destroy(&this->wake);
+   pthread_mutex_destroy(&this->lock);
+   free(this);
+}
+
+size_t WorkerPool_run(WorkerPool* this, size_t count, size_t batch, WorkerPool_Work work, void* context) {
+   pthread_mutex_lock(&this->lock);
+   this->count = count;
+   this->next = 0;
+   this->batch = MAXIMUM(batch, 1);
+   this->stopped = false;
+   this->work = work;
+   this->context = context;
+
+   /* threads with nothing left to claim are done at once */
+   this->busy = this->threadCount;
+   this->generation++;
+   pthread_cond_broadcast(&this->wake);
+   pthread_mutex_unlock(&this->lock);
+
+   /* the calling thread is a worker too */
+   WorkerPool_work(this);
+
+   pthread_mutex_lock(&this->lock);
+   while (this->busy > 0)
+      pthread_cond_wait(&this->idle, &this->lock);
+   size_t claimed = this->next;
+   pthread_mutex_unlock(&this->lock);
+   return claimed;
+}
@@ -0,0 +1,34 @@
+#ifndef HEADER_WorkerPool
+#define HEADER_WorkerPool
+/*
+htop - WorkerPool.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+#define WORKER_POOL_MAX_THREADS 16
+
+/* Does the work of one index; false to have no further indexes claimed */
+typedef bool (*WorkerPool_Work)(void* context, size_t index);
+
+/* Threads started once and kept waiting between runs */
+typedef struct WorkerPool_ WorkerPool;
+
+/* A pool of at most maxThreads threads, the calling one of each run
+ * included, and no more than the online CPUs */
+WorkerPool* WorkerPool_new(size_t maxThreads);
+
+void WorkerPool_delete(WorkerPool* this);
+
+/* Calls work for the indexes from 0 up to count, from the calling thread
+ * and the threads of the pool, which claim batch indexes at a time.
+ * Returns once all are done with the number of indexes claimed, all of
+ * which were worked on */
+size_t WorkerPool_run(WorkerPool* this, size_t count, size_t batch, WorkerPool_Work work, void* context);
+
+#endif
@@ -336,7 +336,12 @@ FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    return NULL;
 }
 
-bool Platform_getDiskIO(DiskIOData* data) {
+OpenFiles_ProcessData* Platform_getProcessFiles(pid_t pid) {
+   (void)pid;
+   return NULL;
+}
+
+bool Platform_getDiskIO(DiskIOData* data, ATTR_UNUSED DiskIODevices* devices) {
    const int mib[] = { CTL_HW, HW_IOSTATS, sizeof(struct io_sysctl) };
    struct io_sysctl *iostats = NULL;
    size_t size = 0;
@@ -387,7 +392,7 @@ bool Platform_getDiskIO(DiskIOData* data) {
    return true;
 }
 
-bool Platform_getNetworkIO(NetworkIOData* data) {
+bool Platform_getNetworkIO(NetworkIOData* data, ATTR_UNUSED NetworkIOInterfaces* interfaces) {
    struct ifaddrs* ifaddrs = NULL;
 
    if (getifaddrs(&ifaddrs) != 0)
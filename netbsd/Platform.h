@@ -22,6 +22,7 @@ in the source distribution for its full text.
 #include "Meter.h"
 #include "NetworkIOMeter.h"
 #include "Process.h"
+#include "OpenFilesScreen.h"
 #include "ProcessLocksScreen.h"
 #include "SignalsPanel.h"
 #include "generic/gettime.h"
@@ -66,9 +67,11 @@ char* Platform_getInodeFilename(pid_t pid, ino_t inode);
 
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid);
 
-bool Platform_getDiskIO(DiskIOData* data);
+OpenFiles_ProcessData* Platform_getProcessFiles(pid_t pid);
 
-bool Platform_getNetworkIO(NetworkIOData* data);
+bool Platform_getDiskIO(DiskIOData* data, DiskIODevices* devices);
+
+bool Platform_getNetworkIO(NetworkIOData* data, NetworkIOInterfaces* interfaces);
 
 void Platform_getBattery(double* percent, ACPresence* isOnAC);
 
@@ -0,0 +1,80 @@
+/*
+htop - HostsMeter.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "pcp/HostsMeter.h"
+
+#include "CRT.h"
+#include "Macros.h"
+#include "Object.h"
+#include "RichString.h"
+#include "XUtils.h"
+
+#include "pcp/PCPProcessList.h"
+#include "pcp/Platform.h"
+
+
+static const int HostsMeter_attributes[] = {
+   METER_VALUE,
+};
+
+static void HostsMeter_updateValues(Meter* this) {
+   const PCPProcessList* pl = (const PCPProcessList*) this->pl;
+   this->values[0] = pl->hostCount;
+   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%zu", pl->hostCount);
+}
+
+static double HostsMeter_cpuPercent(const pmAtomValue* cpu) {
+   double total = cpu[CPU_TOTAL_PERIOD].ull;
+   if (total <= 0.0)
+      return 0.0;
+
+   double busy = total - (double) cpu[CPU_IDLE_ALL_PERIOD].ull;
+   return CLAMP(100.0 * busy / total, 0.0, 100.0);
+}
+
+/* A summary of every host in turn, so that a busy one stands out */
+static void HostsMeter_display(const Object* cast, RichString* out) {
+   const Meter* this = (const Meter*)cast;
+   const PCPProcessList* pl = (const PCPProcessList*) this->pl;
+   char buffer[64];
+
+   for (size_t i = 0; i < pl->hostCount; i++) {
+      const PCPHostSample* host = &pl->hosts[i];
+      if (i)
+         RichString_appendAscii(out, CRT_colors[METER_TEXT], "  ");
+      RichString_appendAscii(out, CRT_colors[HOSTNAME], Platform_getHostnameOf(i));
+
+      double mem = host->totalMem ? 100.0 * host->usedMem / host->totalMem : 0.0;
+      xSnprintf(buffer, sizeof(buffer), " %.1f%%", HostsMeter_cpuPercent(host->cpu));
+      RichString_appendAscii(out, CRT_colors[METER_VALUE], buffer);
+      RichString_appendAscii(out, CRT_colors[METER_TEXT], " cpu ");
+      xSnprintf(buffer, sizeof(buffer), "%.1f%%", mem);
+      RichString_appendAscii(out, CRT_colors[METER_VALUE], buffer);
+      RichString_appendAscii(out, CRT_colors[METER_TEXT], " mem ");
+      xSnprintf(buffer, sizeof(buffer), "%u", host->totalTasks);
+      RichString_appendAscii(out, CRT_colors[METER_VALUE], buffer);
+      RichString_appendAscii(out, CRT_colors[METER_TEXT], " tasks");
+   }
+}
+
+const MeterClass HostsMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = HostsMeter_display
+   },
+   .updateValues = HostsMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .maxItems = 1,
+   .total = 100.0,
+   .attributes = HostsMeter_attributes,
+   .name = "Hosts",
+   .uiName = "Hosts",
+   .caption = "Hosts: ",
+};
@@ -0,0 +1,15 @@
+#ifndef HEADER_HostsMeter
+#define HEADER_HostsMeter
+/*
+htop - HostsMeter.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Meter.h"
+
+
+extern const MeterClass HostsMeter_class;
+
+#endif
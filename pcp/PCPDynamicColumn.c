@@ -14,6 +14,7 @@ in the source distribution for its full text.
 #include <ctype.h>
 #include <dirent.h>
 #include <errno.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -66,6 +67,32 @@ static void PCPDynamicColumn_parseMetric(PCPDynamicColumns* columns, PCPDynamicC
    }
 }
 
+static void PCPDynamicColumn_parseExpression(PCPDynamicColumns* columns, PCPDynamicColumn* column, const char* path, unsigned int line, const char* value) {
+   if (column->expression)
+      return;
+
+   char* error;
+   column->expression = PCPExpression_compile(value, columns->offset, &columns->cursor, &error);
+   if (!column->expression) {
+      char* note;
+      xAsprintf(&note,
+                "%s: failed to parse expression in %s at line %u\n%s\n",
+                pmGetProgname(), path, line, error);
+      free(error);
+      errno = EINVAL;
+      CRT_fatalError(note);
+      free(note);
+   }
+
+   size_t n = columns->expressionCount + 1;
+   columns->expressions = xReallocArray(columns->expressions, n, sizeof(PCPDynamicColumn*));
+   columns->expressions[n - 1] = column;
+   columns->expressionCount = n;
+   column->derived = n - 1;
+   column->slot = columns->rateCount;
+   columns->rateCount += column->expression->rates;
+}
+
 // Ensure a valid name for use in a PCP metric name and in htoprc
 static bool PCPDynamicColumn_validateColumnName(char* key, const char* path, unsigned int line) {
    char* p = key;
@@ -161,6 +188,8 @@ static void PCPDynamicColumn_parseFile(PCPDynamicColumns* columns, const char* p
          column->super.width = strtoul(value, NULL, 10);
       } else if (value && column && String_eq(key, "metric")) {
          PCPDynamicColumn_parseMetric(columns, column, path, lineno, value);
+      } else if (value && column && String_eq(key, "expression")) {
+         PCPDynamicColumn_parseExpression(columns, column, path, lineno, value);
       }
       String_freeArray(config);
       free(value);
@@ -226,12 +255,53 @@ void PCPDynamicColumns_init(PCPDynamicColumns* columns) {
    free(path);
 }
 
+void PCPDynamicColumns_evaluate(const PCPDynamicColumns* columns, PCPProcess* pp, double timestamp) {
+   if (!columns->expressionCount)
+      return;
+
+   if (!pp->derived) {
+      pp->derived = xMallocArray(columns->expressionCount, sizeof(double));
+      for (size_t i = 0; i < columns->expressionCount; i++)
+         pp->derived[i] = NAN;
+      pp->rates = xMallocArray(MAXIMUM(columns->rateCount, 1), sizeof(double));
+      for (size_t i = 0; i < columns->rateCount; i++)
+         pp->rates[i] = NAN;
+   }
+
+   double seconds = pp->derivedTime > 0 ? timestamp - pp->derivedTime : 0;
+   pp->derivedTime = timestamp;
+
+   for (size_t i = 0; i < columns->expressionCount; i++) {
+      const PCPDynamicColumn* column = columns->expressions[i];
+      if (column->expression->enabled)
+         pp->derived[i] = PCPExpression_evaluate(column->expression, pp->offset, pp->rates + column->slot, seconds);
+   }
+}
+
+static double PCPDynamicColumn_derived(const PCPDynamicColumn* this, const PCPProcess* pp) {
+   return pp->derived ? pp->derived[this->derived] : NAN;
+}
+
+/* Values of processes of further hosts are in the result of their host */
+static pmAtomValue* PCPDynamicColumn_instance(size_t metric, const PCPProcess* pp, pmAtomValue* atom, int type) {
+   pid_t pid = PCPProcess_realPid(pp, pp->super.pid);
+   if (pp->host == 0)
+      return PCPMetric_instance(metric, pid, pp->offset, atom, type);
+
+   Platform_useHost(pp->host);
+   pmAtomValue* value = PCPMetric_instance(metric, pid, pp->offset, atom, type);
+   Platform_useHost(0);
+   return value;
+}
+
 void PCPDynamicColumn_writeField(PCPDynamicColumn* this, const Process* proc, RichString* str) {
    const PCPProcess* pp = (const PCPProcess*) proc;
-   unsigned int type = PCPMetric_type(this->id);
+   unsigned int type = this->expression ? PM_TYPE_DOUBLE : PCPMetric_type(this->id);
 
    pmAtomValue atom;
-   if (!PCPMetric_instance(this->id, proc->pid, pp->offset, &atom, type)) {
+   if (this->expression) {
+      atom.d = PCPDynamicColumn_derived(this, pp);
+   } else if (!PCPDynamicColumn_instance(this->id, pp, &atom, type)) {
       RichString_appendAscii(str, CRT_colors[METER_VALUE_ERROR], "no data");
       return;
    }
@@ -274,7 +344,12 @@ void PCPDynamicColumn_writeField(PCPDynamicColumn* this, const Process* proc, Ri
          RichString_appendAscii(str, attr, buffer);
          break;
       case PM_TYPE_DOUBLE:
-         xSnprintf(buffer, sizeof(buffer), "%*.2f ", width, atom.d);
+         if (isnan(atom.d)) {
+            attr = CRT_colors[PROCESS_SHADOW];
+            xSnprintf(buffer, sizeof(buffer), "%*s ", width, "N/A");
+         } else {
+            xSnprintf(buffer, sizeof(buffer), "%*.2f ", width, atom.d);
+         }
          RichString_appendAscii(str, attr, buffer);
          break;
       default:
@@ -290,12 +365,19 @@ int PCPDynamicColumn_compareByKey(const PCPProcess* p1, const PCPProcess* p2, Pr
    if (!column)
       return -1;
 
+   if (column->expression) {
+      /* processes without a value yet sort below all others */
+      double v1 = PCPDynamicColumn_derived(column, p1);
+      double v2 = PCPDynamicColumn_derived(column, p2);
+      return SPACESHIP_NUMBER(isnan(v2) ? -INFINITY : v2, isnan(v1) ? -INFINITY : v1);
+   }
+
    size_t metric = column->id;
    unsigned int type = PCPMetric_type(metric);
 
    pmAtomValue atom1 = {0}, atom2 = {0};
-   if (!PCPMetric_instance(metric, p1->super.pid, p1->offset, &atom1, type) ||
-       !PCPMetric_instance(metric, p2->super.pid, p2->offset, &atom2, type)) {
+   if (!PCPDynamicColumn_instance(metric, p1, &atom1, type) ||
+       !PCPDynamicColumn_instance(metric, p2, &atom2, type)) {
       if (type == PM_TYPE_STRING) {
          free(atom1.cp);
          free(atom2.cp);
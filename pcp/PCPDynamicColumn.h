@@ -8,6 +8,7 @@
 #include "Process.h"
 #include "RichString.h"
 
+#include "pcp/PCPExpression.h"
 #include "pcp/PCPProcess.h"
 
 
@@ -15,6 +16,9 @@ typedef struct PCPDynamicColumn_ {
    DynamicColumn super;
    char* metricName;
    size_t id;  /* identifier for metric array lookups */
+   PCPExpression* expression; /* evaluated by htop instead of a metric */
+   size_t derived; /* index of its values in each process */
+   size_t slot;    /* of its first rate() in each process */
 } PCPDynamicColumn;
 
 typedef struct PCPDynamicColumns_ {
@@ -22,10 +26,17 @@ typedef struct PCPDynamicColumns_ {
    size_t count;  /* count of dynamic meters discovered by scan */
    size_t offset; /* start offset into the Platform metric array */
    size_t cursor; /* identifier allocator for each new metric used */
+   PCPDynamicColumn** expressions; /* columns with an expression */
+   size_t expressionCount;
+   size_t rateCount; /* rate() slots of all expressions */
 } PCPDynamicColumns;
 
 void PCPDynamicColumns_init(PCPDynamicColumns* columns);
 
+/* Evaluates the expressions of the columns in use for the process, at the
+ * offset of the current result, sampled at timestamp */
+void PCPDynamicColumns_evaluate(const PCPDynamicColumns* columns, PCPProcess* pp, double timestamp);
+
 void PCPDynamicColumn_writeField(PCPDynamicColumn* this, const Process* proc, RichString* str);
 
 int PCPDynamicColumn_compareByKey(const PCPProcess* p1, const PCPProcess* p2, ProcessField key);
@@ -12,6 +12,7 @@ in the source distribution for its full text.
 #include <ctype.h>
 #include <dirent.h>
 #include <errno.h>
+#include <math.h>
 #include <pcp/pmapi.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -26,7 +27,7 @@ in the source distribution for its full text.
 #include "pcp/PCPMetric.h"
 
 
-static PCPDynamicMetric* PCPDynamicMeter_lookupMetric(PCPDynamicMeters* meters, PCPDynamicMeter* meter, const char* name) {
+static PCPDynamicMetric* PCPDynamicMeter_lookupMetric(PCPDynamicMeter* meter, const char* name) {
    size_t bytes = 16 + strlen(meter->super.name) + strlen(name);
    char* metricName = xMalloc(bytes);
    xSnprintf(metricName, bytes, "htop.meter.%s.%s", meter->super.name, name);
@@ -48,12 +49,19 @@ static PCPDynamicMetric* PCPDynamicMeter_lookupMetric(PCPDynamicMeters* meters,
    memset(metric, 0, sizeof(PCPDynamicMetric));
    metric->name = metricName;
    metric->label = String_cat(name, ": ");
+   return metric;
+}
+
+/* allocate a metric slot only once a PCP metric is observed - expressions */
+/* are evaluated by htop and never fetched, so they leave the id unset */
+static void PCPDynamicMeter_registerMetric(PCPDynamicMeters* meters, PCPDynamicMetric* metric) {
+   if (metric->id)
+      return;
+
    metric->id = meters->offset + meters->cursor;
    meters->cursor++;
 
-   Platform_addMetric(metric->id, metricName);
-
-   return metric;
+   Platform_addMetric(metric->id, metric->name);
 }
 
 static void PCPDynamicMeter_parseMetric(PCPDynamicMeters* meters, PCPDynamicMeter* meter, const char* path, unsigned int line, char* key, char* value) {
@@ -66,7 +74,8 @@ static void PCPDynamicMeter_parseMetric(PCPDynamicMeters* meters, PCPDynamicMete
 
    if (String_eq(p, "metric")) {
       /* lookup a dynamic metric with this name, else create */
-      metric = PCPDynamicMeter_lookupMetric(meters, meter, key);
+      metric = PCPDynamicMeter_lookupMetric(meter, key);
+      PCPDynamicMeter_registerMetric(meters, metric);
 
       /* use derived metrics in dynamic meters for simplicity */
       char* error;
@@ -80,10 +89,33 @@ static void PCPDynamicMeter_parseMetric(PCPDynamicMeters* meters, PCPDynamicMete
          CRT_fatalError(note);
          free(note);
       }
+   } else if (String_eq(p, "expression")) {
+      /* evaluated by htop, e.g. using rate() of counters */
+      metric = PCPDynamicMeter_lookupMetric(meter, key);
+      if (metric->expression)
+         return;
+
+      char* error;
+      metric->expression = PCPExpression_compile(value, meters->offset, &meters->cursor, &error);
+      if (!metric->expression) {
+         char* note;
+         xAsprintf(&note,
+                   "%s: failed to parse expression in %s at line %u\n%s\n%s",
+                   pmGetProgname(), path, line, error, pmGetProgname());
+         free(error);
+         errno = EINVAL;
+         CRT_fatalError(note);
+         free(note);
+      }
+
+      size_t n = meters->expressionCount + 1;
+      meters->expressions = xReallocArray(meters->expressions, n, sizeof(PCPExpression*));
+      meters->expressions[n - 1] = metric->expression;
+      meters->expressionCount = n;
    } else {
       /* this is a property of a dynamic metric - the metric expression */
       /* may not have been observed yet - i.e. we allow for any ordering */
-      metric = PCPDynamicMeter_lookupMetric(meters, meter, key);
+      metric = PCPDynamicMeter_lookupMetric(meter, key);
       if (String_eq(p, "color")) {
          if (String_eq(value, "gray"))
             metric->color = DYNAMIC_GRAY;
@@ -283,9 +315,20 @@ void PCPDynamicMeters_init(PCPDynamicMeters* meters) {
    free(path);
 }
 
+void PCPDynamicMeters_sample(PCPDynamicMeters* meters, double timestamp) {
+   for (size_t i = 0; i < meters->expressionCount; i++) {
+      if (meters->expressions[i]->enabled)
+         PCPExpression_sample(meters->expressions[i], timestamp);
+   }
+}
+
 void PCPDynamicMeter_enable(PCPDynamicMeter* this) {
-   for (size_t i = 0; i < this->totalMetrics; i++)
-      PCPMetric_enable(this->metrics[i].id, true);
+   for (size_t i = 0; i < this->totalMetrics; i++) {
+      if (this->metrics[i].expression)
+         PCPExpression_enable(this->metrics[i].expression);
+      else if (this->metrics[i].id)
+         PCPMetric_enable(this->metrics[i].id, true);
+   }
 }
 
 void PCPDynamicMeter_updateValues(PCPDynamicMeter* this, Meter* meter) {
@@ -298,6 +341,24 @@ void PCPDynamicMeter_updateValues(PCPDynamicMeter* this, Meter* meter) {
          buffer[bytes++] = '/';  /* separator */
 
       PCPDynamicMetric* metric = &this->metrics[i];
+      if (metric->expression) {
+         if (isnan(metric->expression->value)) {
+            if (i > 0)
+               bytes--; /* clear the separator */
+            continue;
+         }
+         bytes += xSnprintf(buffer + bytes, size - bytes, "%.2f", metric->expression->value);
+         if (metric->suffix)
+            bytes += xSnprintf(buffer + bytes, size - bytes, "%s", metric->suffix);
+         continue;
+      }
+
+      if (!metric->id) {
+         if (i > 0)
+            bytes--; /* clear the separator */
+         continue;
+      }
+
       const pmDesc* desc = PCPMetric_desc(metric->id);
       pmAtomValue atom, raw;
 
@@ -369,9 +430,28 @@ void PCPDynamicMeter_display(PCPDynamicMeter* this, ATTR_UNUSED const Meter* met
 
    for (size_t i = 0; i < this->totalMetrics; i++) {
       PCPDynamicMetric* metric = &this->metrics[i];
+      char buffer[64];
+
+      if (metric->expression) {
+         if (isnan(metric->expression->value))
+            continue;
+         nodata = 0;
+         if (i > 0)
+            RichString_appendnAscii(out, CRT_colors[metric->color], " ", 1);
+         if (metric->label)
+            RichString_appendAscii(out, CRT_colors[METER_TEXT], metric->label);
+         int len = xSnprintf(buffer, sizeof(buffer), "%.2f", metric->expression->value);
+         RichString_appendnAscii(out, CRT_colors[metric->color], buffer, len);
+         if (metric->suffix)
+            RichString_appendAscii(out, CRT_colors[METER_TEXT], metric->suffix);
+         continue;
+      }
+
+      if (!metric->id)
+         continue;
+
       const pmDesc* desc = PCPMetric_desc(metric->id);
       pmAtomValue atom, raw;
-      char buffer[64];
 
       if (!PCPMetric_values(metric->id, &raw, 1, desc->type))
          continue;
@@ -9,13 +9,16 @@
 #include "Meter.h"
 #include "RichString.h"
 
+#include "pcp/PCPExpression.h"
+
 
 typedef struct PCPDynamicMetric_ {
-   size_t id; /* index into metric array */
+   size_t id; /* index into metric array, zero if not fetched */
    ColorElements color;
    char* name; /* derived metric name */
    char* label;
    char* suffix;
+   PCPExpression* expression; /* evaluated by htop instead of the metric */
 } PCPDynamicMetric;
 
 typedef struct PCPDynamicMeter_ {
@@ -29,10 +32,15 @@ typedef struct PCPDynamicMeters_ {
    size_t count;  /* count of dynamic meters discovered by scan */
    size_t offset; /* start offset into the Platform metric array */
    size_t cursor; /* identifier allocator for each new metric used */
+   PCPExpression** expressions; /* of all meters */
+   size_t expressionCount;
 } PCPDynamicMeters;
 
 void PCPDynamicMeters_init(PCPDynamicMeters* meters);
 
+/* Evaluates the expressions of the meters in use on a new sample */
+void PCPDynamicMeters_sample(PCPDynamicMeters* meters, double timestamp);
+
 void PCPDynamicMeter_enable(PCPDynamicMeter* this);
 
 void PCPDynamicMeter_updateValues(PCPDynamicMeter* this, Meter* meter);
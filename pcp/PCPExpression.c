@@ -0,0 +1,326 @@
+/*
+htop - PCPExpression.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "pcp/PCPExpression.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "Platform.h"
+#include "XUtils.h"
+
+#include "pcp/PCPMetric.h"
+
+
+typedef struct PCPExpressionParser_ {
+   PCPExpression* expression;
+   const char* text;
+   const char* at;
+   size_t offset;
+   size_t* cursor;
+   size_t depth;
+   size_t allocd;
+   char* error;
+} PCPExpressionParser;
+
+static bool PCPExpression_parseSum(PCPExpressionParser* this);
+
+static bool PCPExpression_fail(PCPExpressionParser* this, const char* reason) {
+   if (!this->error)
+      xAsprintf(&this->error, "%s at column %d of \"%s\"", reason, (int)(this->at - this->text) + 1, this->text);
+   return false;
+}
+
+static void PCPExpression_skipSpace(PCPExpressionParser* this) {
+   while (isspace((unsigned char) *this->at))
+      this->at++;
+}
+
+static bool PCPExpression_accept(PCPExpressionParser* this, char c) {
+   PCPExpression_skipSpace(this);
+   if (*this->at != c)
+      return false;
+   this->at++;
+   return true;
+}
+
+/* Appends an operation, tracking the depth of the stack it leaves */
+static bool PCPExpression_emit(PCPExpressionParser* this, PCPExpressionOp op, size_t arg, double value) {
+   switch (op) {
+      case EXPR_CONSTANT:
+      case EXPR_METRIC:
+         if (++this->depth > PCP_EXPRESSION_DEPTH)
+            return PCPExpression_fail(this, "expression nested too deeply");
+         break;
+      case EXPR_ADD:
+      case EXPR_SUBTRACT:
+      case EXPR_MULTIPLY:
+      case EXPR_DIVIDE:
+      case EXPR_MIN:
+      case EXPR_MAX:
+         this->depth--;
+         break;
+      case EXPR_RATE:
+      case EXPR_NEGATE:
+         break;
+   }
+
+   PCPExpression* expression = this->expression;
+   if (expression->length == this->allocd) {
+      this->allocd = this->allocd ? this->allocd * 2 : 8;
+      expression->code = xReallocArray(expression->code, this->allocd, sizeof(PCPExpressionCode));
+   }
+   expression->code[expression->length++] = (PCPExpressionCode) { .op = op, .arg = arg, .value = value };
+   return true;
+}
+
+/* Each metric is fetched once however often it is used */
+static size_t PCPExpression_metric(PCPExpressionParser* this, const char* name, size_t length) {
+   PCPExpression* expression = this->expression;
+   for (size_t i = 0; i < expression->metricCount; i++) {
+      if (strlen(expression->names[i]) == length && strncmp(expression->names[i], name, length) == 0)
+         return expression->metrics[i];
+   }
+
+   size_t n = expression->metricCount + 1;
+   expression->metrics = xReallocArray(expression->metrics, n, sizeof(size_t));
+   expression->names = xReallocArray(expression->names, n, sizeof(char*));
+   expression->names[n - 1] = xStrndup(name, length);
+   expression->metrics[n - 1] = this->offset + (*this->cursor)++;
+   expression->metricCount = n;
+
+   Platform_addMetric(expression->metrics[n - 1], expression->names[n - 1]);
+   return expression->metrics[n - 1];
+}
+
+static bool PCPExpression_parseCall(PCPExpressionParser* this, const char* name, size_t length) {
+   PCPExpressionOp op;
+   if (length == 4 && strncmp(name, "rate", length) == 0)
+      op = EXPR_RATE;
+   else if (length == 3 && strncmp(name, "min", length) == 0)
+      op = EXPR_MIN;
+   else if (length == 3 && strncmp(name, "max", length) == 0)
+      op = EXPR_MAX;
+   else
+      return PCPExpression_fail(this, "unknown function");
+
+   if (!PCPExpression_parseSum(this))
+      return false;
+   if (op != EXPR_RATE) {
+      if (!PCPExpression_accept(this, ','))
+         return PCPExpression_fail(this, "expected ','");
+      if (!PCPExpression_parseSum(this))
+         return false;
+   }
+   if (!PCPExpression_accept(this, ')'))
+      return PCPExpression_fail(this, "expected ')'");
+
+   size_t arg = op == EXPR_RATE ? this->expression->rates++ : 0;
+   return PCPExpression_emit(this, op, arg, 0.0);
+}
+
+static bool PCPExpression_parsePrimary(PCPExpressionParser* this) {
+   PCPExpression_skipSpace(this);
+   const char* start = this->at;
+
+   if (isdigit((unsigned char) *start) || *start == '.') {
+      char* end;
+      double value = strtod(start, &end);
+      if (end == start)
+         return PCPExpression_fail(this, "invalid number");
+      this->at = end;
+      return PCPExpression_emit(this, EXPR_CONSTANT, 0, value);
+   }
+
+   if (isalpha((unsigned char) *start) || *start == '_') {
+      while (isalnum((unsigned char) *this->at) || *this->at == '_' || *this->at == '.')
+         this->at++;
+      size_t length = (size_t)(this->at - start);
+      if (PCPExpression_accept(this, '('))
+         return PCPExpression_parseCall(this, start, length);
+      return PCPExpression_emit(this, EXPR_METRIC, PCPExpression_metric(this, start, length), 0.0);
+   }
+
+   if (PCPExpression_accept(this, '(')) {
+      if (!PCPExpression_parseSum(this))
+         return false;
+      if (!PCPExpression_accept(this, ')'))
+         return PCPExpression_fail(this, "expected ')'");
+      return true;
+   }
+
+   return PCPExpression_fail(this, *start ? "unexpected character" : "unexpected end");
+}
+
+static bool PCPExpression_parseUnary(PCPExpressionParser* this) {
+   if (PCPExpression_accept(this, '-')) {
+      if (!PCPExpression_parseUnary(this))
+         return false;
+      return PCPExpression_emit(this, EXPR_NEGATE, 0, 0.0);
+   }
+   return PCPExpression_parsePrimary(this);
+}
+
+static bool PCPExpression_parseProduct(PCPExpressionParser* this) {
+   if (!PCPExpression_parseUnary(this))
+      return false;
+
+   for (;;) {
+      PCPExpressionOp op;
+      if (PCPExpression_accept(this, '*'))
+         op = EXPR_MULTIPLY;
+      else if (PCPExpression_accept(this, '/'))
+         op = EXPR_DIVIDE;
+      else
+         return true;
+
+      if (!PCPExpression_parseUnary(this) || !PCPExpression_emit(this, op, 0, 0.0))
+         return false;
+   }
+}
+
+static bool PCPExpression_parseSum(PCPExpressionParser* this) {
+   if (!PCPExpression_parseProduct(this))
+      return false;
+
+   for (;;) {
+      PCPExpressionOp op;
+      if (PCPExpression_accept(this, '+'))
+         op = EXPR_ADD;
+      else if (PCPExpression_accept(this, '-'))
+         op = EXPR_SUBTRACT;
+      else
+         return true;
+
+      if (!PCPExpression_parseProduct(this) || !PCPExpression_emit(this, op, 0, 0.0))
+         return false;
+   }
+}
+
+PCPExpression* PCPExpression_compile(const char* text, size_t offset, size_t* cursor, char** error) {
+   PCPExpressionParser parser = {
+      .expression = xCalloc(1, sizeof(PCPExpression)),
+      .text = text,
+      .at = text,
+      .offset = offset,
+      .cursor = cursor,
+   };
+
+   bool ok = PCPExpression_parseSum(&parser);
+   if (ok) {
+      PCPExpression_skipSpace(&parser);
+      if (*parser.at)
+         ok = PCPExpression_fail(&parser, "unexpected character");
+   }
+   if (!ok) {
+      /* metrics added already stay known to the platform, unused */
+      *error = parser.error;
+      PCPExpression_delete(parser.expression);
+      return NULL;
+   }
+
+   PCPExpression* this = parser.expression;
+   this->previous = xMallocArray(MAXIMUM(this->rates, 1), sizeof(double));
+   for (size_t i = 0; i < this->rates; i++)
+      this->previous[i] = NAN;
+   this->sampled = NAN;
+   this->value = NAN;
+   return this;
+}
+
+void PCPExpression_delete(PCPExpression* this) {
+   if (!this)
+      return;
+
+   /* the names themselves stay referred to by the platform */
+   free(this->code);
+   free(this->metrics);
+   free(this->names);
+   free(this->previous);
+   free(this);
+}
+
+void PCPExpression_enable(PCPExpression* this) {
+   for (size_t i = 0; i < this->metricCount; i++)
+      PCPMetric_enable(this->metrics[i], true);
+   this->enabled = true;
+}
+
+static double PCPExpression_value(size_t metric, int offset) {
+   if (offset >= 0) {
+      const pmAtomValue* value = PCPMetric_column(metric, offset, PM_TYPE_DOUBLE);
+      return value ? value->d : NAN;
+   }
+
+   pmAtomValue atom;
+   if (!PCPMetric_values(metric, &atom, 1, PM_TYPE_DOUBLE))
+      return NAN;
+   return atom.d;
+}
+
+double PCPExpression_evaluate(const PCPExpression* this, int offset, double* rates, double seconds) {
+   double stack[PCP_EXPRESSION_DEPTH];
+   size_t top = 0;
+
+   for (size_t i = 0; i < this->length; i++) {
+      const PCPExpressionCode* code = &this->code[i];
+      switch (code->op) {
+         case EXPR_CONSTANT:
+            stack[top++] = code->value;
+            break;
+         case EXPR_METRIC:
+            stack[top++] = PCPExpression_value(code->arg, offset);
+            break;
+         case EXPR_RATE: {
+            double current = stack[top - 1];
+            double previous = rates[code->arg];
+            rates[code->arg] = current;
+            stack[top - 1] = seconds > 0 ? (current - previous) / seconds : NAN;
+            break;
+         }
+         case EXPR_NEGATE:
+            stack[top - 1] = -stack[top - 1];
+            break;
+         case EXPR_ADD:
+            top--;
+            stack[top - 1] += stack[top];
+            break;
+         case EXPR_SUBTRACT:
+            top--;
+            stack[top - 1] -= stack[top];
+            break;
+         case EXPR_MULTIPLY:
+            top--;
+            stack[top - 1] *= stack[top];
+            break;
+         case EXPR_DIVIDE:
+            top--;
+            stack[top - 1] = fabs(stack[top]) > 0 ? stack[top - 1] / stack[top] : NAN;
+            break;
+         case EXPR_MIN:
+            top--;
+            stack[top - 1] = fmin(stack[top - 1], stack[top]);
+            break;
+         case EXPR_MAX:
+            top--;
+            stack[top - 1] = fmax(stack[top - 1], stack[top]);
+            break;
+      }
+   }
+   return top ? stack[top - 1] : NAN;
+}
+
+void PCPExpression_sample(PCPExpression* this, double timestamp) {
+   double seconds = isnan(this->sampled) ? 0 : timestamp - this->sampled;
+   this->value = PCPExpression_evaluate(this, -1, this->previous, seconds);
+   this->sampled = timestamp;
+}
@@ -0,0 +1,71 @@
+#ifndef HEADER_PCPExpression
+#define HEADER_PCPExpression
+/*
+htop - PCPExpression.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/* Deepest evaluation stack of an expression */
+#define PCP_EXPRESSION_DEPTH 32
+
+typedef enum PCPExpressionOp_ {
+   EXPR_CONSTANT,             /* pushes value */
+   EXPR_METRIC,               /* pushes the value of metric arg */
+   EXPR_RATE,                 /* replaces the top by its change per second, rate slot arg */
+   EXPR_NEGATE,
+   EXPR_ADD,
+   EXPR_SUBTRACT,
+   EXPR_MULTIPLY,
+   EXPR_DIVIDE,
+   EXPR_MIN,
+   EXPR_MAX,
+} PCPExpressionOp;
+
+typedef struct PCPExpressionCode_ {
+   PCPExpressionOp op;
+   size_t arg;
+   double value;
+} PCPExpressionCode;
+
+/* An arithmetic expression of metric values, compiled to the code of a
+ * stack machine and evaluated by htop on every sample */
+typedef struct PCPExpression_ {
+   PCPExpressionCode* code;
+   size_t length;
+   size_t* metrics;           /* identifiers of the metrics used */
+   char** names;              /* of the metrics used, referred to by the platform */
+   size_t metricCount;
+   size_t rates;              /* count of rate() slots */
+   bool enabled;              /* evaluated on every sample */
+
+   /* of expressions with a single value, e.g. in meters */
+   double* previous;          /* inputs of rate() in the previous sample */
+   double sampled;            /* time of the previous sample, in seconds */
+   double value;
+} PCPExpression;
+
+/* Compiles text such as "rate(proc.io.read_bytes) / 1024", adding the
+ * metrics used with identifiers from offset + *cursor on; NULL with the
+ * reason in error if it is not valid */
+PCPExpression* PCPExpression_compile(const char* text, size_t offset, size_t* cursor, char** error);
+
+void PCPExpression_delete(PCPExpression* this);
+
+void PCPExpression_enable(PCPExpression* this);
+
+/* Value for the process at the offset of PCP_PROC_PID in the current
+ * result, or of single valued metrics with a negative offset. rate() takes
+ * its previous inputs from rates, seconds ago, and leaves the current ones
+ * there; NAN if a value is missing */
+double PCPExpression_evaluate(const PCPExpression* this, int offset, double* rates, double seconds);
+
+/* Evaluates a single valued expression on a new sample taken at timestamp */
+void PCPExpression_sample(PCPExpression* this, double timestamp);
+
+#endif
@@ -10,10 +10,16 @@ in the source distribution for its full text.
 
 #include "pcp/PCPMetric.h"
 
+#include <assert.h>
+#include <limits.h>
+#include <pthread.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "Macros.h"
 #include "XUtils.h"
 
 #include "pcp/Platform.h"
@@ -30,10 +36,10 @@ int PCPMetric_type(PCPMetric metric) {
 }
 
 pmAtomValue* PCPMetric_values(PCPMetric metric, pmAtomValue* atom, int count, int type) {
-   if (pcp->result == NULL)
+   if (pcp->host->result == NULL)
       return NULL;
 
-   pmValueSet* vset = pcp->result->vset[metric];
+   pmValueSet* vset = pcp->host->result->vset[metric];
    if (!vset || vset->numval <= 0)
       return NULL;
 
@@ -55,23 +61,77 @@ pmAtomValue* PCPMetric_values(PCPMetric metric, pmAtomValue* atom, int count, in
 }
 
 int PCPMetric_instanceCount(PCPMetric metric) {
-   pmValueSet* vset = pcp->result->vset[metric];
+   pmValueSet* vset = pcp->host->result->vset[metric];
    if (vset)
       return vset->numval;
    return 0;
 }
 
+static int PCPMetric_compareInstances(const void* v1, const void* v2) {
+   const PCPMetricInstance* i1 = (const PCPMetricInstance*) v1;
+   const PCPMetricInstance* i2 = (const PCPMetricInstance*) v2;
+   return SPACESHIP_NUMBER(i1->inst, i2->inst);
+}
+
+/* Sorts the instances, once per fetch and only for metrics looked up out of
+ * order; proc instances mostly come sorted by pid already */
+static const PCPMetricIndex* PCPMetric_index(PCPMetric metric, const pmValueSet* vset) {
+   PCPMetricIndex* index = &pcp->host->indexes[metric];
+   if (index->valid)
+      return index;
+
+   index->valid = true;
+   index->count = vset->numval;
+
+   bool sorted = true;
+   for (int i = 1; i < vset->numval && sorted; i++)
+      sorted = vset->vlist[i - 1].inst < vset->vlist[i].inst;
+   if (sorted) {
+      free(index->instances);
+      index->instances = NULL;
+      index->allocd = 0;
+      return index;
+   }
+
+   if (index->allocd < vset->numval) {
+      index->allocd = vset->numval;
+      index->instances = xReallocArray(index->instances, index->allocd, sizeof(PCPMetricInstance));
+   }
+   for (int i = 0; i < vset->numval; i++) {
+      index->instances[i].inst = vset->vlist[i].inst;
+      index->instances[i].offset = i;
+   }
+   qsort(index->instances, vset->numval, sizeof(PCPMetricInstance), PCPMetric_compareInstances);
+   return index;
+}
+
+/* Offset of the value of the instance, or -1 */
+static int PCPMetric_find(PCPMetric metric, const pmValueSet* vset, int inst) {
+   const PCPMetricIndex* index = PCPMetric_index(metric, vset);
+
+   int lo = 0;
+   int hi = index->count - 1;
+   while (lo <= hi) {
+      int mid = lo + (hi - lo) / 2;
+      int found = index->instances ? index->instances[mid].inst : vset->vlist[mid].inst;
+      if (found == inst)
+         return index->instances ? index->instances[mid].offset : mid;
+      if (found < inst)
+         lo = mid + 1;
+      else
+         hi = mid - 1;
+   }
+   return -1;
+}
+
 int PCPMetric_instanceOffset(PCPMetric metric, int inst) {
-   pmValueSet* vset = pcp->result->vset[metric];
+   pmValueSet* vset = pcp->host->result->vset[metric];
    if (!vset || vset->numval <= 0)
       return 0;
 
-   /* search for optimal offset for subsequent inst lookups to begin */
-   for (int i = 0; i < vset->numval; i++) {
-      if (inst == vset->vlist[i].inst)
-         return i;
-   }
-   return 0;
+   /* optimal offset for subsequent inst lookups to begin */
+   int offset = PCPMetric_find(metric, vset, inst);
+   return offset < 0 ? 0 : offset;
 }
 
 static pmAtomValue* PCPMetric_extract(PCPMetric metric, int inst, int offset, pmValueSet* vset, pmAtomValue* atom, int type) {
@@ -91,7 +151,7 @@ static pmAtomValue* PCPMetric_extract(PCPMetric metric, int inst, int offset, pm
 
 pmAtomValue* PCPMetric_instance(PCPMetric metric, int inst, int offset, pmAtomValue* atom, int type) {
 
-   pmValueSet* vset = pcp->result->vset[metric];
+   pmValueSet* vset = pcp->host->result->vset[metric];
    if (!vset || vset->numval <= 0)
       return NULL;
 
@@ -99,12 +159,116 @@ pmAtomValue* PCPMetric_instance(PCPMetric metric, int inst, int offset, pmAtomVa
    if (offset >= 0 && offset < vset->numval && inst == vset->vlist[offset].inst)
       return PCPMetric_extract(metric, inst, offset, vset, atom, type);
 
-   /* slow-path using a linear search for the requested instance */
-   for (int i = 0; i < vset->numval; i++) {
-      if (inst == vset->vlist[i].inst)
-         return PCPMetric_extract(metric, inst, i, vset, atom, type);
+   /* slow-path using a binary search for the requested instance */
+   int found = PCPMetric_find(metric, vset, inst);
+   if (found < 0)
+      return NULL;
+   return PCPMetric_extract(metric, inst, found, vset, atom, type);
+}
+
+/* Strings normally end in the result already and are used in place */
+static void PCPMetric_extractString(PCPMetricColumn* column, int at, const pmValueSet* vset, const pmValue* value) {
+   pmValueBlock* block = value->value.pval;
+   size_t length = block->vlen > PM_VAL_HDR_SIZE ? block->vlen - PM_VAL_HDR_SIZE : 0;
+   if (length > 0 && block->vbuf[length - 1] == '\0') {
+      column->values[at].cp = block->vbuf;
+      return;
    }
-   return NULL;
+
+   /* room for all strings of the result at once, so that copies never move */
+   if (!column->stringsSize) {
+      size_t needed = 0;
+      for (int i = 0; i < vset->numval; i++)
+         needed += vset->vlist[i].value.pval->vlen + 1;
+      if (needed > column->stringsAllocd) {
+         column->stringsAllocd = needed;
+         column->strings = xRealloc(column->strings, needed);
+      }
+   }
+
+   char* copy = column->strings + column->stringsSize;
+   memcpy(copy, block->vbuf, length);
+   copy[length] = '\0';
+   column->stringsSize += length + 1;
+   column->values[at].cp = copy;
+}
+
+static bool PCPMetric_extractColumnValue(PCPMetric metric, PCPMetricColumn* column, int at, const pmValueSet* vset, int offset) {
+   const pmValue* value = &vset->vlist[offset];
+   int type = column->type;
+   int descType = pcp->descs[metric].type;
+
+   /* the common case of a value of the requested type needs no conversion */
+   if (descType == type) {
+      if (vset->valfmt == PM_VAL_INSITU && (type == PM_TYPE_32 || type == PM_TYPE_U32)) {
+         column->values[at].l = value->value.lval;
+         return true;
+      }
+      if (vset->valfmt != PM_VAL_INSITU && value->value.pval->vtype == type) {
+         if (type == PM_TYPE_STRING) {
+            PCPMetric_extractString(column, at, vset, value);
+            return true;
+         }
+         if (type == PM_TYPE_64 || type == PM_TYPE_U64 || type == PM_TYPE_DOUBLE) {
+            memcpy(&column->values[at], value->value.pval->vbuf, sizeof(uint64_t));
+            return true;
+         }
+      }
+   }
+   if (type == PM_TYPE_STRING)
+      return false;
+
+   int sts = pmExtractValue(vset->valfmt, value, descType, &column->values[at], type);
+   if (sts < 0) {
+      if (pmDebugOptions.appl0)
+         fprintf(stderr, "Error: cannot extract %s instance %d value: %s\n",
+                         pcp->names[metric], value->inst, pmErrStr(sts));
+      return false;
+   }
+   return true;
+}
+
+static void PCPMetric_extractColumn(PCPMetric metric, PCPMetricColumn* column) {
+   const pmValueSet* pids = pcp->host->result->vset[PCP_PROC_PID];
+   const pmValueSet* vset = pcp->host->result->vset[metric];
+   int count = pids ? MAXIMUM(pids->numval, 0) : 0;
+
+   column->valid = true;
+   column->count = count;
+   column->stringsSize = 0;
+   if (column->allocd < count) {
+      column->allocd = count;
+      column->values = xReallocArray(column->values, count, sizeof(pmAtomValue));
+      column->present = xReallocArray(column->present, count, sizeof(bool));
+   }
+
+   for (int i = 0; i < count; i++) {
+      column->present[i] = false;
+      if (!vset || vset->numval <= 0)
+         continue;
+
+      /* instances mostly line up with those of the pids */
+      int inst = pids->vlist[i].inst;
+      int offset = (i < vset->numval && vset->vlist[i].inst == inst) ? i : PCPMetric_find(metric, vset, inst);
+      if (offset >= 0)
+         column->present[i] = PCPMetric_extractColumnValue(metric, column, i, vset, offset);
+   }
+}
+
+const pmAtomValue* PCPMetric_column(PCPMetric metric, int offset, int type) {
+   if (!pcp->host->result)
+      return NULL;
+
+   PCPMetricColumn* column = &pcp->host->extracted[metric];
+   if (!column->valid) {
+      column->type = type;
+      PCPMetric_extractColumn(metric, column);
+   }
+   assert(column->type == type);
+
+   if (offset < 0 || offset >= column->count || !column->present[offset])
+      return NULL;
+   return &column->values[offset];
 }
 
 /*
@@ -114,10 +278,10 @@ pmAtomValue* PCPMetric_instance(PCPMetric metric, int inst, int offset, pmAtomVa
  * Start it off by passing offset -1 into the routine.
  */
 bool PCPMetric_iterate(PCPMetric metric, int* instp, int* offsetp) {
-   if (!pcp->result)
+   if (!pcp->host->result)
       return false;
 
-   pmValueSet* vset = pcp->result->vset[metric];
+   pmValueSet* vset = pcp->host->result->vset[metric];
    if (!vset || vset->numval <= 0)
       return false;
 
@@ -159,19 +323,318 @@ void PCPMetric_enableThreads(void) {
    pmFreeResult(result);
 }
 
+/*
+ * Samples of live hosts are fetched ahead by a thread per host, so that the
+ * round trips to remote pmcds overlap with each other and with the update
+ * interval instead of stalling the user interface. The next fetch is
+ * requested as soon as a sample is taken, with the metrics enabled at that
+ * time.
+ *
+ * Archives are decoded up to PCP_FETCH_AHEAD samples ahead in the same way,
+ * and the thread also repositions them, so that seeking and playing on
+ * stay smooth on long archives.
+ */
+#define PCP_FETCH_AHEAD 8
+
+struct PCPMetricFetcher_ {
+   pthread_t thread;
+   pthread_mutex_t lock;
+   pthread_cond_t changed;
+   int context;               /* of the host, made current in the thread */
+   bool archive;
+   bool quit;
+   pmID* pmids;               /* the metrics to fetch */
+   size_t count;
+   size_t allocd;
+   unsigned int generation;   /* of pmids and position; older samples are dropped */
+   pmResult* queue[PCP_FETCH_AHEAD]; /* completed and not taken yet */
+   size_t head;
+   size_t queued;
+   size_t depth;              /* of the queue in use */
+   int sts;                   /* of a failed fetch, ending the queue */
+   bool seek;                 /* reposition the archive before fetching on */
+   struct timeval seekTo;
+   struct timeval next;       /* archive time of the next sample to take */
+   bool positioned;           /* next is known */
+};
+
+/* as set up by pmGetContextOptions */
+int PCPMetric_archiveDelta(void) {
+   long delta = opts.interval.tv_sec * 1000L + opts.interval.tv_usec / 1000L;
+   return delta > 0 && delta < INT_MAX ? (int)delta : 1000;
+}
+
+/* with the lock held */
+static void PCPMetric_setNext(PCPMetricFetcher* fetcher, const struct timeval* taken) {
+   int delta = PCPMetric_archiveDelta();
+   struct timeval step = { delta / 1000, (delta % 1000) * 1000 };
+   fetcher->next = *taken;
+   pmtimevalInc(&fetcher->next, &step);
+   fetcher->positioned = true;
+}
+
+/* with the lock held */
+static void PCPMetric_flushFetched(PCPMetricFetcher* fetcher) {
+   for (; fetcher->queued; fetcher->queued--) {
+      pmFreeResult(fetcher->queue[fetcher->head]);
+      fetcher->head = (fetcher->head + 1) % PCP_FETCH_AHEAD;
+   }
+   fetcher->sts = 0;
+   fetcher->generation++;
+}
+
+static void* PCPMetric_fetchLoop(void* arg) {
+   PCPMetricFetcher* fetcher = arg;
+   pmID* pmids = NULL;
+   size_t allocd = 0;
+
+   /* the current PMAPI context is per thread */
+   pmUseContext(fetcher->context);
+
+   pthread_mutex_lock(&fetcher->lock);
+   while (!fetcher->quit) {
+      if (fetcher->seek) {
+         struct timeval when = fetcher->seekTo;
+         fetcher->seek = false;
+         pthread_mutex_unlock(&fetcher->lock);
+         int sts = pmSetMode(PM_MODE_INTERP | PM_XTB_SET(PM_TIME_MSEC), &when, PCPMetric_archiveDelta());
+         if (sts < 0 && pmDebugOptions.appl0)
+            fprintf(stderr, "Error: cannot seek the archive: %s\n", pmErrStr(sts));
+         pthread_mutex_lock(&fetcher->lock);
+         continue;
+      }
+      if (fetcher->queued == fetcher->depth || fetcher->sts < 0) {
+         pthread_cond_wait(&fetcher->changed, &fetcher->lock);
+         continue;
+      }
+
+      /* fetch with a copy of the identifiers, they may change meanwhile */
+      if (allocd < fetcher->count) {
+         allocd = fetcher->count;
+         pmids = xReallocArray(pmids, allocd, sizeof(pmID));
+      }
+      size_t count = fetcher->count;
+      memcpy(pmids, fetcher->pmids, count * sizeof(pmID));
+      unsigned int generation = fetcher->generation;
+      pthread_mutex_unlock(&fetcher->lock);
+      pmResult* result = NULL;
+      int sts = pmFetch(count, pmids, &result);
+      pthread_mutex_lock(&fetcher->lock);
+
+      if (generation != fetcher->generation) {
+         if (sts >= 0)
+            pmFreeResult(result);
+         continue;
+      }
+      if (sts < 0) {
+         fetcher->sts = sts;
+      } else {
+         fetcher->queue[(fetcher->head + fetcher->queued) % PCP_FETCH_AHEAD] = result;
+         fetcher->queued++;
+      }
+      pthread_cond_broadcast(&fetcher->changed);
+   }
+   pthread_mutex_unlock(&fetcher->lock);
+   free(pmids);
+   return NULL;
+}
+
+static bool PCPMetric_fetchedCurrent(const PCPMetricFetcher* fetcher) {
+   return fetcher->count == pcp->totalMetrics &&
+          memcmp(fetcher->pmids, pcp->fetch, fetcher->count * sizeof(pmID)) == 0;
+}
+
+/* with the lock held; samples of other metrics than the enabled ones are
+ * dropped, archives are fetched again from after the last sample taken */
+static void PCPMetric_requestCurrent(PCPMetricFetcher* fetcher) {
+   if (PCPMetric_fetchedCurrent(fetcher))
+      return;
+
+   if (fetcher->allocd < pcp->totalMetrics) {
+      fetcher->allocd = pcp->totalMetrics;
+      fetcher->pmids = xReallocArray(fetcher->pmids, fetcher->allocd, sizeof(pmID));
+   }
+   memcpy(fetcher->pmids, pcp->fetch, pcp->totalMetrics * sizeof(pmID));
+   fetcher->count = pcp->totalMetrics;
+
+   PCPMetric_flushFetched(fetcher);
+   if (fetcher->archive && fetcher->positioned) {
+      fetcher->seekTo = fetcher->next;
+      fetcher->seek = true;
+   }
+   pthread_cond_broadcast(&fetcher->changed);
+}
+
+void PCPMetric_startFetcher(PCPHost* host, bool archive) {
+   if (host->fetcher)
+      return;
+
+   PCPMetricFetcher* fetcher = xCalloc(1, sizeof(PCPMetricFetcher));
+   pthread_mutex_init(&fetcher->lock, NULL);
+   pthread_cond_init(&fetcher->changed, NULL);
+   fetcher->context = host->context;
+   fetcher->archive = archive;
+   fetcher->depth = archive ? PCP_FETCH_AHEAD : 1;
+
+   /* archives go on after the sample taken already */
+   if (host->result)
+      PCPMetric_setNext(fetcher, &host->result->timestamp);
+
+   /* the first fetch of every host is underway before any is waited for */
+   PCPMetric_requestCurrent(fetcher);
+
+   if (pthread_create(&fetcher->thread, NULL, PCPMetric_fetchLoop, fetcher) != 0) {
+      pthread_cond_destroy(&fetcher->changed);
+      pthread_mutex_destroy(&fetcher->lock);
+      free(fetcher->pmids);
+      free(fetcher);
+      return;
+   }
+   host->fetcher = fetcher;
+}
+
+void PCPMetric_stopFetcher(PCPHost* host) {
+   PCPMetricFetcher* fetcher = host->fetcher;
+   if (!fetcher)
+      return;
+
+   pthread_mutex_lock(&fetcher->lock);
+   fetcher->quit = true;
+   pthread_cond_broadcast(&fetcher->changed);
+   pthread_mutex_unlock(&fetcher->lock);
+   pthread_join(fetcher->thread, NULL);
+
+   PCPMetric_flushFetched(fetcher);
+   pthread_cond_destroy(&fetcher->changed);
+   pthread_mutex_destroy(&fetcher->lock);
+   free(fetcher->pmids);
+   free(fetcher);
+   host->fetcher = NULL;
+}
+
+void PCPMetric_seek(PCPHost* host, const struct timeval* when) {
+   PCPMetricFetcher* fetcher = host->fetcher;
+   if (!fetcher) {
+      pmUseContext(host->context);
+      pmSetMode(PM_MODE_INTERP | PM_XTB_SET(PM_TIME_MSEC), when, PCPMetric_archiveDelta());
+      return;
+   }
+
+   pthread_mutex_lock(&fetcher->lock);
+   PCPMetric_flushFetched(fetcher);
+   fetcher->seekTo = fetcher->next = *when;
+   fetcher->positioned = true;
+   fetcher->seek = true;
+   pthread_cond_broadcast(&fetcher->changed);
+   pthread_mutex_unlock(&fetcher->lock);
+}
+
+void PCPMetric_freeHost(PCPHost* host) {
+   if (host->result)
+      pmFreeResult(host->result);
+   host->result = NULL;
+   for (size_t i = 0; i < host->indexCount; i++) {
+      free(host->indexes[i].instances);
+      free(host->extracted[i].values);
+      free(host->extracted[i].present);
+      free(host->extracted[i].strings);
+   }
+   free(host->indexes);
+   free(host->extracted);
+   host->indexes = NULL;
+   host->extracted = NULL;
+   host->indexCount = 0;
+}
+
+/* Takes the next sample, if any; live hosts wait only while there is no
+ * sample at all to show, archives always wait as they are shown in order */
+static int PCPMetric_takeFetched(PCPHost* host, pmResult** result) {
+   PCPMetricFetcher* fetcher = host->fetcher;
+   *result = NULL;
+   int sts = 0;
+
+   pthread_mutex_lock(&fetcher->lock);
+   PCPMetric_requestCurrent(fetcher);
+   for (;;) {
+      if (fetcher->queued) {
+         *result = fetcher->queue[fetcher->head];
+         fetcher->head = (fetcher->head + 1) % PCP_FETCH_AHEAD;
+         fetcher->queued--;
+         PCPMetric_setNext(fetcher, &(*result)->timestamp);
+         pthread_cond_broadcast(&fetcher->changed);
+         break;
+      }
+      if (fetcher->sts < 0) {
+         /* reported once, then fetched again */
+         sts = fetcher->sts;
+         fetcher->sts = 0;
+         pthread_cond_broadcast(&fetcher->changed);
+         break;
+      }
+      if (!fetcher->archive && host->result)
+         break;
+
+      pthread_cond_wait(&fetcher->changed, &fetcher->lock);
+   }
+   pthread_mutex_unlock(&fetcher->lock);
+   return sts;
+}
+
 bool PCPMetric_fetch(struct timeval* timestamp) {
-   if (pcp->result) {
-      pmFreeResult(pcp->result);
-      pcp->result = NULL;
+   PCPHost* host = pcp->host;
+   pmResult* result = NULL;
+   int sts;
+   if (host->fetcher) {
+      sts = PCPMetric_takeFetched(host, &result);
+      if (!result && sts == 0)
+         return false; /* the next sample is still on its way */
+   } else {
+      sts = pmFetch(pcp->totalMetrics, pcp->fetch, &result);
+   }
+
+   if (host->result) {
+      pmFreeResult(host->result);
+      host->result = NULL;
+   }
+   if (host->indexCount < pcp->totalMetrics) {
+      size_t added = pcp->totalMetrics - host->indexCount;
+      host->indexes = xReallocArray(host->indexes, pcp->totalMetrics, sizeof(PCPMetricIndex));
+      memset(&host->indexes[host->indexCount], 0, added * sizeof(PCPMetricIndex));
+      host->extracted = xReallocArray(host->extracted, pcp->totalMetrics, sizeof(PCPMetricColumn));
+      memset(&host->extracted[host->indexCount], 0, added * sizeof(PCPMetricColumn));
+      host->indexCount = pcp->totalMetrics;
+   }
+   for (size_t i = 0; i < host->indexCount; i++) {
+      host->indexes[i].valid = false;
+      host->extracted[i].valid = false;
    }
-   int sts = pmFetch(pcp->totalMetrics, pcp->fetch, &pcp->result);
+
    if (sts < 0) {
       if (pmDebugOptions.appl0)
          fprintf(stderr, "Error: cannot fetch metric values: %s\n",
                  pmErrStr(sts));
       return false;
    }
+   host->result = result;
    if (timestamp)
-      *timestamp = pcp->result->timestamp;
+      *timestamp = host->result->timestamp;
    return true;
 }
+
+bool PCPMetric_rebased(void) {
+   bool rebase = pcp->host->rebase;
+   pcp->host->rebase = false;
+   return rebase;
+}
+
+uint64_t PCPMetric_sampleAge(void) {
+   if (!pcp->host->result)
+      return 0;
+
+   struct timeval now;
+   uint64_t nowMs;
+   Platform_gettime_realtime(&now, &nowMs);
+   const struct timeval* tv = &pcp->host->result->timestamp;
+   uint64_t sampleMs = ((uint64_t)tv->tv_sec * 1000) + ((uint64_t)tv->tv_usec / 1000);
+   return nowMs > sampleMs ? nowMs - sampleMs : 0;
+}
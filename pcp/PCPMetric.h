@@ -10,6 +10,8 @@ in the source distribution for its full text.
 
 #include <ctype.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <pcp/pmapi.h>
 #include <sys/time.h>
 
@@ -77,6 +79,11 @@ typedef enum PCPMetric_ {
    PCP_PSI_IOFULL,              /* kernel.all.pressure.io.full.avg */
    PCP_PSI_MEMSOME,             /* kernel.all.pressure.memory.some.avg */
    PCP_PSI_MEMFULL,             /* kernel.all.pressure.memory.full.avg */
+   PCP_PSI_CPUSOME_TOTAL,       /* kernel.all.pressure.cpu.some.total */
+   PCP_PSI_IOSOME_TOTAL,        /* kernel.all.pressure.io.some.total */
+   PCP_PSI_IOFULL_TOTAL,        /* kernel.all.pressure.io.full.total */
+   PCP_PSI_MEMSOME_TOTAL,       /* kernel.all.pressure.memory.some.total */
+   PCP_PSI_MEMFULL_TOTAL,       /* kernel.all.pressure.memory.full.total */
    PCP_ZFS_ARC_ANON_SIZE,       /* zfs.arc.anon_size */
    PCP_ZFS_ARC_BONUS_SIZE,      /* zfs.arc.bonus_size */
    PCP_ZFS_ARC_COMPRESSED_SIZE, /* zfs.arc.compressed_size */
@@ -154,14 +161,78 @@ typedef enum PCPMetric_ {
    PCP_METRIC_COUNT             /* total metric count */
 } PCPMetric;
 
+typedef struct PCPMetricInstance_ {
+   int inst;
+   int offset;                /* of its value in the result */
+} PCPMetricInstance;
+
+/* Instances of a metric in the current result, sorted for lookups */
+typedef struct PCPMetricIndex_ {
+   PCPMetricInstance* instances; /* NULL if the result is sorted already */
+   int count;
+   int allocd;
+   bool valid;                /* built for the current result */
+} PCPMetricIndex;
+
+/* Values of a per-process metric in the current result, extracted a metric
+ * at a time, aligned with the instances of PCP_PROC_PID */
+typedef struct PCPMetricColumn_ {
+   pmAtomValue* values;       /* strings point into the result, not owned */
+   bool* present;
+   int count;
+   int allocd;
+   int type;                  /* requested type of the values */
+   char* strings;             /* copies of strings not terminated in the result */
+   size_t stringsSize;
+   size_t stringsAllocd;
+   bool valid;                /* extracted from the current result */
+} PCPMetricColumn;
+
+typedef struct PCPMetricFetcher_ PCPMetricFetcher;
+
+/* A metrics source sampled along with the others, with its own result */
+typedef struct PCPHost_ {
+   int context;               /* PMAPI(3) context identifier */
+   char* name;                /* as reported by the host, for display */
+   pmResult* result;          /* sample values result indexed by Metric */
+   PCPMetricIndex* indexes;   /* instance lookups into result by Metric */
+   PCPMetricColumn* extracted; /* per-process values of result by Metric */
+   size_t indexCount;         /* of indexes and extracted */
+   PCPMetricFetcher* fetcher; /* NULL unless fetched in the background */
+   long long btime;           /* boottime in seconds since the epoch */
+   bool rebase;               /* the next sample follows a seek */
+} PCPHost;
+
 void PCPMetric_enable(PCPMetric metric, bool enable);
 
 bool PCPMetric_enabled(PCPMetric metric);
 
 void PCPMetric_enableThreads(void);
 
+/* Fetches a live host or an archive ahead in the background from now on */
+void PCPMetric_startFetcher(PCPHost* host, bool archive);
+
+void PCPMetric_stopFetcher(PCPHost* host);
+
+/* Positions an archive so that the next sample is the one at the given time */
+void PCPMetric_seek(PCPHost* host, const struct timeval* when);
+
+/* Milliseconds between archive samples */
+int PCPMetric_archiveDelta(void);
+
+/* true once for the first sample after a seek, which is a baseline only */
+bool PCPMetric_rebased(void);
+
+/* Frees the sample of the host and its lookups */
+void PCPMetric_freeHost(PCPHost* host);
+
+/* Fetches the current host; false if there is no new sample, e.g. while a
+ * background fetch is pending */
 bool PCPMetric_fetch(struct timeval* timestamp);
 
+/* Milliseconds since the sample shown was taken */
+uint64_t PCPMetric_sampleAge(void);
+
 bool PCPMetric_iterate(PCPMetric metric, int* instp, int* offsetp);
 
 pmAtomValue* PCPMetric_values(PCPMetric metric, pmAtomValue* atom, int count, int type);
@@ -176,4 +247,8 @@ int PCPMetric_instanceOffset(PCPMetric metric, int inst);
 
 pmAtomValue* PCPMetric_instance(PCPMetric metric, int inst, int offset, pmAtomValue* atom, int type);
 
+/* Value of a per-process metric for the process at the offset of PCP_PROC_PID,
+ * NULL if it has none; strings are valid until the next fetch */
+const pmAtomValue* PCPMetric_column(PCPMetric metric, int offset, int type);
+
 #endif
@@ -21,6 +21,7 @@ in the source distribution for its full text.
 #include "XUtils.h"
 
 #include "pcp/PCPDynamicColumn.h"
+#include "pcp/Platform.h"
 
 
 const ProcessFieldData Process_fields[] = {
@@ -86,6 +87,7 @@ const ProcessFieldData Process_fields[] = {
    [CWD] = { .name = "CWD", .title = "CWD                       ", .description = "The current working directory of the process", .flags = PROCESS_FLAG_CWD, },
    [AUTOGROUP_ID] = { .name = "AUTOGROUP_ID", .title = "AGRP", .description = "The autogroup identifier of the process", .flags = PROCESS_FLAG_LINUX_AUTOGROUP, },
    [AUTOGROUP_NICE] = { .name = "AUTOGROUP_NICE", .title = " ANI", .description = "Nice value (the higher the value, the more other processes take priority) associated with the process autogroup", .flags = PROCESS_FLAG_LINUX_AUTOGROUP, },
+   [HOST] = { .name = "HOST", .title = "HOST            ", .description = "Host the process runs on, of those given with --host", .flags = 0, },
 };
 
 Process* PCPProcess_new(const Settings* settings) {
@@ -100,6 +102,8 @@ void Process_delete(Object* cast) {
    Process_done((Process*)cast);
    free(this->cgroup);
    free(this->secattr);
+   free(this->derived);
+   free(this->rates);
    free(this);
 }
 
@@ -191,6 +195,22 @@ static void PCPProcess_writeField(const Process* this, RichString* str, ProcessF
          xSnprintf(buffer, n, "N/A ");
       }
       break;
+   case HOST:
+      xSnprintf(buffer, n, "%-15.15s ", Platform_getHostnameOf(pp->host));
+      break;
+   /* identifiers as known on the host, for processes of further hosts */
+   case PID:
+      xSnprintf(buffer, n, "%*d ", Process_pidDigits, PCPProcess_realPid(pp, this->pid));
+      break;
+   case PPID:
+      xSnprintf(buffer, n, "%*d ", Process_pidDigits, PCPProcess_realPid(pp, this->ppid));
+      break;
+   case TGID:
+      if (this->tgid == this->pid)
+         attr = CRT_colors[PROCESS_SHADOW];
+
+      xSnprintf(buffer, n, "%*d ", Process_pidDigits, PCPProcess_realPid(pp, this->tgid));
+      break;
    default:
       Process_writeField(this, str, field);
       return;
@@ -198,6 +218,31 @@ static void PCPProcess_writeField(const Process* this, RichString* str, ProcessF
    RichString_appendWide(str, attr, buffer);
 }
 
+static bool PCPProcess_getFieldValue(const Process* this, ProcessField key, ProcessFieldValue* value) {
+   const PCPProcess* pp = (const PCPProcess*) this;
+
+   switch ((int)key) {
+   case HOST:
+      value->string = Platform_getHostnameOf(pp->host);
+      value->number = 0.0;
+      return true;
+   case PID:
+      value->string = NULL;
+      value->number = PCPProcess_realPid(pp, this->pid);
+      return true;
+   case PPID:
+      value->string = NULL;
+      value->number = PCPProcess_realPid(pp, this->ppid);
+      return true;
+   case TGID:
+      value->string = NULL;
+      value->number = PCPProcess_realPid(pp, this->tgid);
+      return true;
+   default:
+      return Process_getFieldValue_Base(this, key, value);
+   }
+}
+
 static double adjustNaN(double num) {
    if (isnan(num))
       return -0.0005;
@@ -272,6 +317,8 @@ static int PCPProcess_compareByKey(const Process* v1, const Process* v2, Process
       return SPACESHIP_NUMBER(p1->autogroup_id, p2->autogroup_id);
    case AUTOGROUP_NICE:
       return SPACESHIP_NUMBER(p1->autogroup_nice, p2->autogroup_nice);
+   case HOST:
+      return SPACESHIP_NUMBER(p1->host, p2->host);
    default:
       if (key < LAST_PROCESSFIELD)
          return Process_compareByKey_Base(v1, v2, key);
@@ -287,5 +334,6 @@ const ProcessClass PCPProcess_class = {
       .compare = Process_compare
    },
    .writeField = PCPProcess_writeField,
-   .compareByKey = PCPProcess_compareByKey
+   .compareByKey = PCPProcess_compareByKey,
+   .getFieldValue = PCPProcess_getFieldValue
 };
@@ -11,7 +11,9 @@ in the source distribution for its full text.
 
 #include "config.h" // IWYU pragma: keep
 
+#include <limits.h>
 #include <stdbool.h>
+#include <sys/types.h>
 
 #include "Object.h"
 #include "Process.h"
@@ -25,12 +27,20 @@ in the source distribution for its full text.
 #define PROCESS_FLAG_LINUX_SECATTR   0x00008000
 #define PROCESS_FLAG_LINUX_AUTOGROUP 0x00080000
 
+/* Processes of further hosts are told apart by their identifiers, offset by
+ * this much per host, the Linux PID_MAX_LIMIT */
+#define PCP_HOST_PID_STRIDE (1 << 22)
+#define PCP_MAX_HOSTS (INT_MAX / PCP_HOST_PID_STRIDE + 1)
+
 typedef struct PCPProcess_ {
    Process super;
 
    /* default result offset to use for searching proc metrics */
    unsigned int offset;
 
+   /* index of the host the process runs on, see Platform_useHost */
+   unsigned int host;
+
    unsigned long int cminflt;
    unsigned long int cmajflt;
    unsigned long long int utime;
@@ -87,8 +97,23 @@ typedef struct PCPProcess_ {
    unsigned long ctxt_diff;
    char* secattr;
    unsigned long long int last_mlrs_calctime;
+
+   /* values of the expression columns, and the inputs of their rate()s */
+   double* derived;
+   double* rates;
+   double derivedTime;
 } PCPProcess;
 
+/* Identifier of a process of the host as kept in the process list */
+static inline pid_t PCPProcess_hostPid(unsigned int host, pid_t pid) {
+   return (pid_t)(host * PCP_HOST_PID_STRIDE) + pid;
+}
+
+/* Identifier of a process of the host as known on the host */
+static inline pid_t PCPProcess_realPid(const PCPProcess* this, pid_t pid) {
+   return pid - (pid_t)(this->host * PCP_HOST_PID_STRIDE);
+}
+
 extern const ProcessFieldData Process_fields[LAST_PROCESSFIELD];
 
 extern const ProcessClass PCPProcess_class;
@@ -25,10 +25,14 @@ in the source distribution for its full text.
 #include "Settings.h"
 #include "XUtils.h"
 
+#include "pcp/PCPDynamicColumn.h"
+#include "pcp/PCPDynamicMeter.h"
 #include "pcp/PCPMetric.h"
 #include "pcp/PCPProcess.h"
 
 
+extern Platform* pcp;
+
 static void PCPProcessList_updateCPUcount(PCPProcessList* this) {
    ProcessList* pl = &(this->super);
    pl->activeCPUs = PCPMetric_instanceCount(PCP_PERCPU_SYSTEM);
@@ -50,15 +54,15 @@ static void PCPProcessList_updateCPUcount(PCPProcessList* this) {
    this->values = xCalloc(cpus, sizeof(pmAtomValue));
 }
 
-static char* setUser(UsersTable* this, unsigned int uid, int pid, int offset) {
-   char* name = Hashtable_get(this->users, uid);
+static char* setUser(Hashtable* users, unsigned int uid, int offset) {
+   char* name = Hashtable_get(users, uid);
    if (name)
       return name;
 
-   pmAtomValue value;
-   if (PCPMetric_instance(PCP_PROC_ID_USER, pid, offset, &value, PM_TYPE_STRING)) {
-      Hashtable_put(this->users, uid, value.cp);
-      name = value.cp;
+   const pmAtomValue* value = PCPMetric_column(PCP_PROC_ID_USER, offset, PM_TYPE_STRING);
+   if (value) {
+      name = xStrdup(value->cp);
+      Hashtable_put(users, uid, name);
    }
    return name;
 }
@@ -71,17 +75,30 @@ ProcessList* ProcessList_new(UsersTable* usersTable, Hashtable* dynamicMeters, H
 
    struct timeval timestamp;
    gettimeofday(&timestamp, NULL);
-   this->timestamp = pmtimevalToReal(&timestamp);
 
    this->cpu = xCalloc(CPU_METRIC_COUNT, sizeof(pmAtomValue));
    PCPProcessList_updateCPUcount(this);
 
+   this->hostCount = Platform_getHostCount();
+   this->hosts = xCalloc(this->hostCount, sizeof(PCPHostSample));
+   for (size_t i = 0; i < this->hostCount; i++) {
+      PCPHostSample* host = &this->hosts[i];
+      host->timestamp = pmtimevalToReal(&timestamp);
+      host->cpu = i ? xCalloc(CPU_METRIC_COUNT, sizeof(pmAtomValue)) : this->cpu;
+      host->users = i ? Hashtable_new(64, true) : usersTable->users;
+   }
+
    return super;
 }
 
 void ProcessList_delete(ProcessList* pl) {
    PCPProcessList* this = (PCPProcessList*) pl;
    ProcessList_done(pl);
+   for (size_t i = 1; i < this->hostCount; i++) {
+      free(this->hosts[i].cpu);
+      Hashtable_delete(this->hosts[i].users);
+   }
+   free(this->hosts);
    free(this->values);
    for (unsigned int i = 0; i < pl->existingCPUs; i++)
       free(this->percpu[i]);
@@ -90,106 +107,92 @@ void ProcessList_delete(ProcessList* pl) {
    free(this);
 }
 
-static inline long Metric_instance_s32(int metric, int pid, int offset, long fallback) {
-   pmAtomValue value;
-   if (PCPMetric_instance(metric, pid, offset, &value, PM_TYPE_32))
-      return value.l;
-   return fallback;
+static inline long Metric_instance_s32(int metric, int offset, long fallback) {
+   const pmAtomValue* value = PCPMetric_column(metric, offset, PM_TYPE_32);
+   return value ? value->l : fallback;
 }
 
-static inline long long Metric_instance_s64(int metric, int pid, int offset, long long fallback) {
-   pmAtomValue value;
-   if (PCPMetric_instance(metric, pid, offset, &value, PM_TYPE_64))
-      return value.l;
-   return fallback;
+static inline long long Metric_instance_s64(int metric, int offset, long long fallback) {
+   const pmAtomValue* value = PCPMetric_column(metric, offset, PM_TYPE_64);
+   return value ? value->ll : fallback;
 }
 
-static inline unsigned long Metric_instance_u32(int metric, int pid, int offset, unsigned long fallback) {
-   pmAtomValue value;
-   if (PCPMetric_instance(metric, pid, offset, &value, PM_TYPE_U32))
-      return value.ul;
-   return fallback;
+static inline unsigned long Metric_instance_u32(int metric, int offset, unsigned long fallback) {
+   const pmAtomValue* value = PCPMetric_column(metric, offset, PM_TYPE_U32);
+   return value ? value->ul : fallback;
 }
 
-static inline unsigned long long Metric_instance_u64(int metric, int pid, int offset, unsigned long long fallback) {
-   pmAtomValue value;
-   if (PCPMetric_instance(metric, pid, offset, &value, PM_TYPE_U64))
-      return value.ull;
-   return fallback;
+static inline unsigned long long Metric_instance_u64(int metric, int offset, unsigned long long fallback) {
+   const pmAtomValue* value = PCPMetric_column(metric, offset, PM_TYPE_U64);
+   return value ? value->ull : fallback;
 }
 
-static inline unsigned long long Metric_instance_time(int metric, int pid, int offset) {
-   pmAtomValue value;
-   if (PCPMetric_instance(metric, pid, offset, &value, PM_TYPE_U64))
-      return value.ull / 10;
-   return 0;
+static inline unsigned long long Metric_instance_time(int metric, int offset) {
+   const pmAtomValue* value = PCPMetric_column(metric, offset, PM_TYPE_U64);
+   return value ? value->ull / 10 : 0;
 }
 
-static inline unsigned long long Metric_instance_ONE_K(int metric, int pid, int offset) {
-   pmAtomValue value;
-   if (PCPMetric_instance(metric, pid, offset, &value, PM_TYPE_U64))
-      return value.ull / ONE_K;
-   return ULLONG_MAX;
+static inline unsigned long long Metric_instance_ONE_K(int metric, int offset) {
+   const pmAtomValue* value = PCPMetric_column(metric, offset, PM_TYPE_U64);
+   return value ? value->ull / ONE_K : ULLONG_MAX;
 }
 
-static inline char Metric_instance_char(int metric, int pid, int offset, char fallback) {
-   pmAtomValue value;
-   if (PCPMetric_instance(metric, pid, offset, &value, PM_TYPE_STRING)) {
-      char uchar = value.cp[0];
-      free(value.cp);
-      return uchar;
-   }
-   return fallback;
+static inline char Metric_instance_char(int metric, int offset, char fallback) {
+   const pmAtomValue* value = PCPMetric_column(metric, offset, PM_TYPE_STRING);
+   return value ? value->cp[0] : fallback;
 }
 
-static void PCPProcessList_updateID(Process* process, int pid, int offset) {
-   process->tgid = Metric_instance_u32(PCP_PROC_TGID, pid, offset, 1);
-   process->ppid = Metric_instance_u32(PCP_PROC_PPID, pid, offset, 1);
-   process->state = Metric_instance_char(PCP_PROC_STATE, pid, offset, '?');
+/* The string in the current result, NULL if there is none */
+static inline const char* Metric_instance_string(int metric, int offset) {
+   const pmAtomValue* value = PCPMetric_column(metric, offset, PM_TYPE_STRING);
+   return value ? value->cp : NULL;
 }
 
-static void PCPProcessList_updateInfo(Process* process, int pid, int offset, char* command, size_t commLen) {
+static void PCPProcessList_updateID(Process* process, unsigned int host, int offset) {
+   process->tgid = PCPProcess_hostPid(host, Metric_instance_u32(PCP_PROC_TGID, offset, 1));
+   process->ppid = PCPProcess_hostPid(host, Metric_instance_u32(PCP_PROC_PPID, offset, 1));
+   process->state = Metric_instance_char(PCP_PROC_STATE, offset, '?');
+}
+
+static void PCPProcessList_updateInfo(Process* process, int offset, char* command, size_t commLen) {
    PCPProcess* pp = (PCPProcess*) process;
-   pmAtomValue value;
 
-   if (!PCPMetric_instance(PCP_PROC_CMD, pid, offset, &value, PM_TYPE_STRING))
-      value.cp = xStrdup("<unknown>");
-   String_safeStrncpy(command, value.cp, commLen);
-   free(value.cp);
-
-   process->pgrp = Metric_instance_u32(PCP_PROC_PGRP, pid, offset, 0);
-   process->session = Metric_instance_u32(PCP_PROC_SESSION, pid, offset, 0);
-   process->tty_nr = Metric_instance_u32(PCP_PROC_TTY, pid, offset, 0);
-   process->tpgid = Metric_instance_u32(PCP_PROC_TTYPGRP, pid, offset, 0);
-   process->minflt = Metric_instance_u32(PCP_PROC_MINFLT, pid, offset, 0);
-   pp->cminflt = Metric_instance_u32(PCP_PROC_CMINFLT, pid, offset, 0);
-   process->majflt = Metric_instance_u32(PCP_PROC_MAJFLT, pid, offset, 0);
-   pp->cmajflt = Metric_instance_u32(PCP_PROC_CMAJFLT, pid, offset, 0);
-   pp->utime = Metric_instance_time(PCP_PROC_UTIME, pid, offset);
-   pp->stime = Metric_instance_time(PCP_PROC_STIME, pid, offset);
-   pp->cutime = Metric_instance_time(PCP_PROC_CUTIME, pid, offset);
-   pp->cstime = Metric_instance_time(PCP_PROC_CSTIME, pid, offset);
-   process->priority = Metric_instance_u32(PCP_PROC_PRIORITY, pid, offset, 0);
-   process->nice = Metric_instance_s32(PCP_PROC_NICE, pid, offset, 0);
-   process->nlwp = Metric_instance_u32(PCP_PROC_THREADS, pid, offset, 0);
-   process->starttime_ctime = Metric_instance_time(PCP_PROC_STARTTIME, pid, offset);
-   process->processor = Metric_instance_u32(PCP_PROC_PROCESSOR, pid, offset, 0);
+   const char* cmd = Metric_instance_string(PCP_PROC_CMD, offset);
+   String_safeStrncpy(command, cmd ? cmd : "<unknown>", commLen);
+
+   process->pgrp = Metric_instance_u32(PCP_PROC_PGRP, offset, 0);
+   process->session = Metric_instance_u32(PCP_PROC_SESSION, offset, 0);
+   process->tty_nr = Metric_instance_u32(PCP_PROC_TTY, offset, 0);
+   process->tpgid = Metric_instance_u32(PCP_PROC_TTYPGRP, offset, 0);
+   process->minflt = Metric_instance_u32(PCP_PROC_MINFLT, offset, 0);
+   pp->cminflt = Metric_instance_u32(PCP_PROC_CMINFLT, offset, 0);
+   process->majflt = Metric_instance_u32(PCP_PROC_MAJFLT, offset, 0);
+   pp->cmajflt = Metric_instance_u32(PCP_PROC_CMAJFLT, offset, 0);
+   pp->utime = Metric_instance_time(PCP_PROC_UTIME, offset);
+   pp->stime = Metric_instance_time(PCP_PROC_STIME, offset);
+   pp->cutime = Metric_instance_time(PCP_PROC_CUTIME, offset);
+   pp->cstime = Metric_instance_time(PCP_PROC_CSTIME, offset);
+   process->priority = Metric_instance_u32(PCP_PROC_PRIORITY, offset, 0);
+   process->nice = Metric_instance_s32(PCP_PROC_NICE, offset, 0);
+   process->nlwp = Metric_instance_u32(PCP_PROC_THREADS, offset, 0);
+   process->starttime_ctime = Metric_instance_time(PCP_PROC_STARTTIME, offset);
+   process->processor = Metric_instance_u32(PCP_PROC_PROCESSOR, offset, 0);
 
    process->time = pp->utime + pp->stime;
 }
 
-static void PCPProcessList_updateIO(PCPProcess* pp, int pid, int offset, unsigned long long now) {
-   pmAtomValue value;
+static void PCPProcessList_updateIO(PCPProcess* pp, int offset, unsigned long long now) {
+   const pmAtomValue* value;
 
-   pp->io_rchar = Metric_instance_ONE_K(PCP_PROC_IO_RCHAR, pid, offset);
-   pp->io_wchar = Metric_instance_ONE_K(PCP_PROC_IO_WCHAR, pid, offset);
-   pp->io_syscr = Metric_instance_u64(PCP_PROC_IO_SYSCR, pid, offset, ULLONG_MAX);
-   pp->io_syscw = Metric_instance_u64(PCP_PROC_IO_SYSCW, pid, offset, ULLONG_MAX);
-   pp->io_cancelled_write_bytes = Metric_instance_ONE_K(PCP_PROC_IO_CANCELLED, pid, offset);
+   pp->io_rchar = Metric_instance_ONE_K(PCP_PROC_IO_RCHAR, offset);
+   pp->io_wchar = Metric_instance_ONE_K(PCP_PROC_IO_WCHAR, offset);
+   pp->io_syscr = Metric_instance_u64(PCP_PROC_IO_SYSCR, offset, ULLONG_MAX);
+   pp->io_syscw = Metric_instance_u64(PCP_PROC_IO_SYSCW, offset, ULLONG_MAX);
+   pp->io_cancelled_write_bytes = Metric_instance_ONE_K(PCP_PROC_IO_CANCELLED, offset);
 
-   if (PCPMetric_instance(PCP_PROC_IO_READB, pid, offset, &value, PM_TYPE_U64)) {
+   if ((value = PCPMetric_column(PCP_PROC_IO_READB, offset, PM_TYPE_U64)) != NULL) {
       unsigned long long last_read = pp->io_read_bytes;
-      pp->io_read_bytes = value.ull / ONE_K;
+      pp->io_read_bytes = value->ull / ONE_K;
       pp->io_rate_read_bps = ONE_K * (pp->io_read_bytes - last_read) /
                                      (now - pp->io_last_scan_time);
    } else {
@@ -197,9 +200,9 @@ static void PCPProcessList_updateIO(PCPProcess* pp, int pid, int offset, unsigne
       pp->io_rate_read_bps = NAN;
    }
 
-   if (PCPMetric_instance(PCP_PROC_IO_WRITEB, pid, offset, &value, PM_TYPE_U64)) {
+   if ((value = PCPMetric_column(PCP_PROC_IO_WRITEB, offset, PM_TYPE_U64)) != NULL) {
       unsigned long long last_write = pp->io_write_bytes;
-      pp->io_write_bytes = value.ull;
+      pp->io_write_bytes = value->ull;
       pp->io_rate_write_bps = ONE_K * (pp->io_write_bytes - last_write) /
                                       (now - pp->io_last_scan_time);
    } else {
@@ -210,86 +213,81 @@ static void PCPProcessList_updateIO(PCPProcess* pp, int pid, int offset, unsigne
    pp->io_last_scan_time = now;
 }
 
-static void PCPProcessList_updateMemory(PCPProcess* pp, int pid, int offset) {
-   pp->super.m_virt = Metric_instance_u32(PCP_PROC_MEM_SIZE, pid, offset, 0);
-   pp->super.m_resident = Metric_instance_u32(PCP_PROC_MEM_RSS, pid, offset, 0);
-   pp->m_share = Metric_instance_u32(PCP_PROC_MEM_SHARE, pid, offset, 0);
-   pp->m_trs = Metric_instance_u32(PCP_PROC_MEM_TEXTRS, pid, offset, 0);
-   pp->m_lrs = Metric_instance_u32(PCP_PROC_MEM_LIBRS, pid, offset, 0);
-   pp->m_drs = Metric_instance_u32(PCP_PROC_MEM_DATRS, pid, offset, 0);
-   pp->m_dt = Metric_instance_u32(PCP_PROC_MEM_DIRTY, pid, offset, 0);
+static void PCPProcessList_updateMemory(PCPProcess* pp, int offset) {
+   pp->super.m_virt = Metric_instance_u32(PCP_PROC_MEM_SIZE, offset, 0);
+   pp->super.m_resident = Metric_instance_u32(PCP_PROC_MEM_RSS, offset, 0);
+   pp->m_share = Metric_instance_u32(PCP_PROC_MEM_SHARE, offset, 0);
+   pp->m_trs = Metric_instance_u32(PCP_PROC_MEM_TEXTRS, offset, 0);
+   pp->m_lrs = Metric_instance_u32(PCP_PROC_MEM_LIBRS, offset, 0);
+   pp->m_drs = Metric_instance_u32(PCP_PROC_MEM_DATRS, offset, 0);
+   pp->m_dt = Metric_instance_u32(PCP_PROC_MEM_DIRTY, offset, 0);
 }
 
-static void PCPProcessList_updateSmaps(PCPProcess* pp, pid_t pid, int offset) {
-   pp->m_pss = Metric_instance_u64(PCP_PROC_SMAPS_PSS, pid, offset, 0);
-   pp->m_swap = Metric_instance_u64(PCP_PROC_SMAPS_SWAP, pid, offset, 0);
-   pp->m_psswp = Metric_instance_u64(PCP_PROC_SMAPS_SWAPPSS, pid, offset, 0);
+static void PCPProcessList_updateSmaps(PCPProcess* pp, int offset) {
+   pp->m_pss = Metric_instance_u64(PCP_PROC_SMAPS_PSS, offset, 0);
+   pp->m_swap = Metric_instance_u64(PCP_PROC_SMAPS_SWAP, offset, 0);
+   pp->m_psswp = Metric_instance_u64(PCP_PROC_SMAPS_SWAPPSS, offset, 0);
 }
 
-static void PCPProcessList_readOomData(PCPProcess* pp, int pid, int offset) {
-   pp->oom = Metric_instance_u32(PCP_PROC_OOMSCORE, pid, offset, 0);
+static void PCPProcessList_readOomData(PCPProcess* pp, int offset) {
+   pp->oom = Metric_instance_u32(PCP_PROC_OOMSCORE, offset, 0);
 }
 
-static void PCPProcessList_readAutogroup(PCPProcess* pp, int pid, int offset) {
-   pp->autogroup_id = Metric_instance_s64(PCP_PROC_AUTOGROUP_ID, pid, offset, -1);
-   pp->autogroup_nice = Metric_instance_s32(PCP_PROC_AUTOGROUP_NICE, pid, offset, 0);
+static void PCPProcessList_readAutogroup(PCPProcess* pp, int offset) {
+   pp->autogroup_id = Metric_instance_s64(PCP_PROC_AUTOGROUP_ID, offset, -1);
+   pp->autogroup_nice = Metric_instance_s32(PCP_PROC_AUTOGROUP_NICE, offset, 0);
 }
 
-static void PCPProcessList_readCtxtData(PCPProcess* pp, int pid, int offset) {
-   pmAtomValue value;
-   unsigned long ctxt = 0;
-
-   if (PCPMetric_instance(PCP_PROC_VCTXSW, pid, offset, &value, PM_TYPE_U32))
-      ctxt += value.ul;
-   if (PCPMetric_instance(PCP_PROC_NVCTXSW, pid, offset, &value, PM_TYPE_U32))
-      ctxt += value.ul;
+static void PCPProcessList_readCtxtData(PCPProcess* pp, int offset) {
+   unsigned long ctxt = Metric_instance_u32(PCP_PROC_VCTXSW, offset, 0) +
+                        Metric_instance_u32(PCP_PROC_NVCTXSW, offset, 0);
 
    pp->ctxt_diff = ctxt > pp->ctxt_total ? ctxt - pp->ctxt_total : 0;
    pp->ctxt_total = ctxt;
 }
 
-static char* setString(PCPMetric metric, int pid, int offset, char* string) {
-   if (string)
-      free(string);
-   pmAtomValue value;
-   if (PCPMetric_instance(metric, pid, offset, &value, PM_TYPE_STRING))
-      string = value.cp;
-   else
-      string = NULL;
-   return string;
+/* Copies the string only when it changed, which it rarely does */
+static char* setString(PCPMetric metric, int offset, char* string) {
+   const char* value = Metric_instance_string(metric, offset);
+   if (string && value && String_eq(string, value))
+      return string;
+
+   free(string);
+   return value ? xStrdup(value) : NULL;
 }
 
-static void PCPProcessList_updateTTY(Process* process, int pid, int offset) {
-   process->tty_name = setString(PCP_PROC_TTYNAME, pid, offset, process->tty_name);
+static void PCPProcessList_updateTTY(Process* process, int offset) {
+   process->tty_name = setString(PCP_PROC_TTYNAME, offset, process->tty_name);
 }
 
-static void PCPProcessList_readCGroups(PCPProcess* pp, int pid, int offset) {
-   pp->cgroup = setString(PCP_PROC_CGROUPS, pid, offset, pp->cgroup);
+static void PCPProcessList_readCGroups(PCPProcess* pp, int offset) {
+   pp->cgroup = setString(PCP_PROC_CGROUPS, offset, pp->cgroup);
 }
 
-static void PCPProcessList_readSecattrData(PCPProcess* pp, int pid, int offset) {
-   pp->secattr = setString(PCP_PROC_LABELS, pid, offset, pp->secattr);
+static void PCPProcessList_readSecattrData(PCPProcess* pp, int offset) {
+   pp->secattr = setString(PCP_PROC_LABELS, offset, pp->secattr);
 }
 
-static void PCPProcessList_readCwd(PCPProcess* pp, int pid, int offset) {
-   pp->super.procCwd = setString(PCP_PROC_CWD, pid, offset, pp->super.procCwd);
+static void PCPProcessList_readCwd(PCPProcess* pp, int offset) {
+   pp->super.procCwd = setString(PCP_PROC_CWD, offset, pp->super.procCwd);
 }
 
-static void PCPProcessList_updateUsername(Process* process, int pid, int offset, UsersTable* users) {
-   process->st_uid = Metric_instance_u32(PCP_PROC_ID_UID, pid, offset, 0);
-   process->user = setUser(users, process->st_uid, pid, offset);
+static void PCPProcessList_updateUsername(Process* process, int offset, Hashtable* users) {
+   process->st_uid = Metric_instance_u32(PCP_PROC_ID_UID, offset, 0);
+   process->user = setUser(users, process->st_uid, offset);
 }
 
-static void PCPProcessList_updateCmdline(Process* process, int pid, int offset, const char* comm) {
-   pmAtomValue value;
-   if (!PCPMetric_instance(PCP_PROC_PSARGS, pid, offset, &value, PM_TYPE_STRING)) {
+static void PCPProcessList_updateCmdline(Process* process, int offset, const char* comm) {
+   const char* psargs = Metric_instance_string(PCP_PROC_PSARGS, offset);
+   if (!psargs) {
       if (process->state != 'Z')
          process->isKernelThread = true;
       Process_updateCmdline(process, NULL, 0, 0);
       return;
    }
 
-   char* command = value.cp;
+   char* copy = xStrdup(psargs);
+   char* command = copy;
    int length = strlen(command);
    if (command[0] != '(') {
       process->isKernelThread = false;
@@ -312,22 +310,25 @@ static void PCPProcessList_updateCmdline(Process* process, int pid, int offset,
    int tokenEnd = length;
 
    Process_updateCmdline(process, command, tokenStart, tokenEnd);
-   free(value.cp);
+   free(copy);
 
    Process_updateComm(process, comm);
 
-   if (PCPMetric_instance(PCP_PROC_EXE, pid, offset, &value, PM_TYPE_STRING)) {
-      Process_updateExe(process, value.cp);
-      free(value.cp);
-   }
+   const char* exe = Metric_instance_string(PCP_PROC_EXE, offset);
+   if (exe)
+      Process_updateExe(process, exe);
 }
 
-static bool PCPProcessList_updateProcesses(PCPProcessList* this, double period, struct timeval* tv) {
+static bool PCPProcessList_updateProcesses(PCPProcessList* this, unsigned int host, double period, struct timeval* tv) {
    ProcessList* pl = (ProcessList*) this;
    const Settings* settings = pl->settings;
+   PCPHostSample* sample = &this->hosts[host];
+   unsigned int totalTasks = pl->totalTasks;
+   unsigned int runningTasks = pl->runningTasks;
 
    bool hideKernelThreads = settings->hideKernelThreads;
    bool hideUserlandThreads = settings->hideUserlandThreads;
+   uint32_t scanFlags = ProcessList_scanFlags(pl);
 
    unsigned long long now = tv->tv_sec * 1000LL + tv->tv_usec / 1000LL;
    int pid = -1, offset = -1;
@@ -336,9 +337,10 @@ static bool PCPProcessList_updateProcesses(PCPProcessList* this, double period,
    while (PCPMetric_iterate(PCP_PROC_PID, &pid, &offset)) {
 
       bool preExisting;
-      Process* proc = ProcessList_getProcess(pl, pid, &preExisting, PCPProcess_new);
+      Process* proc = ProcessList_getProcess(pl, PCPProcess_hostPid(host, pid), &preExisting, PCPProcess_new);
       PCPProcess* pp = (PCPProcess*) proc;
-      PCPProcessList_updateID(proc, pid, offset);
+      pp->host = host;
+      PCPProcessList_updateID(proc, host, offset);
       proc->isUserlandThread = proc->pid != proc->tgid;
       pp->offset = offset >= 0 ? offset : 0;
 
@@ -367,58 +369,60 @@ static bool PCPProcessList_updateProcesses(PCPProcessList* this, double period,
          continue;
       }
 
-      if (settings->flags & PROCESS_FLAG_IO)
-         PCPProcessList_updateIO(pp, pid, offset, now);
+      if (scanFlags & PROCESS_FLAG_IO)
+         PCPProcessList_updateIO(pp, offset, now);
 
-      PCPProcessList_updateMemory(pp, pid, offset);
+      PCPProcessList_updateMemory(pp, offset);
 
-      if ((settings->flags & PROCESS_FLAG_LINUX_SMAPS) &&
+      if ((scanFlags & PROCESS_FLAG_LINUX_SMAPS) &&
           (Process_isKernelThread(proc) == false)) {
          if (PCPMetric_enabled(PCP_PROC_SMAPS_PSS))
-            PCPProcessList_updateSmaps(pp, pid, offset);
+            PCPProcessList_updateSmaps(pp, offset);
       }
 
       char command[MAX_NAME + 1];
       unsigned int tty_nr = proc->tty_nr;
       unsigned long long int lasttimes = pp->utime + pp->stime;
 
-      PCPProcessList_updateInfo(proc, pid, offset, command, sizeof(command));
+      PCPProcessList_updateInfo(proc, offset, command, sizeof(command));
       proc->starttime_ctime += Platform_getBootTime();
       if (tty_nr != proc->tty_nr)
-         PCPProcessList_updateTTY(proc, pid, offset);
+         PCPProcessList_updateTTY(proc, offset);
 
       float percent_cpu = (pp->utime + pp->stime - lasttimes) / period * 100.0;
       proc->percent_cpu = isnan(percent_cpu) ?
-                          0.0 : CLAMP(percent_cpu, 0.0, pl->activeCPUs * 100.0);
-      proc->percent_mem = proc->m_resident / (double)pl->totalMem * 100.0;
+                          0.0 : CLAMP(percent_cpu, 0.0, sample->activeCPUs * 100.0);
+      proc->percent_mem = proc->m_resident / (double)sample->totalMem * 100.0;
 
-      PCPProcessList_updateUsername(proc, pid, offset, pl->usersTable);
+      PCPProcessList_updateUsername(proc, offset, sample->users);
 
       if (!preExisting) {
-         PCPProcessList_updateCmdline(proc, pid, offset, command);
+         PCPProcessList_updateCmdline(proc, offset, command);
          Process_fillStarttimeBuffer(proc);
          ProcessList_add(pl, proc);
       } else if (settings->updateProcessNames && proc->state != 'Z') {
-         PCPProcessList_updateCmdline(proc, pid, offset, command);
+         PCPProcessList_updateCmdline(proc, offset, command);
       }
 
-      if (settings->flags & PROCESS_FLAG_LINUX_CGROUP)
-         PCPProcessList_readCGroups(pp, pid, offset);
+      if (scanFlags & PROCESS_FLAG_LINUX_CGROUP)
+         PCPProcessList_readCGroups(pp, offset);
+
+      if (scanFlags & PROCESS_FLAG_LINUX_OOM)
+         PCPProcessList_readOomData(pp, offset);
 
-      if (settings->flags & PROCESS_FLAG_LINUX_OOM)
-         PCPProcessList_readOomData(pp, pid, offset);
+      if (scanFlags & PROCESS_FLAG_LINUX_CTXT)
+         PCPProcessList_readCtxtData(pp, offset);
 
-      if (settings->flags & PROCESS_FLAG_LINUX_CTXT)
-         PCPProcessList_readCtxtData(pp, pid, offset);
+      if (scanFlags & PROCESS_FLAG_LINUX_SECATTR)
+         PCPProcessList_readSecattrData(pp, offset);
 
-      if (settings->flags & PROCESS_FLAG_LINUX_SECATTR)
-         PCPProcessList_readSecattrData(pp, pid, offset);
+      if (scanFlags & PROCESS_FLAG_CWD)
+         PCPProcessList_readCwd(pp, offset);
 
-      if (settings->flags & PROCESS_FLAG_CWD)
-         PCPProcessList_readCwd(pp, pid, offset);
+      if (scanFlags & PROCESS_FLAG_LINUX_AUTOGROUP)
+         PCPProcessList_readAutogroup(pp, offset);
 
-      if (settings->flags & PROCESS_FLAG_LINUX_AUTOGROUP)
-         PCPProcessList_readAutogroup(pp, pid, offset);
+      PCPDynamicColumns_evaluate(&pcp->columns, pp, sample->timestamp);
 
       if (proc->state == 'Z' && !proc->cmdline && command[0]) {
          Process_updateCmdline(proc, command, 0, strlen(command));
@@ -443,6 +447,9 @@ static bool PCPProcessList_updateProcesses(PCPProcessList* this, double period,
          pl->runningTasks++;
       proc->updated = true;
    }
+
+   sample->totalTasks = pl->totalTasks - totalTasks;
+   sample->runningTasks = pl->runningTasks - runningTasks;
    return true;
 }
 
@@ -549,11 +556,11 @@ static void PCPProcessList_deriveCPUTime(pmAtomValue* values) {
    PCPProcessList_saveCPUTimePeriod(values, CPU_TOTAL_PERIOD, totaltime);
 }
 
-static void PCPProcessList_updateAllCPUTime(PCPProcessList* this, PCPMetric metric, CPUMetric cpumetric)
+static void PCPProcessList_updateAllCPUTime(pmAtomValue* values, PCPMetric metric, CPUMetric cpumetric)
 {
-   pmAtomValue* value = &this->cpu[cpumetric];
+   pmAtomValue* value = &values[cpumetric];
    if (PCPMetric_values(metric, value, 1, PM_TYPE_U64) == NULL)
-      memset(&value, 0, sizeof(pmAtomValue));
+      memset(value, 0, sizeof(pmAtomValue));
 }
 
 static void PCPProcessList_updatePerCPUTime(PCPProcessList* this, PCPMetric metric, CPUMetric cpumetric)
@@ -609,23 +616,27 @@ static inline void PCPProcessList_scanZfsArcstats(PCPProcessList* this) {
    this->zfs.isCompressed = (this->zfs.compressed > 0);
 }
 
+static void PCPProcessList_updateAllCPU(pmAtomValue* values) {
+   PCPProcessList_backupCPUTime(values);
+   PCPProcessList_updateAllCPUTime(values, PCP_CPU_USER, CPU_USER_TIME);
+   PCPProcessList_updateAllCPUTime(values, PCP_CPU_NICE, CPU_NICE_TIME);
+   PCPProcessList_updateAllCPUTime(values, PCP_CPU_SYSTEM, CPU_SYSTEM_TIME);
+   PCPProcessList_updateAllCPUTime(values, PCP_CPU_IDLE, CPU_IDLE_TIME);
+   PCPProcessList_updateAllCPUTime(values, PCP_CPU_IOWAIT, CPU_IOWAIT_TIME);
+   PCPProcessList_updateAllCPUTime(values, PCP_CPU_IRQ, CPU_IRQ_TIME);
+   PCPProcessList_updateAllCPUTime(values, PCP_CPU_SOFTIRQ, CPU_SOFTIRQ_TIME);
+   PCPProcessList_updateAllCPUTime(values, PCP_CPU_STEAL, CPU_STEAL_TIME);
+   PCPProcessList_updateAllCPUTime(values, PCP_CPU_GUEST, CPU_GUEST_TIME);
+   PCPProcessList_deriveCPUTime(values);
+}
+
 static void PCPProcessList_updateHeader(ProcessList* super, const Settings* settings) {
    PCPProcessList_updateMemoryInfo(super);
 
    PCPProcessList* this = (PCPProcessList*) super;
    PCPProcessList_updateCPUcount(this);
 
-   PCPProcessList_backupCPUTime(this->cpu);
-   PCPProcessList_updateAllCPUTime(this, PCP_CPU_USER, CPU_USER_TIME);
-   PCPProcessList_updateAllCPUTime(this, PCP_CPU_NICE, CPU_NICE_TIME);
-   PCPProcessList_updateAllCPUTime(this, PCP_CPU_SYSTEM, CPU_SYSTEM_TIME);
-   PCPProcessList_updateAllCPUTime(this, PCP_CPU_IDLE, CPU_IDLE_TIME);
-   PCPProcessList_updateAllCPUTime(this, PCP_CPU_IOWAIT, CPU_IOWAIT_TIME);
-   PCPProcessList_updateAllCPUTime(this, PCP_CPU_IRQ, CPU_IRQ_TIME);
-   PCPProcessList_updateAllCPUTime(this, PCP_CPU_SOFTIRQ, CPU_SOFTIRQ_TIME);
-   PCPProcessList_updateAllCPUTime(this, PCP_CPU_STEAL, CPU_STEAL_TIME);
-   PCPProcessList_updateAllCPUTime(this, PCP_CPU_GUEST, CPU_GUEST_TIME);
-   PCPProcessList_deriveCPUTime(this->cpu);
+   PCPProcessList_updateAllCPU(this->cpu);
 
    for (unsigned int i = 0; i < super->existingCPUs; i++)
       PCPProcessList_backupCPUTime(this->percpu[i]);
@@ -645,6 +656,109 @@ static void PCPProcessList_updateHeader(ProcessList* super, const Settings* sett
       PCPProcessList_updatePerCPUReal(this, PCP_HINV_CPUCLOCK, CPU_FREQUENCY);
 
    PCPProcessList_scanZfsArcstats(this);
+
+   PCPHostSample* sample = &this->hosts[0];
+   sample->activeCPUs = super->activeCPUs;
+   sample->totalMem = super->totalMem;
+   sample->usedMem = super->usedMem;
+}
+
+/* Of further hosts, only what the hosts meter shows */
+static void PCPProcessList_updateHostHeader(PCPHostSample* sample) {
+   int cpus = PCPMetric_instanceCount(PCP_PERCPU_SYSTEM);
+   sample->activeCPUs = cpus > 1 ? (unsigned int)cpus : 1;
+
+   PCPProcessList_updateAllCPU(sample->cpu);
+
+   pmAtomValue total, available;
+   if (PCPMetric_values(PCP_MEM_TOTAL, &total, 1, PM_TYPE_U64) == NULL)
+      total.ull = 0;
+   if (PCPMetric_values(PCP_MEM_AVAILABLE, &available, 1, PM_TYPE_U64) == NULL &&
+       PCPMetric_values(PCP_MEM_FREE, &available, 1, PM_TYPE_U64) == NULL)
+      available.ull = 0;
+   sample->totalMem = total.ull;
+   sample->usedMem = total.ull - MINIMUM(available.ull, total.ull);
+}
+
+/* Marks the processes of the previous sample of the host as updated again */
+static void PCPProcessList_keepProcesses(ProcessList* super, unsigned int host) {
+   for (int i = 0; i < Vector_size(super->processes); i++) {
+      Process* proc = (Process*) Vector_get(super->processes, i);
+      if (proc->tombStampMs > 0 || ((PCPProcess*) proc)->host != host)
+         continue;
+
+      proc->updated = true;
+      proc->show = proc->wasShown;
+      if (Process_isKernelThread(proc))
+         super->kernelThreads++;
+      else if (Process_isUserlandThread(proc))
+         super->userlandThreads++;
+      if (proc->state == 'R')
+         super->runningTasks++;
+      super->totalTasks++;
+   }
+}
+
+static void PCPProcessList_updateSample(PCPProcessList* this, unsigned int host, struct timeval* timestamp, bool pauseProcessUpdate) {
+   ProcessList* super = &this->super;
+   PCPHostSample* sample = &this->hosts[host];
+
+   double previous = sample->timestamp;
+   sample->timestamp = pmtimevalToReal(timestamp);
+
+   if (host == 0) {
+      PCPProcessList_updateHeader(super, super->settings);
+      PCPDynamicMeters_sample(&pcp->meters, sample->timestamp);
+   } else
+      PCPProcessList_updateHostHeader(sample);
+
+   /* In pause mode only update global data for meters (CPU, memory, etc) */
+   if (pauseProcessUpdate)
+      return;
+
+   double period = (sample->timestamp - previous) * 100;
+   PCPProcessList_updateProcesses(this, host, period, timestamp);
+}
+
+static void PCPProcessList_updateHost(PCPProcessList* this, unsigned int host, bool pauseProcessUpdate) {
+   ProcessList* super = &this->super;
+
+   struct timeval timestamp;
+   if (!PCPMetric_fetch(&timestamp)) {
+      /* keep showing the previous sample until a newer one arrives */
+      if (!pauseProcessUpdate)
+         PCPProcessList_keepProcesses(super, host);
+      return;
+   }
+
+   /* After an archive seek, the periods and rates of the sample before the
+    * one shown are over the time skipped; it is a baseline only */
+   if (PCPMetric_rebased()) {
+      unsigned int totalTasks = super->totalTasks;
+      unsigned int runningTasks = super->runningTasks;
+      unsigned int kernelThreads = super->kernelThreads;
+      unsigned int userlandThreads = super->userlandThreads;
+
+      PCPProcessList_updateSample(this, host, &timestamp, pauseProcessUpdate);
+
+      for (int i = 0; i < Vector_size(super->processes); i++) {
+         Process* proc = (Process*) Vector_get(super->processes, i);
+         if (((PCPProcess*) proc)->host == host)
+            proc->updated = false;
+      }
+      super->totalTasks = totalTasks;
+      super->runningTasks = runningTasks;
+      super->kernelThreads = kernelThreads;
+      super->userlandThreads = userlandThreads;
+
+      if (!PCPMetric_fetch(&timestamp)) {
+         if (!pauseProcessUpdate)
+            PCPProcessList_keepProcesses(super, host);
+         return;
+      }
+   }
+
+   PCPProcessList_updateSample(this, host, &timestamp, pauseProcessUpdate);
 }
 
 void ProcessList_goThroughEntries(ProcessList* super, bool pauseProcessUpdate) {
@@ -659,16 +773,17 @@ void ProcessList_goThroughEntries(ProcessList* super, bool pauseProcessUpdate) {
    for (int metric = PCP_PROC_PID; metric < PCP_METRIC_COUNT; metric++)
       PCPMetric_enable(metric, enabled);
 
-   flagged = settings->flags & PROCESS_FLAG_LINUX_CGROUP;
+   uint32_t scanFlags = ProcessList_scanFlags(super);
+   flagged = scanFlags & PROCESS_FLAG_LINUX_CGROUP;
    PCPMetric_enable(PCP_PROC_CGROUPS, flagged && enabled);
-   flagged = settings->flags & PROCESS_FLAG_LINUX_OOM;
+   flagged = scanFlags & PROCESS_FLAG_LINUX_OOM;
    PCPMetric_enable(PCP_PROC_OOMSCORE, flagged && enabled);
-   flagged = settings->flags & PROCESS_FLAG_LINUX_CTXT;
+   flagged = scanFlags & PROCESS_FLAG_LINUX_CTXT;
    PCPMetric_enable(PCP_PROC_VCTXSW, flagged && enabled);
    PCPMetric_enable(PCP_PROC_NVCTXSW, flagged && enabled);
-   flagged = settings->flags & PROCESS_FLAG_LINUX_SECATTR;
+   flagged = scanFlags & PROCESS_FLAG_LINUX_SECATTR;
    PCPMetric_enable(PCP_PROC_LABELS, flagged && enabled);
-   flagged = settings->flags & PROCESS_FLAG_LINUX_AUTOGROUP;
+   flagged = scanFlags & PROCESS_FLAG_LINUX_AUTOGROUP;
    PCPMetric_enable(PCP_PROC_AUTOGROUP_ID, flagged && enabled);
    PCPMetric_enable(PCP_PROC_AUTOGROUP_NICE, flagged && enabled);
 
@@ -679,20 +794,12 @@ void ProcessList_goThroughEntries(ProcessList* super, bool pauseProcessUpdate) {
    PCPMetric_enable(PCP_PROC_SMAPS_SWAP, smaps_flag && enabled);
    PCPMetric_enable(PCP_PROC_SMAPS_SWAPPSS, smaps_flag && enabled);
 
-   struct timeval timestamp;
-   PCPMetric_fetch(&timestamp);
-
-   double sample = this->timestamp;
-   this->timestamp = pmtimevalToReal(&timestamp);
-
-   PCPProcessList_updateHeader(super, settings);
-
-   /* In pause mode only update global data for meters (CPU, memory, etc) */
-   if (pauseProcessUpdate)
-      return;
-
-   double period = (this->timestamp - sample) * 100;
-   PCPProcessList_updateProcesses(this, period, &timestamp);
+   /* the hosts are fetched in the background at the same time, if live */
+   for (unsigned int host = 0; host < this->hostCount; host++) {
+      Platform_useHost(host);
+      PCPProcessList_updateHost(this, host, pauseProcessUpdate);
+   }
+   Platform_useHost(0);
 }
 
 bool ProcessList_isCPUonline(const ProcessList* super, unsigned int id) {
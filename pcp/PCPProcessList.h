@@ -54,9 +54,22 @@ typedef enum CPUMetric_ {
    CPU_METRIC_COUNT
 } CPUMetric;
 
+/* Summary of each host sampled; the header meters show the first one */
+typedef struct PCPHostSample_ {
+   double timestamp;     /* previous sample timestamp */
+   pmAtomValue* cpu;     /* aggregate values, those of the list for the first */
+   Hashtable* users;     /* user names by uid, those of the list for the first */
+   unsigned int activeCPUs;
+   memory_t totalMem;
+   memory_t usedMem;
+   unsigned int totalTasks;
+   unsigned int runningTasks;
+} PCPHostSample;
+
 typedef struct PCPProcessList_ {
    ProcessList super;
-   double timestamp;     /* previous sample timestamp */
+   PCPHostSample* hosts; /* indexed like the hosts of the platform */
+   size_t hostCount;
    pmAtomValue* cpu;     /* aggregate values for each metric */
    pmAtomValue** percpu; /* per-processor values for each metric */
    pmAtomValue* values;  /* per-processor buffer for just one metric */
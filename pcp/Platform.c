@@ -11,20 +11,24 @@ in the source distribution for its full text.
 
 #include "pcp/Platform.h"
 
+#include <ctype.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "BatteryMeter.h"
 #include "CPUMeter.h"
+#include "CRT.h"
 #include "ClockMeter.h"
 #include "DateMeter.h"
 #include "DateTimeMeter.h"
 #include "DiskIOMeter.h"
 #include "DynamicColumn.h"
 #include "DynamicMeter.h"
+#include "FunctionBar.h"
 #include "HostnameMeter.h"
 #include "LoadAverageMeter.h"
 #include "Macros.h"
@@ -33,6 +37,7 @@ in the source distribution for its full text.
 #include "Meter.h"
 #include "NetworkIOMeter.h"
 #include "ProcessList.h"
+#include "ProvideCurses.h"
 #include "Settings.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
@@ -45,8 +50,11 @@ in the source distribution for its full text.
 #include "linux/ZramStats.h"
 #include "pcp/PCPDynamicColumn.h"
 #include "pcp/PCPDynamicMeter.h"
+#include "pcp/HostsMeter.h"
 #include "pcp/PCPMetric.h"
+#include "pcp/PCPProcess.h"
 #include "pcp/PCPProcessList.h"
+#include "pcp/SampleAgeMeter.h"
 #include "zfs/ZfsArcMeter.h"
 #include "zfs/ZfsArcStats.h"
 #include "zfs/ZfsCompressedArcMeter.h"
@@ -93,6 +101,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs8Meter_class,
    &BlankMeter_class,
    &PressureStallCPUSomeMeter_class,
+   &PressureStallCPUFullMeter_class,
    &PressureStallIOSomeMeter_class,
    &PressureStallIOFullMeter_class,
    &PressureStallMemorySomeMeter_class,
@@ -103,6 +112,8 @@ const MeterClass* const Platform_meterTypes[] = {
    &DiskIOMeter_class,
    &NetworkIOMeter_class,
    &SysArchMeter_class,
+   &SampleAgeMeter_class,
+   &HostsMeter_class,
    NULL
 };
 
@@ -162,6 +173,11 @@ static const char* Platform_metricNames[] = {
    [PCP_PSI_IOFULL] = "kernel.all.pressure.io.full.avg",
    [PCP_PSI_MEMSOME] = "kernel.all.pressure.memory.some.avg",
    [PCP_PSI_MEMFULL] = "kernel.all.pressure.memory.full.avg",
+   [PCP_PSI_CPUSOME_TOTAL] = "kernel.all.pressure.cpu.some.total",
+   [PCP_PSI_IOSOME_TOTAL] = "kernel.all.pressure.io.some.total",
+   [PCP_PSI_IOFULL_TOTAL] = "kernel.all.pressure.io.full.total",
+   [PCP_PSI_MEMSOME_TOTAL] = "kernel.all.pressure.memory.some.total",
+   [PCP_PSI_MEMFULL_TOTAL] = "kernel.all.pressure.memory.full.total",
 
    [PCP_ZFS_ARC_ANON_SIZE] = "zfs.arc.anon_size",
    [PCP_ZFS_ARC_BONUS_SIZE] = "zfs.arc.bonus_size",
@@ -286,7 +302,29 @@ void Platform_init(void) {
    }
 
    pcp = xCalloc(1, sizeof(Platform));
-   pcp->context = sts;
+   pcp->hostCount = opts.context == PM_CONTEXT_HOST && opts.nhosts > 1 ? (size_t)opts.nhosts : 1;
+   if (pcp->hostCount > PCP_MAX_HOSTS) {
+      fprintf(stderr, "Cannot monitor more than %d hosts\n", PCP_MAX_HOSTS);
+      exit(1);
+   }
+   pcp->hosts = xCalloc(pcp->hostCount, sizeof(PCPHost));
+   pcp->hosts[0].context = sts;
+
+   /* further hosts are sampled alongside, with the metrics of the first */
+   for (size_t i = 1; i < pcp->hostCount; i++) {
+      sts = pmNewContext(PM_CONTEXT_HOST, opts.hosts[i]);
+      if (sts < 0) {
+         fprintf(stderr, "Cannot setup PCP metric source %s: %s\n", opts.hosts[i], pmErrStr(sts));
+         exit(1);
+      }
+      pcp->hosts[i].context = sts;
+   }
+   for (size_t i = 0; i < pcp->hostCount; i++) {
+      const char* name = pmGetContextHostName(pcp->hosts[i].context);
+      pcp->hosts[i].name = xStrdup(name ? name : "");
+   }
+   Platform_useHost(0);
+
    pcp->fetch = xCalloc(PCP_METRIC_COUNT, sizeof(pmID));
    pcp->pmids = xCalloc(PCP_METRIC_COUNT, sizeof(pmID));
    pcp->names = xCalloc(PCP_METRIC_COUNT, sizeof(char*));
@@ -330,7 +368,10 @@ void Platform_init(void) {
    }
 
    /* set proc.control.perclient.threads to 1 for live contexts */
-   PCPMetric_enableThreads();
+   for (size_t i = 0; i < pcp->hostCount; i++) {
+      Platform_useHost(i);
+      PCPMetric_enableThreads();
+   }
 
    /* extract values needed for setup - e.g. cpu count, pid_max */
    PCPMetric_enable(PCP_PID_MAX, true);
@@ -342,10 +383,14 @@ void Platform_init(void) {
    PCPMetric_enable(PCP_UNAME_MACHINE, true);
    PCPMetric_enable(PCP_UNAME_DISTRO, true);
 
-   for (size_t i = pcp->columns.offset; i < pcp->columns.offset + pcp->columns.count; i++)
+   for (size_t i = pcp->columns.offset; i < pcp->columns.offset + pcp->columns.cursor; i++)
       PCPMetric_enable(i, true);
 
-   PCPMetric_fetch(NULL);
+   for (size_t i = pcp->hostCount; i-- > 0; ) {
+      Platform_useHost(i);
+      PCPMetric_fetch(NULL);
+      Platform_getBootTime();
+   }
 
    for (PCPMetric metric = 0; metric < PCP_PROC_PID; metric++)
       PCPMetric_enable(metric, true);
@@ -357,16 +402,28 @@ void Platform_init(void) {
    PCPMetric_enable(PCP_UNAME_DISTRO, false);
 
    /* first sample (fetch) performed above, save constants */
-   Platform_getBootTime();
    Platform_getRelease(0);
    Platform_getMaxCPU();
    Platform_getMaxPid();
+
+   /* local contexts are not to be used from other threads */
+   if (opts.context == PM_CONTEXT_HOST) {
+      for (size_t i = 0; i < pcp->hostCount; i++)
+         PCPMetric_startFetcher(&pcp->hosts[i], false);
+   } else if (opts.context == PM_CONTEXT_ARCHIVE) {
+      PCPMetric_startFetcher(&pcp->hosts[0], true);
+   }
 }
 
 void Platform_done(void) {
-   pmDestroyContext(pcp->context);
-   if (pcp->result)
-      pmFreeResult(pcp->result);
+   for (size_t i = 0; i < pcp->hostCount; i++) {
+      PCPHost* host = &pcp->hosts[i];
+      PCPMetric_stopFetcher(host);
+      pmDestroyContext(host->context);
+      PCPMetric_freeHost(host);
+      free(host->name);
+   }
+   free(pcp->hosts);
    free(pcp->release);
    free(pcp->fetch);
    free(pcp->pmids);
@@ -375,9 +432,165 @@ void Platform_done(void) {
    free(pcp);
 }
 
+/* Time of the archive sample shown */
+static void Platform_archiveTime(struct timeval* when) {
+   if (pcp->host->result) {
+      *when = pcp->host->result->timestamp;
+   } else {
+      uint64_t msec;
+      Platform_gettime_realtime(when, &msec);
+   }
+}
+
+static void Platform_seekArchive(struct timeval target) {
+   PCPHost* host = &pcp->hosts[0];
+   if (pmtimevalSub(&target, &opts.start) < 0)
+      target = opts.start;
+   if ((opts.finish.tv_sec || opts.finish.tv_usec) && pmtimevalSub(&target, &opts.finish) > 0)
+      target = opts.finish;
+
+   /* the sample before the target is taken as the baseline of the periods
+    * of CPU times and rates, which are then over one interval as usual */
+   int delta = PCPMetric_archiveDelta();
+   struct timeval step = { delta / 1000, (delta % 1000) * 1000 };
+   struct timeval baseline = target;
+   pmtimevalDec(&baseline, &step);
+   if (pmtimevalSub(&baseline, &opts.start) < 0)
+      baseline = opts.start;
+
+   /* the clock goes on from the target, the monotonic time by an interval */
+   struct timeval shown;
+   Platform_archiveTime(&shown);
+   pcp->seekShift += (int64_t)(pmtimevalSub(&shown, &baseline) * 1000) + delta;
+   gettimeofday(&pcp->offset, NULL);
+   pmtimevalDec(&pcp->offset, &target);
+
+   host->rebase = true;
+   PCPMetric_seek(host, &baseline);
+}
+
+static Htop_Reaction Platform_seekArchiveBy(State* st, long seconds) {
+   struct timeval target;
+   Platform_archiveTime(&target);
+   target.tv_sec += seconds;
+   Platform_seekArchive(target);
+   st->pauseProcessUpdate = false;
+   return HTOP_RECALCULATE | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionSeekForward(State* st) {
+   return Platform_seekArchiveBy(st, 60);
+}
+
+static Htop_Reaction Platform_actionSeekBack(State* st) {
+   return Platform_seekArchiveBy(st, -60);
+}
+
+static Htop_Reaction Platform_actionSeekHourForward(State* st) {
+   return Platform_seekArchiveBy(st, 60 * 60);
+}
+
+static Htop_Reaction Platform_actionSeekHourBack(State* st) {
+   return Platform_seekArchiveBy(st, -60 * 60);
+}
+
+/* A date and time, or a time on the day shown, in local time */
+static bool Platform_parseArchiveTime(const char* text, struct timeval* when) {
+   static const char* const formats[] = {
+      "%Y-%m-%d %H:%M:%S",
+      "%Y-%m-%d %H:%M",
+      "%H:%M:%S",
+      "%H:%M",
+   };
+
+   struct timeval shown;
+   Platform_archiveTime(&shown);
+   time_t seconds = shown.tv_sec;
+   struct tm day;
+   (void) localtime_r(&seconds, &day);
+
+   for (size_t i = 0; i < ARRAYSIZE(formats); i++) {
+      struct tm date = day;
+      date.tm_sec = 0;
+      const char* end = strptime(text, formats[i], &date);
+      if (!end || *end)
+         continue;
+
+      date.tm_isdst = -1;
+      time_t parsed = mktime(&date);
+      if (parsed == (time_t)-1)
+         return false;
+
+      when->tv_sec = parsed;
+      when->tv_usec = 0;
+      return true;
+   }
+   return false;
+}
+
+static const char* const jumpFunctions[] = {"Jump  ", "Cancel ", " Jump to: ", NULL};
+static const char* const jumpKeys[] = {"Enter", "Esc", "  "};
+static const int jumpEvents[] = {13, 27, ERR};
+
+static Htop_Reaction Platform_actionJump(State* st) {
+   FunctionBar* bar = FunctionBar_new(jumpFunctions, jumpKeys, jumpEvents);
+   char buffer[32] = "";
+   size_t length = 0;
+   bool failed = false;
+   bool jumped = false;
+   bool resized = false;
+
+   for (;;) {
+      FunctionBar_drawExtra(bar, buffer, failed ? CRT_colors[FAILED_SEARCH] : -1, true);
+      move(LINES - 1, CRT_cursorX);
+      refresh();
+
+      int ch = CRT_readKey();
+      if (ch == 27)
+         break;
+      if (ch == KEY_RESIZE) {
+         /* the prompt follows the bottom line, the rest is redrawn once done */
+         resized = true;
+         continue;
+      }
+      if (ch == 13 || ch == KEY_ENTER || ch == '\n') {
+         struct timeval target;
+         if (!Platform_parseArchiveTime(buffer, &target)) {
+            failed = true;
+            continue;
+         }
+         Platform_seekArchive(target);
+         jumped = true;
+         break;
+      }
+      if ((ch == KEY_BACKSPACE || ch == 127) && length > 0) {
+         buffer[--length] = '\0';
+      } else if (0 < ch && ch < 255 && isprint((unsigned char)ch) && length + 1 < sizeof(buffer)) {
+         buffer[length++] = (char)ch;
+         buffer[length] = '\0';
+      }
+      failed = false;
+   }
+
+   curs_set(0);
+   FunctionBar_delete(bar);
+   Htop_Reaction reaction = resized ? HTOP_RESIZE : HTOP_OK;
+   if (!jumped)
+      return reaction | HTOP_REDRAW_BAR;
+
+   st->pauseProcessUpdate = false;
+   return reaction | HTOP_RECALCULATE | HTOP_REDRAW_BAR;
+}
+
 void Platform_setBindings(Htop_Action* keys) {
-   /* no platform-specific key bindings */
-   (void)keys;
+   if (opts.context != PM_CONTEXT_ARCHIVE)
+      return;
+
+   keys['f'] = Platform_actionSeekForward;
+   keys['b'] = Platform_actionSeekBack;
+   keys['}'] = Platform_actionSeekHourForward;
+   keys['{'] = Platform_actionSeekHourBack;
+   keys['j'] = Platform_actionJump;
 }
 
 int Platform_getUptime(void) {
@@ -422,13 +635,14 @@ int Platform_getMaxPid(void) {
 }
 
 long long Platform_getBootTime(void) {
-   if (pcp->btime)
-      return pcp->btime;
+   PCPHost* host = pcp->host;
+   if (host->btime)
+      return host->btime;
 
    pmAtomValue value;
    if (PCPMetric_values(PCP_BOOTTIME, &value, 1, PM_TYPE_64) != NULL)
-      pcp->btime = value.ll;
-   return pcp->btime;
+      host->btime = value.ll;
+   return host->btime;
 }
 
 static double Platform_setOneCPUValues(Meter* this, pmAtomValue* values) {
@@ -545,8 +759,20 @@ void Platform_setZfsCompressedArcValues(Meter* this) {
 }
 
 void Platform_getHostname(char* buffer, size_t size) {
-   const char* hostname = pmGetContextHostName(pcp->context);
-   String_safeStrncpy(buffer, hostname, size);
+   String_safeStrncpy(buffer, pcp->host->name, size);
+}
+
+size_t Platform_getHostCount(void) {
+   return pcp->hostCount;
+}
+
+const char* Platform_getHostnameOf(size_t host) {
+   return pcp->hosts[host].name;
+}
+
+void Platform_useHost(size_t host) {
+   pcp->host = &pcp->hosts[host];
+   pmUseContext(pcp->host->context);
 }
 
 void Platform_getRelease(char** string) {
@@ -628,28 +854,50 @@ FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    return NULL;
 }
 
-void Platform_getPressureStall(const char* file, bool some, double* ten, double* sixty, double* threehundred) {
-   *ten = *sixty = *threehundred = 0;
+OpenFiles_ProcessData* Platform_getProcessFiles(pid_t pid) {
+   (void)pid;
+   return NULL;
+}
 
-   PCPMetric metric;
-   if (String_eq(file, "cpu"))
-      metric = PCP_PSI_CPUSOME;
-   else if (String_eq(file, "io"))
-      metric = some ? PCP_PSI_IOSOME : PCP_PSI_IOFULL;
-   else if (String_eq(file, "mem"))
-      metric = some ? PCP_PSI_MEMSOME : PCP_PSI_MEMFULL;
-   else
+static void Platform_getPressureStallLine(PCPMetric avg, PCPMetric total, PressureStallLine* line) {
+   pmAtomValue values[3] = {0};
+   if (PCPMetric_values(avg, values, 3, PM_TYPE_DOUBLE) == NULL)
       return;
 
-   pmAtomValue values[3] = {0};
-   if (PCPMetric_values(metric, values, 3, PM_TYPE_DOUBLE) != NULL) {
-      *ten = values[0].d;
-      *sixty = values[1].d;
-      *threehundred = values[2].d;
+   line->valid = true;
+   line->avg10 = values[0].d;
+   line->avg60 = values[1].d;
+   line->avg300 = values[2].d;
+
+   pmAtomValue value;
+   if (PCPMetric_values(total, &value, 1, PM_TYPE_U64) != NULL)
+      line->total = value.ull;
+}
+
+bool Platform_getPressureStall(PressureStallResource resource, PressureStallData* data) {
+   memset(data, 0, sizeof(*data));
+
+   switch (resource) {
+      case PRESSURE_STALL_CPU:
+         /* no metric for the full line of cpu pressure */
+         Platform_getPressureStallLine(PCP_PSI_CPUSOME, PCP_PSI_CPUSOME_TOTAL, &data->some);
+         break;
+      case PRESSURE_STALL_IO:
+         Platform_getPressureStallLine(PCP_PSI_IOSOME, PCP_PSI_IOSOME_TOTAL, &data->some);
+         Platform_getPressureStallLine(PCP_PSI_IOFULL, PCP_PSI_IOFULL_TOTAL, &data->full);
+         break;
+      case PRESSURE_STALL_MEMORY:
+         Platform_getPressureStallLine(PCP_PSI_MEMSOME, PCP_PSI_MEMSOME_TOTAL, &data->some);
+         Platform_getPressureStallLine(PCP_PSI_MEMFULL, PCP_PSI_MEMFULL_TOTAL, &data->full);
+         break;
+      default:
+         return false;
    }
+
+   return data->some.valid;
 }
 
-bool Platform_getDiskIO(DiskIOData* data) {
+bool Platform_getDiskIO(DiskIOData* data, ATTR_UNUSED DiskIODevices* devices) {
    memset(data, 0, sizeof(*data));
 
    pmAtomValue value;
@@ -662,7 +910,7 @@ bool Platform_getDiskIO(DiskIOData* data) {
    return true;
 }
 
-bool Platform_getNetworkIO(NetworkIOData* data) {
+bool Platform_getNetworkIO(NetworkIOData* data, ATTR_UNUSED NetworkIOInterfaces* interfaces) {
    memset(data, 0, sizeof(*data));
 
    pmAtomValue value;
@@ -684,7 +932,8 @@ void Platform_getBattery(double* level, ACPresence* isOnAC) {
 
 void Platform_longOptionsUsage(ATTR_UNUSED const char* name) {
    printf(
-"   --host=HOSTSPEC              metrics source is PMCD at HOSTSPEC [see PCPIntro(1)]\n"
+"   --host=HOSTSPEC              metrics source is PMCD at HOSTSPEC [see PCPIntro(1)],\n"
+"                                repeat to show the processes of several hosts\n"
 "   --hostzone                   set reporting timezone to local time of metrics source\n"
 "   --timezone=TZ                set reporting timezone\n");
 }
@@ -739,9 +988,10 @@ void Platform_gettime_realtime(struct timeval* tv, uint64_t* msec) {
 }
 
 void Platform_gettime_monotonic(uint64_t* msec) {
-   if (pcp->result) {
-      struct timeval* tv = &pcp->result->timestamp;
+   if (pcp->host->result) {
+      struct timeval* tv = &pcp->host->result->timestamp;
       *msec = ((uint64_t)tv->tv_sec * 1000) + ((uint64_t)tv->tv_usec / 1000);
+      *msec = (uint64_t)((int64_t)*msec + pcp->seekShift);
    } else {
       *msec = 0;
    }
@@ -776,7 +1026,10 @@ Hashtable* Platform_dynamicColumns(void) {
 const char* Platform_dynamicColumnInit(unsigned int key) {
    PCPDynamicColumn* this = Hashtable_get(pcp->columns.table, key);
    if (this) {
-      PCPMetric_enable(this->id, true);
+      if (this->expression)
+         PCPExpression_enable(this->expression);
+      else
+         PCPMetric_enable(this->id, true);
       if (this->super.caption)
          return this->super.caption;
       if (this->super.heading)
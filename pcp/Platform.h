@@ -31,27 +31,30 @@ in the source distribution for its full text.
 #include "Meter.h"
 #include "NetworkIOMeter.h"
 #include "Process.h"
+#include "OpenFilesScreen.h"
 #include "ProcessLocksScreen.h"
 #include "RichString.h"
 #include "SignalsPanel.h"
 
+#include "linux/PressureStall.h"
 #include "pcp/PCPDynamicColumn.h"
 #include "pcp/PCPDynamicMeter.h"
 #include "pcp/PCPMetric.h"
 
 
 typedef struct Platform_ {
-   int context;               /* PMAPI(3) context identifier */
+   PCPHost* hosts;            /* metrics sources, the first one in the header */
+   size_t hostCount;
+   PCPHost* host;             /* the source metric values are taken from */
    size_t totalMetrics;       /* total number of all metrics */
    const char** names;        /* name array indexed by Metric */
    pmID* pmids;               /* all known metric identifiers */
    pmID* fetch;               /* enabled identifiers for sampling */
    pmDesc* descs;             /* metric desc array indexed by Metric */
-   pmResult* result;          /* sample values result indexed by Metric */
    PCPDynamicMeters meters;   /* dynamic meters via configuration files */
    PCPDynamicColumns columns; /* dynamic columns via configuration files */
    struct timeval offset;     /* time offset used in archive mode only */
-   long long btime;           /* boottime in seconds since the epoch */
+   int64_t seekShift;         /* msec keeping sample times monotonic over seeks */
    char* release;             /* uname and distro from this context */
    int pidmax;                /* maximum platform process identifier */
    unsigned int ncpu;         /* maximum processor count configured */
@@ -101,16 +104,26 @@ char* Platform_getInodeFilename(pid_t pid, ino_t inode);
 
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid);
 
-void Platform_getPressureStall(const char* file, bool some, double* ten, double* sixty, double* threehundred);
+OpenFiles_ProcessData* Platform_getProcessFiles(pid_t pid);
 
-bool Platform_getDiskIO(DiskIOData* data);
+bool Platform_getPressureStall(PressureStallResource resource, PressureStallData* data);
 
-bool Platform_getNetworkIO(NetworkIOData* data);
+bool Platform_getDiskIO(DiskIOData* data, DiskIODevices* devices);
+
+bool Platform_getNetworkIO(NetworkIOData* data, NetworkIOInterfaces* interfaces);
 
 void Platform_getBattery(double* percent, ACPresence* isOnAC);
 
 void Platform_getHostname(char* buffer, size_t size);
 
+/* Hosts given with --host, at least the one metrics source */
+size_t Platform_getHostCount(void);
+
+const char* Platform_getHostnameOf(size_t host);
+
+/* Takes metric values from the given host from now on */
+void Platform_useHost(size_t host);
+
 void Platform_getRelease(char** string);
 
 enum {
@@ -0,0 +1,54 @@
+/*
+htop - SampleAgeMeter.c
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "pcp/SampleAgeMeter.h"
+
+#include "CRT.h"
+#include "Object.h"
+#include "ProcessList.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "XUtils.h"
+
+#include "pcp/PCPMetric.h"
+
+
+static const int SampleAgeMeter_attributes[] = {
+   METER_VALUE,
+};
+
+static void SampleAgeMeter_updateValues(Meter* this) {
+   this->values[0] = PCPMetric_sampleAge() / 1000.0;
+   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%.1fs", this->values[0]);
+}
+
+static void SampleAgeMeter_display(const Object* cast, RichString* out) {
+   const Meter* this = (const Meter*)cast;
+
+   /* older than two update intervals: the host is slow to answer */
+   double delay = this->pl->settings->delay / 10.0;
+   int color = this->values[0] > 2 * delay ? METER_VALUE_WARN : METER_VALUE;
+   RichString_writeAscii(out, CRT_colors[color], this->txtBuffer);
+}
+
+const MeterClass SampleAgeMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = SampleAgeMeter_display
+   },
+   .updateValues = SampleAgeMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .maxItems = 1,
+   .total = 100.0,
+   .attributes = SampleAgeMeter_attributes,
+   .name = "SampleAge",
+   .uiName = "Sample age",
+   .caption = "Sample age: ",
+};
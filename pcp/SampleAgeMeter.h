@@ -0,0 +1,15 @@
+#ifndef HEADER_SampleAgeMeter
+#define HEADER_SampleAgeMeter
+/*
+htop - SampleAgeMeter.h
+(C) 2021 htop dev team
+Released under the GNU GPLv2, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Meter.h"
+
+
+extern const MeterClass SampleAgeMeter_class;
+
+#endif